@@ -16,6 +16,7 @@
 
 // Standard C++ headers
 #include <vector>
+#include <memory>
 
 // wxWidgets headers
 #include <wx/wx.h>
@@ -30,7 +31,9 @@ namespace LibPlot2D
 class PlotRenderer;
 class TextRendering;
 class PlotCurve;
+class CurveBatch;
 class Dataset2D;
+class TiledDataset;
 class Color;
 class GuiInterface;
 
@@ -60,6 +63,33 @@ public:
 	/// \param data Data set to add.
 	void AddCurve(const Dataset2D &data);
 
+	/// Adds the specified out-of-core data set to the plot.  The plotted
+	/// data is rebuilt from the data set's tiles whenever the x-axis limits
+	/// change, and again as finer tiles are read in the background.  The
+	/// data set must remain valid until the curve is removed.
+	///
+	/// \param data Data set to add.
+	void AddCurve(TiledDataset &data);
+
+	/// Adds a curve which draws a copy of the caller's data (see
+	/// PlotRenderer::AddCurve()).  If an out-of-core data set is specified,
+	/// it must have been prepared with PrepareTiledDataset(), and the copy is
+	/// refreshed from it whenever its view changes.  The data set must
+	/// remain valid until the curve is removed, but its load callback is
+	/// not cleared on removal.
+	///
+	/// \param data  Copy of the data to plot.
+	/// \param tiled Data set from which the copy was made, if any.
+	void AddCurve(std::shared_ptr<Dataset2D> data,
+		TiledDataset* tiled = nullptr);
+
+	/// Builds the initial view of an out-of-core data set and arranges for
+	/// the plot to be updated as tiles are read.  Doesn't modify the scene,
+	/// so this may be called while a frame is being drawn.
+	///
+	/// \param data Data set to prepare.
+	void PrepareTiledDataset(TiledDataset &data);
+
 	/// \name Accessors for the axes limits
 	/// @{
 
@@ -101,6 +131,33 @@ public:
 		const bool &visible, const bool &rightAxis, const double &lineSize,
 		const int &markerSize);
 
+	/// Indicates that the data for the specified curve has been modified in
+	/// place, so the curve's geometry must be rebuilt.
+	///
+	/// \param index Index of the modified curve.
+	void SetCurveDataModified(const unsigned int &index);
+
+	/// Replaces the copy of the data drawn by the specified curve (see
+	/// AddCurve()).
+	///
+	/// \param index Index of the modified curve.
+	/// \param data  New copy of the data.
+	void SetCurveDataModified(const unsigned int &index, Dataset2D data);
+
+	/// Indicates that points have been added to the end of the data for the
+	/// specified curve, and that the existing points are unchanged.
+	///
+	/// \param index Index of the modified curve.
+	void SetCurveDataAppended(const unsigned int &index);
+
+	/// Adds points to the end of the copy of the data drawn by the specified
+	/// curve (see AddCurve()).
+	///
+	/// \param index    Index of the modified curve.
+	/// \param appended Points to add.
+	void SetCurveDataAppended(const unsigned int &index,
+		const Dataset2D& appended);
+
 	/// \name Grid line control
 	/// @{
 
@@ -140,6 +197,83 @@ public:
 	/// \param pretty Set true to use the higher quality rendering algorithm.
 	void SetPrettyCurves(const bool &pretty) { mPretty = pretty; }
 
+	/// Sets the flag indicating whether or not curve geometry should be kept
+	/// resident on the GPU (see PlotRenderer::SetResidentCurves()).
+	///
+	/// \param resident Set true to keep curve geometry resident.
+	void SetResidentCurves(const bool &resident) { mResident = resident; }
+
+	/// Gets the flag indicating whether or not curve geometry is kept
+	/// resident on the GPU.
+	/// \returns True if curve geometry is kept resident.
+	bool GetResidentCurves() const { return mResident; }
+
+	/// Sets the flag indicating whether or not thick curves should be expanded
+	/// into triangles on the GPU (see PlotRenderer::SetShaderLines()).
+	///
+	/// \param shaderLines Set true to expand curves on the GPU.
+	void SetShaderLines(const bool &shaderLines) { mShaderLines = shaderLines; }
+
+	/// Gets the flag indicating whether or not thick curves are expanded into
+	/// triangles on the GPU.
+	/// \returns True if curves are expanded on the GPU.
+	bool GetShaderLines() const { return mShaderLines; }
+
+	/// Sets the flag indicating whether or not the lines of curves sharing a
+	/// y-axis should be drawn together (see PlotRenderer::SetBatchCurves()).
+	///
+	/// \param batch Set true to draw curves together.
+	void SetBatchCurves(const bool &batch) { mBatchCurves = batch; }
+
+	/// Gets the flag indicating whether or not the lines of curves sharing a
+	/// y-axis are drawn together.
+	/// \returns True if curves are drawn together.
+	bool GetBatchCurves() const { return mBatchCurves; }
+
+	/// Sets the flag indicating whether or not curves should be drawn as
+	/// density maps (see PlotRenderer::SetDensityCurves()).
+	///
+	/// \param density Set true to draw density maps.
+	void SetDensityCurves(const bool &density) { mDensity = density; }
+
+	/// Gets the flag indicating whether or not curves are drawn as density
+	/// maps.
+	/// \returns True if curves are drawn as density maps.
+	bool GetDensityCurves() const { return mDensity; }
+
+	/// Sets the flag indicating whether or not large curves are refined in
+	/// the background (see PlotRenderer::SetProgressiveRendering()).
+	///
+	/// \param progressive Set true to refine large curves in the background.
+	void SetProgressiveCurves(const bool &progressive) { mProgressive = progressive; }
+
+	/// Gets the flag indicating whether or not large curves are refined in
+	/// the background.
+	/// \returns True if large curves are refined in the background.
+	bool GetProgressiveCurves() const { return mProgressive; }
+
+	/// Sets the flag indicating whether or not curves should be drawn as
+	/// decimated previews.  Has no effect unless progressive rendering is
+	/// enabled.
+	///
+	/// \param preview Set true to draw previews.
+	void SetPreviewCurves(const bool &preview) { mPreview = preview; }
+
+	/// Gets the flag indicating whether or not curves are drawn as previews.
+	/// \returns True if curves are drawn as previews.
+	bool GetPreviewCurves() const { return mProgressive && mPreview; }
+
+	/// Sets the maximum number of points to use for each curve when drawing
+	/// previews.
+	///
+	/// \param budget Maximum number of points per curve.
+	void SetPreviewPointBudget(const unsigned int &budget) { mPreviewPointBudget = budget; }
+
+	/// Gets the maximum number of points to use for each curve when drawing
+	/// previews.
+	/// \returns The maximum number of points per curve.
+	unsigned int GetPreviewPointBudget() const { return mPreviewPointBudget; }
+
 	/// \name Text object controls
 	/// @{
 
@@ -242,6 +376,10 @@ private:
 
 	TextRendering *mTitleObject;
 
+	// Draw the lines of the curves bound to each y-axis
+	CurveBatch *mLeftBatch;
+	CurveBatch *mRightBatch;
+
 	// The minimums and maximums for the axis
 	double mXMin, mXMax, mYLeftMin, mYLeftMax, mYRightMin, mYRightMax;
 	double mXMinOriginal = 0.0;
@@ -260,6 +398,13 @@ private:
 	bool mRightUsed = false;
 
 	bool mPretty;
+	bool mResident = false;
+	bool mShaderLines = false;
+	bool mBatchCurves = false;
+	bool mDensity = false;
+	bool mProgressive = false;
+	bool mPreview = false;
+	unsigned int mPreviewPointBudget = 200000;
 
 	double mXMajorResolution;
 	double mYLeftMajorResolution;
@@ -270,6 +415,8 @@ private:
 	// The actual plot objects
 	std::vector<PlotCurve*> mPlotList;
 	std::vector<const Dataset2D*> mDataList;
+	std::vector<TiledDataset*> mTiledList;// nullptr for in-memory curves
+	std::vector<std::shared_ptr<Dataset2D>> mCopyList;// nullptr for curves drawing the caller's data
 
 	std::string mFontFileName;
 	void CreateAxisObjects();
@@ -302,6 +449,7 @@ private:
 	void FormatTitle();
 
 	void FormatCurves();
+	void UpdateTiledCurves();
 
 	void CheckForZeroRange();
 	void HandleZeroRangeAxis(double &min, double &max) const;
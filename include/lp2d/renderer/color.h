@@ -113,6 +113,18 @@ public:
 	/// \returns A wxColor object equivalent to this.
 	wxColor ToWxColor() const;
 
+	/// \name Comparison operators
+	/// @{
+
+	inline bool operator==(const Color &c) const
+	{
+		return mRed == c.mRed && mGreen == c.mGreen && mBlue == c.mBlue
+			&& mAlpha == c.mAlpha;
+	}
+	inline bool operator!=(const Color &c) const { return !(*this == c); }
+
+	/// @}
+
 	/// Creates a color object given its RGBA values.
 	///
 	/// \param red   Value of red (0.0 to 1.0).
@@ -0,0 +1,117 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  contextGroup.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Group of render windows whose OpenGL contexts share objects, with an
+//        optional on-disk cache of linked program binaries.
+
+#ifndef CONTEXT_GROUP_H_
+#define CONTEXT_GROUP_H_
+
+// Local headers
+#include "lp2d/renderer/renderWindow.h"
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+namespace LibPlot2D
+{
+
+/// Group of render windows whose OpenGL contexts share objects.  Programs,
+/// shared index buffers and glyph textures are created by the first window in
+/// the group which needs them and re-used by the others, so an application
+/// with many plots pays the cost of building them only once.  Windows are
+/// added to a group with RenderWindow::SetContextGroup() prior to rendering.
+/// All windows in a group must render on the same thread.
+///
+/// Optionally, linked programs may be stored in a file (as returned by
+/// glGetProgramBinary()) and loaded on later runs in place of compiling the
+/// shaders.  The cache is discarded if the OpenGL driver changes.
+class ContextGroup
+{
+public:
+	ContextGroup() = default;
+	~ContextGroup();
+
+	ContextGroup(const ContextGroup&) = delete;
+	ContextGroup& operator=(const ContextGroup&) = delete;
+
+	/// Sets the file used to store program binaries.  Existing contents are
+	/// read the first time a program is built.  Has no effect if the OpenGL
+	/// implementation does not support program binaries.
+	///
+	/// \param fileName Path and name of the cache file.
+	void SetProgramCacheFile(const std::string& fileName);
+
+	/// Writes any program binaries added since the cache was read.  Called
+	/// automatically on destruction.
+	///
+	/// \returns True if the file was written (or nothing needed writing).
+	bool SaveProgramCache();
+
+private:
+	friend RenderWindow;
+
+	// Protects the members below (but not the OpenGL objects themselves)
+	std::mutex mMutex;
+
+	// Contexts belonging to the group; new contexts share with the first
+	std::vector<wxGLContext*> mContexts;
+
+	// Uniform values (i.e. matrices) are stored with the program, so each
+	// window must send its own values when it follows another window
+	const RenderWindow* mProgramOwner = nullptr;
+
+	std::unordered_map<std::string, RenderWindow::ShaderInfo> mPrograms;
+	std::unordered_map<std::string, RenderWindow::SharedIndexBuffer> mIndexBuffers;
+
+	wxGLContext* CreateContext(RenderWindow& window,
+		const wxGLContextAttrs& attributes);
+	void RemoveContext(const RenderWindow& window, wxGLContext* context);
+	bool ClaimPrograms(const RenderWindow& window);
+
+	bool FindProgram(const std::string& name, RenderWindow::ShaderInfo& shader);
+	void AddProgram(const std::string& name,
+		const RenderWindow::ShaderInfo& shader);
+
+	// Program binary cache
+	std::string mCacheFileName;
+	bool mCacheLoaded = false;
+	bool mCacheSupported = false;
+	bool mCacheModified = false;
+	std::string mDriverName;
+
+	struct ProgramBinary
+	{
+		GLenum format;
+		std::vector<char> data;
+	};
+
+	std::unordered_map<std::uint64_t, ProgramBinary> mProgramBinaries;
+
+	bool UsesProgramCache();
+	GLuint LoadProgram(const std::uint64_t& key);
+	void StoreProgram(const std::uint64_t& key, const GLuint& program);
+	bool ReadProgramCache();
+
+	static std::uint64_t ComputeProgramKey(
+		const std::vector<std::pair<GLenum, std::string>>& shaders);
+
+	static const char mCacheMagic[8];
+	static const std::uint32_t mCacheVersion;
+};
+
+}// namespace LibPlot2D
+
+#endif// CONTEXT_GROUP_H_
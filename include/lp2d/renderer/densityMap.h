@@ -0,0 +1,157 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  densityMap.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helper class for rendering the density of large sets of points as a
+//        color-mapped, screen-resolution histogram.
+
+#ifndef DENSITY_MAP_H_
+#define DENSITY_MAP_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Local headers
+#include "lp2d/renderer/color.h"
+
+namespace LibPlot2D
+{
+
+// Local forward declarations
+class RenderWindow;
+
+/// Helper class for rendering the density of points rather than the points
+/// themselves.  Points are counted in a two-dimensional histogram with one
+/// bin per pixel, which is sent to OpenGL as a texture and drawn as a single
+/// quad, with the count in each bin mapped to a color.  The cost of drawing
+/// depends only on the size of the plot area, and the cost of binning only on
+/// the number of points counted, so this is suitable for data sets which are
+/// too large to draw as markers (and which would appear as a solid area if
+/// they were).
+class DensityMap
+{
+public:
+	/// Constructor.
+	///
+	/// \param renderWindow Window in which the map will be rendered.
+	explicit DensityMap(RenderWindow& renderWindow);
+	~DensityMap();
+
+	DensityMap(const DensityMap&) = delete;
+	DensityMap& operator=(const DensityMap&) = delete;
+
+	/// Structure describing the location and size of the histogram bins.
+	struct Extents
+	{
+		double xMinimum = 0.0;///< Left edge of the first column [scaled plot units].
+		double yMinimum = 0.0;///< Bottom edge of the first row [scaled plot units].
+		double xScale = 0.0;///< Width of each column [scaled plot units].
+		double yScale = 0.0;///< Height of each row [scaled plot units].
+		unsigned int columns = 0;///< Number of columns.
+		unsigned int rows = 0;///< Number of rows.
+	};
+
+	/// Sets the colors to which bin counts are mapped.  Counts are scaled
+	/// logarithmically, with the first color used for bins containing one
+	/// point and the last used for the fullest bin.  Empty bins are not
+	/// drawn.
+	///
+	/// \param colorMap Colors, ordered from least to most dense.  Must
+	///                 contain between two and eight colors.
+	void SetColorMap(const std::vector<Color>& colorMap);
+
+	/// Counts the specified points.  If the points, stride and extents are
+	/// the same as for the previous call, no work is done.  The points may be
+	/// binned on any thread, but the result must be sent to OpenGL with
+	/// Upload() from the thread which owns the OpenGL context.
+	///
+	/// \param x       Array of x-values [scaled plot units].
+	/// \param y       Array of y-values [scaled plot units].
+	/// \param count   Number of elements in \p x and \p y.
+	/// \param stride  Spacing between points to count (one to count every
+	///                point).
+	/// \param extents Location and size of the bins.
+	/// \param force   Set to true to bin the points even if the arguments
+	///                match the previous call (i.e. when the values have
+	///                changed).
+	///
+	/// \returns True if the bins were updated.
+	bool Build(const double* x, const double* y, const std::size_t& count,
+		const unsigned int& stride, const Extents& extents,
+		const bool& force);
+
+	/// Gets the location and size of the most recently built bins.
+	/// \returns The extents of the bins.
+	const Extents& GetExtents() const { return mExtents; }
+
+	/// Sends the most recently built bins to OpenGL.
+	void Upload();
+
+	/// Renders the bins previously sent to OpenGL with Upload().  Uses the
+	/// map's own program, restoring the default program prior to returning.
+	///
+	/// \param modelview Matrix converting positions relative to the minimum
+	///                  of the extents to pixels.
+	void Draw(const Eigen::Matrix4d& modelview);
+
+private:
+	RenderWindow& mRenderWindow;
+
+	std::vector<Color> mColorMap;
+
+	// Inputs for the most recent build
+	Extents mExtents;
+	const double* mX = nullptr;
+	const double* mY = nullptr;
+	std::size_t mCount = 0;
+	unsigned int mStride = 0;
+
+	std::vector<unsigned int> mBins;// Row-major, from bottom left
+	unsigned int mMaximumCount = 0;
+
+	GLuint mTexture = 0;
+	GLuint mVertexArray = 0;
+	unsigned int mTextureColumns = 0;
+	unsigned int mTextureRows = 0;
+
+	static bool ExtentsMatch(const Extents& a, const Extents& b);
+	static void CountPoints(const double* x, const double* y,
+		const std::size_t& begin, const std::size_t& end,
+		const unsigned int& stride, const Extents& extents,
+		std::vector<unsigned int>& bins);
+
+	// Each block counts into its own set of bins, so the points are only
+	// split into blocks when there are many more points than bins
+	static const unsigned int mMinPointsPerBlock;
+
+	static const unsigned int mMaxColorMapSize;
+	static const std::vector<Color> mDefaultColorMap;
+
+	static const std::string mVertexShader;
+	static const std::string mFragmentShader;
+
+	static const std::string mExtentName;
+	static const std::string mBinsName;
+	static const std::string mLogMaximumName;
+	static const std::string mColorMapName;
+	static const std::string mColorMapSizeName;
+
+	GLuint DoGLInitialization();
+	friend RenderWindow;
+};
+
+}// namespace LibPlot2D
+
+#endif// DENSITY_MAP_H_
@@ -0,0 +1,144 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  glyphCache.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Process-wide cache of glyphs rasterized with Freetype, shared among
+//        all objects rendering text with the same font and size.
+
+#ifndef GLYPH_CACHE_H_
+#define GLYPH_CACHE_H_
+
+// Freetype headers
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <tuple>
+#include <memory>
+#include <mutex>
+
+namespace LibPlot2D
+{
+
+/// Class for rasterizing and storing the glyphs for one font face at one
+/// pixel size.  Instances are obtained with Get(); all callers requesting the
+/// same font and size share one instance (and one set of rasterizations),
+/// which is destroyed when the last reference is released.  The ASCII glyphs
+/// are rasterized when the cache is created; other glyphs are rasterized the
+/// first time they are requested.  Glyphs are never removed, so glyph indices
+/// remain valid for the life of the cache.  All methods are thread-safe.
+class GlyphCache
+{
+public:
+	~GlyphCache();
+
+	GlyphCache(const GlyphCache&) = delete;
+	GlyphCache& operator=(const GlyphCache&) = delete;
+
+	/// Gets the cache for the specified font and size, creating it if
+	/// necessary.
+	///
+	/// \param fontFileName Path and file name of the TrueType font file.
+	/// \param width        Width of the glyphs in pixels (zero to maintain
+	///                     the font's aspect ratio).
+	/// \param height       Height of the glyphs in pixels.
+	///
+	/// \returns The cache, or nullptr if the font could not be loaded.
+	static std::shared_ptr<GlyphCache> Get(const std::string& fontFileName,
+		const unsigned int& width, const unsigned int& height);
+
+	/// Checks to see if the specified font file can be loaded.  Results are
+	/// remembered, so only the first check for each file is expensive.
+	///
+	/// \param fontFileName Path and file name of the TrueType font file.
+	///
+	/// \returns True if the file contains a usable font.
+	static bool FaceIsValid(const std::string& fontFileName);
+
+	/// Structure describing a rasterized glyph.
+	struct Glyph
+	{
+		int xSize;///< Width of the bitmap in pixels.
+		int ySize;///< Height of the bitmap in pixels.
+		int xBearing;///< Offset from the pen position to the left of the bitmap.
+		int yBearing;///< Offset from the baseline to the top of the bitmap.
+		unsigned int advance;///< Pen advance in 1/64 pixels.
+		std::vector<unsigned char> bitmap;///< Rows of single-byte pixels.
+	};
+
+	/// Gets the index of the glyph for the specified character, rasterizing
+	/// the glyph if necessary.
+	///
+	/// \param c           Unicode code point of the character.
+	/// \param index [out] Index of the glyph.
+	///
+	/// \returns True if the glyph is available.
+	bool GetGlyphIndex(const char32_t& c, unsigned int& index);
+
+	/// Gets the glyph with the specified index.  The returned reference
+	/// remains valid for the life of the cache.
+	///
+	/// \param index Index of the glyph, as returned by GetGlyphIndex().
+	///
+	/// \returns The glyph.
+	const Glyph& GetGlyph(const unsigned int& index) const;
+
+	/// Gets the number of glyphs which have been rasterized.
+	/// \returns The number of glyphs.
+	unsigned int GetGlyphCount() const;
+
+	/// Gets the size of the largest glyph bitmap.
+	///
+	/// \param xSize [out] Largest bitmap width in pixels.
+	/// \param ySize [out] Largest bitmap height in pixels.
+	void GetMaximumSize(unsigned int& xSize, unsigned int& ySize) const;
+
+private:
+	GlyphCache() = default;
+
+	static const unsigned int mPreloadedGlyphCount;
+
+	FT_Face mFace = nullptr;
+
+	std::deque<Glyph> mGlyphs;
+	std::unordered_map<char32_t, unsigned int> mGlyphIndices;
+
+	unsigned int mMaxXSize = 0;
+	unsigned int mMaxYSize = 0;
+
+	mutable std::mutex mMutex;
+
+	bool Rasterize(const char32_t& c);
+
+	typedef std::tuple<std::string, unsigned int, unsigned int> Key;
+	static std::map<Key, std::weak_ptr<GlyphCache>> mCaches;
+	static std::set<std::string> mValidFaces;
+
+	// Recursive, since a cache which fails to initialize is destroyed (which
+	// also requires the lock) from within Get()
+	static std::recursive_mutex mCacheMutex;
+
+	// Library is shared among all caches (guarded by mCacheMutex)
+	static FT_Library mFt;
+	static unsigned int mFtReferenceCount;
+
+	static bool AcquireLibrary();
+	static void ReleaseLibrary();
+};
+
+}// namespace LibPlot2D
+
+#endif// GLYPH_CACHE_H_
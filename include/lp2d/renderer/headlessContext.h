@@ -0,0 +1,58 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  headlessContext.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  OpenGL context which does not belong to a window, for rendering to
+//        framebuffer objects without a window system surface.
+
+#ifndef HEADLESS_CONTEXT_H_
+#define HEADLESS_CONTEXT_H_
+
+namespace LibPlot2D
+{
+
+/// OpenGL (4.0 core profile) context which does not belong to a window, for
+/// rendering to framebuffer objects only (see RenderWindow::SetHeadless()).
+/// The context is created with EGL, on Mesa's surfaceless platform where it
+/// is available (which requires neither a display server nor a GPU, when
+/// rendering with llvmpipe); otherwise, on the default display.  If the
+/// implementation can't make a context current without a surface, a 1x1
+/// pbuffer is used.  Each object has its own context, so several may be
+/// current at once on different threads.  Not available under MSW.
+class HeadlessContext
+{
+public:
+	HeadlessContext();
+	~HeadlessContext();
+
+	HeadlessContext(const HeadlessContext&) = delete;
+	HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+	/// Checks to see if the context was created successfully.
+	/// \returns True if the context can be used.
+	bool IsOK() const { return mContext != nullptr; }
+
+	/// Makes the context current on the calling thread.
+	/// \returns True if the context was made current.
+	bool MakeCurrent() const;
+
+private:
+	// EGL handles (stored opaquely, so EGL's platform headers aren't
+	// included with ours)
+	void* mDisplay = nullptr;
+	void* mSurface = nullptr;
+	void* mContext = nullptr;
+
+	static bool HasExtension(const char* extensions, const char* name);
+};
+
+}// namespace LibPlot2D
+
+#endif// HEADLESS_CONTEXT_H_
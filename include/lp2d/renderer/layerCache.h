@@ -0,0 +1,97 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  layerCache.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Offscreen image of the static portion of a scene, which is composited
+//        with the overlay primitives each frame.
+
+#ifndef LAYER_CACHE_H_
+#define LAYER_CACHE_H_
+
+// Standard C++ headers
+#include <string>
+
+namespace LibPlot2D
+{
+
+/// Class for caching an image of the objects which don't change during
+/// overlay-only interactions (grid, axes, curves, etc.).  The objects are
+/// drawn to a framebuffer with the same number of samples as the window and
+/// resolved into a texture; on subsequent frames, the texture is drawn to
+/// the window in place of the objects.  Since this class uses OpenGL types
+/// which are only available through GLEW, it must only be included after
+/// GL/glew.h.  All methods must be called with the owning context current.
+class LayerCache
+{
+public:
+	LayerCache() = default;
+
+	LayerCache(const LayerCache&) = delete;
+	LayerCache& operator=(const LayerCache&) = delete;
+
+	/// Checks to see if the cached image has the specified size.
+	///
+	/// \param width  Width of the render target in pixels.
+	/// \param height Height of the render target in pixels.
+	///
+	/// \returns True if the cached image can be composited.
+	bool Matches(const int& width, const int& height) const
+	{ return mWidth == width && mHeight == height; }
+
+	/// Binds the cache framebuffer for drawing, (re)allocating it if the size
+	/// has changed.  The window's framebuffer must be bound when this is
+	/// called.
+	///
+	/// \param width  Width of the render target in pixels.
+	/// \param height Height of the render target in pixels.
+	///
+	/// \returns True if the framebuffer is ready; if false, the objects must
+	///          be drawn directly to the window.
+	bool Begin(const int& width, const int& height);
+
+	/// Resolves the drawn objects into the cache texture and binds the
+	/// window's framebuffer.
+	void End();
+
+	/// Draws the cached image to the bound framebuffer, replacing its
+	/// contents.
+	///
+	/// \param activeProgram OpenGL id of the program to restore afterwards.
+	void Composite(const GLuint& activeProgram);
+
+	/// Deletes all OpenGL objects owned by this.
+	void FreeOpenGLObjects();
+
+private:
+	static const std::string mVertexShader;
+	static const std::string mFragmentShader;
+	static const std::string mLayerName;
+
+	int mWidth = 0;
+	int mHeight = 0;
+	GLint mSamples = 0;
+
+	// First framebuffer is drawn to when multisampling; second holds the
+	// resolved image
+	GLuint mFramebuffers[2] = {};
+	GLuint mRenderbuffer = 0;
+	GLuint mTexture = 0;
+
+	GLuint mProgram = 0;
+	GLuint mVertexArray = 0;
+
+	bool Allocate(const int& width, const int& height);
+	void FreeFramebuffers();
+	void BuildProgram();
+};
+
+}// namespace LibPlot2D
+
+#endif// LAYER_CACHE_H_
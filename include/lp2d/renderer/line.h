@@ -21,6 +21,11 @@
 #include <vector>
 #include <utility>
 #include <cassert>
+#include <functional>
+#include <string>
+
+// Eigen headers
+#include <Eigen/Eigen>
 
 // Local headers
 #include "lp2d/renderer/color.h"
@@ -41,7 +46,7 @@ public:
 	/// Constructor.
 	///
 	/// \param renderWindow Window in which the line will be rendered.
-	explicit Line(const RenderWindow& renderWindow);
+	explicit Line(RenderWindow& renderWindow);
 
 	/// \name Option setting methods
 	/// @{
@@ -91,6 +96,25 @@ public:
 	inline void SetYScale(const double& scale)
 	{ assert(scale > 0.0); mYScale = scale; }
 
+	/// Sets a flag indicating whether or not pretty lines should use the
+	/// index buffer shared among all lines in the window, rather than
+	/// creating their own.  Lines built with shared indices have an empty
+	/// Primitive::BufferInfo::indexBuffer, so this must be disabled if the
+	/// indices are needed (e.g. to combine buffers prior to rendering).
+	///
+	/// \param share True to use the shared index buffer.
+	inline void SetShareIndices(const bool &share) { mShareIndices = share; }
+
+	/// Sets a flag indicating whether or not the vertex buffer should contain
+	/// only vertex positions.  Compact lines have a single color, which is
+	/// supplied when rendering; they must be drawn after a call to
+	/// UseCompactProgram() rather than with the default program.  Compact
+	/// geometry is not compatible with the default program, so this must be
+	/// disabled if buffers are to be combined with other geometry.
+	///
+	/// \param compact True to omit colors from the vertex buffer.
+	inline void SetCompact(const bool &compact) { mCompact = compact; }
+
 	/// Sets the OpenGL rendering type hint.
 	///
 	/// \param hint Hint to tell the drivers how often to expect this object to
@@ -188,11 +212,32 @@ public:
 		Primitive::BufferInfo& bufferInfo,
 		const UpdateMethod& update = UpdateMethod::Immediate) const;
 
+	/// Sends geometry created with UpdateMethod::Manual to OpenGL.  The
+	/// geometry may be created on any thread, but this must be called from
+	/// the thread which owns the OpenGL context.
+	///
+	/// \param bufferInfo Information regarding populated buffers.
+	void Upload(Primitive::BufferInfo& bufferInfo) const;
+
 	/// @}
 
 	/// \name Methods for executing the OpenGL rendering.
 	/// @{
 
+	/// Activates the program for rendering compact geometry (see
+	/// SetCompact()).  Each group of four vertices in a pretty line is drawn
+	/// with the edge color on the outer vertices and the line color on the
+	/// inner vertices, so the fade to the background requires no per-vertex
+	/// data.  Other geometry (ugly lines, markers, etc.) should be drawn with
+	/// the edge color equal to the line color.  The caller is responsible for
+	/// restoring the default program after drawing.
+	///
+	/// \param modelview Matrix to apply to vertex positions.
+	/// \param lineColor Color of the line.
+	/// \param edgeColor Color of the faded edges of the line.
+	void UseCompactProgram(const Eigen::Matrix4d& modelview,
+		const Color& lineColor, const Color& edgeColor);
+
 	/// To be called after creation of Primitive::BufferInfo objects.  This
 	/// method must only be used if geometry was created with a call to Build()
 	/// after a call to SetPretty(false).
@@ -219,6 +264,9 @@ public:
 
 	/// @}
 
+	/// Attribute location for vertex positions in compact geometry.
+	static const GLuint mCompactPositionLocation;
+
 private:
 	static const double mFadeDistance;
 	double mHalfWidth;
@@ -226,41 +274,41 @@ private:
 	Color mLineColor = Color::ColorBlack;
 	Color mBackgroundColor;
 	bool mPretty = true;
+	bool mShareIndices = true;
+	bool mCompact = false;
 
 	double mXScale = 1.0;
 	double mYScale = 1.0;
 
-	const RenderWindow& mRenderWindow;
+	RenderWindow& mRenderWindow;
 
 	GLenum mHint;
 
-	void ComputeOffsets(const double &x1, const double &y1, const double &x2,
-		const double &y2, double& dxLine, double& dyLine, double& dxEdge,
-		double& dyEdge) const;
-	void ComputeOffsets(const double &xPrior, const double &yPrior,
-		const double &x, const double &y, const double &xNext,
-		const double &yNext, double& dxLine, double& dyLine, double& dxEdge,
-		double& dyEdge) const;
+	void ComputeDirections(const Eigen::ArrayXd& dx, const Eigen::ArrayXd& dy,
+		Eigen::Ref<Eigen::ArrayXd> ux, Eigen::Ref<Eigen::ArrayXd> uy) const;
+	void ComputeContinuousOffsets(const std::vector<double>& x,
+		const std::vector<double>& y, const unsigned int& begin,
+		const unsigned int& end, Eigen::ArrayXd& dxLine,
+		Eigen::ArrayXd& dyLine) const;
+	void ComputeSegmentOffsets(const std::vector<double>& x,
+		const std::vector<double>& y, const unsigned int& begin,
+		const unsigned int& end, Eigen::ArrayXd& dxLine,
+		Eigen::ArrayXd& dyLine) const;
 
-	struct Offsets
-	{
-		double dxLine;
-		double dyLine;
-		double dxEdge;
-		double dyEdge;
-	};
+	static void SplitPoints(const std::vector<std::pair<double, double>> &points,
+		std::vector<double>& x, std::vector<double>& y);
 
 	void DoUglyDraw(const double &x1, const double &y1, const double &x2,
 		const double &y2, const UpdateMethod& update,
 		Primitive::BufferInfo& bufferInfo) const;
-	void DoUglyDraw(const std::vector<std::pair<double, double>> &points,
+	void DoUglyDraw(const std::vector<double>& x, const std::vector<double>& y,
 		const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const;
-	void DoPrettyDraw(const std::vector<std::pair<double, double>> &points,
+	void DoPrettyDraw(const std::vector<double>& x, const std::vector<double>& y,
 		const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const;
 
-	void DoPrettySegmentDraw(
-		const std::vector<std::pair<double, double>> &points,
-		const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const;
+	void DoPrettySegmentDraw(const std::vector<double>& x,
+		const std::vector<double>& y, const UpdateMethod& update,
+		Primitive::BufferInfo& bufferInfo) const;
 
 	enum class LineStyle
 	{
@@ -268,11 +316,38 @@ private:
 		Segments
 	};
 
-	void AssignVertexData(const std::vector<std::pair<double, double>>& points,
-		const LineStyle& style, Primitive::BufferInfo& bufferInfo) const;
+	// Style of the most recently built pretty line, for selecting the
+	// appropriate shared index buffer
+	mutable LineStyle mPrettyStyle = LineStyle::Continuous;
+
+	static const std::string mContinuousIndicesName;
+	static const std::string mSegmentIndicesName;
+	static void AssignContinuousIndices(std::vector<unsigned int>& indices);
+	static void AssignSegmentIndices(std::vector<unsigned int>& indices);
+
+	void AssignVertexData(const std::vector<double>& x,
+		const std::vector<double>& y, const LineStyle& style,
+		Primitive::BufferInfo& bufferInfo) const;
+	void AssignVertexData(const std::vector<double>& x,
+		const std::vector<double>& y, const LineStyle& style,
+		const unsigned int& begin, const unsigned int& end,
+		Primitive::BufferInfo& bufferInfo) const;
+
+	// Long lines are split into blocks of this many points, which are built
+	// concurrently (must be even, so segments are never split)
+	static const unsigned int mPointsPerBlock;
 
 	void AllocateBuffer(const unsigned int& vertexCount,
 		const unsigned int& triangleCount, Primitive::BufferInfo& bufferInfo) const;
+
+	static const std::string mCompactVertexShader;
+	static const std::string mCompactFragmentShader;
+
+	static const std::string mLineColorName;
+	static const std::string mEdgeColorName;
+
+	GLuint DoGLInitialization();
+	friend RenderWindow;
 };
 
 }// namespace LibPlot2D
@@ -0,0 +1,132 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  marker.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Object representing data markers, drawn as instanced quads with the
+//        shape determined by the fragment shader.
+
+#ifndef MARKER_H_
+#define MARKER_H_
+
+// Standard C++ headers
+#include <string>
+#include <cassert>
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Local headers
+#include "lp2d/renderer/color.h"
+#include "lp2d/renderer/primitives/primitive.h"
+
+namespace LibPlot2D
+{
+
+// Local forward declarations
+class RenderWindow;
+
+/// Helper class for rendering data markers.  The vertex buffer contains only
+/// one position per marker; each marker is drawn as an instance of a quad,
+/// sized in pixels by the vertex shader and shaped by the fragment shader.
+/// Since marker sizes are computed on the GPU, the geometry does not need to
+/// be rebuilt when the scale changes.
+class Marker
+{
+public:
+	/// Constructor.
+	///
+	/// \param renderWindow Window in which the markers will be rendered.
+	explicit Marker(RenderWindow& renderWindow);
+
+	/// Enumeration of available marker shapes.
+	enum class Shape
+	{
+		Square,
+		Circle,
+		Cross
+	};
+
+	/// \name Option setting methods
+	/// @{
+
+	/// Sets the marker size.
+	///
+	/// \param size Width of the markers in pixels.
+	inline void SetSize(const double &size)
+	{ assert(size >= 0.0); mHalfSize = 0.5 * size; }
+
+	/// Sets the marker color.
+	///
+	/// \param color Color of the markers.
+	inline void SetColor(const Color &color) { mColor = color; }
+
+	/// Sets the marker shape.
+	///
+	/// \param shape Shape of the markers.
+	inline void SetShape(const Shape &shape) { mShape = shape; }
+
+	/// Sets the OpenGL rendering type hint.
+	///
+	/// \param hint Hint to tell the drivers how often to expect this object to
+	///             update.
+	inline void SetBufferHint(const GLenum& hint) { mHint = hint; }
+
+	/// @}
+
+	/// Sends the marker positions to OpenGL.  The vertex buffer must contain
+	/// one x-y pair for each marker, with Primitive::BufferInfo::vertexCount
+	/// equal to the number of markers.  The buffer may be filled on any
+	/// thread, but this must be called from the thread which owns the OpenGL
+	/// context.
+	///
+	/// \param bufferInfo Information regarding populated buffers.
+	/// \param first      Index of the first element of the vertex buffer
+	///                   which changed since the last upload.
+	void Upload(Primitive::BufferInfo& bufferInfo,
+		const std::vector<float>::size_type& first = 0);
+
+	/// Renders markers previously sent to OpenGL with Upload().  Uses the
+	/// markers' own program, restoring the default program prior to
+	/// returning.
+	///
+	/// \param bufferInfo Information regarding the populated OpenGL buffers.
+	/// \param modelview  Matrix converting marker positions to pixels.
+	void Draw(const Primitive::BufferInfo& bufferInfo,
+		const Eigen::Matrix4d& modelview);
+
+private:
+	double mHalfSize;
+
+	Color mColor = Color::ColorBlack;
+	Shape mShape = Shape::Square;
+
+	RenderWindow& mRenderWindow;
+
+	GLenum mHint;
+
+	static const std::string mVertexShader;
+	static const std::string mFragmentShader;
+
+	static const std::string mHalfSizeName;
+	static const std::string mShapeName;
+	static const std::string mMarkerColorName;
+
+	// Attribute location (fixed by layout qualifier in the vertex shader)
+	static const GLuint mCenterLocation;
+
+	static const unsigned int mVerticesPerMarker;
+
+	GLuint DoGLInitialization();
+	friend RenderWindow;
+};
+
+}// namespace LibPlot2D
+
+#endif// MARKER_H_
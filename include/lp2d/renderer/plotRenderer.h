@@ -28,6 +28,10 @@
 #include <vector>
 #include <cmath>
 #include <memory>
+#include <chrono>
+
+// wxWidgets headers
+#include <wx/timer.h>
 
 // wxWidgets forward declarations
 class wxString;
@@ -38,11 +42,18 @@ namespace LibPlot2D
 // Local forward declarations
 class PlotObject;
 class Dataset2D;
+class TiledDataset;
 class ZoomBox;
 class PlotCursor;
 class GuiInterface;
-
-/// Class for handling rendering of 2D plots.
+class TextRendering;
+
+/// Class for handling rendering of 2D plots.  Threaded rendering (see
+/// RenderWindow::SetThreadedRendering()) is supported:  methods which modify
+/// the scene wait for the frame being drawn (if any) to complete, while
+/// panning and zooming only change the axis limits, which are applied to the
+/// scene once the frame is complete.  Data sets must not be modified while a
+/// frame is being drawn.
 class PlotRenderer : public RenderWindow
 {
 public:
@@ -54,7 +65,7 @@ public:
 	/// \param attr		    Requested OpenGL canvas/context attributes.
 	PlotRenderer(GuiInterface& guiInterface, wxWindow &parent, wxWindowID id,
 		const wxGLAttributes& attr);
-	~PlotRenderer() = default;
+	~PlotRenderer();
 
 	/// Enumeration of quality levels for drawing curves.
 	enum class CurveQuality
@@ -99,6 +110,24 @@ public:
 	bool GetMinorGridOn() const;
 
 	CurveQuality GetCurveQuality() const { return mCurveQuality; }
+	bool GetResidentCurves() const;
+	bool GetShaderLines() const;
+	bool GetBatchCurves() const;
+	bool GetDensityCurves() const;
+	bool GetProgressiveRendering() const;
+
+	/// Gets the time allowed for rendering each frame during interaction.
+	/// \returns The frame time budget in seconds.
+	double GetPreviewFrameBudget() const { return mPreviewFrameBudget; }
+
+	/// Gets the time after the most recent interaction before curves are
+	/// refined.
+	/// \returns The refinement delay in seconds.
+	double GetRefinementDelay() const { return mRefinementDelay; }
+
+	/// Checks to see if rendering statistics are shown over the plot.
+	/// \returns True if the statistics overlay is shown.
+	bool GetShowStatistics() const { return mShowStatistics; }
 
 	bool LegendIsVisible() const;
 
@@ -148,6 +177,78 @@ public:
 
 	void SetCurveQuality(const CurveQuality& curveQuality);
 
+	/// Sets a flag indicating whether or not curve geometry should be kept
+	/// resident on the GPU.  When enabled, panning and zooming are handled by
+	/// updating the modelview matrices only; curve geometry is rebuilt when
+	/// the data, curve properties or (for line styles that depend on it) the
+	/// number of pixels per unit change.
+	///
+	/// \param resident True to keep curve geometry resident.
+	void SetResidentCurves(const bool& resident);
+
+	/// Sets a flag indicating whether or not the thick, anti-aliased curves
+	/// should be expanded into triangles on the GPU.  When enabled, only the
+	/// data points are sent to OpenGL (rather than the triangle vertices and
+	/// indices) and the geometry does not depend on the plot scale.
+	///
+	/// \param shaderLines True to expand curves on the GPU.
+	void SetShaderLines(const bool& shaderLines);
+
+	/// Sets a flag indicating whether or not the lines of curves which share
+	/// a y-axis should be drawn together.  When enabled, the line geometry
+	/// of the curves is packed into one buffer per axis and drawn with a
+	/// single multi-draw call (per line width, for non-pretty curves), so
+	/// the per-frame cost of issuing draw calls does not grow with the
+	/// number of curves.  Curves expanded on the GPU (see SetShaderLines())
+	/// and markers are still drawn individually.
+	///
+	/// \param batch True to draw curves together.
+	void SetBatchCurves(const bool& batch);
+
+	/// Sets a flag indicating whether or not curves should be drawn as
+	/// density maps.  Rather than drawing lines and markers, the points of
+	/// each curve are counted in a histogram with one bin per pixel, and the
+	/// bins are drawn with colors indicating the number of points they
+	/// contain.  This is useful for scatter plots with too many points to
+	/// distinguish when drawn individually; the cost of drawing depends on
+	/// the size of the plot rather than the number of points.
+	///
+	/// \param density True to draw curves as density maps.
+	void SetDensityCurves(const bool& density);
+
+	/// Sets a flag indicating whether or not curves should be rendered
+	/// progressively.  When enabled, curves are drawn as decimated previews
+	/// while the user is panning or zooming, with the number of points per
+	/// curve adjusted so frames are rendered within the preview frame
+	/// budget.  Once interaction stops, full-fidelity geometry for large
+	/// curves is built on worker threads and is displayed when complete.
+	///
+	/// \param progressive True to render curves progressively.
+	void SetProgressiveRendering(const bool& progressive);
+
+	/// Sets the time allowed for rendering each frame during interaction
+	/// (see SetProgressiveRendering()).
+	///
+	/// \param budget Frame time budget in seconds.
+	void SetPreviewFrameBudget(const double& budget);
+
+	/// Sets the time after the most recent interaction before curves are
+	/// refined (see SetProgressiveRendering()).
+	///
+	/// \param delay Refinement delay in seconds.
+	void SetRefinementDelay(const double& delay);
+
+	/// Sets a flag indicating whether or not to show rendering statistics
+	/// (frame rate, vertices drawn, data uploaded, buffers rebuilt, frame
+	/// times and input latency) in the upper left corner of the plot area.
+	/// Showing the statistics enables their collection (see
+	/// RenderWindow::SetCollectStatistics()); hiding them does not disable
+	/// it.  The overlay is updated each time a frame is rendered and is
+	/// omitted from offscreen renders.
+	///
+	/// \param show True to show the statistics.
+	void SetShowStatistics(const bool& show);
+
 	void SetLegendOn();
 	void SetLegendOff();
 
@@ -174,16 +275,54 @@ public:
 		const bool &visible, const bool &rightAxis, const double &lineSize,
 		const int &markerSize);
 
+	/// Indicates that the data for the specified curve has been modified in
+	/// place and updates the display.  Curve geometry is only rebuilt when
+	/// the data or the view changes, and changes to the values of existing
+	/// data can't be detected otherwise.  If the curve draws a copy of the
+	/// data (see AddCurve()), the copy is replaced.
+	///
+	/// \param index Index of the modified curve.
+	void SetCurveDataModified(const unsigned int &index);
+
+	/// Indicates that points have been added to the end of the data for the
+	/// specified curve (i.e. streaming data), and that the existing points
+	/// are unchanged.  Where possible, only the new points are processed and
+	/// sent to OpenGL (and only the new points are added to the curve's copy
+	/// of the data, if any).
+	///
+	/// \param index Index of the modified curve.
+	void SetCurveDataAppended(const unsigned int &index);
+
 	/// Adds the specified curve to the list of rendered curves.  Internally
-	/// creates a PlotCurve object and adds it to this.
+	/// creates a PlotCurve object and adds it to this.  The data must remain
+	/// valid until the curve is removed, and must not be modified without
+	/// calling SetCurveDataModified() or SetCurveDataAppended().  When
+	/// rendering is threaded, the curve draws a copy of the data, so frames
+	/// being drawn never read the caller's data, and adding, modifying and
+	/// removing the curve are queued (see ModifyScene()) rather than waiting
+	/// for the frame to complete.  Curves added before rendering was made
+	/// threaded draw the caller's data, so these changes wait for the
+	/// render thread.
 	///
 	/// \param data Data set to add.
 	void AddCurve(const Dataset2D &data);
 
-	/// Removes all curves from the list.
+	/// Adds the specified out-of-core data set to the list of rendered
+	/// curves.  Only the tiles required for the current view are read from
+	/// the data set's file, so files much larger than the available memory
+	/// may be plotted.  The data set must remain valid until the curve is
+	/// removed.  As with in-memory curves, when rendering is threaded the
+	/// curve draws a copy of the data set's current view.
+	///
+	/// \param data Data set to add.
+	void AddCurve(TiledDataset &data);
+
+	/// Removes all curves from the list.  Once this returns, the caller may
+	/// destroy the curves' data.
 	void RemoveAllCurves();
 
-	/// Remvoes the specified curve from the list.
+	/// Remvoes the specified curve from the list.  Once this returns, the
+	/// caller may destroy the curve's data.
 	///
 	/// \param index Index of curve to remove.
 	void RemoveCurve(const unsigned int &index);
@@ -205,6 +344,23 @@ public:
 
 	void UpdateDisplay();///< Updates the rendered scene.
 
+	/// Requests an update of the rendered scene in response to user input.
+	/// Unlike UpdateDisplay(), this returns immediately; the scene is
+	/// updated and rendered at most once per display refresh, using the
+	/// state at the time of rendering.  Any number of requests made between
+	/// frames are satisfied by a single frame.
+	///
+	/// \param userInput True if the update is in response to user input
+	///                  (used for measuring input latency).
+	void ScheduleUpdate(const bool& userInput = true);
+
+	/// Gets the input-to-display latency for the most recent frame rendered
+	/// in response to user input.  This is the time from the oldest input
+	/// satisfied by the frame until the frame's buffers were swapped.
+	/// \returns The latency in seconds (zero if no such frame has been
+	///          rendered).
+	double GetInputLatency() const { return mInputLatency; }
+
 	/// Gets the value at which the cursor intersects the x-axis.
 	/// \returns The value at which the cursor intersects the x-axis.
 	double GetLeftCursorValue() const;
@@ -238,6 +394,17 @@ public:
 
 	wxImage GetImage() const override;
 
+	/// Renders the plot offscreen at the specified size (see
+	/// RenderWindow::RenderOffscreen()).  Curves are always rendered at full
+	/// fidelity, using the quality specified for writing images.
+	///
+	/// \param width  Width of the image in pixels.
+	/// \param height Height of the image in pixels.
+	///
+	/// \returns The rendered image (invalid on failure).
+	wxImage RenderOffscreen(const unsigned int& width,
+		const unsigned int& height) override;
+
 	unsigned int GetVertexDimension() const override { return 2; }
 
 	/// Enumeration of available modelview matrices.
@@ -254,6 +421,28 @@ public:
 	/// \param mv Source of matrix to load into the uniform.
 	void LoadModelviewUniform(const Modelview& mv);
 
+	/// Loads the specified matrix into the modelview uniform for the current
+	/// shader, after offsetting it by the specified origin.  This allows
+	/// vertices to be stored relative to an origin near the data, preserving
+	/// precision when converting to single-precision floats.
+	///
+	/// \param mv      Source of matrix to load into the uniform.
+	/// \param xOrigin X-value (in scaled plot units) of the vertex origin.
+	/// \param yOrigin Y-value (in scaled plot units) of the vertex origin.
+	void LoadModelviewUniform(const Modelview& mv, const double& xOrigin,
+		const double& yOrigin);
+
+	/// Gets the specified modelview matrix, after offsetting it by the
+	/// specified origin.
+	///
+	/// \param mv      Source of the matrix.
+	/// \param xOrigin X-value (in scaled plot units) of the vertex origin.
+	/// \param yOrigin Y-value (in scaled plot units) of the vertex origin.
+	///
+	/// \returns The offset modelview matrix.
+	Eigen::Matrix4d GetModelviewMatrix(const Modelview& mv,
+		const double& xOrigin, const double& yOrigin) const;
+
 	/// Sets the valud of the modelview matrix.
 	///
 	/// \param m Value to assign to the modelview matrix.
@@ -329,12 +518,14 @@ public:
 	void DoCopy();///< Pastes clipboard data into plot.
 	void DoPaste();///< Copies plot image to clipboard.
 
-	/// Checks for visibility of the markers for the specified curve.
+	/// Checks for visibility of the markers for the specified curve.  If the
+	/// addition or removal of curves has been queued, waits for the render
+	/// thread so the index refers to the same curve as for the caller.
 	///
 	/// \param i Index of curve of interest.
 	///
 	/// \returns True if curve \p i has visible markers.
-	bool CurveMarkersVisible(const unsigned int& i) const;
+	bool CurveMarkersVisible(const unsigned int& i);
 
 private:
 	static const std::string mDefaultVertexShader;
@@ -344,8 +535,54 @@ private:
 
 	std::unique_ptr<PlotObject> mPlot;
 
+	// The caller's data for each curve, in the order seen by the caller
+	// (changes to the curves may be waiting to be applied to mPlot)
+	struct CurveSource
+	{
+		const Dataset2D* data;
+		TiledDataset* tiled;// nullptr for in-memory curves
+		bool copied;// True if the curve draws a copy of the data
+		std::vector<double>::size_type pointCount;// in the copy
+	};
+
+	std::vector<CurveSource> mCurveSources;
+	unsigned int mQueuedCurveChanges = 0;// Additions and removals
+
 	// Overload of size event
 	void OnSize(wxSizeEvent &event);
+	void UpdateRenderSize() override;
+
+	// Frame scheduling
+	void OnPaint(wxPaintEvent &event);
+	void FrameRendered() override;
+	void OnFrameTimer(wxTimerEvent &event);
+	void UpdatePlot();
+	void ScheduleFrame(const bool& userInput);
+	std::chrono::steady_clock::duration GetFrameInterval() const;
+
+	static const int mDefaultRefreshRate;// [Hz]
+
+	wxTimer mFrameTimer;
+	wxTimer mRefinementTimer;
+	bool mUpdatePending = false;
+	bool mPlotUpdatePending = false;// False when only overlays have changed
+	bool mInputPending = false;
+	std::chrono::steady_clock::time_point mLastFrameTime;
+	std::chrono::steady_clock::time_point mFrameStart;
+	std::chrono::steady_clock::time_point mOldestInputTime;
+	double mInputLatency = 0.0;// [sec]
+
+	// Progressive rendering
+	void BeginInteraction();
+	void EndInteraction();
+	void OnRefinementTimer(wxTimerEvent &event);
+	void AdjustPreviewBudget(const double& frameTime);
+
+	static const unsigned int mMinPreviewPoints;
+	static const unsigned int mMaxPreviewPoints;
+
+	double mPreviewFrameBudget = 1.0 / 30.0;// [sec]
+	double mRefinementDelay = 0.2;// [sec]
 
 	// Overload of interaction events
 	void OnMouseWheelEvent(wxMouseEvent &event);
@@ -362,6 +599,10 @@ private:
 	PlotCursor *mLeftCursor;
 	PlotCursor *mRightCursor;
 	Legend *mLegend;
+	TextRendering *mStatisticsText = nullptr;
+
+	bool mShowStatistics = false;
+	void UpdateStatisticsOverlay();
 
 	bool mDraggingLeftCursor = false;
 	bool mDraggingRightCursor = false;
@@ -384,6 +625,9 @@ private:
 	void PanLeftYAxis(wxMouseEvent &event);
 	void PanRightYAxis(wxMouseEvent &event);
 
+	static void PanLogarithmicRange(double &min, double &max,
+		const double &fraction);
+
 	void ProcessPlotAreaDoubleClick(const unsigned int &x);
 	void ProcessOffPlotDoubleClick(const unsigned int &x,
 		const unsigned int &y);
@@ -471,7 +715,10 @@ private:
 		idPlotContextSetRightRange,
 		idPlotContextSetRightMajorResolution,
 		idPlotContextRightLogarithmic,
-		idPlotContextEditRightLabel
+		idPlotContextEditRightLabel,
+
+		idFrameTimer,
+		idRefinementTimer
 	};
 
 	std::unique_ptr<wxMenu> CreateAxisContextMenu(
@@ -14,6 +14,11 @@
 #ifndef AXIS_H_
 #define AXIS_H_
 
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <unordered_map>
+
 // wxWidgets headers
 #include <wx/wx.h>
 
@@ -56,19 +61,19 @@ public:
 	/// \name Set option methods
 	/// @{
 
-	void SetOrientation(const Orientation &orientation) { mOrientation = orientation; mModified = true; }
-	void SetMinimum(const double &minimum) { mMinimum = minimum; mModified = true; }
-	void SetMaximum(const double &maximum) { mMaximum = maximum; mModified = true; }
-	void SetMajorResolution(const double &majorResolution) { mMajorResolution = majorResolution; mModified = true; }
-	void SetMinorResolution(const double &minorResolution) { mMinorResolution = minorResolution; mModified = true; }
-	void SetMajorGrid(const bool &majorGrid) { mMajorGrid = majorGrid; mModified = true; }
-	void SetMinorGrid(const bool &minorGrid) { mMinorGrid = minorGrid; mModified = true; }
-	void SetLabel(wxString label) { mLabel = label; mModified = true; }
-	void SetGridColor(const Color &gridColor) { mGridColor = gridColor; mModified = true; }
-	void SetTickStyle(const TickStyle &tickStyle) { mTickStyle = tickStyle; mModified = true; }
-	void SetTickSize(const int &tickSize) { mTickSize = tickSize; mModified = true; }
-	void SetOffsetFromWindowEdge(const unsigned int &offset) { mOffsetFromWindowEdge = offset; mModified = true; }
-	void SetLogarithmicScale(const bool &log) { mLogarithmic = log; mModified = true; }
+	void SetOrientation(const Orientation &orientation) { mOrientation = orientation; Invalidate(Change::Transform); }
+	void SetMinimum(const double &minimum) { mMinimum = minimum; Invalidate(Change::Data); }
+	void SetMaximum(const double &maximum) { mMaximum = maximum; Invalidate(Change::Data); }
+	void SetMajorResolution(const double &majorResolution) { mMajorResolution = majorResolution; Invalidate(Change::Data); }
+	void SetMinorResolution(const double &minorResolution) { mMinorResolution = minorResolution; Invalidate(Change::Data); }
+	void SetMajorGrid(const bool &majorGrid) { mMajorGrid = majorGrid; Invalidate(Change::Data); }
+	void SetMinorGrid(const bool &minorGrid) { mMinorGrid = minorGrid; Invalidate(Change::Data); }
+	void SetLabel(wxString label) { mLabel = label; Invalidate(Change::Data); }
+	void SetGridColor(const Color &gridColor) { mGridColor = gridColor; Invalidate(Change::Style); }
+	void SetTickStyle(const TickStyle &tickStyle) { mTickStyle = tickStyle; Invalidate(Change::Style); }
+	void SetTickSize(const int &tickSize) { mTickSize = tickSize; Invalidate(Change::Style); }
+	void SetOffsetFromWindowEdge(const unsigned int &offset) { mOffsetFromWindowEdge = offset; Invalidate(Change::Transform); }
+	void SetLogarithmicScale(const bool &log) { mLogarithmic = log; Invalidate(Change::Data); }
 
 	/// @}
 
@@ -80,21 +85,21 @@ public:
 	/// intersections this one at this axis' minimum value.
 	///
 	/// \param min Adjacent axis at the minimum end of this.
-	void SetAxisAtMinEnd(const Axis *min) { assert(!mMinAxis); mMinAxis = min; mModified = true; }
+	void SetAxisAtMinEnd(const Axis *min) { assert(!mMinAxis); mMinAxis = min; Invalidate(Change::Transform); }
 
 	/// Must be called exactly once immediately following axis creation.  Sets
 	/// the relationship between this axis and the adjacent axis that
 	/// intersections this one at this axis' maximum value.
 	///
 	/// \param max Adjacent axis at the minimum end of this.
-	void SetAxisAtMaxEnd(const Axis *max) { assert(!mMaxAxis); mMaxAxis = max; mModified = true; }
+	void SetAxisAtMaxEnd(const Axis *max) { assert(!mMaxAxis); mMaxAxis = max; Invalidate(Change::Transform); }
 
 	/// Must be called exactly once immediately following axis creation.  Sets
 	/// the relationship between this axis and the parallel axis on the
 	/// opposite side of the plot area.
 	///
 	/// \param opposite Axis at the opposite side of the plot area.
-	void SetOppositeAxis(const Axis *opposite) { assert(!mOppositeAxis); mOppositeAxis = opposite; mModified = true; }
+	void SetOppositeAxis(const Axis *opposite) { assert(!mOppositeAxis); mOppositeAxis = opposite; Invalidate(Change::Transform); }
 
 	/// Initializes the font objects used to render axis value and label text.
 	///
@@ -165,7 +170,7 @@ protected:
 	// Mandatory overloads from Primitive - for creating geometry and testing the
 	// validity of this object's parameters
 	bool HasValidParameters() override;
-	void Update(const unsigned int& i) override;
+	bool Update(const unsigned int& i) override;
 	void GenerateGeometry() override;
 
 private:
@@ -221,8 +226,63 @@ private:
 	double GetNextTickValue(const bool &first, const bool &last, const unsigned int &tick) const;
 	double GetNextGridValue(const unsigned int &tick) const;
 
-	void DrawAxisLabel();
-	void DrawTickLabels();
+	// Inputs which determine the placement of the value and axis label text.
+	// Text geometry is rebuilt only when these (or the inputs specific to
+	// each type of text) change.
+	struct TextLayout
+	{
+		int windowWidth = 0;
+		int windowHeight = 0;
+		Orientation orientation = Orientation::Bottom;
+		unsigned int offset = 0;
+		unsigned int minAxisOffset = 0;
+		unsigned int maxAxisOffset = 0;
+
+		bool operator==(const TextLayout& l) const;
+	};
+
+	struct TickRange
+	{
+		double minimum = 0.0;
+		double maximum = 0.0;
+		double majorResolution = 0.0;
+		bool logarithmic = false;
+		unsigned int fontRevision = 0;
+
+		bool operator==(const TickRange& r) const;
+	};
+
+	struct TickLabel
+	{
+		double value;
+		std::string text;
+		Text::BoundingBox boundingBox;
+	};
+
+	// Incremented each time the fonts change; zero is never used so that
+	// default-constructed cache keys never match
+	unsigned int mFontRevision = 1;
+
+	TickRange mTickRange;
+	TextLayout mTickLayout;
+	std::vector<TickLabel> mTickLabels;
+	double mTickLabelMinimum = 0.0;
+	double mTickLabelMaximum = 1.0;
+
+	// Extents of previously rendered value strings (valid for current fonts)
+	std::unordered_map<std::string, Text::BoundingBox> mTickLabelExtents;
+	static const unsigned int mMaxTickLabelExtents;
+
+	TextLayout mLabelLayout;
+	wxString mLayoutLabel;
+	unsigned int mLabelFontRevision = 0;
+
+	TextLayout GetTextLayout() const;
+	void ComputeTickLabels();
+	const Text::BoundingBox& GetTickLabelExtents(const std::string& text);
+
+	bool DrawAxisLabel();
+	bool DrawTickLabels();
 
 	double GetAxisLabelTranslation(const double &offset, const double &fontHeight) const;
 	unsigned int GetPrecision() const;
@@ -0,0 +1,135 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  curveBatch.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Derived from Primitive for drawing the lines of many plot curves
+//        with a single set of draw calls.
+
+#ifndef CURVE_BATCH_H_
+#define CURVE_BATCH_H_
+
+// Local headers
+#include "lp2d/renderer/primitives/primitive.h"
+#include "lp2d/renderer/line.h"
+
+// Standard C++ headers
+#include <vector>
+#include <map>
+#include <string>
+
+namespace LibPlot2D
+{
+
+// Local forward declarations
+class PlotCurve;
+
+/// Object for drawing the lines of a group of plot curves which share a
+/// y-axis.  The line geometry built by each curve is packed into a single
+/// vertex buffer, and the color and vertex origin of each curve are stored in
+/// a table which is read by the shader, so all of the pretty lines are drawn
+/// with one call (and the ugly lines with one call per line width),
+/// regardless of the number of curves.  Curves with lines that cannot be
+/// combined (i.e. lines expanded on the GPU) continue to draw themselves, as
+/// do all of the markers.  This must be drawn after the member curves, since
+/// the curves build the geometry.
+class CurveBatch : public Primitive
+{
+public:
+	/// Constructor.
+	///
+	/// \param renderWindow The window that owns this primitive.
+	explicit CurveBatch(RenderWindow &renderWindow);
+	~CurveBatch();
+
+	CurveBatch(const CurveBatch&) = delete;
+	CurveBatch& operator=(const CurveBatch&) = delete;
+
+	/// Sets the curves whose lines are drawn by this object.  Curves which
+	/// were previously members but are not included in \p curves go back to
+	/// drawing their own lines.  The order of the curves determines the
+	/// order in which they are drawn.
+	///
+	/// \param curves Curves to draw.
+	void SetCurves(const std::vector<PlotCurve*>& curves);
+
+	/// Removes the specified curve from this object (i.e. prior to deleting
+	/// the curve).
+	///
+	/// \param curve Curve to remove.
+	void RemoveCurve(PlotCurve* curve);
+
+protected:
+	// Mandatory overloads from Primitive - for creating geometry and testing the
+	// validity of this object's parameters
+	bool HasValidParameters() override;
+	bool Update(const unsigned int& i) override;
+	void GenerateGeometry() override;
+
+	// Colors, line sizes and visibility are read from the curves when drawing
+	Change GetRebuildChanges() const override { return Change::Data; }
+
+private:
+	std::vector<PlotCurve*> mCurves;
+
+	// Used only to send the packed vertices and to bind the shared indices
+	Line mLine;
+
+	// Location of each curve's geometry within the packed vertex buffer
+	struct Slot
+	{
+		GLint firstVertex = 0;
+		GLsizei vertexCount = 0;
+		GLsizei indexCount = 0;
+		double xOrigin = 0.0;
+		double yOrigin = 0.0;
+	};
+
+	std::vector<Slot> mSlots;
+
+	// Packed vertices are stored relative to this point [scaled plot units]
+	double mXOrigin = 0.0;
+	double mYOrigin = 0.0;
+
+	// Index of the owning curve for each packed vertex
+	std::vector<GLuint> mCurveIndices;
+	GLuint mCurveIndexBuffer = 0;
+
+	// Two texels per curve:  line color, then (x-offset, y-offset, edge
+	// alpha scale, unused)
+	std::vector<GLfloat> mCurveTable;
+	GLuint mCurveTableBuffer = 0;
+	GLuint mCurveTableTexture = 0;
+
+	struct DrawList
+	{
+		std::vector<GLint> first;
+		std::vector<GLsizei> count;
+		std::vector<GLvoid*> indices;
+	};
+
+	DrawList mPrettyDraws;
+	std::map<GLfloat, DrawList> mUglyDraws;// Keyed by line width
+
+	void BuildDrawLists();
+	void SendCurveTable(const std::vector<GLfloat>& table);
+
+	static const GLuint mCurveIndexLocation;
+
+	static const std::string mVertexShader;
+	static const std::string mFragmentShader;
+	static const std::string mCurveTableName;
+
+	GLuint DoGLInitialization();
+	friend RenderWindow;
+};
+
+}// namespace LibPlot2D
+
+#endif// CURVE_BATCH_H_
@@ -79,9 +79,9 @@ public:
 	{ mSampleLength = size; RequiresRedraw(); }
 
 	void SetWindowReference(const PositionReference &windowRef)
-	{ mWindowRef = windowRef; mModified = true; }
+	{ mWindowRef = windowRef; Invalidate(Change::Transform); }
 	void SetLegendReference(const PositionReference &legendRef)
-	{ mLegendRef = legendRef; mModified = true; }
+	{ mLegendRef = legendRef; Invalidate(Change::Transform); }
 
 	/// Specifies bottom left corner of legend.
 	///
@@ -151,7 +151,7 @@ protected:
 	// Mandatory overloads from Primitive - for creating geometry and testing the
 	// validity of this object's parameters
 	bool HasValidParameters() override;
-	void Update(const unsigned int& i) override;
+	bool Update(const unsigned int& i) override;
 	void GenerateGeometry() override;
 
 private:
@@ -64,7 +64,7 @@ protected:
 	// Mandatory overloads from Primitive - for creating geometry and testing the
 	// validity of this object's parameters
 	bool HasValidParameters() override;
-	void Update(const unsigned int& i) override;
+	bool Update(const unsigned int& i) override;
 	void GenerateGeometry() override;
 
 private:
@@ -18,6 +18,13 @@
 #include "lp2d/renderer/primitives/primitive.h"
 #include "lp2d/utilities/managedList.h"
 #include "lp2d/renderer/line.h"
+#include "lp2d/renderer/shaderLine.h"
+#include "lp2d/renderer/marker.h"
+#include "lp2d/renderer/densityMap.h"
+
+// Standard C++ headers
+#include <future>
+#include <memory>
 
 namespace LibPlot2D
 {
@@ -25,6 +32,7 @@ namespace LibPlot2D
 // Local forward declarations
 class Axis;
 class Dataset2D;
+class CurveBatch;
 
 /// Object for rendering a Dataset2D.
 class PlotCurve : public Primitive
@@ -41,34 +49,103 @@ public:
 	/// \param plotCurve Curve to copy into this.
 	explicit PlotCurve(const PlotCurve &plotCurve);
 
-	~PlotCurve() = default;
+	~PlotCurve();
 
 	/// Sets the width of the curve.
 	///
 	/// \param size Width of the curve in pixels.
-	inline void SetLineSize(const double &size) { mLineSize = size; mModified = true; }
+	inline void SetLineSize(const double &size) { mLineSize = size; Invalidate(Change::Style); }
 
 	/// Sets the size of the data marker.
 	///
 	/// \param size Size of the data marker.
-	inline void SetMarkerSize(const double &size) { mMarkerSize = size; mModified = true; }
+	inline void SetMarkerSize(const double &size) { mMarkerSize = size; Invalidate(Change::Style); }
+
+	/// Sets the shape of the data marker.
+	///
+	/// \param shape Shape of the data marker.
+	inline void SetMarkerShape(const Marker::Shape &shape) { mMarker.SetShape(shape); Invalidate(Change::Style); }
 
 	/// Sets a flag indicating whether or not to use the higher-quality (but
 	/// slower) rendering algorithm.
 	///
 	/// \param pretty Set to true to use the rendering algorithm with better
 	///               anti-aliasing.
-	inline void SetPretty(const bool &pretty) { mPretty = pretty; mLine.SetPretty(pretty); mModified = true; }
+	inline void SetPretty(const bool &pretty) { mPretty = pretty; mLine.SetPretty(pretty); Invalidate(Change::Style); }
+
+	/// Sets a flag indicating whether or not the geometry for this curve
+	/// should be kept resident on the GPU.  Resident geometry is built for the
+	/// entire data set and is only rebuilt when the data, the curve properties
+	/// or (for geometry which depends on it) the plot scale changes.
+	///
+	/// \param resident Set to true to keep the geometry resident.
+	inline void SetResident(const bool &resident) { mResident = resident; }
+
+	/// Sets a flag indicating whether or not pretty lines should be expanded
+	/// into triangles on the GPU.  Only the data points are sent to OpenGL,
+	/// and the geometry does not need to be rebuilt when the scale changes.
+	///
+	/// \param shaderLines Set to true to expand pretty lines on the GPU.
+	inline void SetShaderLines(const bool &shaderLines) { mShaderLines = shaderLines; }
+
+	/// Sets a flag indicating whether or not a quickly-built preview of the
+	/// curve should be drawn (i.e. during user interaction).  Preview
+	/// geometry is decimated so that it contains no more than approximately
+	/// the number of points specified with SetPreviewPointBudget().
+	///
+	/// \param preview Set to true to draw the preview geometry.
+	inline void SetPreview(const bool &preview) { mPreview = preview; }
+
+	/// Sets the maximum number of points to use for preview geometry.  When
+	/// background refinement is enabled, curves with more points than this
+	/// are refined in the background.
+	///
+	/// \param points Maximum number of points in the preview geometry.
+	inline void SetPreviewPointBudget(const unsigned int &points) { mPreviewPointBudget = points; }
+
+	/// Sets a flag indicating whether or not full-fidelity geometry for large
+	/// curves should be built on a worker thread.  The existing geometry
+	/// (typically the preview) continues to be drawn until the new geometry
+	/// is ready, at which point an update is scheduled with the
+	/// PlotRenderer.  If the existing geometry is not valid for the current
+	/// data and view, a preview is built immediately instead.  The visible
+	/// data is copied before the refinement starts, so the worker thread
+	/// never reads the Dataset2D.
+	///
+	/// \param background Set to true to refine large curves in the
+	///                   background.
+	inline void SetBackgroundRefinement(const bool &background) { mBackgroundRefinement = background; }
+
+	/// Sets a flag indicating whether or not the curve should be drawn as a
+	/// density map.  When set, the points are counted in a histogram with
+	/// one bin per pixel, which is drawn with colors indicating the number
+	/// of points in each bin (instead of drawing lines and markers).  When
+	/// previewing, only a subset of the points (limited by the preview point
+	/// budget) is counted.
+	///
+	/// \param density Set to true to draw the density of the points.
+	void SetDensity(const bool &density);
+
+	/// Indicates that points have been added to the end of the data, and
+	/// that the existing points are unchanged.  Where possible (for resident
+	/// lines expanded on the GPU), only the new points are processed and sent
+	/// to OpenGL, into storage which grows geometrically; otherwise, this is
+	/// equivalent to Invalidate(Change::Data).
+	inline void SetDataAppended() { mDataAppended = true; Invalidate(Change::Data); }
+
+	/// Indicates that the data has been modified in place, so the geometry
+	/// must be rebuilt.
+	inline void SetDataModified() { mDataAppended = false; Invalidate(Change::Data); }
 
 	/// Binds the curve to the specified x-axis.
 	///
 	/// \param xAxis Axis to which this curve should be bound.
-	inline void BindToXAxis(Axis* xAxis) { mXAxis = xAxis; mModified = true; }
+	inline void BindToXAxis(Axis* xAxis) { mXAxis = xAxis; Invalidate(Change::Transform); }
 
 	/// Binds the curve to the specified y-axis.
 	///
 	/// \param yAxis Axis to which this curve should be bound.
-	inline void BindToYAxis(Axis* yAxis) { mYAxis = yAxis; mModified = true; }
+	inline void BindToYAxis(Axis* yAxis) { mYAxis = yAxis; Invalidate(Change::Transform); }
 
 	/// Gets the associated y-axis.
 	/// \returns The associated y-axis.
@@ -89,9 +166,18 @@ protected:
 	// Mandatory overloads from Primitive - for creating geometry and testing the
 	// validity of this object's parameters
 	bool HasValidParameters() override;
-	void Update(const unsigned int& i) override;
+	bool Update(const unsigned int& i) override;
 	void GenerateGeometry() override;
 
+	bool HasPreparationStage() const override { return true; }
+	void PrepareUpdate(const unsigned int& i) override;
+
+	// Visibility changes never require new geometry, and color is applied
+	// with uniforms; other style changes are checked against the previous
+	// build in PrepareUpdate()
+	Change GetRebuildChanges() const override
+	{ return Change::Data | Change::Transform | Change::Style; }
+
 private:
 	// The axes with which this object is associated
 	Axis *mXAxis = nullptr;
@@ -100,15 +186,40 @@ private:
 	const Dataset2D& mData;
 
 	Line mLine;
+	ShaderLine mShaderLine;
+	Marker mMarker;
+	DensityMap mDensityMap;
+
+	// Tracks which kind of line was most recently built, and which kind
+	// currently owns the line buffer's vertex array (the vertex attribute
+	// layouts are not compatible)
+	bool mLineBuiltWithShaderLine = false;
+	bool mLineBufferHasShaderLine = false;
+
+	// Set when geometry has been prepared but not yet sent to OpenGL
+	bool mLineUploadRequired = false;
+	bool mMarkerUploadRequired = false;
+	bool mDensityUploadRequired = false;
+
+	// When geometry has been appended, only the vertex buffer elements from
+	// these are sent to OpenGL
+	std::vector<float>::size_type mLineUploadStart = 0;
+	std::vector<float>::size_type mMarkerUploadStart = 0;
+
+	static const double mLineSizeScale;
 
 	bool mPretty = true;
+	bool mResident = false;
+	bool mShaderLines = false;
+	bool mPreview = false;
+	bool mBackgroundRefinement = false;
+	bool mDensity = false;
+	unsigned int mPreviewPointBudget = 200000;
 	double mLineSize = 1.0;
 	double mMarkerSize = -1.0;
 
 	bool PointIsValid(const unsigned int &i) const;
 
-	void BuildMarkers();
-
 	enum class RangeSize
 	{
 		Small,
@@ -123,9 +234,139 @@ private:
 	double mXScale;
 	double mYScale;
 
-	void InitializeMarkerVertexBuffer();
-	static std::vector<double> DoLogarithmicScale(
-		const std::vector<double>& values);
+	// Vertices are stored relative to this point [scaled plot units]
+	double mXOrigin = 0.0;
+	double mYOrigin = 0.0;
+
+	// Description of the inputs used for the most recent geometry build, so we
+	// can tell when resident geometry needs to be rebuilt
+	struct BuildState
+	{
+		const double* xData = nullptr;
+		const double* yData = nullptr;
+		std::vector<double>::size_type pointCount = 0;
+		double lineSize = 0.0;
+		bool pretty = false;
+		bool resident = false;
+		bool shaderLines = false;
+		bool xLogarithmic = false;
+		bool yLogarithmic = false;
+		bool decimated = false;
+		bool preview = false;
+		bool xSorted = false;
+		double xScale = 0.0;
+		double yScale = 0.0;
+		int plotWidth = 0;// [pixels]
+
+		// Limits which determine the visible data and the vertex origin
+		double xMinimum = 0.0;
+		double xMaximum = 0.0;
+		double yMinimum = 0.0;
+	};
+
+	static const double mScaleTolerance;
+	BuildState mLastBuild;
+	bool mRebuildRequired = true;
+
+	BuildState GetBuildState(const int& plotWidth) const;
+	bool GeometryIsCurrent(const BuildState& state) const;
+	static bool BuildStatesMatch(const BuildState& a, const BuildState& b);
+	static bool LineSizesMatch(const BuildState& a, const BuildState& b);
+
+	void ComputeOrigin(const BuildState& state, double& xOrigin,
+		double& yOrigin) const;
+	bool BuildDensity(const BuildState& state, const int& plotHeight,
+		const bool& dataChanged);
+	void ConfigureLines();
+	static bool BuildLineGeometry(const BuildState& state,
+		const std::vector<double>& x, const std::vector<double>& y,
+		const unsigned int& pointLimit, Line& line, ShaderLine& shaderLine,
+		Primitive::BufferInfo& bufferInfo);
+
+	// Line geometry built on a worker thread
+	struct Refinement
+	{
+		BuildState state;
+		double xOrigin;
+		double yOrigin;
+		bool shaderLine;
+		Primitive::BufferInfo bufferInfo;
+	};
+
+	std::future<std::unique_ptr<Refinement>> mRefinement;
+	bool mRefinementDisplayed = false;
+
+	void UpdateRefinement(const BuildState& state);
+	void StartRefinement(const BuildState& state);
+	void AdoptRefinement(Refinement& refinement);
+
+	// Cached result of checking the x-data for monotonicity, along with the
+	// information required to tell when the check needs to be repeated
+	mutable bool mXIsSorted = false;
+	mutable const double* mSortCheckData = nullptr;
+	mutable std::vector<double>::size_type mSortCheckSize = 0;
+
+	bool XDataIsSorted() const;
+	void GetVisibleRange(const BuildState& state,
+		std::vector<double>::size_type& startIndex,
+		std::vector<double>::size_type& endIndex) const;
+	void GetVisibleData(const BuildState& state, const double& xOrigin,
+		const double& yOrigin, std::vector<double>& x,
+		std::vector<double>& y) const;
+
+	// Curves with more than this many points per pixel column are decimated
+	// prior to building the line geometry
+	static const unsigned int mDecimationFactor;
+	static void DecimateForPixelColumns(const std::vector<double>& x,
+		const std::vector<double>& y, const double& xOrigin,
+		const double& columnWidth, std::vector<double>& xOut,
+		std::vector<double>& yOut);
+	static double GetPreviewColumnWidth(const std::vector<double>& x,
+		const unsigned int& pointLimit);
+
+	void BuildMarkers(const BuildState& state);
+
+	// Set when the only change to the data is the addition of points
+	bool mDataAppended = false;
+
+	// Number of points in the data before the most recent append (zero if
+	// the geometry was not appended)
+	std::vector<double>::size_type mAppendedFrom = 0;
+
+	bool AppendLineGeometry(const BuildState& state);
+	void AppendMarkers(const std::vector<double>::size_type& previousCount);
+	void CheckAppendedXData() const;
+
+	// Logarithms of the data plotted against logarithmic axes.  These are
+	// only recomputed when the data changes or an axis is made logarithmic,
+	// so rebuilding the geometry for log axes costs no more than for linear
+	// axes.
+	struct ScaledColumn
+	{
+		const double* source = nullptr;
+		std::vector<double>::size_type size = 0;
+		std::vector<double> values;
+	};
+
+	ScaledColumn mLogX;
+	ScaledColumn mLogY;
+
+	void UpdateScaledData(const BuildState& state, const bool& dataChanged,
+		const bool& dataAppended);
+	void UpdateScaledColumn(const std::vector<double>& data,
+		const bool& logarithmic, const bool& dataChanged,
+		const bool& dataAppended, ScaledColumn& column);
+	const std::vector<double>& GetScaledX(const bool& logarithmic) const;
+	const std::vector<double>& GetScaledY(const bool& logarithmic) const;
+
+	// When set, compact lines are sent to OpenGL and drawn by the batch
+	// (along with the other curves on the same axis) instead of by this
+	CurveBatch* mBatch = nullptr;
+
+	void SetBatch(CurveBatch* batch);
+	bool LineIsBatched() const;
+
+	friend CurveBatch;
 };
 
 }// namespace LibPlot2D
@@ -18,9 +18,11 @@
 #include <vector>
 #include <memory>
 #include <limits>
+#include <cstddef>
 
 // Local headers
 #include "lp2d/renderer/color.h"
+#include "lp2d/utilities/flagEnum.h"
 
 namespace LibPlot2D
 {
@@ -49,9 +51,31 @@ public:
 
 	virtual ~Primitive();
 
+	/// Flags identifying the aspects of an object which have changed since
+	/// it was last drawn.
+	enum class Change : unsigned int
+	{
+		None = 0,
+		Data = 1 << 0,///< Data from which the geometry is built.
+		Transform = 1 << 1,///< Scale, position or size of the geometry.
+		Style = 1 << 2,///< Appearance (color, line width, etc.).
+		Visibility = 1 << 3,///< Whether or not the object is drawn.
+		All = Data | Transform | Style | Visibility
+	};
+
 	/// Performs the drawing operations.
 	void Draw();
 
+	/// Performs the CPU-only portion of the buffer updates required prior to
+	/// the next call to Draw().  Makes no OpenGL calls, so it may be called
+	/// from any thread, provided no other methods of this object are called
+	/// concurrently.  If this is not called, Draw() will do it.
+	void Prepare();
+
+	/// Checks to see if a call to Prepare() would do any work.
+	/// \returns True if this object has buffers which need to be prepared.
+	bool NeedsPreparation();
+
 	/// \name Private data accessors.
 	/// @{
 
@@ -73,11 +97,27 @@ public:
 	///
 	/// \param drawOrder Value to assign to this object's drawing priority.
 	void SetDrawOrder(const unsigned int &drawOrder);
-	inline void SetModified() { mModified = true; }///< Forces a full re-draw.
+
+	/// Sets a flag indicating whether this object is part of the overlay
+	/// layer.  Overlays (cursors, selection boxes, etc.) are drawn on top of
+	/// an image of the remaining objects which is cached by the render
+	/// window, so changes to overlays don't require the rest of the scene to
+	/// be drawn again.
+	///
+	/// \param overlay True if this object should be drawn as an overlay.
+	void SetOverlay(const bool &overlay);
+	inline void SetModified() { Invalidate(Change::All); }///< Forces a full re-draw.
+
+	/// Marks the specified aspects of this object as changed.  Buffers are
+	/// only rebuilt for changes included in GetRebuildChanges().
+	///
+	/// \param change Aspects which have changed.
+	void Invalidate(const Change& change);
 
 	inline Color GetColor() const { return mColor; }
 	inline bool GetIsVisible() const { return mIsVisible; }
 	inline unsigned int GetDrawOrder() const { return mDrawOrder; }
+	inline bool GetIsOverlay() const { return mIsOverlay; }
 
 	/// @}
 
@@ -118,6 +158,19 @@ public:
 		/// Flag indicating whether or not a full update is required.
 		bool vertexCountModified = true;
 
+		/// Number of indices to render from a shared index buffer (see
+		/// RenderWindow::GetSharedIndexBuffer()).  Only used when indexBuffer
+		/// is empty.
+		unsigned int sharedIndexCount = 0;
+
+		/// Gets the number of indices to render.
+		/// \returns The number of indices to render.
+		unsigned int GetIndexCount() const
+		{
+			return indexBuffer.empty() ? sharedIndexCount
+				: static_cast<unsigned int>(indexBuffer.size());
+		}
+
 		/// Obtains new OpenGL index values.  Always obtains vertex and array
 		/// buffer indices, but index buffers are optional.
 		///
@@ -128,6 +181,48 @@ public:
 		/// Releases all associated OpenGL objects.
 		void FreeOpenGLObjects();
 
+		/// Sends the vertex buffer to OpenGL.  If the existing storage is
+		/// large enough, it is updated in place; otherwise it is reallocated.
+		/// Requires prior call to GetOpenGLIndices().
+		///
+		/// \param hint  Usage hint (e.g. GL_STATIC_DRAW) for new storage.
+		/// \param first Index of the first element of the vertex buffer which
+		///              has changed since the last call.  Elements prior to
+		///              this are not sent unless the storage is reallocated.
+		void BufferVertexData(const unsigned int& hint,
+			const std::vector<float>::size_type& first = 0);
+
+		/// Sends the index buffer to OpenGL.  If the existing storage is large
+		/// enough, it is updated in place; otherwise it is reallocated.  The
+		/// associated vertex array must be bound prior to calling.
+		///
+		/// \param hint Usage hint (e.g. GL_STATIC_DRAW) for new storage.
+		void BufferIndexData(const unsigned int& hint);
+
+		/// Sets a flag indicating whether or not this buffer is expected to
+		/// grow from one update to the next (i.e. for streaming data).  When
+		/// set, reallocations reserve extra storage so that subsequent growth
+		/// can be handled without reallocating.
+		///
+		/// \param streaming True if the buffer is expected to grow.
+		void SetStreaming(const bool& streaming) { isStreaming = streaming; }
+
+		/// Records data sent to OpenGL without using BufferVertexData() or
+		/// BufferIndexData(), for inclusion in the rendering statistics.
+		///
+		/// \param bytes Amount of data sent.
+		void AddBytesUploaded(const std::size_t& bytes) { bytesUploaded += bytes; }
+
+		/// Gets the amount of data sent to OpenGL since the last call, and
+		/// resets the count.
+		/// \returns The amount of data sent [bytes].
+		std::size_t TakeBytesUploaded()
+		{
+			const std::size_t bytes(bytesUploaded);
+			bytesUploaded = 0;
+			return bytes;
+		}
+
 		/// \name Index getters.
 		/// @{
 
@@ -140,6 +235,18 @@ public:
 	private:
 		bool glVertexBufferExists = false;
 		bool glIndexBufferExists = false;
+		bool isStreaming = false;
+
+		// Sizes of the storage allocated for the OpenGL buffers [bytes]
+		std::size_t vertexBufferCapacity = 0;
+		std::size_t indexBufferCapacity = 0;
+
+		// Data sent since the last call to TakeBytesUploaded() [bytes]
+		std::size_t bytesUploaded = 0;
+
+		void SendData(const unsigned int& target, const unsigned int& hint,
+			const std::size_t& size, const std::size_t& offset,
+			const void* data, std::size_t& capacity);
 
 		unsigned int vertexBufferIndex = std::numeric_limits<unsigned int>::max();
 		unsigned int vertexArrayIndex = std::numeric_limits<unsigned int>::max();
@@ -151,7 +258,20 @@ protected:
 
 	Color mColor = Color::ColorBlack;///< Color of this object.
 
-	bool mModified = true;///< Indicates whether or not this is up-to-date.
+	/// Checks to see if any of the specified aspects of this object have
+	/// changed since it was last drawn.
+	///
+	/// \param change Aspects to check.
+	///
+	/// \returns True if any of the specified aspects have changed.
+	bool HasChanged(const Change& change) const;
+
+	/// Gets the changes which require the buffers to be updated (i.e. for
+	/// which Update() is called).  Changes not included here must be applied
+	/// in GenerateGeometry() (typically by setting uniforms).  By default,
+	/// any change causes all buffers to be updated.
+	/// \returns The changes which require buffer updates.
+	virtual Change GetRebuildChanges() const { return Change::All; }
 
 	RenderWindow &mRenderWindow;///< The window that owns this object.
 
@@ -164,11 +284,28 @@ protected:
 	/// Updates the specified internal buffer required to render this object.
 	///
 	/// \param i Index of the buffer to update.
-	virtual void Update(const unsigned int& i) = 0;
+	///
+	/// \returns True if the buffer was rebuilt or new data was sent to
+	///          OpenGL; false if there was nothing to do.
+	virtual bool Update(const unsigned int& i) = 0;
 
 	/// Performs the actions necessary to render this object.
 	virtual void GenerateGeometry() = 0;
 
+	/// Checks to see if this type implements PrepareUpdate().  Types which
+	/// do are expected to do their CPU-intensive work there, leaving only the
+	/// OpenGL calls for Update().
+	/// \returns True if PrepareUpdate() is implemented.
+	virtual bool HasPreparationStage() const { return false; }
+
+	/// Performs the CPU-only portion of updating the specified buffer.  This
+	/// may be called from a worker thread, so implementations must not make
+	/// any OpenGL calls.  When implemented, Update() is called for every
+	/// buffer after the preparation.
+	///
+	/// \param i Index of the buffer to prepare.
+	virtual void PrepareUpdate(const unsigned int& /*i*/) {}
+
 	/// Enables alpha blending.
 	void EnableAlphaBlending();
 
@@ -180,6 +317,21 @@ protected:
 
 private:
 	unsigned int mDrawOrder = 1000;
+	bool mIsOverlay = false;
+	bool mPrepared = false;
+
+	Change mChanges = Change::All;// Since the last call to Draw()
+
+	bool BufferNeedsUpdate(const unsigned int& i) const;
+};
+
+/// Template specialization to enable bitwise operators for Primitive::Change
+/// enumeration.
+template<>
+struct EnableBitwiseOperators<Primitive::Change>
+{
+	/// Flag that indicates that bitwise operators should be enabled.
+	static constexpr bool mEnable = true;
 };
 
 }// namespace LibPlot2D
@@ -47,23 +47,23 @@ public:
 	/// the text counter-clockwise.
 	///
 	/// \param angle Angle at which to draw the text (in radians).
-	void SetAngle(const double& angle) { mAngle = angle; mModified = true; }
+	void SetAngle(const double& angle) { mAngle = angle; Invalidate(Change::Transform); }
 
 	/// Sets the value of the string to render.
 	///
 	/// \param text Value of the string.
-	void SetText(const wxString& text) { mText = text; mModified = true; }
+	void SetText(const wxString& text) { mText = text; Invalidate(Change::Data); }
 
 	/// Sets the position of the text.
 	///
 	/// \param x X-position.
 	/// \param y Y-position.
-	void SetPosition(const double& x, const double& y) { mX = x; mY = y; mModified = true; }
+	void SetPosition(const double& x, const double& y) { mX = x; mY = y; Invalidate(Change::Transform); }
 
 	/// Sets a flag indicating whether or not the text should be centered at
 	/// the specified location.  If false (default), text is positioned with
 	/// respect to the lower left-hand corner of the bounding box.
-	void SetCentered(const bool& centered) { mCentered = centered; mModified = true; }
+	void SetCentered(const bool& centered) { mCentered = centered; Invalidate(Change::Transform); }
 
 	/// @}
 
@@ -82,7 +82,7 @@ protected:
 	// Mandatory overloads from Primitive - for creating geometry and testing the
 	// validity of this object's parameters
 	bool HasValidParameters() override;
-	void Update(const unsigned int& i) override;
+	bool Update(const unsigned int& i) override;
 	void GenerateGeometry() override;
 
 private:
@@ -0,0 +1,119 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  readbackQueue.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Queue of requests for images of a rendered scene, with pixels read
+//        back asynchronously through pixel buffer objects.
+
+#ifndef READBACK_QUEUE_H_
+#define READBACK_QUEUE_H_
+
+// Local headers
+#include "lp2d/renderer/renderWindow.h"
+
+// Standard C++ headers
+#include <array>
+#include <vector>
+#include <utility>
+
+namespace LibPlot2D
+{
+
+/// Class for reading images back from OpenGL without stalling the renderer.
+/// Pixels are copied into one of two pixel buffer objects (so a second frame
+/// may be read while the first transfer is still in progress) and a fence is
+/// placed after the copy; once the fence has been signaled, the pixels are
+/// copied out of the buffer (flipping them vertically) and the image is
+/// handed to the callbacks.  Since this class uses OpenGL types which are
+/// only available through GLEW, it must only be included after GL/glew.h.
+/// All methods (except for Request() and HasRequests()) must be called with
+/// the owning context current.
+class ReadbackQueue
+{
+public:
+	ReadbackQueue() = default;
+
+	ReadbackQueue(const ReadbackQueue&) = delete;
+	ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+	/// Adds a request for an image of the next rendered frame.
+	///
+	/// \param callback Function to receive the image.
+	void Request(const RenderWindow::ImageCallback& callback);
+
+	/// Checks to see if any requests are waiting for a frame to be rendered.
+	/// \returns True if Begin() needs to be called for the next frame.
+	bool HasRequests() const { return !mRequests.empty(); }
+
+	/// Checks to see if any transfers are in progress.
+	/// \returns True if Complete() needs to be called again.
+	bool IsBusy() const;
+
+	/// Completed image, along with the functions which requested it.
+	typedef std::pair<wxImage, std::vector<RenderWindow::ImageCallback>>
+		CompletedImage;
+
+	/// Starts copying the pixels of the current read framebuffer into a
+	/// pixel buffer object.  Returns without waiting for the copy to
+	/// complete, unless both buffers are already in use (in which case this
+	/// blocks until the older transfer is complete).  All pending requests
+	/// are satisfied by this frame.
+	///
+	/// \param width           Width of the frame in pixels.
+	/// \param height          Height of the frame in pixels.
+	/// \param completed [out] Images from transfers which had to be completed
+	///                        are appended to this list.
+	void Begin(const int& width, const int& height,
+		std::vector<CompletedImage>& completed);
+
+	/// Retrieves the images from any transfers which have completed.  The
+	/// callbacks are not called, so the caller may do so after releasing
+	/// any locks.
+	///
+	/// \param completed [out] Completed images are appended to this list.
+	/// \param wait            True to block until all transfers are
+	///                        complete.
+	void Complete(std::vector<CompletedImage>& completed,
+		const bool& wait = false);
+
+	/// Deletes the pixel buffer objects.  Transfers which are in progress
+	/// are abandoned (along with their callbacks).
+	void FreeOpenGLObjects();
+
+	/// Passes completed images to the functions which requested them.  Need
+	/// not be called with the context current.
+	///
+	/// \param completed Images returned by Begin() or Complete().
+	static void Deliver(const std::vector<CompletedImage>& completed);
+
+private:
+	static const GLuint64 mWaitTimeout;// [nsec]
+
+	struct Transfer
+	{
+		GLuint buffer = 0;
+		GLsync fence = nullptr;
+		unsigned int capacity = 0;// [bytes]
+		int width = 0;
+		int height = 0;
+		std::vector<RenderWindow::ImageCallback> callbacks;
+	};
+
+	std::vector<RenderWindow::ImageCallback> mRequests;
+	std::array<Transfer, 2> mTransfers;
+	unsigned int mNextTransfer = 0;
+
+	static bool Complete(Transfer& transfer, const bool& wait,
+		std::vector<CompletedImage>& completed);
+};
+
+}// namespace LibPlot2D
+
+#endif// READBACK_QUEUE_H_
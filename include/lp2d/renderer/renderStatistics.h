@@ -0,0 +1,169 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  renderStatistics.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Collection of per-frame and per-primitive rendering statistics,
+//        including CPU timers and OpenGL timer queries.
+
+#ifndef RENDER_STATISTICS_H_
+#define RENDER_STATISTICS_H_
+
+// Standard C++ headers
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <cstddef>
+
+namespace LibPlot2D
+{
+
+// Local forward declarations
+class Primitive;
+
+/// Structure containing statistics for drawing one primitive.  A primitive
+/// which is drawn in more than one viewport has one entry per viewport.
+struct PrimitiveStatistics
+{
+	/// Object which was drawn.  For identification only; the object may have
+	/// been deleted since the statistics were collected.
+	const Primitive* primitive = nullptr;
+
+	double cpuTime = 0.0;///< Time spent in Primitive::Draw() [sec].
+	double updateTime = 0.0;///< Portion of cpuTime spent rebuilding buffers [sec].
+	double gpuTime = -1.0;///< GPU time (negative if unavailable) [sec].
+
+	unsigned int vertexCount = 0;///< Number of vertices drawn.
+	unsigned int rebuildCount = 0;///< Number of buffers rebuilt.
+	std::size_t bytesUploaded = 0;///< Vertex and index data sent to OpenGL.
+};
+
+/// Structure containing statistics for one rendered frame.
+struct FrameStatistics
+{
+	unsigned long long frameNumber = 0;///< Sequential frame identifier.
+
+	/// Time spent updating the scene prior to rendering (i.e. formatting the
+	/// plot), as reported with RenderStatistics::RecordSceneUpdate() [sec].
+	double sceneUpdateTime = 0.0;
+	double preparationTime = 0.0;///< Time spent preparing buffers in parallel [sec].
+	double cpuTime = 0.0;///< Time spent rendering, excluding the buffer swap [sec].
+	double gpuTime = -1.0;///< Sum of primitive GPU times (negative if unavailable) [sec].
+
+	double framesPerSecond = 0.0;///< Frame rate averaged over the last second.
+
+	/// Input-to-display latency, as reported with
+	/// RenderStatistics::RecordInputLatency() (zero if the frame was not
+	/// rendered in response to input) [sec].
+	double inputLatency = 0.0;
+
+	unsigned int vertexCount = 0;///< Total number of vertices drawn.
+	unsigned int rebuildCount = 0;///< Total number of buffers rebuilt.
+	std::size_t bytesUploaded = 0;///< Total vertex and index data sent to OpenGL.
+
+	std::vector<PrimitiveStatistics> primitives;///< Per-primitive statistics.
+};
+
+/// Class for collecting rendering statistics.  CPU times are measured
+/// directly; GPU times are measured with GL_TIME_ELAPSED queries, which are
+/// read without blocking once the results become available (typically one
+/// or two frames later).  Statistics for a frame are published (and become
+/// available through GetFrameStatistics()) once all of its query results
+/// have been read.  All methods other than GetFrameStatistics() must be
+/// called with the owning context current.
+class RenderStatistics
+{
+public:
+	RenderStatistics() = default;
+
+	RenderStatistics(const RenderStatistics&) = delete;
+	RenderStatistics& operator=(const RenderStatistics&) = delete;
+
+	/// Begins collecting statistics for a new frame.  Also publishes the
+	/// statistics for any earlier frames whose query results are available.
+	void BeginFrame();
+
+	/// Finishes collecting CPU statistics for the current frame.
+	void EndFrame();
+
+	/// Records the time spent updating the scene prior to the next frame.
+	///
+	/// \param time Elapsed time [sec].
+	void RecordSceneUpdate(const double& time) { mSceneUpdateTime += time; }
+
+	/// Records the time spent preparing buffers for the current frame.
+	///
+	/// \param time Elapsed time [sec].
+	void RecordPreparation(const double& time);
+
+	/// Records the input-to-display latency of the most recent frame.
+	///
+	/// \param latency Latency [sec].
+	void RecordInputLatency(const double& latency);
+
+	/// Begins collecting statistics for drawing a primitive.  Ignored if no
+	/// frame is in progress (i.e. when rendering offscreen).
+	///
+	/// \param primitive Object being drawn.
+	void BeginPrimitive(const Primitive& primitive);
+
+	/// Marks the end of the buffer updates for the current primitive.
+	void EndPrimitiveUpdate();
+
+	/// Finishes collecting statistics for the current primitive.
+	///
+	/// \param vertexCount   Number of vertices drawn.
+	/// \param rebuildCount  Number of buffers rebuilt.
+	/// \param bytesUploaded Amount of data sent to OpenGL.
+	void EndPrimitive(const unsigned int& vertexCount,
+		const unsigned int& rebuildCount, const std::size_t& bytesUploaded);
+
+	/// Gets the statistics for the most recent frame whose results are
+	/// complete.
+	/// \returns The frame statistics.
+	const FrameStatistics& GetFrameStatistics() const { return mPublished; }
+
+	/// Deletes the timer queries.  Statistics for frames which are in
+	/// progress are discarded.
+	void FreeOpenGLObjects();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static const unsigned int mMaxPendingFrames;
+
+	struct PendingFrame
+	{
+		FrameStatistics statistics;
+		std::vector<unsigned int> queries;// One per primitive (zero if none)
+	};
+
+	std::deque<PendingFrame> mPendingFrames;
+	FrameStatistics mPublished;
+
+	bool mFrameActive = false;
+	bool mPrimitiveActive = false;
+	unsigned long long mFrameCount = 0;
+	double mSceneUpdateTime = 0.0;// [sec]
+
+	Clock::time_point mFrameStart;
+	Clock::time_point mPrimitiveStart;
+	Clock::time_point mUpdateEnd;
+	std::deque<Clock::time_point> mRecentFrames;// For computing frame rate
+
+	std::vector<unsigned int> mFreeQueries;
+	std::vector<unsigned int> mAllQueries;
+
+	unsigned int AcquireQuery();
+	bool ResolvePendingFrame(PendingFrame& frame, const bool& wait);
+};
+
+}// namespace LibPlot2D
+
+#endif// RENDER_STATISTICS_H_
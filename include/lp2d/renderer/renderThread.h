@@ -0,0 +1,125 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  renderThread.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Thread which owns a render window's OpenGL context and draws its
+//        frames, so drawing does not block the event loop.
+
+#ifndef RENDER_THREAD_H_
+#define RENDER_THREAD_H_
+
+// Local headers
+#include "lp2d/renderer/renderWindow.h"
+#include "lp2d/utilities/spscQueue.h"
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace LibPlot2D
+{
+
+/// State of the window captured by the main thread when a frame is
+/// requested.  The render thread must not query the window itself (wxWidgets
+/// is not thread-safe), so everything it needs from the window is copied
+/// here; the scene itself is handed over for the duration of the frame (see
+/// RenderWindow::SetThreadedRendering()).
+struct FrameSnapshot
+{
+	wxSize size;///< Size of the window.
+	wxSize clientSize;///< Size of the client area of the window.
+
+	/// Image requests (see RenderWindow::RequestImage()) to be satisfied by
+	/// this frame.
+	std::vector<RenderWindow::ImageCallback> imageRequests;
+};
+
+/// Thread which owns the OpenGL context of a render window.  The main thread
+/// posts frames and other work requiring the context; they are passed
+/// through a lock-free queue and executed in order.  The main thread is the
+/// only producer, so waiting until the queue is empty is sufficient to know
+/// that the scene is no longer in use.  Only one frame is in flight at a time
+/// (see RenderWindow::RequestFrame()) and Execute() blocks, so the queue holds
+/// at most one frame and one task.
+class RenderThread
+{
+public:
+	/// Constructor.  Starts the thread.
+	///
+	/// \param window Window whose frames are drawn by this thread.
+	explicit RenderThread(RenderWindow& window);
+
+	/// Destructor.  Completes any posted work before stopping the thread.
+	~RenderThread();
+
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+
+	/// Posts a request to draw a frame.  Returns immediately.
+	///
+	/// \param frame State of the window for the frame.
+	void PostFrame(std::shared_ptr<const FrameSnapshot> frame);
+
+	/// Executes the specified function on this thread and waits for it to
+	/// complete.  If called from this thread, the function is executed
+	/// immediately.
+	///
+	/// \param task Function to execute.
+	void Execute(const std::function<void()>& task);
+
+	/// Blocks until all posted work has been completed.  Returns immediately
+	/// if called from this thread.
+	void WaitForIdle();
+
+	/// Checks to see if any posted work has not yet been completed.
+	/// \returns True if work is pending.
+	bool IsBusy() const { return mPendingCount.load() > 0; }
+
+	/// Checks to see if the caller is executing on this thread.
+	/// \returns True if called from this thread.
+	bool IsCurrentThread() const
+	{ return std::this_thread::get_id() == mThread.get_id(); }
+
+private:
+	RenderWindow& mWindow;
+
+	struct Request
+	{
+		std::shared_ptr<const FrameSnapshot> frame;
+		std::function<void()> task;
+	};
+
+	static const std::size_t mQueueCapacity;
+	SpscQueue<Request> mQueue;
+
+	// Number of requests which have been posted but have not been completed
+	std::atomic<unsigned int> mPendingCount;
+
+	// The queue itself is lock-free; the mutex is only used for sleeping
+	// while there is nothing to do
+	std::mutex mMutex;
+	std::condition_variable mWakeCondition;
+	std::condition_variable mIdleCondition;
+	bool mStopping = false;
+
+	std::thread mThread;// Must be last, since it is started by the constructor
+
+	void Post(Request&& request);
+	void ThreadEntry();
+};
+
+}// namespace LibPlot2D
+
+#endif// RENDER_THREAD_H_
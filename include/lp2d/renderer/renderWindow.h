@@ -21,6 +21,7 @@
 // Local headers
 #include "lp2d/utilities/managedList.h"
 #include "lp2d/renderer/primitives/primitive.h"
+#include "lp2d/renderer/renderStatistics.h"
 
 // Eigen headers
 #include <Eigen/Eigen>
@@ -28,12 +29,15 @@
 // wxWidgets headers
 #include <wx/wx.h>
 #include <wx/glcanvas.h>
+#include <wx/timer.h>
 
 // Standard C++ headers
 #include <memory>
+#include <vector>
 #include <unordered_map>
 #include <typeindex>
 #include <mutex>
+#include <functional>
 
 /// Custom event to know when a scene has been rendered.
 ///
@@ -49,6 +53,15 @@ wxDECLARE_EVENT(RENDERED_EVENT, wxCommandEvent);
 namespace LibPlot2D
 {
 
+// Local forward declarations
+class ThreadPool;
+class ReadbackQueue;
+class LayerCache;
+class ContextGroup;
+class RenderThread;
+class HeadlessContext;
+struct FrameSnapshot;
+
 /// Class for creating OpenGL scenes.  Includes event handlers for various
 /// mouse and keyboard interactions.
 class RenderWindow : public wxGLCanvas
@@ -78,6 +91,96 @@ public:
 	/// objects are freed while the correct context is active.
 	void FreeOpenGLObjects();
 
+	/// Adds this window to the specified group of windows which share
+	/// OpenGL objects (see ContextGroup).  Must be called before the window
+	/// is first rendered.  May not be combined with threaded rendering.
+	///
+	/// \param group Group to join.
+	void SetContextGroup(std::shared_ptr<ContextGroup> group);
+
+	/// Gets the group of windows with which this window shares OpenGL
+	/// objects.
+	/// \returns The group, or nullptr if objects are not shared.
+	std::shared_ptr<ContextGroup> GetContextGroup() const
+	{ return mContextGroup; }
+
+	/// Gets a value identifying the set of windows which share this window's
+	/// OpenGL objects.  Objects which may be shared (i.e. textures) can be
+	/// cached using this as a key.
+	/// \returns The context group, or this window if it is not in a group.
+	const void* GetSharingKey() const;
+
+	/// Enables or disables drawing on a dedicated thread.  When enabled, the
+	/// OpenGL context belongs to a thread created for this window, and
+	/// painting the window only posts a request for a frame, so the event
+	/// loop (menus, dialogs, other windows) remains responsive while a slow
+	/// frame is drawn.  The scene is used by the render thread until the
+	/// frame is complete, so it must only be modified through ModifyScene(),
+	/// or after calling WaitForRenderThread() (AddActor() and RemoveActor()
+	/// do this).  Must be called before the window is first rendered, and
+	/// may not be combined with a context group.  The platform must allow a
+	/// context to be made current on a secondary thread (with X11,
+	/// XInitThreads() must be called before any other Xlib calls).
+	///
+	/// \param threaded True to draw on a dedicated thread.
+	void SetThreadedRendering(const bool& threaded);
+
+	/// Checks to see if frames are drawn on a dedicated thread.
+	/// \returns True if frames are drawn on a dedicated thread.
+	bool GetThreadedRendering() const { return mRenderThread != nullptr; }
+
+	/// Enables or disables headless rendering.  When enabled, images are
+	/// rendered (see RenderOffscreen()) with an OpenGL context which does not
+	/// belong to this window (see HeadlessContext), so the window never needs
+	/// to be shown or realized, and no GPU is required where EGL renders in
+	/// software.  A headless window is never drawn on screen, so its image
+	/// can't be read with GetImage() or RequestImage().  Must be called
+	/// before the window is first rendered, and may not be combined with a
+	/// context group or threaded rendering.  Not available under MSW.
+	///
+	/// \param headless True to render without the window's context.
+	void SetHeadless(const bool& headless);
+
+	/// Checks to see if images are rendered without the window's context.
+	/// \returns True if rendering is headless.
+	bool GetHeadless() const { return mHeadless; }
+
+	/// Checks to see if a frame has been requested which has not yet been
+	/// displayed.  Always false unless rendering is threaded.
+	/// \returns True if a frame is being drawn.
+	bool IsFrameInProgress() const { return mFrameInProgress; }
+
+	/// Checks to see if the scene may be modified by the caller, i.e. the
+	/// caller is the render thread, or the render thread is not using the
+	/// scene (no frame is in progress, or WaitForRenderThread() has been
+	/// called since the frame was requested, which includes while changes
+	/// queued by ModifyScene() are applied).  Used in assertions.
+	/// \returns True if the scene may be modified.
+	bool IsSceneModifiable() const;
+
+	/// Blocks until the render thread has finished with the scene, then
+	/// applies any changes queued by ModifyScene(), so changes are applied
+	/// in the order in which they were made.  Returns immediately if
+	/// rendering is not threaded, or if called from the render thread.
+	void WaitForRenderThread();
+
+	/// Applies a change to the scene without waiting for the render thread.
+	/// If a frame is being drawn, the change is queued and applied once the
+	/// frame is complete (after which another frame is drawn); otherwise, it
+	/// is applied immediately.  Event handlers use this so a slow frame never
+	/// blocks the event loop.  Must be called from the main thread, and the
+	/// change must capture any arguments by value.  Changes are applied
+	/// while the frame is still considered to be in progress, so they must
+	/// not show dialogs or menus (use CallAfter() for these).
+	///
+	/// \param change Function which modifies the scene.
+	void ModifyScene(std::function<void()> change);
+
+	/// Checks to see if the caller is executing on this window's render
+	/// thread.
+	/// \returns True if called from the render thread.
+	bool IsRenderThread() const;
+
 	/// Sets the camera position and orientation.
 	///
 	/// \param position    Location of the camera's "eye."
@@ -119,7 +222,7 @@ public:
 	///
 	/// \param toAdd Object to add to the scene.
 	inline void AddActor(std::unique_ptr<Primitive> toAdd)
-	{ mPrimitiveList.Add(std::move(toAdd)); mModified = true; }
+	{ WaitForRenderThread(); mPrimitiveList.Add(std::move(toAdd)); mModified = true; }
 
 	/// Removes the specified object from the primitives list.
 	///
@@ -195,10 +298,135 @@ public:
 	/// \returns True if the file was successfully written.
 	bool WriteImageToFile(wxString pathAndFileName) const;
 
-	/// Gets an image of the current rendered scene.
+	/// Renders the scene offscreen at the specified size and writes the
+	/// image to file (see RenderOffscreen()).
+	///
+	/// \param pathAndFileName Location to write the file.
+	/// \param width           Width of the image in pixels.
+	/// \param height          Height of the image in pixels.
+	///
+	/// \returns True if the file was successfully written.
+	bool WriteImageToFile(wxString pathAndFileName, const unsigned int& width,
+		const unsigned int& height);
+
+	/// Renders the scene to an offscreen framebuffer and returns the image.
+	/// The scene is laid out for the requested size (rather than scaled from
+	/// the window size), and images larger than the OpenGL implementation
+	/// can render in one pass are rendered in tiles.  Unless rendering is
+	/// headless (see SetHeadless()), the context belongs to this window,
+	/// which must already be realized (on some platforms, this requires it
+	/// to have been shown) so the context can be made current.
+	///
+	/// \param width  Width of the image in pixels.
+	/// \param height Height of the image in pixels.
+	///
+	/// \returns The rendered image (invalid on failure).
+	virtual wxImage RenderOffscreen(const unsigned int& width,
+		const unsigned int& height);
+
+	/// Gets the size of the image being rendered.  This is the size of the
+	/// window, except while rendering offscreen.  Objects in the scene must
+	/// use this (rather than the window size) for layout.
+	/// \returns The size of the render target in pixels.
+	wxSize GetRenderSize() const;
+
+	/// Gets the size of the image for which the scene is being drawn.  This
+	/// is captured from GetRenderSize() at the start of each frame, before
+	/// primitives are prepared, so (unlike GetRenderSize()) it may be called
+	/// from Primitive::PrepareUpdate() on worker threads, which must not
+	/// query the window.
+	/// \returns The size of the render target in pixels.
+	const wxSize& GetSceneSize() const { return mSceneSize; }
+
+	/// Sets the area to which drawing is limited while the scissor test is
+	/// enabled.  The area is applied at the start of each frame (and each
+	/// tile, when rendering offscreen).
+	///
+	/// \param area Scissor area in render target pixels.
+	void SetScissorArea(const wxRect& area)
+	{
+		if (area != mScissorArea)
+		{
+			mScissorArea = area;
+			InvalidateStaticLayer();
+		}
+	}
+
+	/// Enables or disables caching of the static layer.  When enabled (and
+	/// rendering a 2D scene with a single viewport), primitives which are
+	/// not overlays (see Primitive::SetOverlay()) are drawn to an offscreen
+	/// image, which is re-used until one of them changes.  Frames in which
+	/// only overlays have changed then cost no more than drawing the
+	/// overlays.  Enabled by default.
+	///
+	/// \param cache True to cache the static layer.
+	void SetCacheStaticLayer(const bool& cache)
+	{ mCacheStaticLayer = cache; InvalidateStaticLayer(); }
+
+	/// Checks to see if the static layer is cached.
+	/// \returns True if the static layer is cached.
+	bool GetCacheStaticLayer() const { return mCacheStaticLayer; }
+
+	/// Indicates that the cached image of the static layer must be drawn
+	/// again.  Called by primitives when they change; derived classes must
+	/// call this when they change anything else affecting the static layer.
+	void InvalidateStaticLayer() { mStaticLayerValid = false; }
+
+	/// Gets an image of the current rendered scene.  The pixels are read
+	/// back synchronously; prefer RequestImage() where possible.
 	/// \returns An image object representing the current scene.
 	virtual wxImage GetImage() const;
 
+	/// Type of function called when a requested image is available.
+	typedef std::function<void(const wxImage&)> ImageCallback;
+
+	/// Requests an image of the rendered scene.  The pixels are copied into
+	/// a pixel buffer object as the next frame is rendered, and the transfer
+	/// completes while the application continues to run.  The callback is
+	/// called from the event loop once the image is available.  Requests
+	/// made before the same frame share one transfer.  The window must be
+	/// shown for the request to be satisfied.
+	///
+	/// \param callback Function to receive the image.
+	void RequestImage(const ImageCallback& callback);
+
+	/// Copies the specified rows of pixels (in OpenGL order, i.e. bottom row
+	/// first, tightly packed RGB) into the specified region of the image,
+	/// flipping them vertically.
+	///
+	/// \param source       Pixel data read from OpenGL.
+	/// \param region       Region of the image covered by the pixels, with
+	///                     the y-coordinate measured from the bottom.
+	/// \param image [out]  Image to receive the pixels.
+	static void CopyFlipped(const unsigned char* source, const wxRect& region,
+		wxImage& image);
+
+	/// Enables or disables the collection of rendering statistics.  When
+	/// enabled, each primitive is timed on the CPU and with an OpenGL timer
+	/// query, so collection is disabled by default.
+	///
+	/// \param collect True to collect statistics.
+	void SetCollectStatistics(const bool& collect);
+
+	/// Checks to see if rendering statistics are being collected.
+	/// \returns True if statistics are being collected.
+	bool GetCollectStatistics() const { return mRenderStatistics != nullptr; }
+
+	/// Gets the statistics for the most recent frame whose GPU timings are
+	/// available.  This is typically one or two frames behind the frame on
+	/// screen.
+	/// \returns The frame statistics (default values if statistics are not
+	///          being collected).
+	FrameStatistics GetFrameStatistics() const;
+
+	/// Gets the object collecting statistics for this window.  Intended for
+	/// use by primitives and derived classes, which may add to the
+	/// statistics for the current frame.
+	/// \returns The statistics object, or nullptr if statistics are not
+	///          being collected.
+	RenderStatistics* GetRenderStatistics() const
+	{ return mRenderStatistics.get(); }
+
 	/// Determines if a particular primitive is in the scene owned by this
 	/// object.
 	///
@@ -226,10 +454,23 @@ public:
 
 	/// Creates the program using the specified shaders.
 	///
-	/// \param shaderList List of shaders to include in the program.
+	/// \param shaderList  List of shaders to include in the program.
+	/// \param retrievable Set to true if the binary of the linked program
+	///                    will be requested.
+	///
+	/// \returns Index for the program.
+	static GLuint CreateProgram(const std::vector<GLuint>& shaderList,
+		const bool& retrievable = false);
+
+	/// Compiles the specified shaders and creates a program using them.  If
+	/// this window is in a context group with a program cache, the cached
+	/// binary is used instead of compiling, when available.
+	///
+	/// \param shaders List of shader types and sources.
 	///
 	/// \returns Index for the program.
-	static GLuint CreateProgram(const std::vector<GLuint>& shaderList);
+	GLuint BuildProgram(
+		const std::vector<std::pair<GLenum, std::string>>& shaders);
 
 	/// Applies a small shift to the modelview matrix to enable exact
 	/// pixelization.
@@ -348,13 +589,50 @@ public:
 	template<typename T>
 	GLuint GetPrimitiveTypeProgram() const;
 
-	/// Accessor for the render mutex.
+	/// Gets an index buffer which may be shared among all objects in this
+	/// window with the same topology (i.e. the same pattern of indices).  The
+	/// buffer is grown and regenerated as necessary to hold at least the
+	/// requested number of indices; otherwise no work is done.  Since the
+	/// buffer object itself is retained when it grows, vertex arrays which
+	/// refer to it do not need to be updated.
+	///
+	/// \param name       Name identifying the topology.
+	/// \param indexCount Minimum required number of indices.
+	/// \param generator  Function which fills the specified vector (already
+	///                   sized as required) with indices.
+	///
+	/// \returns The name of the OpenGL buffer object.
+	GLuint GetSharedIndexBuffer(const std::string& name,
+		const unsigned int& indexCount,
+		const std::function<void(std::vector<unsigned int>&)>& generator);
+
+	/// Accessor for the render mutex, which must be held while this
+	/// window's context is current.
 	/// \returns Reference to the render mutex.
-	static std::mutex& GetRenderMutex() { return renderMutex; }
+	std::mutex& GetRenderMutex() { return mRenderMutex; }
 
-	/// Makes the GL context associated with this object current.
+	/// Makes the GL context associated with this object current.  When
+	/// rendering is threaded, this may only be called from the render
+	/// thread (see ExecuteWithContext()).
 	void MakeCurrent();
 
+	/// Calls the specified function with this window's context current (and
+	/// the render mutex held).  When rendering is threaded, the function is
+	/// executed on the render thread and this call waits for it to complete.
+	/// If the context has not been created, there are no OpenGL objects to
+	/// act on, so the function is called without it.  Must not be called
+	/// from within a frame.
+	///
+	/// \param task Function to call.
+	void ExecuteWithContext(const std::function<void()>& task) const;
+
+	/// Gets the pool of worker threads shared by all windows for building
+	/// geometry.  Work added from one of the pool's own threads (i.e. while
+	/// preparing a primitive) is executed serially, so the number of threads
+	/// is bounded regardless of the number of windows and primitives.
+	/// \returns Reference to the shared thread pool.
+	static ThreadPool& GetThreadPool();
+
 	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
 protected:
@@ -368,6 +646,22 @@ protected:
 
 	GLuint mActiveProgram = 0;
 
+	void Render();///< Updates the scene and re-draws the image.
+
+	/// Called when the render size changes for reasons other than resizing
+	/// the window (i.e. when offscreen rendering begins and ends).  Derived
+	/// classes should update any layout which depends on the size.
+	virtual void UpdateRenderSize() {}
+
+	/// Called on the main thread when a frame has been displayed.  When
+	/// rendering is threaded, this happens some time after the paint event
+	/// which requested the frame.
+	virtual void FrameRendered() {}
+
+	/// Discards any changes queued by ModifyScene() without applying them.
+	/// Used by derived classes when they are destroyed.
+	void DiscardSceneChanges() { mSceneChanges.clear(); }
+
 	/// Stores the current location of the mouse cursor.
 	///
 	/// \param event Mouse location information.
@@ -493,6 +787,14 @@ private:
 	std::unique_ptr<wxGLContext> mContext;
 	wxGLContext* GetContext();
 
+	// Used in place of mContext when rendering is headless
+	bool mHeadless = false;
+	std::unique_ptr<HeadlessContext> mHeadlessContext;
+	HeadlessContext* GetHeadlessContext();
+
+	bool HasContext() const { return mContext || mHeadlessContext; }
+	bool MakeContextCurrent() const;
+
 	static const double mExactPixelShift;
 
 	// Flags describing the options for this object's functionality
@@ -531,10 +833,9 @@ private:
 	void OnPaint(wxPaintEvent& event);
 	void OnSize(wxSizeEvent& event);
 	void OnEnterWindow(wxMouseEvent &event);
+	void OnReadbackTimer(wxTimerEvent &event);
 	// End event handlers-------------------------------------------------
 
-	void Render();
-
 	// Performs the computations and transformations associated with the
 	// specified interaction
 	void PerformInteraction(Interaction interaction, wxMouseEvent &event);
@@ -559,20 +860,111 @@ private:
 	Eigen::Vector3d mFocalPoint;
 
 	bool mGlewInitialized = false;
+	bool InitializeGLEW();
+	void DrawScene();
+
+	enum class Layer
+	{
+		All,
+		Static,
+		Overlay
+	};
+
+	void ClearBuffers();
+	void DrawPrimitives(const Layer& layer,
+		const Primitive* firstTransparentPrimitive = nullptr);
+
+	// Image of the non-overlay primitives (created the first time it is
+	// needed)
+	bool mCacheStaticLayer = true;
+	bool mStaticLayerValid = false;
+	std::unique_ptr<LayerCache> mLayerCache;
+	bool UseStaticLayerCache() const;
+	void DrawCachedLayers();
+
+	// Offscreen rendering
+	static const int mMaxTileSize;// [pixels]
+
+	wxSize mOffscreenSize;// Zero when rendering to the window
+	wxSize mSceneSize;// Render size for the frame being drawn
+	wxRect mRenderRegion;// Portion of the render target drawn by the viewport
+	wxRect mScissorArea;
+
+	bool RenderTiles(wxImage& image);
+	Eigen::Matrix4d GenerateRegionMatrix() const;
+
+	// Pixels for requested images are read back asynchronously (created the
+	// first time an image is requested)
+	std::unique_ptr<ReadbackQueue> mReadbackQueue;
+	void CompleteReadbacks();
+
+	// Transfers in progress are polled for completion with a timer
+	enum EventIDs
+	{
+		idReadbackTimer = wxID_HIGHEST + 500
+	};
+
+	static const int mReadbackPollInterval;// [msec]
+	wxTimer mReadbackTimer;
+
+	std::unique_ptr<RenderStatistics> mRenderStatistics;
 
 	static void GetGLInfo();
 
 	std::unordered_map<std::type_index, bool> mTypeInitializedMap;
 	std::unordered_map<std::type_index, GLuint> mTypeProgramMap;
 
-	static std::mutex renderMutex;
+	struct SharedIndexBuffer
+	{
+		GLuint bufferIndex;
+		unsigned int indexCount = 0;
+	};
+
+	std::unordered_map<std::string, SharedIndexBuffer> mSharedIndexBuffers;
+
+	mutable std::mutex mRenderMutex;
+
+	// When rendering is threaded, the main thread posts a frame (along with
+	// the state of the window) and the render thread draws it.  Paint events
+	// received while a frame is in progress are combined into one more frame.
+	std::unique_ptr<RenderThread> mRenderThread;
+	bool mFrameInProgress = false;
+	bool mSceneInUse = false;// Until the render thread is known to be idle
+	bool mFramePending = false;
+	wxSize mFrameSize;
+	wxSize mFrameClientSize;
+	std::vector<ImageCallback> mImageRequests;
+
+	// Changes made to the scene while a frame is in progress
+	std::vector<std::function<void()>> mSceneChanges;
+	bool mApplyingSceneChanges = false;
+	bool ApplySceneChanges();
+
+	void RequestFrame();
+	void DrawFrame(const FrameSnapshot& frame);
+	void FinishFrame(std::shared_ptr<std::vector<std::pair<wxImage,
+		std::vector<ImageCallback>>>> completedImages, const bool& redraw);
+	void NotifyFrameRendered();
+	friend RenderThread;
+
+	// Programs and shared index buffers belong to the group, if any
+	std::shared_ptr<ContextGroup> mContextGroup;
+	bool FindSharedProgram(const std::string& name, ShaderInfo& shader) const;
+	void ShareProgram(const std::string& name, const ShaderInfo& shader);
+	friend ContextGroup;
+
+	// Primitives with a preparation stage have their CPU work done by the
+	// shared thread pool prior to rendering
+	void PreparePrimitives();
 };
 
 //=============================================================================
 // Class:			RenderWindow
 // Function:		InitializePrimitiveType
 //
-// Description:		Initializes the specified primitive type.
+// Description:		Initializes the specified primitive type.  Within a
+//					context group, the program built by the first window is
+//					shared by the others.
 //
 // Input Arguments:
 //		primitive	= T&
@@ -590,7 +982,15 @@ void RenderWindow::InitializePrimitiveType(T& primitive)
 	if (IsPrimitiveTypeInitialized<T>())
 		return;
 
-	mTypeProgramMap[typeid(T)] = primitive.DoGLInitialization();
+	ShaderInfo shader;
+	if (FindSharedProgram(typeid(T).name(), shader))
+		mTypeProgramMap[typeid(T)] = AddShader(shader);
+	else
+	{
+		mTypeProgramMap[typeid(T)] = primitive.DoGLInitialization();
+		ShareProgram(typeid(T).name(), mShaders[mTypeProgramMap[typeid(T)]]);
+	}
+
 	mTypeInitializedMap[typeid(T)] = true;
 }
 
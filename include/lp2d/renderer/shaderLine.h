@@ -0,0 +1,154 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  shaderLine.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Object representing a line, drawn with triangles faded from line
+//        color to transparent, where the triangles are generated on the GPU
+//        from the raw line points.
+
+#ifndef SHADER_LINE_H_
+#define SHADER_LINE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <string>
+#include <cassert>
+
+// Eigen headers
+#include <Eigen/Eigen>
+
+// Local headers
+#include "lp2d/renderer/color.h"
+#include "lp2d/renderer/primitives/primitive.h"
+#include "lp2d/renderer/line.h"
+
+namespace LibPlot2D
+{
+
+// Local forward declarations
+class RenderWindow;
+
+/// Helper class for rendering a line with the same appearance as a "pretty"
+/// Line, but only the line points are sent to OpenGL.  Each segment is drawn
+/// as an instance of a triangle strip; the vertex shader computes the offsets
+/// for the line width (including miter joins) and the fade to transparent.
+/// Since line widths are computed on the GPU in pixels, the geometry does not
+/// need to be rebuilt when the scale changes.
+class ShaderLine
+{
+public:
+	/// Constructor.
+	///
+	/// \param renderWindow Window in which the line will be rendered.
+	explicit ShaderLine(RenderWindow& renderWindow);
+
+	/// \name Option setting methods
+	/// @{
+
+	/// Sets the line width.
+	///
+	/// \param width Line width in pixels.
+	inline void SetWidth(const double &width)
+	{ assert(width >= 0.0); mHalfWidth = 0.5 * width; }
+
+	/// Sets the line color.
+	///
+	/// \param color Color of the line.
+	inline void SetLineColor(const Color &color) { mLineColor = color; }
+
+	/// Sets the OpenGL rendering type hint.
+	///
+	/// \param hint Hint to tell the drivers how often to expect this object to
+	///             update.
+	inline void SetBufferHint(const GLenum& hint) { mHint = hint; }
+
+	/// @}
+
+	/// Creates OpenGL buffers and fills them with the line points.  Each point
+	/// after the first results in a new line segment.  Lines with a single
+	/// point are retained (so more points can be appended), but not drawn.
+	///
+	/// \param x                List of x-ordinates of line points.
+	/// \param y                List of y-ordinates of line points.
+	/// \param bufferInfo [out] Information regarding populated OpenGL buffers.
+	/// \param update           Desired update method.
+	void Build(const std::vector<double>& x, const std::vector<double>& y,
+		Primitive::BufferInfo& bufferInfo,
+		const Line::UpdateMethod& update = Line::UpdateMethod::Immediate);
+
+	/// Adds points to the end of a line previously created with Build().
+	/// Only the new points are sent to OpenGL, making this suitable for
+	/// streaming data.
+	///
+	/// \param x                List of x-ordinates of points to add.
+	/// \param y                List of y-ordinates of points to add.
+	/// \param replacedPoints   Number of points at the end of the existing
+	///                         line which are replaced by the new points
+	///                         (i.e. when decimated data is extended).
+	/// \param bufferInfo [out] Information regarding populated OpenGL buffers.
+	/// \param update           Desired update method.
+	///
+	/// \returns Index of the first element of the vertex buffer which was
+	///          modified (for passing to Upload() when \p update is
+	///          Line::UpdateMethod::Manual).
+	std::vector<float>::size_type Append(const std::vector<double>& x,
+		const std::vector<double>& y, const unsigned int& replacedPoints,
+		Primitive::BufferInfo& bufferInfo,
+		const Line::UpdateMethod& update = Line::UpdateMethod::Immediate);
+
+	/// Sends geometry created with Line::UpdateMethod::Manual to OpenGL.  Must
+	/// be called from the thread which owns the OpenGL context.
+	///
+	/// \param bufferInfo Information regarding populated buffers.
+	/// \param first      Index of the first element of the vertex buffer
+	///                   which changed since the last upload.
+	void Upload(Primitive::BufferInfo& bufferInfo,
+		const std::vector<float>::size_type& first = 0);
+
+	/// Renders a line previously created with Build().  Uses the line's own
+	/// program, restoring the default program prior to returning.
+	///
+	/// \param bufferInfo Information regarding the populated OpenGL buffers.
+	/// \param modelview  Matrix converting line points to pixels.
+	void Draw(const Primitive::BufferInfo& bufferInfo,
+		const Eigen::Matrix4d& modelview);
+
+private:
+	static const double mFadeDistance;
+	double mHalfWidth;
+
+	Color mLineColor = Color::ColorBlack;
+
+	RenderWindow& mRenderWindow;
+
+	GLenum mHint;
+
+	static const std::string mVertexShader;
+	static const std::string mFragmentShader;
+
+	static const std::string mHalfWidthName;
+	static const std::string mFadeDistanceName;
+	static const std::string mLineColorName;
+
+	// Attribute locations (fixed by layout qualifiers in the vertex shader)
+	static const GLuint mPriorLocation;
+	static const GLuint mStartLocation;
+	static const GLuint mEndLocation;
+	static const GLuint mNextLocation;
+
+	static const unsigned int mVerticesPerSegment;
+
+	GLuint DoGLInitialization();
+	friend RenderWindow;
+};
+
+}// namespace LibPlot2D
+
+#endif// SHADER_LINE_H_
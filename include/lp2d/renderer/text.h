@@ -16,23 +16,26 @@
 
 // Local headers
 #include "lp2d/renderer/primitives/primitive.h"
+#include "lp2d/renderer/glyphCache.h"
 
 // Eigen headers
 #include <Eigen/Eigen>
 
-// Freetype headers
-#include <ft2build.h>
-#include FT_FREETYPE_H
-
 // Standard C++ headers
 #include <string>
 #include <map>
-#include <limits>
+#include <memory>
+#include <utility>
+#include <mutex>
 
 namespace LibPlot2D
 {
 
-/// Helper class for building BufferInfo objects for rendering text.
+/// Helper class for building BufferInfo objects for rendering text.  Glyphs
+/// are obtained from the process-wide GlyphCache, and the glyph textures are
+/// shared among all Text objects in the same window with the same font and
+/// size.  Strings are interpreted as UTF-8; glyphs outside of the ASCII range
+/// are rasterized as they are encountered.
 class Text
 {
 public:
@@ -48,7 +51,8 @@ public:
 	Text& operator=(const Text&) = delete;
 	Text& operator=(Text&&) = delete;
 
-	/// Sets the size of the text.  The width is automatically determined.
+	/// Sets the size of the text.  The width is automatically determined.  Has
+	/// no effect until a face has been set with SetFace().
 	///
 	/// \param height Height of the text in pixels.
 	void SetSize(const double& height);
@@ -126,7 +130,7 @@ public:
 	/// Checks to see if this object is ready to render.
 	/// \returns True if this object was successfully initialized and is ready
 	///          to render.
-	bool IsOK() const { return mIsOK && (mGlyphsGenerated || mFace); }
+	bool IsOK() const { return static_cast<bool>(mGlyphCache); }
 
 	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
@@ -143,44 +147,46 @@ private:
 	static GLint mVertexLocation;
 	static GLint mIndexLocation;
 
-	static FT_Library mFt;
-	static unsigned int mFtReferenceCount;
+	std::string mFontFileName;
+	unsigned int mWidth = 0;
+	unsigned int mHeight = 0;
+	std::shared_ptr<GlyphCache> mGlyphCache;
 
-	FT_Face mFace = nullptr;
 	Color mColor = Color::ColorBlack;
 
 	double mX;
 	double mY;
 	double mScale = 1.0;
 
-	unsigned int mMaxXSize;
-	unsigned int mMaxYSize;
-
 	std::string mText;
 
-	struct Glyph
+	GLuint DoGLInitialization();
+	friend RenderWindow;
+
+	// Glyph textures are shared by all Text objects using the same glyph
+	// cache within the same window, or within the same context group (see
+	// RenderWindow::GetSharingKey())
+	struct GlyphTexture
 	{
-		unsigned int index;
-		int xSize;
-		int ySize;
-		int xBearing;
-		int yBearing;
-		unsigned int advance;
+		GLuint textureId = 0;
+		unsigned int layerCapacity = 0;
+		unsigned int glyphCount = 0;
+		unsigned int xSize = 0;
+		unsigned int ySize = 0;
+		unsigned int referenceCount = 0;
 	};
 
-	std::map<char, Glyph> mGlyphs;
-	unsigned int mTextureId = std::numeric_limits<unsigned int>::max();
+	typedef std::pair<const void*, const GlyphCache*> TextureKey;
+	static std::map<TextureKey, GlyphTexture> mGlyphTextures;
 
-	void DoInternalInitialization();
-	GLuint DoGLInitialization();
-	friend RenderWindow;
+	// Windows which render on their own threads use the map concurrently
+	static std::mutex mGlyphTextureMutex;
 
-	bool GenerateGlyphs();
-	bool mGlyphsGenerated = false;
+	void AcquireGlyphs();
+	void ReleaseGlyphTexture();
+	GLuint UpdateGlyphTexture();
 
-	void Initialize();
-	void FreeFTResources();
-	bool mIsOK = true;
+	static std::u32string DecodeUTF8(const std::string& s);
 
 	Eigen::Matrix4d mModelview;
 
@@ -0,0 +1,68 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  mappedFile.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Read-only, memory-mapped view of a file.
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstddef>
+
+namespace LibPlot2D
+{
+
+/// Read-only view of an entire file mapped into the address space of the
+/// process.  Pages are read from disk by the operating system as they are
+/// accessed, so the file may be much larger than the available memory.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// Maps the specified file, closing any previously mapped file.
+	///
+	/// \param fileName Path and name of the file to map.
+	///
+	/// \returns True if the file was mapped successfully.
+	bool Open(const std::string& fileName);
+
+	/// Unmaps the file (if one is mapped).
+	void Close();
+
+	/// Gets a pointer to the start of the mapped file.
+	/// \returns The start of the file, or nullptr if no file is mapped.
+	const unsigned char* GetData() const { return mData; }
+
+	/// Gets the size of the mapped file.
+	/// \returns The size of the file [bytes].
+	std::size_t GetSize() const { return mSize; }
+
+private:
+	const unsigned char* mData = nullptr;
+	std::size_t mSize = 0;
+
+#ifdef _WIN32
+	void* mFileHandle = nullptr;
+	void* mMappingHandle = nullptr;
+#else
+	int mFileDescriptor = -1;
+#endif
+};
+
+}// namespace LibPlot2D
+
+#endif// MAPPED_FILE_H_
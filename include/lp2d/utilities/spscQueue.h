@@ -0,0 +1,162 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  spscQueue.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Bounded, lock-free queue for passing objects from one producer
+//        thread to one consumer thread.
+
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace LibPlot2D
+{
+
+/// Bounded, lock-free queue with a single producer and a single consumer.
+/// Only the producer may call Push() and only the consumer may call Pop();
+/// neither ever blocks.  Objects are moved into and out of a ring buffer,
+/// with the slot indices published using acquire/release ordering.
+template <class T>
+class SpscQueue
+{
+public:
+	/// Constructor.
+	///
+	/// \param capacity Maximum number of objects in the queue.
+	explicit SpscQueue(const std::size_t& capacity);
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	/// Adds an object to the back of the queue.  Called by the producer.
+	///
+	/// \param item Object to add.
+	///
+	/// \returns True if the object was added, false if the queue is full (in
+	///          which case \p item is not modified).
+	bool Push(T&& item);
+
+	/// Removes the object at the front of the queue.  Called by the
+	/// consumer.
+	///
+	/// \param item [out] Object removed from the queue.
+	///
+	/// \returns True if an object was removed, false if the queue is empty.
+	bool Pop(T& item);
+
+	/// Checks to see if the queue is empty.  The result is only a snapshot
+	/// when called from the producer.
+	/// \returns True if the queue is empty.
+	bool IsEmpty() const
+	{ return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire); }
+
+private:
+	// One slot is always left empty to distinguish full from empty
+	std::vector<T> mSlots;
+
+	std::atomic<std::size_t> mHead;// Next slot to read (written by consumer)
+	std::atomic<std::size_t> mTail;// Next slot to write (written by producer)
+
+	std::size_t Next(const std::size_t& index) const
+	{ return (index + 1) % mSlots.size(); }
+};
+
+//=============================================================================
+// Class:			SpscQueue
+// Function:		SpscQueue
+//
+// Description:		Constructor for SpscQueue class.
+//
+// Input Arguments:
+//		capacity	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+template <class T>
+SpscQueue<T>::SpscQueue(const std::size_t& capacity) : mSlots(capacity + 1),
+	mHead(0), mTail(0)
+{
+	assert(capacity > 0);
+}
+
+//=============================================================================
+// Class:			SpscQueue
+// Function:		Push
+//
+// Description:		Moves the specified object into the queue, if there is
+//					room.
+//
+// Input Arguments:
+//		item	= T&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if the queue is full
+//
+//=============================================================================
+template <class T>
+bool SpscQueue<T>::Push(T&& item)
+{
+	const std::size_t tail(mTail.load(std::memory_order_relaxed));
+	const std::size_t next(Next(tail));
+	if (next == mHead.load(std::memory_order_acquire))
+		return false;
+
+	mSlots[tail] = std::move(item);
+	mTail.store(next, std::memory_order_release);
+	return true;
+}
+
+//=============================================================================
+// Class:			SpscQueue
+// Function:		Pop
+//
+// Description:		Moves the object at the front of the queue into the
+//					argument, if the queue is not empty.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		item	= T&
+//
+// Return Value:
+//		bool, true for success, false if the queue is empty
+//
+//=============================================================================
+template <class T>
+bool SpscQueue<T>::Pop(T& item)
+{
+	const std::size_t head(mHead.load(std::memory_order_relaxed));
+	if (head == mTail.load(std::memory_order_acquire))
+		return false;
+
+	item = std::move(mSlots[head]);
+	mSlots[head] = T();// Release any resources held by the moved-from slot
+	mHead.store(Next(head), std::memory_order_release);
+	return true;
+}
+
+}// namespace LibPlot2D
+
+#endif// SPSC_QUEUE_H_
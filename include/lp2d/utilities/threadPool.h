@@ -0,0 +1,92 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  threadPool.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed-size pool of worker threads for executing batches of jobs.
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+// Standard C++ headers
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace LibPlot2D
+{
+
+/// Fixed-size pool of worker threads.  Jobs are executed in the order in
+/// which they are added; callers typically add a batch of independent jobs
+/// and then wait for the whole batch to complete.  ParallelFor() does both,
+/// waiting only for its own jobs, so one pool may be shared by unrelated
+/// callers.
+class ThreadPool
+{
+public:
+	/// Constructor.
+	///
+	/// \param threadCount Number of worker threads to create.
+	explicit ThreadPool(const unsigned int& threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// Adds a job to the queue.  The job will be executed by the first
+	/// available worker thread.
+	///
+	/// \param job Function to execute.
+	void AddJob(std::function<void()> job);
+
+	/// Blocks until all jobs have been executed.
+	void WaitForAllJobsComplete();
+
+	/// Splits the range [0, \p count) into blocks and executes the specified
+	/// work for each block, using the worker threads and the calling thread.
+	/// Returns once all of the blocks are complete.  When called from a
+	/// worker thread (of any pool), the work is executed on the calling
+	/// thread, so nested calls neither deadlock nor add threads.
+	///
+	/// \param count     Number of items in the range.
+	/// \param blockSize Number of items in each block.
+	/// \param work      Function to be called with the beginning and (one
+	///                  past the) end of each block.
+	void ParallelFor(const unsigned int& count, const unsigned int& blockSize,
+		const std::function<void(const unsigned int&, const unsigned int&)>& work);
+
+	/// Gets the number of worker threads in the pool.
+	/// \returns The number of worker threads.
+	unsigned int GetThreadCount() const
+	{ return static_cast<unsigned int>(mThreads.size()); }
+
+private:
+	std::vector<std::thread> mThreads;
+	std::queue<std::function<void()>> mJobs;
+
+	std::mutex mMutex;
+	std::condition_variable mJobReadyCondition;
+	std::condition_variable mJobsCompleteCondition;
+
+	// Number of jobs that have been added but have not finished executing
+	unsigned int mPendingJobs = 0;
+	bool mShuttingDown = false;
+
+	// Set for threads belonging to any pool
+	static thread_local bool mIsWorkerThread;
+
+	void ThreadEntry();
+};
+
+}// namespace LibPlot2D
+
+#endif// THREAD_POOL_H_
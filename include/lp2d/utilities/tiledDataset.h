@@ -0,0 +1,216 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  tiledDataset.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Multi-resolution, on-disk representation of x-y data sets which are
+//        too large to fit in memory.
+
+#ifndef TILED_DATASET_H_
+#define TILED_DATASET_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <cstdint>
+
+// Local headers
+#include "lp2d/utilities/dataset2D.h"
+#include "lp2d/utilities/mappedFile.h"
+
+namespace LibPlot2D
+{
+
+/// Class for browsing x-y data sets which are too large to fit in memory.
+/// The data is stored in a file containing the raw points (sorted by x) and a
+/// pyramid of coarser levels, each of which summarizes groups of records from
+/// the level below with their x-range and the minimum, maximum and mean
+/// y-value.  Each level is divided into fixed-size tiles.  The file is mapped
+/// into memory, and for a given view only the tiles at the coarsest level
+/// that still resolves each pixel column are read.  Tiles which are not yet
+/// cached are read on a worker thread; until they are available, the view is
+/// built from the level above (the coarsest level is always kept in memory).
+/// The file is never read on the thread which updates the view.
+///
+/// The view is exposed as an ordinary Dataset2D containing the minimum and
+/// maximum of each record within the view, and the coarsest level elsewhere
+/// (so the range of the data set as a whole is always represented).  Each
+/// object maintains a single view, so it may only be plotted by one curve at
+/// a time.
+class TiledDataset
+{
+public:
+	TiledDataset() = default;
+	~TiledDataset();
+
+	TiledDataset(const TiledDataset&) = delete;
+	TiledDataset& operator=(const TiledDataset&) = delete;
+
+	/// Function for providing the data to be stored, one chunk at a time.
+	/// Fills the arguments with the next chunk of points (which must continue
+	/// in order of increasing x-value), and returns false when there are no
+	/// more points.
+	typedef std::function<bool(std::vector<double>& x,
+		std::vector<double>& y)> Source;
+
+	/// Creates a tiled data file from the specified source.  Only one chunk
+	/// of points and one record per level are held in memory at a time.  The
+	/// file is written in the native byte order.
+	///
+	/// \param fileName Path and name of the file to create.
+	/// \param source   Function providing the points.
+	///
+	/// \returns True if the file was written successfully.
+	static bool Create(const std::string& fileName, const Source& source);
+
+	/// Opens the specified tiled data file, closing any previously opened
+	/// file.
+	///
+	/// \param fileName Path and name of the file to open.
+	///
+	/// \returns True if the file was opened successfully.
+	bool Open(const std::string& fileName);
+
+	/// Sets the function to be called (from a worker thread) when tiles have
+	/// been read, and a subsequent call to UpdateView() may produce a finer
+	/// view.
+	///
+	/// \param callback Function to call.
+	void SetLoadCallback(std::function<void()> callback);
+
+	/// Sets the maximum number of tiles to keep in memory.
+	///
+	/// \param tiles Number of tiles.
+	void SetCacheSize(const unsigned int& tiles);
+
+	/// Updates the contents of the data set returned by GetData() for the
+	/// specified view.  Reading of tiles required for the view which are not
+	/// yet cached is started, and the load callback is called when complete.
+	///
+	/// \param xMin    Minimum x-value within the view.
+	/// \param xMax    Maximum x-value within the view.
+	/// \param columns Width of the view [pixels].
+	///
+	/// \returns True if the data set was modified.
+	bool UpdateView(const double& xMin, const double& xMax,
+		const unsigned int& columns);
+
+	/// Gets the data set representing the most recent view.
+	/// \returns The data set for the current view.
+	const Dataset2D& GetData() const { return mData; }
+
+	/// Gets the number of points stored in the file.
+	/// \returns The number of raw points.
+	std::uint64_t GetPointCount() const;
+
+	/// Gets the number of levels stored in the file (including the raw
+	/// points).
+	/// \returns The number of levels.
+	unsigned int GetLevelCount() const
+	{ return static_cast<unsigned int>(mLevelSizes.size()); }
+
+	/// \name Accessors for the range of the x-data.
+	/// @{
+
+	double GetXMinimum() const;
+	double GetXMaximum() const;
+
+	/// @}
+
+	/// Summary of a group of consecutive points.  Records at the lowest
+	/// level represent a single point.
+	struct Record
+	{
+		double xMin;///< Minimum x-value.
+		double xMax;///< Maximum x-value.
+		double yMin;///< Minimum (valid) y-value.
+		double yMax;///< Maximum (valid) y-value.
+		double yMean;///< Mean of the valid y-values.
+		double xAtYMin;///< The x-value corresponding to yMin.
+		double xAtYMax;///< The x-value corresponding to yMax.
+		std::uint64_t count;///< Number of valid y-values.
+	};
+
+private:
+	struct FileHeader;
+	class PyramidWriter;
+
+	MappedFile mFile;
+	unsigned int mTileSize = 0;
+	std::vector<std::uint64_t> mLevelOffsets;// [bytes]
+	std::vector<std::uint64_t> mLevelSizes;// [records]
+
+	// The coarsest level is always in memory
+	std::vector<Record> mTopLevel;
+
+	// Tiles read from the finer levels, keyed by level and tile index
+	typedef std::pair<unsigned int, std::uint64_t> TileKey;
+	struct Tile
+	{
+		std::vector<Record> records;
+		std::uint64_t lastUsed;
+	};
+
+	std::map<TileKey, Tile> mTiles;
+	std::uint64_t mUseCounter = 0;
+	unsigned int mCacheSize = mDefaultCacheSize;
+
+	// Protects mTiles and mUseCounter, which are modified by the worker
+	std::mutex mMutex;
+	std::future<void> mLoad;
+	std::function<void()> mLoadCallback;
+
+	Dataset2D mData;
+
+	// Inputs for the current contents of mData
+	bool mViewValid = false;
+	double mViewXMin = 0.0;
+	double mViewXMax = 0.0;
+	unsigned int mViewColumns = 0;
+	unsigned int mViewLevel = 0;
+
+	Record ReadRecord(const unsigned int& level,
+		const std::uint64_t& index) const;
+	const Record& GetCachedRecord(const unsigned int& level,
+		const std::uint64_t& index) const;
+	void FindRange(const unsigned int& level, const double& xMin,
+		const double& xMax, const std::uint64_t& start,
+		const std::uint64_t& end, std::uint64_t& first,
+		std::uint64_t& last) const;
+	bool TilesAreCached(const unsigned int& level, const std::uint64_t& first,
+		const std::uint64_t& last);
+	void RequestTiles(const unsigned int& level, const std::uint64_t& first,
+		const std::uint64_t& last);
+	void CacheTile(const TileKey& key, std::vector<Record>&& records);
+	void BuildData(const unsigned int& level, const std::uint64_t& first,
+		const std::uint64_t& last);
+
+	static void AppendRecord(const Record& record, std::vector<double>& x,
+		std::vector<double>& y);
+	static std::size_t GetRecordSize(const unsigned int& level);
+	static std::uint64_t RecordsToPoints(const unsigned int& level,
+		const std::uint64_t& records);
+
+	static const char mMagic[8];
+	static const std::uint32_t mVersion;
+	static const unsigned int mLevelFactor;
+	static const unsigned int mDefaultTileSize;
+	static const unsigned int mMaxLevels;
+	static const unsigned int mMinCacheSize;
+	static const unsigned int mDefaultCacheSize;
+	static const unsigned int mPointsPerColumn;
+};
+
+}// namespace LibPlot2D
+
+#endif// TILED_DATASET_H_
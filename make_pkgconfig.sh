@@ -33,7 +33,7 @@ echo Name: LibPlot2D>> $outputFile
 echo URL: https://github.com/KerryL/LibPlot2D>> $outputFile
 echo Description: Lightweight 2D plotting library.>> $outputFile
 echo Version: $version>> $outputFile
-echo Requires: freetype2,glew,gl>> $outputFile
+echo Requires: freetype2,glew,gl,egl>> $outputFile
 echo Requires.private: >> $outputFile
 echo Libs: -L\${libdir} -l$libName `wx-config --version=3.1 $debug_flag --libs all`>> $outputFile
 echo Libs.private: >> $outputFile
@@ -20,12 +20,18 @@
 #include "lp2d/renderer/plotRenderer.h"
 #include "lp2d/renderer/color.h"
 #include "lp2d/renderer/primitives/plotCurve.h"
+#include "lp2d/renderer/primitives/curveBatch.h"
 #include "lp2d/renderer/primitives/textRendering.h"
 #include "lp2d/renderer/primitives/legend.h"
 #include "lp2d/utilities/math/plotMath.h"
 #include "lp2d/utilities/dataset2D.h"
+#include "lp2d/utilities/tiledDataset.h"
 #include "lp2d/utilities/fontFinder.h"
 
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+
 namespace LibPlot2D
 {
 
@@ -100,6 +106,8 @@ void PlotObject::CreateAxisObjects()
 	mAxisLeft = new Axis(mRenderer);
 	mAxisRight = new Axis(mRenderer);
 	mTitleObject = new TextRendering(mRenderer);
+	mLeftBatch = new CurveBatch(mRenderer);
+	mRightBatch = new CurveBatch(mRenderer);
 
 	// Tell each axis how they relate to other axes
 	mAxisTop->SetAxisAtMaxEnd(mAxisRight);
@@ -192,6 +200,9 @@ void PlotObject::InitializeFonts()
 //=============================================================================
 void PlotObject::Update()
 {
+	// Formatting modifies the axes and curves
+	assert(mRenderer.IsSceneModifiable());
+
 	FormatPlot();
 	ComputeTransformationMatrices();
 
@@ -451,10 +462,19 @@ void PlotObject::RemoveExistingPlots()
 //=============================================================================
 void PlotObject::RemovePlot(const unsigned int &index)
 {
+	mLeftBatch->RemoveCurve(mPlotList[index]);
+	mRightBatch->RemoveCurve(mPlotList[index]);
 	mRenderer.RemoveActor(mPlotList[index]);
 
+	// Data sets for curves drawing copies are released by the renderer when
+	// the removal is requested, so they may already have been destroyed
+	if (mTiledList[index] && !mCopyList[index])
+		mTiledList[index]->SetLoadCallback(nullptr);
+
 	mPlotList.erase(mPlotList.begin() + index);
 	mDataList.erase(mDataList.begin() + index);
+	mTiledList.erase(mTiledList.begin() + index);
+	mCopyList.erase(mCopyList.begin() + index);
 }
 
 //=============================================================================
@@ -478,11 +498,99 @@ void PlotObject::AddCurve(const Dataset2D &data)
 	PlotCurve *newPlot = new PlotCurve(mRenderer, data);
 	mPlotList.push_back(newPlot);
 	mDataList.push_back(&data);
+	mTiledList.push_back(nullptr);
+	mCopyList.push_back(nullptr);
 
 	newPlot->BindToXAxis(mAxisBottom);
 	newPlot->BindToYAxis(mAxisLeft);
 }
 
+//=============================================================================
+// Class:			PlotObject
+// Function:		AddCurve
+//
+// Description:		Adds an out-of-core curve to the plot.  The data set
+//					initially contains the coarsest level of the whole file,
+//					which is sufficient for determining the axis limits.
+//
+// Input Arguments:
+//		data	= TiledDataset& to plot
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::AddCurve(TiledDataset &data)
+{
+	PrepareTiledDataset(data);
+	AddCurve(data.GetData());
+	mTiledList.back() = &data;
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		AddCurve
+//
+// Description:		Adds a curve which draws a copy of the caller's data.  The
+//					curve shares ownership of the copy.
+//
+// Input Arguments:
+//		data	= std::shared_ptr<Dataset2D> to plot
+//		tiled	= TiledDataset* from which the copy was made (may be
+//				  nullptr)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::AddCurve(std::shared_ptr<Dataset2D> data,
+	TiledDataset* tiled)
+{
+	AddCurve(*data);
+	mTiledList.back() = tiled;
+	mCopyList.back() = std::move(data);
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		PrepareTiledDataset
+//
+// Description:		Builds the initial view of an out-of-core data set (the
+//					coarsest level of the whole file, which is sufficient for
+//					determining the axis limits) and requests an update
+//					whenever finer tiles are read.
+//
+// Input Arguments:
+//		data	= TiledDataset& to prepare
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::PrepareTiledDataset(TiledDataset &data)
+{
+	data.UpdateView(data.GetXMinimum(), data.GetXMaximum(),
+		mAxisBottom->GetAxisLength());
+
+	PlotRenderer& renderer(mRenderer);
+	data.SetLoadCallback([&renderer]()
+	{
+		renderer.CallAfter([&renderer]()
+		{
+			renderer.ScheduleUpdate(false);
+		});
+	});
+}
+
 //=============================================================================
 // Class:			PlotObject
 // Function:		FormatPlot
@@ -548,6 +656,7 @@ void PlotObject::FormatPlot()
 	ResetOriginalLimits();
 	ApplyRangeLimits(xMinor, xMajor, yLeftMinor, yLeftMajor, yRightMinor, yRightMajor);
 	UpdateLimitValues();
+	UpdateTiledCurves();
 
 	if (mNeedScissorUpdate)
 	{
@@ -831,8 +940,8 @@ void PlotObject::FormatTitle()
 {
 	mTitleObject->SetCentered(true);
 	mTitleObject->SetPosition(mAxisLeft->GetOffsetFromWindowEdge()
-		+ (mRenderer.GetSize().GetWidth() - mAxisLeft->GetOffsetFromWindowEdge() - mAxisRight->GetOffsetFromWindowEdge()) / 2.0,
-		mRenderer.GetSize().GetHeight() - mAxisTop->GetOffsetFromWindowEdge() / 2.0);
+		+ (mRenderer.GetRenderSize().GetWidth() - mAxisLeft->GetOffsetFromWindowEdge() - mAxisRight->GetOffsetFromWindowEdge()) / 2.0,
+		mRenderer.GetRenderSize().GetHeight() - mAxisTop->GetOffsetFromWindowEdge() / 2.0);
 }
 
 //=============================================================================
@@ -1732,6 +1841,112 @@ void PlotObject::SetCurveProperties(const unsigned int &index, const Color &colo
 		mPlotList[index]->BindToYAxis(mAxisLeft);
 }
 
+//=============================================================================
+// Class:			PlotObject
+// Function:		SetCurveDataModified
+//
+// Description:		Indicates that the data for the specified curve has been
+//					modified in place.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::SetCurveDataModified(const unsigned int &index)
+{
+	mPlotList[index]->SetDataModified();
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		SetCurveDataModified
+//
+// Description:		Replaces the copy of the data drawn by the specified
+//					curve.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//		data	= Dataset2D
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::SetCurveDataModified(const unsigned int &index,
+	Dataset2D data)
+{
+	assert(mCopyList[index]);
+
+	// The curve references the copy, so it is replaced in place
+	*mCopyList[index] = std::move(data);
+	mPlotList[index]->SetDataModified();
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		SetCurveDataAppended
+//
+// Description:		Indicates that points have been added to the end of the
+//					data for the specified curve.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::SetCurveDataAppended(const unsigned int &index)
+{
+	mPlotList[index]->SetDataAppended();
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		SetCurveDataAppended
+//
+// Description:		Adds points to the end of the copy of the data drawn by
+//					the specified curve.
+//
+// Input Arguments:
+//		index		= const unsigned int&
+//		appended	= const Dataset2D& containing the new points
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::SetCurveDataAppended(const unsigned int &index,
+	const Dataset2D& appended)
+{
+	assert(mCopyList[index]);
+
+	Dataset2D& data(*mCopyList[index]);
+	const std::vector<double>::size_type start(data.GetNumberOfPoints());
+	data.Resize(start + appended.GetNumberOfPoints());
+	std::copy(appended.GetX().begin(), appended.GetX().end(),
+		data.GetX().begin() + start);
+	std::copy(appended.GetY().begin(), appended.GetY().end(),
+		data.GetY().begin() + start);
+
+	mPlotList[index]->SetDataAppended();
+}
+
 //=============================================================================
 // Class:			PlotObject
 // Function:		SetMajorGrid
@@ -2079,10 +2294,66 @@ void PlotObject::SetRightLogarithmic(const bool &log)
 //=============================================================================
 void PlotObject::FormatCurves()
 {
+	// Curves compare the view against their previous build, so only the
+	// geometry affected by the new axis limits is rebuilt
+	std::vector<PlotCurve*> leftCurves;
+	std::vector<PlotCurve*> rightCurves;
 	for (auto& plot : mPlotList)
 	{
-		plot->SetModified();
+		plot->Invalidate(Primitive::Change::Transform);
 		plot->SetPretty(mPretty);
+		plot->SetResident(mResident);
+		plot->SetShaderLines(mShaderLines);
+		plot->SetPreview(mProgressive && mPreview);
+		plot->SetPreviewPointBudget(mPreviewPointBudget);
+		plot->SetBackgroundRefinement(mProgressive);
+		plot->SetDensity(mDensity);
+
+		if (!mBatchCurves)
+			continue;
+
+		if (plot->GetYAxis() == mAxisRight)
+			rightCurves.push_back(plot);
+		else
+			leftCurves.push_back(plot);
+	}
+
+	// The batches are only invalidated if the membership has changed
+	mLeftBatch->SetCurves(leftCurves);
+	mRightBatch->SetCurves(rightCurves);
+}
+
+//=============================================================================
+// Class:			PlotObject
+// Function:		UpdateTiledCurves
+//
+// Description:		Rebuilds the data for out-of-core curves for the current
+//					x-axis limits.  Curves are only invalidated if the data
+//					actually changed (i.e. the view changed, or finer tiles
+//					became available).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotObject::UpdateTiledCurves()
+{
+	unsigned int i;
+	for (i = 0; i < mTiledList.size(); ++i)
+	{
+		if (!mTiledList[i] || !mTiledList[i]->UpdateView(mXMin, mXMax,
+			mAxisBottom->GetAxisLength()))
+			continue;
+
+		if (mCopyList[i])
+			*mCopyList[i] = mTiledList[i]->GetData();
+		mPlotList[i]->Invalidate(Primitive::Change::Data);
 	}
 }
 
@@ -2224,8 +2495,8 @@ void PlotObject::ComputeTransformationMatrices()
 		mAxisLeft->GetOffsetFromWindowEdge(),
 		mAxisBottom->GetOffsetFromWindowEdge(), 0.0));
 
-	int width, height;
-	mRenderer.GetSize(&width, &height);
+	const int width(mRenderer.GetRenderSize().GetWidth());
+	const int height(mRenderer.GetRenderSize().GetHeight());
 
 	const double plotAreaWidth{ static_cast<double>(
 		width - mAxisLeft->GetOffsetFromWindowEdge()
@@ -2262,8 +2533,8 @@ void PlotObject::ComputeTransformationMatrices()
 // Class:			PlotObject
 // Function:		UpdateScissorArea
 //
-// Description:		Updates the scissor buffer according to the size of the
-//					plot area.
+// Description:		Updates the scissor area (applied by the renderer) according
+//					to the size of the plot area.
 //
 // Input Arguments:
 //		None
@@ -2277,19 +2548,12 @@ void PlotObject::ComputeTransformationMatrices()
 //=============================================================================
 void PlotObject::UpdateScissorArea() const
 {
-	assert(!RenderWindow::GLHasError());
-
-	int width, height;
-	mRenderer.GetSize(&width, &height);
-	glEnable(GL_SCISSOR_TEST);
-	glScissor(mAxisLeft->GetOffsetFromWindowEdge(),
+	const int width(mRenderer.GetRenderSize().GetWidth());
+	const int height(mRenderer.GetRenderSize().GetHeight());
+	mRenderer.SetScissorArea(wxRect(mAxisLeft->GetOffsetFromWindowEdge(),
 		mAxisBottom->GetOffsetFromWindowEdge(),
 		width - mAxisRight->GetOffsetFromWindowEdge() - mAxisLeft->GetOffsetFromWindowEdge(),
-		height - mAxisTop->GetOffsetFromWindowEdge() - mAxisBottom->GetOffsetFromWindowEdge());
-
-	glDisable(GL_SCISSOR_TEST);
-
-	assert(!RenderWindow::GLHasError());
+		height - mAxisTop->GetOffsetFromWindowEdge() - mAxisBottom->GetOffsetFromWindowEdge()));
 }
 
 //=============================================================================
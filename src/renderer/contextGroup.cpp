@@ -0,0 +1,545 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  contextGroup.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Group of render windows whose OpenGL contexts share objects, with an
+//        optional on-disk cache of linked program binaries.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/contextGroup.h"
+
+// Standard C++ headers
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for ContextGroup class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const char ContextGroup::mCacheMagic[8] = { 'L', 'P', '2', 'D', 'P', 'R', 'O', 'G' };
+const std::uint32_t ContextGroup::mCacheVersion(1);
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		~ContextGroup
+//
+// Description:		Destructor for ContextGroup class.  Writes the program
+//					cache, if necessary.  All windows have been removed from
+//					the group by this point (they hold references to it).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+ContextGroup::~ContextGroup()
+{
+	assert(mContexts.empty());
+	SaveProgramCache();
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		SetProgramCacheFile
+//
+// Description:		Sets the file used to store program binaries.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ContextGroup::SetProgramCacheFile(const std::string& fileName)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCacheFileName = fileName;
+	mCacheLoaded = false;
+	mCacheModified = false;
+	mProgramBinaries.clear();
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		SaveProgramCache
+//
+// Description:		Writes the program binaries to the cache file, if any
+//					were added since it was read.  The binaries are tagged
+//					with the driver which created them.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool ContextGroup::SaveProgramCache()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (!mCacheModified)
+		return true;
+
+	std::ofstream file(mCacheFileName.c_str(),
+		std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	const std::uint32_t driverLength(static_cast<std::uint32_t>(
+		mDriverName.size()));
+	const std::uint32_t count(static_cast<std::uint32_t>(
+		mProgramBinaries.size()));
+
+	file.write(mCacheMagic, sizeof(mCacheMagic));
+	file.write(reinterpret_cast<const char*>(&mCacheVersion),
+		sizeof(mCacheVersion));
+	file.write(reinterpret_cast<const char*>(&driverLength),
+		sizeof(driverLength));
+	file.write(mDriverName.data(), driverLength);
+	file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+	for (const auto& entry : mProgramBinaries)
+	{
+		const std::uint32_t format(entry.second.format);
+		const std::uint32_t size(static_cast<std::uint32_t>(
+			entry.second.data.size()));
+		file.write(reinterpret_cast<const char*>(&entry.first),
+			sizeof(entry.first));
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		file.write(entry.second.data.data(), size);
+	}
+
+	if (!file.good())
+		return false;
+
+	mCacheModified = false;
+	return true;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		CreateContext
+//
+// Description:		Creates a context for the specified window which shares
+//					objects with the existing contexts in the group.
+//
+// Input Arguments:
+//		window		= RenderWindow&
+//		attributes	= const wxGLContextAttrs&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxGLContext*, owned by the caller
+//
+//=============================================================================
+wxGLContext* ContextGroup::CreateContext(RenderWindow& window,
+	const wxGLContextAttrs& attributes)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	wxGLContext* shareWith(mContexts.empty() ? nullptr : mContexts.front());
+	wxGLContext* context(new wxGLContext(&window, shareWith, &attributes));
+	mContexts.push_back(context);
+
+	return context;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		RemoveContext
+//
+// Description:		Removes the specified window's context from the group,
+//					prior to its destruction.  When the last context is
+//					removed, the shared objects are destroyed along with it,
+//					so they are forgotten here.
+//
+// Input Arguments:
+//		window	= const RenderWindow&
+//		context	= wxGLContext*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ContextGroup::RemoveContext(const RenderWindow& window,
+	wxGLContext* context)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mContexts.erase(std::remove(mContexts.begin(), mContexts.end(), context),
+		mContexts.end());
+
+	if (mProgramOwner == &window)
+		mProgramOwner = nullptr;
+
+	if (mContexts.empty())
+	{
+		mPrograms.clear();
+		mIndexBuffers.clear();
+	}
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		ClaimPrograms
+//
+// Description:		Records that the specified window is about to set uniform
+//					values in the shared programs.
+//
+// Input Arguments:
+//		window	= const RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if another window set the values most recently (so the
+//		window's values must be sent again)
+//
+//=============================================================================
+bool ContextGroup::ClaimPrograms(const RenderWindow& window)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mProgramOwner == &window)
+		return false;
+
+	mProgramOwner = &window;
+	return true;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		FindProgram
+//
+// Description:		Looks up a program previously built by a window in the
+//					group.
+//
+// Input Arguments:
+//		name	= const std::string&
+//
+// Output Arguments:
+//		shader	= RenderWindow::ShaderInfo&
+//
+// Return Value:
+//		bool, true if the program was found
+//
+//=============================================================================
+bool ContextGroup::FindProgram(const std::string& name,
+	RenderWindow::ShaderInfo& shader)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	const auto it(mPrograms.find(name));
+	if (it == mPrograms.end())
+		return false;
+
+	shader = it->second;
+	return true;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		AddProgram
+//
+// Description:		Makes the specified program available to the other
+//					windows in the group.
+//
+// Input Arguments:
+//		name	= const std::string&
+//		shader	= const RenderWindow::ShaderInfo&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ContextGroup::AddProgram(const std::string& name,
+	const RenderWindow::ShaderInfo& shader)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPrograms[name] = shader;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		UsesProgramCache
+//
+// Description:		Checks to see if program binaries should be loaded and
+//					stored, reading the cache file the first time it is
+//					called.  A context in the group must be current.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the program cache is in use
+//
+//=============================================================================
+bool ContextGroup::UsesProgramCache()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCacheFileName.empty())
+		return false;
+
+	if (!mCacheLoaded)
+	{
+		mCacheLoaded = true;
+
+		GLint formatCount(0);
+		if (GLEW_ARB_get_program_binary)
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		mCacheSupported = formatCount > 0;
+
+		if (mCacheSupported)
+		{
+			mDriverName = std::string(reinterpret_cast<const char*>(
+				glGetString(GL_VENDOR))) + "/" + reinterpret_cast<const char*>(
+				glGetString(GL_RENDERER)) + "/" + reinterpret_cast<const char*>(
+				glGetString(GL_VERSION));
+			ReadProgramCache();
+		}
+
+		assert(!RenderWindow::GLHasError());
+	}
+
+	return mCacheSupported;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		LoadProgram
+//
+// Description:		Creates a program from the cached binary with the
+//					specified key.  Binaries which the driver rejects are
+//					removed from the cache.
+//
+// Input Arguments:
+//		key	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint, program id, or zero if the program is not cached
+//
+//=============================================================================
+GLuint ContextGroup::LoadProgram(const std::uint64_t& key)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	const auto it(mProgramBinaries.find(key));
+	if (it == mProgramBinaries.end())
+		return 0;
+
+	GLuint program(glCreateProgram());
+	glProgramBinary(program, it->second.format, it->second.data.data(),
+		static_cast<GLsizei>(it->second.data.size()));
+
+	GLint status;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status == GL_FALSE)
+	{
+		glDeleteProgram(program);
+		mProgramBinaries.erase(it);
+		mCacheModified = true;
+		program = 0;
+	}
+
+	// A rejected binary is not an error for our purposes
+	glGetError();
+	return program;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		StoreProgram
+//
+// Description:		Adds the binary of the specified (linked) program to the
+//					cache.
+//
+// Input Arguments:
+//		key		= const std::uint64_t&
+//		program	= const GLuint&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ContextGroup::StoreProgram(const std::uint64_t& key, const GLuint& program)
+{
+	GLint length(0);
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	ProgramBinary binary;
+	binary.data.resize(length);
+	glGetProgramBinary(program, length, nullptr, &binary.format,
+		binary.data.data());
+	assert(!RenderWindow::GLHasError());
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mProgramBinaries[key] = std::move(binary);
+	mCacheModified = true;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		ReadProgramCache
+//
+// Description:		Reads the program binaries from the cache file.  Files
+//					written by a different driver (or which are invalid) are
+//					ignored, and will be replaced when the cache is saved.
+//					Must be called with mMutex locked.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the binaries were read
+//
+//=============================================================================
+bool ContextGroup::ReadProgramCache()
+{
+	std::ifstream file(mCacheFileName.c_str(), std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	char magic[sizeof(mCacheMagic)];
+	std::uint32_t version, driverLength, count;
+	file.read(magic, sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&driverLength), sizeof(driverLength));
+	if (!file.good() || std::memcmp(magic, mCacheMagic, sizeof(magic)) != 0
+		|| version != mCacheVersion || driverLength != mDriverName.size())
+		return false;
+
+	std::string driverName(driverLength, '\0');
+	file.read(&driverName[0], driverLength);
+	file.read(reinterpret_cast<char*>(&count), sizeof(count));
+	if (!file.good() || driverName != mDriverName)
+		return false;
+
+	std::unordered_map<std::uint64_t, ProgramBinary> binaries;
+	std::uint32_t i;
+	for (i = 0; i < count; ++i)
+	{
+		std::uint64_t key;
+		std::uint32_t format, size;
+		file.read(reinterpret_cast<char*>(&key), sizeof(key));
+		file.read(reinterpret_cast<char*>(&format), sizeof(format));
+		file.read(reinterpret_cast<char*>(&size), sizeof(size));
+		if (!file.good())
+			return false;
+
+		ProgramBinary& binary(binaries[key]);
+		binary.format = format;
+		binary.data.resize(size);
+		file.read(binary.data.data(), size);
+		if (!file.good())
+			return false;
+	}
+
+	mProgramBinaries.swap(binaries);
+	return true;
+}
+
+//=============================================================================
+// Class:			ContextGroup
+// Function:		ComputeProgramKey
+//
+// Description:		Computes a key identifying the program built from the
+//					specified shaders (64-bit FNV-1a hash of the shader types
+//					and sources, which is stable between runs).
+//
+// Input Arguments:
+//		shaders	= const std::vector<std::pair<GLenum, std::string>>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//=============================================================================
+std::uint64_t ContextGroup::ComputeProgramKey(
+	const std::vector<std::pair<GLenum, std::string>>& shaders)
+{
+	std::uint64_t hash(14695981039346656037ULL);
+	const auto add([&hash](const unsigned char& c)
+	{
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	});
+
+	for (const auto& shader : shaders)
+	{
+		unsigned int i;
+		for (i = 0; i < sizeof(shader.first); ++i)
+			add(static_cast<unsigned char>(shader.first >> (8 * i)));
+
+		for (const auto& c : shader.second)
+			add(static_cast<unsigned char>(c));
+		add(0);
+	}
+
+	return hash;
+}
+
+}// namespace LibPlot2D
@@ -0,0 +1,512 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  densityMap.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Helper class for rendering the density of large sets of points as a
+//        color-mapped, screen-resolution histogram.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/densityMap.h"
+#include "lp2d/renderer/renderWindow.h"
+#include "lp2d/utilities/threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <mutex>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for DensityMap class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string DensityMap::mExtentName("extent");
+const std::string DensityMap::mBinsName("bins");
+const std::string DensityMap::mLogMaximumName("logMaximum");
+const std::string DensityMap::mColorMapName("colorMap");
+const std::string DensityMap::mColorMapSizeName("colorMapSize");
+
+const unsigned int DensityMap::mMinPointsPerBlock(1000000);
+const unsigned int DensityMap::mMaxColorMapSize(8);
+
+// Perceptually uniform (dark blue through green to yellow)
+const std::vector<Color> DensityMap::mDefaultColorMap({
+	Color(0.267, 0.004, 0.329),
+	Color(0.231, 0.322, 0.545),
+	Color(0.129, 0.569, 0.549),
+	Color(0.369, 0.788, 0.384),
+	Color(0.992, 0.906, 0.145)});
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		mVertexShader
+//
+// Description:		Density map vertex shader.  Draws a triangle strip of four
+//					vertices covering the bins; no attributes are required.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		binCoordinate	= vec2
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string DensityMap::mVertexShader(
+	"#version 400\n"
+	"\n"
+	"uniform mat4 modelviewMatrix;\n"
+	"uniform mat4 projectionMatrix;\n"
+	"uniform vec2 extent;\n"
+	"\n"
+	"out vec2 binCoordinate;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    binCoordinate = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);\n"
+	"    gl_Position = projectionMatrix * modelviewMatrix * vec4(binCoordinate * extent, 0.0, 1.0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		mFragmentShader
+//
+// Description:		Density map fragment shader.  Looks up the count for the
+//					bin under each fragment and maps it to a color.  Empty
+//					bins are discarded.
+//
+// Input Arguments:
+//		binCoordinate	= vec2
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string DensityMap::mFragmentShader(
+	"#version 400\n"
+	"\n"
+	"uniform usampler2D bins;\n"
+	"uniform float logMaximum;\n"
+	"uniform vec4 colorMap[8];\n"
+	"uniform int colorMapSize;\n"
+	"\n"
+	"in vec2 binCoordinate;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    ivec2 size = textureSize(bins, 0);\n"
+	"    uint count = texelFetch(bins, min(ivec2(binCoordinate * vec2(size)), size - 1), 0).r;\n"
+	"    if (count == 0u)\n"
+	"        discard;\n"
+	"\n"
+	"    float level = logMaximum > 0.0 ? log(float(count)) / logMaximum : 0.0;\n"
+	"    float position = level * float(colorMapSize - 1);\n"
+	"    int i = min(int(position), colorMapSize - 2);\n"
+	"    outputColor = mix(colorMap[i], colorMap[i + 1], position - float(i));\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		DensityMap
+//
+// Description:		Constructor for DensityMap class.
+//
+// Input Arguments:
+//		renderWindow	= RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+DensityMap::DensityMap(RenderWindow& renderWindow)
+	: mRenderWindow(renderWindow), mColorMap(mDefaultColorMap)
+{
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		~DensityMap
+//
+// Description:		Destructor for DensityMap class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+DensityMap::~DensityMap()
+{
+	if (mTexture != 0)
+	{
+		glDeleteTextures(1, &mTexture);
+		glDeleteVertexArrays(1, &mVertexArray);
+	}
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		SetColorMap
+//
+// Description:		Sets the colors to which bin counts are mapped.
+//
+// Input Arguments:
+//		colorMap	= const std::vector<Color>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void DensityMap::SetColorMap(const std::vector<Color>& colorMap)
+{
+	assert(colorMap.size() >= 2 && colorMap.size() <= mMaxColorMapSize);
+	mColorMap = colorMap;
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		Build
+//
+// Description:		Counts the points in each bin.  Large sets of points are
+//					split into blocks on the shared thread pool (at most one
+//					per thread).  Each block counts into its own set of bins,
+//					which is then added to the totals.
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		count	= const std::size_t&
+//		stride	= const unsigned int&
+//		extents	= const Extents&
+//		force	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the bins were updated
+//
+//=============================================================================
+bool DensityMap::Build(const double* x, const double* y,
+	const std::size_t& count, const unsigned int& stride,
+	const Extents& extents, const bool& force)
+{
+	assert(stride > 0);
+
+	if (!force && x == mX && y == mY && count == mCount && stride == mStride &&
+		ExtentsMatch(extents, mExtents))
+		return false;
+
+	mX = x;
+	mY = y;
+	mCount = count;
+	mStride = stride;
+	mExtents = extents;
+
+	const std::size_t binCount(static_cast<std::size_t>(extents.columns) * extents.rows);
+	mBins.assign(binCount, 0);
+	mMaximumCount = 0;
+	if (binCount == 0 || count == 0)
+		return true;
+
+	ThreadPool& pool(RenderWindow::GetThreadPool());
+	const std::size_t samples((count + stride - 1) / stride);
+	const std::size_t blockSize(std::max(std::max<std::size_t>(
+		mMinPointsPerBlock, binCount), samples / (pool.GetThreadCount() + 1) + 1));
+
+	if (samples <= blockSize)
+		CountPoints(x, y, 0, samples, stride, extents, mBins);
+	else
+	{
+		std::mutex binMutex;
+		pool.ParallelFor(static_cast<unsigned int>(samples),
+			static_cast<unsigned int>(blockSize), [this, x, y, &stride,
+			&extents, &binCount, &binMutex](const unsigned int& begin,
+			const unsigned int& end)
+		{
+			std::vector<unsigned int> blockBins(binCount, 0);
+			CountPoints(x, y, begin, end, stride, extents, blockBins);
+
+			std::lock_guard<std::mutex> lock(binMutex);
+			std::transform(mBins.begin(), mBins.end(), blockBins.begin(),
+				mBins.begin(), std::plus<unsigned int>());
+		});
+	}
+
+	mMaximumCount = *std::max_element(mBins.begin(), mBins.end());
+	return true;
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		CountPoints
+//
+// Description:		Counts the points with sample indices in the specified
+//					range.  Points which are not finite or which lie outside
+//					of the bins are ignored.
+//
+// Input Arguments:
+//		x		= const double*
+//		y		= const double*
+//		begin	= const std::size_t&
+//		end		= const std::size_t&
+//		stride	= const unsigned int&
+//		extents	= const Extents&
+//
+// Output Arguments:
+//		bins	= std::vector<unsigned int>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void DensityMap::CountPoints(const double* x, const double* y,
+	const std::size_t& begin, const std::size_t& end,
+	const unsigned int& stride, const Extents& extents,
+	std::vector<unsigned int>& bins)
+{
+	const double xFactor(1.0 / extents.xScale);
+	const double yFactor(1.0 / extents.yScale);
+
+	std::size_t i;
+	for (i = begin; i < end; ++i)
+	{
+		const double column((x[i * stride] - extents.xMinimum) * xFactor);
+		const double row((y[i * stride] - extents.yMinimum) * yFactor);
+
+		// Written so that NaNs fail the test
+		if (!(column >= 0.0 && column < extents.columns &&
+			row >= 0.0 && row < extents.rows))
+			continue;
+
+		++bins[static_cast<std::size_t>(row) * extents.columns
+			+ static_cast<std::size_t>(column)];
+	}
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		ExtentsMatch
+//
+// Description:		Checks to see if the specified extents are identical.
+//
+// Input Arguments:
+//		a	= const Extents&
+//		b	= const Extents&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the extents match
+//
+//=============================================================================
+bool DensityMap::ExtentsMatch(const Extents& a, const Extents& b)
+{
+	return a.xMinimum == b.xMinimum &&
+		a.yMinimum == b.yMinimum &&
+		a.xScale == b.xScale &&
+		a.yScale == b.yScale &&
+		a.columns == b.columns &&
+		a.rows == b.rows;
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		Upload
+//
+// Description:		Sends the bins to OpenGL as an integer texture.  The
+//					storage is only reallocated when the number of bins
+//					changes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void DensityMap::Upload()
+{
+	if (mBins.empty())
+		return;
+
+	if (mTexture == 0)
+	{
+		glGenTextures(1, &mTexture);
+		glBindTexture(GL_TEXTURE_2D, mTexture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+		// Core profiles require a vertex array to be bound for drawing, even
+		// without any attributes
+		glGenVertexArrays(1, &mVertexArray);
+	}
+	else
+		glBindTexture(GL_TEXTURE_2D, mTexture);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	if (mTextureColumns != mExtents.columns || mTextureRows != mExtents.rows)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, mExtents.columns,
+			mExtents.rows, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, mBins.data());
+		mTextureColumns = mExtents.columns;
+		mTextureRows = mExtents.rows;
+	}
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mExtents.columns,
+			mExtents.rows, GL_RED_INTEGER, GL_UNSIGNED_INT, mBins.data());
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		Draw
+//
+// Description:		Renders the bins.
+//
+// Input Arguments:
+//		modelview	= const Eigen::Matrix4d&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void DensityMap::Draw(const Eigen::Matrix4d& modelview)
+{
+	if (mTexture == 0 || mMaximumCount == 0)
+		return;
+
+	mRenderWindow.InitializePrimitiveType(*this);
+	mRenderWindow.UseProgram(mRenderWindow.GetPrimitiveTypeProgram<DensityMap>());
+	const auto& uniforms(mRenderWindow.GetActiveProgramInfo().uniformLocations);
+
+	RenderWindow::SendUniformMatrix(modelview,
+		uniforms.find(RenderWindow::mModelviewName)->second);
+	glUniform2f(uniforms.find(mExtentName)->second,
+		static_cast<GLfloat>(mExtents.xScale * mExtents.columns),
+		static_cast<GLfloat>(mExtents.yScale * mExtents.rows));
+	glUniform1i(uniforms.find(mBinsName)->second, 0);
+	glUniform1f(uniforms.find(mLogMaximumName)->second,
+		static_cast<GLfloat>(log(static_cast<double>(mMaximumCount))));
+
+	std::vector<GLfloat> colors;
+	for (const auto& c : mColorMap)
+	{
+		colors.push_back(static_cast<GLfloat>(c.GetRed()));
+		colors.push_back(static_cast<GLfloat>(c.GetGreen()));
+		colors.push_back(static_cast<GLfloat>(c.GetBlue()));
+		colors.push_back(static_cast<GLfloat>(c.GetAlpha()));
+	}
+	glUniform4fv(uniforms.find(mColorMapName)->second,
+		static_cast<GLsizei>(mColorMap.size()), colors.data());
+	glUniform1i(uniforms.find(mColorMapSizeName)->second,
+		static_cast<GLint>(mColorMap.size()));
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, mTexture);
+	glBindVertexArray(mVertexArray);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	mRenderWindow.UseDefaultProgram();
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			DensityMap
+// Function:		DoGLInitialization
+//
+// Description:		Performs necessary context-state initialization.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint DensityMap::DoGLInitialization()
+{
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mFragmentShader));
+
+	RenderWindow::ShaderInfo s;
+	s.programId = mRenderWindow.BuildProgram(shaders);
+	s.needsModelview = false;
+	s.needsProjection = true;
+	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
+	s.uniformLocations[RenderWindow::mModelviewName] = glGetUniformLocation(s.programId, RenderWindow::mModelviewName.c_str());
+	s.uniformLocations[mExtentName] = glGetUniformLocation(s.programId, mExtentName.c_str());
+	s.uniformLocations[mBinsName] = glGetUniformLocation(s.programId, mBinsName.c_str());
+	s.uniformLocations[mLogMaximumName] = glGetUniformLocation(s.programId, mLogMaximumName.c_str());
+	s.uniformLocations[mColorMapName] = glGetUniformLocation(s.programId, mColorMapName.c_str());
+	s.uniformLocations[mColorMapSizeName] = glGetUniformLocation(s.programId, mColorMapSizeName.c_str());
+
+	assert(!RenderWindow::GLHasError());
+
+	return mRenderWindow.AddShader(s);
+}
+
+}// namespace LibPlot2D
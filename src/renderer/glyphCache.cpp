@@ -0,0 +1,388 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  glyphCache.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Process-wide cache of glyphs rasterized with Freetype, shared among
+//        all objects rendering text with the same font and size.
+
+// Standard C++ headers
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+
+// Local headers
+#include "lp2d/renderer/glyphCache.h"
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for GlyphCache class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const unsigned int GlyphCache::mPreloadedGlyphCount(128);
+
+std::map<GlyphCache::Key, std::weak_ptr<GlyphCache>> GlyphCache::mCaches;
+std::set<std::string> GlyphCache::mValidFaces;
+std::recursive_mutex GlyphCache::mCacheMutex;
+
+FT_Library GlyphCache::mFt;
+unsigned int GlyphCache::mFtReferenceCount(0);
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		~GlyphCache
+//
+// Description:		Destructor for GlyphCache class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+GlyphCache::~GlyphCache()
+{
+	std::lock_guard<std::recursive_mutex> lock(mCacheMutex);
+	if (mFace)
+		FT_Done_Face(mFace);
+
+	ReleaseLibrary();
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		Get
+//
+// Description:		Returns the cache for the specified font and size.  If no
+//					cache exists, a new one is created and the ASCII glyphs
+//					are rasterized.
+//
+// Input Arguments:
+//		fontFileName	= const std::string&
+//		width			= const unsigned int&
+//		height			= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::shared_ptr<GlyphCache>, nullptr on failure
+//
+//=============================================================================
+std::shared_ptr<GlyphCache> GlyphCache::Get(const std::string& fontFileName,
+	const unsigned int& width, const unsigned int& height)
+{
+	std::lock_guard<std::recursive_mutex> lock(mCacheMutex);
+
+	const Key key(fontFileName, width, height);
+	auto it(mCaches.find(key));
+	if (it != mCaches.end())
+	{
+		std::shared_ptr<GlyphCache> cache(it->second.lock());
+		if (cache)
+			return cache;
+	}
+
+	// Forget about caches which are no longer in use
+	for (it = mCaches.begin(); it != mCaches.end();)
+	{
+		if (it->second.expired())
+			it = mCaches.erase(it);
+		else
+			++it;
+	}
+
+	if (!AcquireLibrary())
+		return nullptr;
+
+	std::shared_ptr<GlyphCache> cache(new GlyphCache);// Releases the library on destruction
+	if (FT_New_Face(mFt, fontFileName.c_str(), 0, &cache->mFace))
+	{
+		cache->mFace = nullptr;
+		return nullptr;
+	}
+
+	if (FT_Set_Pixel_Sizes(cache->mFace, width, height) ||
+		FT_Select_Charmap(cache->mFace, FT_ENCODING_UNICODE))
+		return nullptr;
+
+	char32_t c;
+	for (c = 0; c < mPreloadedGlyphCount; ++c)
+	{
+		if (!cache->Rasterize(c))
+			return nullptr;
+	}
+
+	mValidFaces.insert(fontFileName);
+	mCaches[key] = cache;
+	return cache;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		FaceIsValid
+//
+// Description:		Checks to see if the specified font file can be loaded.
+//
+// Input Arguments:
+//		fontFileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the font can be loaded
+//
+//=============================================================================
+bool GlyphCache::FaceIsValid(const std::string& fontFileName)
+{
+	std::lock_guard<std::recursive_mutex> lock(mCacheMutex);
+	if (mValidFaces.find(fontFileName) != mValidFaces.end())
+		return true;
+
+	if (!AcquireLibrary())
+		return false;
+
+	FT_Face face;
+	const bool valid(FT_New_Face(mFt, fontFileName.c_str(), 0, &face) == 0);
+	if (valid)
+	{
+		FT_Done_Face(face);
+		mValidFaces.insert(fontFileName);
+	}
+
+	ReleaseLibrary();
+	return valid;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		GetGlyphIndex
+//
+// Description:		Returns the index of the glyph for the specified
+//					character, rasterizing the glyph if necessary.
+//
+// Input Arguments:
+//		c	= const char32_t&
+//
+// Output Arguments:
+//		index	= unsigned int&
+//
+// Return Value:
+//		bool, true if the glyph is available
+//
+//=============================================================================
+bool GlyphCache::GetGlyphIndex(const char32_t& c, unsigned int& index)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it(mGlyphIndices.find(c));
+	if (it == mGlyphIndices.end())
+	{
+		if (!Rasterize(c))
+			return false;
+		it = mGlyphIndices.find(c);
+	}
+
+	index = it->second;
+	return true;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		GetGlyph
+//
+// Description:		Returns the glyph with the specified index.
+//
+// Input Arguments:
+//		index	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Glyph&
+//
+//=============================================================================
+const GlyphCache::Glyph& GlyphCache::GetGlyph(const unsigned int& index) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	assert(index < mGlyphs.size());
+	return mGlyphs[index];
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		GetGlyphCount
+//
+// Description:		Returns the number of glyphs which have been rasterized.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//=============================================================================
+unsigned int GlyphCache::GetGlyphCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return static_cast<unsigned int>(mGlyphs.size());
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		GetMaximumSize
+//
+// Description:		Returns the size of the largest glyph bitmap.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		xSize	= unsigned int&
+//		ySize	= unsigned int&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void GlyphCache::GetMaximumSize(unsigned int& xSize, unsigned int& ySize) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	xSize = mMaxXSize;
+	ySize = mMaxYSize;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		Rasterize
+//
+// Description:		Rasterizes the glyph for the specified character and adds
+//					it to the cache.  Caller must hold mMutex (or have
+//					exclusive access to this object).
+//
+// Input Arguments:
+//		c	= const char32_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool GlyphCache::Rasterize(const char32_t& c)
+{
+	if (FT_Load_Char(mFace, c, FT_LOAD_RENDER))
+		return false;
+
+	const FT_GlyphSlot slot(mFace->glyph);
+
+	Glyph g;
+	g.xSize = slot->bitmap.width;
+	g.ySize = slot->bitmap.rows;
+	g.xBearing = slot->bitmap_left;
+	g.yBearing = slot->bitmap_top;
+	g.advance = slot->advance.x;
+
+	// Rows may be padded in the Freetype bitmap; store them tightly packed
+	g.bitmap.resize(g.xSize * g.ySize);
+	int row;
+	for (row = 0; row < g.ySize; ++row)
+		memcpy(g.bitmap.data() + row * g.xSize,
+			slot->bitmap.buffer + row * slot->bitmap.pitch, g.xSize);
+
+	mMaxXSize = std::max(mMaxXSize, static_cast<unsigned int>(g.xSize));
+	mMaxYSize = std::max(mMaxYSize, static_cast<unsigned int>(g.ySize));
+
+	mGlyphIndices[c] = static_cast<unsigned int>(mGlyphs.size());
+	mGlyphs.push_back(std::move(g));
+
+	return true;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		AcquireLibrary
+//
+// Description:		Initializes the Freetype library, if necessary, and
+//					increments the reference count.  Caller must hold
+//					mCacheMutex.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool GlyphCache::AcquireLibrary()
+{
+	if (mFtReferenceCount == 0)
+	{
+		if (FT_Init_FreeType(&mFt))
+			return false;
+	}
+
+	++mFtReferenceCount;
+	return true;
+}
+
+//=============================================================================
+// Class:			GlyphCache
+// Function:		ReleaseLibrary
+//
+// Description:		Decrements the reference count for the Freetype library,
+//					freeing it when it is no longer in use.  Caller must hold
+//					mCacheMutex.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void GlyphCache::ReleaseLibrary()
+{
+	assert(mFtReferenceCount > 0);
+	--mFtReferenceCount;
+	if (mFtReferenceCount == 0)
+		FT_Done_FreeType(mFt);
+}
+
+}// namespace LibPlot2D
@@ -0,0 +1,212 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  headlessContext.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  OpenGL context which does not belong to a window, for rendering to
+//        framebuffer objects without a window system surface.
+
+// Local headers
+#include "lp2d/renderer/headlessContext.h"
+
+#ifndef _WIN32
+// EGL headers (without the X11 headers, which aren't needed)
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif// _WIN32
+
+// Standard C++ headers
+#include <cstring>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			HeadlessContext
+// Function:		HasExtension
+//
+// Description:		Checks to see if the specified extension appears in the
+//					space-separated list of extensions.
+//
+// Input Arguments:
+//		extensions	= const char*, may be nullptr
+//		name		= const char*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool HeadlessContext::HasExtension(const char* extensions, const char* name)
+{
+	if (!extensions)
+		return false;
+
+	const std::size_t length(strlen(name));
+	const char* start(extensions);
+	while ((start = strstr(start, name)) != nullptr)
+	{
+		if ((start == extensions || start[-1] == ' ') &&
+			(start[length] == ' ' || start[length] == '\0'))
+			return true;
+		start += length;
+	}
+
+	return false;
+}
+
+//=============================================================================
+// Class:			HeadlessContext
+// Function:		HeadlessContext
+//
+// Description:		Constructor for HeadlessContext class.  Creates the
+//					context; on failure, IsOK() returns false.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+HeadlessContext::HeadlessContext()
+{
+#ifndef _WIN32
+	// The surfaceless platform doesn't need a display server
+	EGLDisplay display(EGL_NO_DISPLAY);
+	if (HasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS),
+		"EGL_MESA_platform_surfaceless"))
+	{
+		auto getPlatformDisplay(reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+			eglGetProcAddress("eglGetPlatformDisplayEXT")));
+		if (getPlatformDisplay)
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+				EGL_DEFAULT_DISPLAY, nullptr);
+	}
+
+	if (display == EGL_NO_DISPLAY)
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+	if (display == EGL_NO_DISPLAY ||
+		eglInitialize(display, nullptr, nullptr) != EGL_TRUE ||
+		eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+		return;
+	mDisplay = display;
+
+	// Everything is drawn to framebuffer objects, so a surface is only
+	// created when the context can't be made current without one
+	const bool surfaceless(HasExtension(
+		eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"));
+	const EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_NONE };
+
+	EGLConfig config;
+	EGLint configCount;
+	if (eglChooseConfig(display, configAttributes, &config, 1, &configCount)
+		!= EGL_TRUE || configCount == 0)
+		return;
+
+	if (!surfaceless)
+	{
+		const EGLint pbufferAttributes[] = {
+			EGL_WIDTH, 1,
+			EGL_HEIGHT, 1,
+			EGL_NONE };
+		mSurface = eglCreatePbufferSurface(display, config, pbufferAttributes);
+		if (mSurface == EGL_NO_SURFACE)
+			return;
+	}
+
+	// Same version as requested for window contexts
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 0,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE };
+	mContext = eglCreateContext(display, config, EGL_NO_CONTEXT,
+		contextAttributes);
+#endif// _WIN32
+}
+
+//=============================================================================
+// Class:			HeadlessContext
+// Function:		~HeadlessContext
+//
+// Description:		Destructor for HeadlessContext class.  The display is
+//					shared by all headless contexts in the process, so it is
+//					not terminated.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+HeadlessContext::~HeadlessContext()
+{
+#ifndef _WIN32
+	if (!mDisplay)
+		return;
+
+	if (mContext)
+	{
+		if (eglGetCurrentContext() == mContext)
+			eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE,
+				EGL_NO_CONTEXT);
+		eglDestroyContext(mDisplay, mContext);
+	}
+
+	if (mSurface)
+		eglDestroySurface(mDisplay, mSurface);
+#endif// _WIN32
+}
+
+//=============================================================================
+// Class:			HeadlessContext
+// Function:		MakeCurrent
+//
+// Description:		Makes the context current on the calling thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool HeadlessContext::MakeCurrent() const
+{
+#ifndef _WIN32
+	return mContext && eglMakeCurrent(mDisplay, mSurface, mSurface, mContext)
+		== EGL_TRUE;
+#else
+	return false;
+#endif// _WIN32
+}
+
+}// namespace LibPlot2D
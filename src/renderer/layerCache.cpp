@@ -0,0 +1,391 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  layerCache.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Offscreen image of the static portion of a scene, which is composited
+//        with the overlay primitives each frame.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/layerCache.h"
+#include "lp2d/renderer/renderWindow.h"
+
+// Standard C++ headers
+#include <cassert>
+#include <vector>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for LayerCache class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string LayerCache::mLayerName("layer");
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		mVertexShader
+//
+// Description:		Composite vertex shader.  Draws a triangle strip of four
+//					vertices covering the viewport; no attributes are
+//					required.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string LayerCache::mVertexShader(
+	"#version 400\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    gl_Position = vec4((gl_VertexID & 1) == 1 ? 1.0 : -1.0,\n"
+	"        (gl_VertexID & 2) == 2 ? 1.0 : -1.0, 0.0, 1.0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		mFragmentShader
+//
+// Description:		Composite fragment shader.  Copies the cached pixel
+//					corresponding to each fragment.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string LayerCache::mFragmentShader(
+	"#version 400\n"
+	"\n"
+	"uniform sampler2D layer;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    outputColor = texelFetch(layer, ivec2(gl_FragCoord.xy), 0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		Begin
+//
+// Description:		Binds the framebuffer to which the cached objects are
+//					drawn.
+//
+// Input Arguments:
+//		width	= const int&
+//		height	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool LayerCache::Begin(const int& width, const int& height)
+{
+	if (width <= 0 || height <= 0)
+		return false;
+
+	if (!Matches(width, height) && !Allocate(width, height))
+		return false;
+
+	if (mSamples > 0)
+		glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[0]);
+	else
+		glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[1]);
+
+	assert(!RenderWindow::GLHasError());
+	return true;
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		End
+//
+// Description:		Resolves the multisampled image (if any) into the cache
+//					texture and restores the window's framebuffer.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void LayerCache::End()
+{
+	if (mSamples > 0)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, mFramebuffers[0]);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mFramebuffers[1]);
+		glBlitFramebuffer(0, 0, mWidth, mHeight, 0, 0, mWidth, mHeight,
+			GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		Composite
+//
+// Description:		Draws the cached image over the entire viewport.  Blending
+//					and the scissor test are disabled while drawing, so the
+//					cached pixels are copied exactly.
+//
+// Input Arguments:
+//		activeProgram	= const GLuint&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void LayerCache::Composite(const GLuint& activeProgram)
+{
+	assert(mTexture != 0);
+
+	if (mProgram == 0)
+		BuildProgram();
+
+	const GLboolean blend(glIsEnabled(GL_BLEND));
+	const GLboolean scissor(glIsEnabled(GL_SCISSOR_TEST));
+	glDisable(GL_BLEND);
+	glDisable(GL_SCISSOR_TEST);
+
+	glUseProgram(mProgram);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, mTexture);
+
+	glBindVertexArray(mVertexArray);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glBindVertexArray(0);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(activeProgram);
+
+	if (blend)
+		glEnable(GL_BLEND);
+	if (scissor)
+		glEnable(GL_SCISSOR_TEST);
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		FreeOpenGLObjects
+//
+// Description:		Deletes all OpenGL objects owned by this object.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void LayerCache::FreeOpenGLObjects()
+{
+	FreeFramebuffers();
+
+	if (mProgram != 0)
+	{
+		glDeleteProgram(mProgram);
+		glDeleteVertexArrays(1, &mVertexArray);
+		mProgram = 0;
+		mVertexArray = 0;
+	}
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		Allocate
+//
+// Description:		Creates the framebuffers for the specified size.  The
+//					number of samples is taken from the bound (window's)
+//					framebuffer.
+//
+// Input Arguments:
+//		width	= const int&
+//		height	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool LayerCache::Allocate(const int& width, const int& height)
+{
+	FreeFramebuffers();
+
+	glGetIntegerv(GL_SAMPLES, &mSamples);
+
+	glGenTextures(1, &mTexture);
+	glBindTexture(GL_TEXTURE_2D, mTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+		GL_UNSIGNED_BYTE, nullptr);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffers(2, mFramebuffers);
+	glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[1]);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_TEXTURE_2D, mTexture, 0);
+	bool complete(glCheckFramebufferStatus(GL_FRAMEBUFFER)
+		== GL_FRAMEBUFFER_COMPLETE);
+
+	if (mSamples > 0)
+	{
+		glGenRenderbuffers(1, &mRenderbuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, mRenderbuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, mSamples, GL_RGBA8,
+			width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[0]);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_RENDERBUFFER, mRenderbuffer);
+		complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER)
+			== GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (!complete)
+	{
+		FreeFramebuffers();
+		return false;
+	}
+
+	mWidth = width;
+	mHeight = height;
+
+	assert(!RenderWindow::GLHasError());
+	return true;
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		FreeFramebuffers
+//
+// Description:		Deletes the framebuffers and their attachments.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void LayerCache::FreeFramebuffers()
+{
+	if (mTexture == 0)
+		return;
+
+	glDeleteFramebuffers(2, mFramebuffers);
+	glDeleteTextures(1, &mTexture);
+	if (mRenderbuffer != 0)
+		glDeleteRenderbuffers(1, &mRenderbuffer);
+
+	mFramebuffers[0] = 0;
+	mFramebuffers[1] = 0;
+	mTexture = 0;
+	mRenderbuffer = 0;
+	mWidth = 0;
+	mHeight = 0;
+}
+
+//=============================================================================
+// Class:			LayerCache
+// Function:		BuildProgram
+//
+// Description:		Builds the program used to draw the cached image.  The
+//					program is not added to the window's list of programs,
+//					since it requires neither the modelview nor the projection
+//					matrix.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void LayerCache::BuildProgram()
+{
+	std::vector<GLuint> shaderList;
+	shaderList.push_back(RenderWindow::CreateShader(GL_VERTEX_SHADER, mVertexShader));
+	shaderList.push_back(RenderWindow::CreateShader(GL_FRAGMENT_SHADER, mFragmentShader));
+	mProgram = RenderWindow::CreateProgram(shaderList);
+
+	glUseProgram(mProgram);
+	glUniform1i(glGetUniformLocation(mProgram, mLayerName.c_str()), 0);
+
+	// Core profiles require a vertex array to be bound for drawing, even
+	// without any attributes
+	glGenVertexArrays(1, &mVertexArray);
+
+	assert(!RenderWindow::GLHasError());
+}
+
+}// namespace LibPlot2D
@@ -21,6 +21,10 @@
 #include "lp2d/renderer/line.h"
 #include "lp2d/utilities/math/plotMath.h"
 #include "lp2d/renderer/renderWindow.h"
+#include "lp2d/utilities/threadPool.h"
+
+// Standard C++ headers
+#include <algorithm>
 
 namespace LibPlot2D
 {
@@ -42,6 +46,80 @@ namespace LibPlot2D
 //
 //=============================================================================
 const double Line::mFadeDistance(0.05);
+const unsigned int Line::mPointsPerBlock(50000);
+const std::string Line::mContinuousIndicesName("Line::Continuous");
+const std::string Line::mSegmentIndicesName("Line::Segments");
+const std::string Line::mLineColorName("lineColor");
+const std::string Line::mEdgeColorName("edgeColor");
+const GLuint Line::mCompactPositionLocation(0);
+
+//=============================================================================
+// Class:			Line
+// Function:		mCompactVertexShader
+//
+// Description:		Vertex shader for compact geometry.  Pretty lines have
+//					four vertices per point, ordered edge, line, line, edge
+//					(for both continuous lines and segments), so the color of
+//					each vertex follows from its index.
+//
+// Input Arguments:
+//		0	= position
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string Line::mCompactVertexShader(
+	"#version 400\n"
+	"\n"
+	"uniform mat4 modelviewMatrix;\n"
+	"uniform mat4 projectionMatrix;\n"
+	"uniform vec4 lineColor;\n"
+	"uniform vec4 edgeColor;\n"
+	"\n"
+	"layout(location = 0) in vec2 position;\n"
+	"\n"
+	"out vec4 vertexColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    int level = gl_VertexID & 3;\n"
+	"    vertexColor = (level == 0 || level == 3) ? edgeColor : lineColor;\n"
+	"    gl_Position = projectionMatrix * modelviewMatrix * vec4(position, 0.0, 1.0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			Line
+// Function:		mCompactFragmentShader
+//
+// Description:		Fragment shader for compact geometry.
+//
+// Input Arguments:
+//		0	= vertexColor
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string Line::mCompactFragmentShader(
+	"#version 400\n"
+	"\n"
+	"in vec4 vertexColor;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    outputColor = vertexColor;\n"
+	"}\n"
+);
 
 //=============================================================================
 // Class:			Line
@@ -50,7 +128,7 @@ const double Line::mFadeDistance(0.05);
 // Description:		Constructor for Line class.
 //
 // Input Arguments:
-//		renderWindow	= const RenderWindow&
+//		renderWindow	= RenderWindow&
 //
 // Output Arguments:
 //		None
@@ -59,7 +137,7 @@ const double Line::mFadeDistance(0.05);
 //		None
 //
 //=============================================================================
-Line::Line(const RenderWindow& renderWindow) : mRenderWindow(renderWindow),
+Line::Line(RenderWindow& renderWindow) : mRenderWindow(renderWindow),
 	mHint(GL_DYNAMIC_DRAW)
 {
 	SetWidth(1.0);
@@ -119,12 +197,8 @@ void Line::Build(const double &x1, const double &y1,const double &x2,
 	const UpdateMethod& update) const
 {
 	if (mPretty)
-	{
-		std::vector<std::pair<double, double>> v;
-		v.push_back(std::make_pair(x1, y1));
-		v.push_back(std::make_pair(x2, y2));
-		DoPrettyDraw(v, update, bufferInfo);
-	}
+		DoPrettyDraw(std::vector<double>{ x1, x2 },
+			std::vector<double>{ y1, y2 }, update, bufferInfo);
 	else
 		DoUglyDraw(x1, y1, x2, y2, update, bufferInfo);
 }
@@ -181,13 +255,10 @@ void Line::Build(
 void Line::Build(const std::vector<std::pair<double, double>> &points,
 	Primitive::BufferInfo& bufferInfo, const UpdateMethod& update) const
 {
-	if (points.size() < 2)
-		return;
-
-	if (mPretty)
-		DoPrettyDraw(points, update, bufferInfo);
-	else
-		DoUglyDraw(points, update, bufferInfo);
+	std::vector<double> x;
+	std::vector<double> y;
+	SplitPoints(points, x, y);
+	Build(x, y, bufferInfo, update);
 }
 
 //=============================================================================
@@ -213,14 +284,13 @@ void Line::Build(const std::vector<double>& x, const std::vector<double>& y,
 {
 	assert(x.size() == y.size());
 
-	std::vector<std::pair<double, double>> dPoints(x.size());
-	unsigned int i;
-	for (i = 0; i < dPoints.size(); ++i)
-	{
-		dPoints[i].first = x[i];
-		dPoints[i].second = y[i];
-	}
-	Build(dPoints, bufferInfo, update);
+	if (x.size() < 2)
+		return;
+
+	if (mPretty)
+		DoPrettyDraw(x, y, update, bufferInfo);
+	else
+		DoUglyDraw(x, y, update, bufferInfo);
 }
 
 //=============================================================================
@@ -247,107 +317,230 @@ void Line::BuildSegments(const std::vector<std::pair<double, double>> &points,
 		return;
 	assert(points.size() % 2 == 0);
 
+	std::vector<double> x;
+	std::vector<double> y;
+	SplitPoints(points, x, y);
+
 	if (mPretty)
-		DoPrettySegmentDraw(points, update, bufferInfo);
+		DoPrettySegmentDraw(x, y, update, bufferInfo);
 	else
-		DoUglyDraw(points, update, bufferInfo);
+		DoUglyDraw(x, y, update, bufferInfo);
 }
 
 //=============================================================================
 // Class:			Line
-// Function:		ComputeOffsets
+// Function:		SplitPoints
 //
-// Description:		Computes the offsets for the outside vertices based on the
-//					line width and orientation.
+// Description:		Splits a list of x-y pairs into separate lists of x and y
+//					values.
 //
 // Input Arguments:
-//		x1	= const double&
-//		y1	= const double&
-//		x2	= const double&
-//		y2	= const double&
+//		points	= const std::vector<std::pair<double, double>>&
 //
 // Output Arguments:
-//		dxLine	= const double&
-//		dyLine	= const double&
-//		dxEdge	= const double&
-//		dyEdge	= const double&
+//		x	= std::vector<double>&
+//		y	= std::vector<double>&
 //
 // Return Value:
 //		None
 //
 //=============================================================================
-void Line::ComputeOffsets(const double &x1, const double &y1, const double &x2,
-	const double &y2, double& dxLine, double& dyLine, double& dxEdge, double& dyEdge) const
+void Line::SplitPoints(const std::vector<std::pair<double, double>> &points,
+	std::vector<double>& x, std::vector<double>& y)
 {
-	double miter(atan2((y2 - y1) / mYScale, (x2 - x1) / mXScale) + M_PI * 0.5);
-
-	dxLine = mHalfWidth * cos(miter) * mXScale;
-	dyLine = mHalfWidth * sin(miter) * mYScale;
-
-	dxEdge = dxLine * (mHalfWidth + mFadeDistance) / mHalfWidth;
-	dyEdge = dyLine * (mHalfWidth + mFadeDistance) / mHalfWidth;
+	x.resize(points.size());
+	y.resize(points.size());
+	unsigned int i;
+	for (i = 0; i < points.size(); ++i)
+	{
+		x[i] = points[i].first;
+		y[i] = points[i].second;
+	}
 }
 
 //=============================================================================
 // Class:			Line
-// Function:		ComputeOffsets
+// Function:		ComputeDirections
 //
-// Description:		Computes the offsets for the outside vertices based on the
-//					line width and orientation.
+// Description:		Computes the unit vectors in the direction of each of the
+//					specified segments, in pixel space.  Zero-length segments
+//					are treated as pointing in the +x direction.  The special
+//					case is handled arithmetically (rather than with a branch)
+//					so the whole computation is done with array operations.
 //
 // Input Arguments:
-//		xPrior	= const double&
-//		yPrior	= const double&
-//		x		= const double&
-//		y		= const double&
-//		xNext	= const double&
-//		yNext	= const double&
+//		dx	= const Eigen::ArrayXd& [plot units]
+//		dy	= const Eigen::ArrayXd& [plot units]
 //
 // Output Arguments:
-//		dxLine	= const double&
-//		dyLine	= const double&
-//		dxEdge	= const double&
-//		dyEdge	= const double&
+//		ux	= Eigen::Ref<Eigen::ArrayXd>
+//		uy	= Eigen::Ref<Eigen::ArrayXd>
 //
 // Return Value:
 //		None
 //
 //=============================================================================
-void Line::ComputeOffsets(const double &xPrior, const double &yPrior,
-	const double &x, const double &y, const double &xNext, const double &yNext,
-	double& dxLine, double& dyLine, double& dxEdge, double& dyEdge) const
+void Line::ComputeDirections(const Eigen::ArrayXd& dx,
+	const Eigen::ArrayXd& dy, Eigen::Ref<Eigen::ArrayXd> ux,
+	Eigen::Ref<Eigen::ArrayXd> uy) const
 {
-	const double anglePrior(atan2((y - yPrior) / mYScale,
-		(x - xPrior) / mXScale));
-	const double angleNext(atan2((yNext - y) / mYScale,
-		(xNext - x) / mXScale));
-	double miter(0.5 * (anglePrior + angleNext));
-	
-	if (fabs(angleNext - anglePrior) < M_PI)
-		miter += M_PI * 0.5;
-	else
-		miter -= M_PI * 0.5;
+	const Eigen::ArrayXd dxPixels(dx / mXScale);
+	const Eigen::ArrayXd dyPixels(dy / mYScale);
+	const Eigen::ArrayXd length((dxPixels.square() + dyPixels.square()).sqrt());
+
+	// One for zero-length segments, zero otherwise
+	const Eigen::ArrayXd zeroLength((length == 0.0).cast<double>());
+	const Eigen::ArrayXd inverseLength((length + zeroLength).inverse());
+
+	ux = dxPixels * inverseLength + zeroLength;
+	uy = dyPixels * inverseLength;
+}
 
-	double miterLength(mHalfWidth), fade(mFadeDistance);
-	const double divisor(sin((M_PI - angleNext + anglePrior) * 0.5));
-	if (!PlotMath::IsZero(divisor))
+//=============================================================================
+// Class:			Line
+// Function:		ComputeContinuousOffsets
+//
+// Description:		Computes the offsets from each point in the specified
+//					range to the inner vertices of a continuous line.  At
+//					interior points, the offset is perpendicular to the
+//					bisector of the two segment directions.  The length of the
+//					(un-normalized) bisector b is twice the cosine of half of
+//					the angle between the segments, which is the factor by
+//					which the offset must be lengthened to maintain the line
+//					width through the corner, so the offset is
+//					2 * w * perp(b) / |b|^2 and requires no square root.  End
+//					points use their only segment as both the prior and next
+//					segments, which results in a square end.
+//
+// Input Arguments:
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
+//		begin	= const unsigned int&
+//		end		= const unsigned int&
+//
+// Output Arguments:
+//		dxLine	= Eigen::ArrayXd& (already sized as required)
+//		dyLine	= Eigen::ArrayXd& (already sized as required)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::ComputeContinuousOffsets(const std::vector<double>& x,
+	const std::vector<double>& y, const unsigned int& begin,
+	const unsigned int& end, Eigen::ArrayXd& dxLine,
+	Eigen::ArrayXd& dyLine) const
+{
+	const unsigned int lastPoint(x.size() - 1);
+	const Eigen::Index count(end - begin);
+
+	// Point i joins segments i - 1 and i, so ux(k) and ux(k + 1) are the
+	// directions on either side of point begin + k (the first and last
+	// segments are repeated for the end points)
+	const unsigned int firstSegment(std::max(begin, 1U) - 1);
+	const Eigen::Index segmentCount(std::min(end, lastPoint) - firstSegment);
+	const Eigen::Index pad(begin == 0 ? 1 : 0);
+
+	const Eigen::Map<const Eigen::ArrayXd> xPoints(x.data() + firstSegment,
+		segmentCount + 1);
+	const Eigen::Map<const Eigen::ArrayXd> yPoints(y.data() + firstSegment,
+		segmentCount + 1);
+
+	Eigen::ArrayXd ux(count + 1);
+	Eigen::ArrayXd uy(count + 1);
+	ComputeDirections(xPoints.tail(segmentCount) - xPoints.head(segmentCount),
+		yPoints.tail(segmentCount) - yPoints.head(segmentCount),
+		ux.segment(pad, segmentCount), uy.segment(pad, segmentCount));
+
+	if (begin == 0)
 	{
-		miterLength /= fabs(divisor);
-		fade /= fabs(divisor);
+		ux(0) = ux(1);
+		uy(0) = uy(1);
 	}
 
-	dxLine = miterLength * cos(miter) * mXScale;
-	dyLine = miterLength * sin(miter) * mYScale;
+	if (end == x.size())
+	{
+		ux(count) = ux(count - 1);
+		uy(count) = uy(count - 1);
+	}
 
-	dxEdge = dxLine * (miterLength + fade) / miterLength;
-	dyEdge = dyLine * (miterLength + fade) / miterLength;
+	const Eigen::ArrayXd bx(ux.head(count) + ux.tail(count));
+	const Eigen::ArrayXd by(uy.head(count) + uy.tail(count));
+	const Eigen::ArrayXd lengthSquared(bx.square() + by.square());
+
+	// Where the line doubles back on itself, there is no bisector, so the
+	// offset is taken along the line instead.  The tolerance corresponds to
+	// a half-angle cosine of PlotMath::NearlyZero.
+	const double reversalTolerance(4.0 * PlotMath::NearlyZero
+		* PlotMath::NearlyZero);
+	const Eigen::ArrayXd reverses((lengthSquared < reversalTolerance).cast<double>());
+	const Eigen::ArrayXd miterScale(2.0 * mHalfWidth
+		/ (lengthSquared + reverses));
+
+	dxLine = mXScale * ((1.0 - reverses) * -miterScale * by
+		+ reverses * mHalfWidth * ux.head(count));
+	dyLine = mYScale * ((1.0 - reverses) * miterScale * bx
+		+ reverses * mHalfWidth * uy.head(count));
 }
 
+//=============================================================================
+// Class:			Line
+// Function:		ComputeSegmentOffsets
+//
+// Description:		Computes the offsets from each point in the specified
+//					range to the inner vertices of disconnected segments.
+//					Both ends of each segment share the same offsets, which
+//					are perpendicular to the segment.
+//
+// Input Arguments:
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
+//		begin	= const unsigned int& (must be even)
+//		end		= const unsigned int& (must be even)
+//
+// Output Arguments:
+//		dxLine	= Eigen::ArrayXd& (already sized as required)
+//		dyLine	= Eigen::ArrayXd& (already sized as required)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::ComputeSegmentOffsets(const std::vector<double>& x,
+	const std::vector<double>& y, const unsigned int& begin,
+	const unsigned int& end, Eigen::ArrayXd& dxLine,
+	Eigen::ArrayXd& dyLine) const
+{
+	assert(begin % 2 == 0 && end % 2 == 0);
+
+	typedef Eigen::Map<const Eigen::ArrayXd, 0, Eigen::InnerStride<2>> PointMap;
+	typedef Eigen::Map<Eigen::ArrayXd, 0, Eigen::InnerStride<2>> OffsetMap;
+
+	const Eigen::Index segmentCount((end - begin) / 2);
+	const PointMap xStart(x.data() + begin, segmentCount);
+	const PointMap yStart(y.data() + begin, segmentCount);
+	const PointMap xEnd(x.data() + begin + 1, segmentCount);
+	const PointMap yEnd(y.data() + begin + 1, segmentCount);
+
+	Eigen::ArrayXd ux(segmentCount);
+	Eigen::ArrayXd uy(segmentCount);
+	ComputeDirections(xEnd - xStart, yEnd - yStart, ux, uy);
+
+	// Offset is perpendicular to the line (direction rotated by 90 deg)
+	const Eigen::ArrayXd dx(-mHalfWidth * mXScale * uy);
+	const Eigen::ArrayXd dy(mHalfWidth * mYScale * ux);
+
+	OffsetMap(dxLine.data(), segmentCount) = dx;
+	OffsetMap(dxLine.data() + 1, segmentCount) = dx;
+	OffsetMap(dyLine.data(), segmentCount) = dy;
+	OffsetMap(dyLine.data() + 1, segmentCount) = dy;
+}
 //=============================================================================
 // Class:			Line
 // Function:		AllocateBuffer
 //
-// Description:		Allocated local vertex buffer;
+// Description:		Allocated local vertex buffer.  Compact lines store only
+//					the vertex positions.
 //
 // Input Arguments:
 //		vertexCount		= const unsigned int&
@@ -363,19 +556,88 @@ void Line::ComputeOffsets(const double &xPrior, const double &yPrior,
 void Line::AllocateBuffer(const unsigned int& vertexCount,
 	const unsigned int& triangleCount, Primitive::BufferInfo& bufferInfo) const
 {
-	bufferInfo.GetOpenGLIndices(triangleCount > 0);
-
 	bufferInfo.vertexCount = vertexCount;
 	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount
-		* (mRenderWindow.GetVertexDimension() + 4));
+		* (mRenderWindow.GetVertexDimension() + (mCompact ? 0 : 4)));
 	assert(mRenderWindow.GetVertexDimension() == 2);
 
 	if (triangleCount > 0)
 		bufferInfo.indexBuffer.resize(triangleCount * 3);
+	else
+		bufferInfo.indexBuffer.clear();
+	bufferInfo.sharedIndexCount = 0;
 
 	bufferInfo.vertexCountModified = false;
 }
 
+//=============================================================================
+// Class:			Line
+// Function:		Upload
+//
+// Description:		Sends the geometry in the specified buffer to OpenGL.  The
+//					index buffer is only sent if it is populated (i.e. for
+//					pretty lines); pretty lines using shared indices instead
+//					bind the window's shared index buffer.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::Upload(Primitive::BufferInfo& bufferInfo) const
+{
+	const bool hasIndices(!bufferInfo.indexBuffer.empty());
+	bufferInfo.GetOpenGLIndices(hasIndices);
+
+	GLuint sharedIndexBuffer(0);
+	if (!hasIndices && bufferInfo.sharedIndexCount > 0)
+	{
+		if (mPrettyStyle == LineStyle::Continuous)
+			sharedIndexBuffer = mRenderWindow.GetSharedIndexBuffer(
+				mContinuousIndicesName, bufferInfo.sharedIndexCount,
+				AssignContinuousIndices);
+		else
+			sharedIndexBuffer = mRenderWindow.GetSharedIndexBuffer(
+				mSegmentIndicesName, bufferInfo.sharedIndexCount,
+				AssignSegmentIndices);
+	}
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+
+	bufferInfo.BufferVertexData(mHint);
+
+	if (mCompact)
+	{
+		glEnableVertexAttribArray(mCompactPositionLocation);
+		glVertexAttribPointer(mCompactPositionLocation,
+			mRenderWindow.GetVertexDimension(), GL_FLOAT, GL_FALSE, 0, 0);
+	}
+	else
+	{
+		glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
+		glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(),
+			mRenderWindow.GetVertexDimension(), GL_FLOAT, GL_FALSE, 0, 0);
+
+		glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
+		glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
+			(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * bufferInfo.vertexCount));
+	}
+
+	if (hasIndices)
+		bufferInfo.BufferIndexData(mHint);
+	else if (sharedIndexBuffer != 0)
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sharedIndexBuffer);
+
+	glBindVertexArray(0);
+
+	assert(!RenderWindow::GLHasError());
+}
+
 //=============================================================================
 // Class:			Line
 // Function:		DoUglyDraw
@@ -407,37 +669,24 @@ void Line::DoUglyDraw(const double &x1, const double &y1,
 	bufferInfo.vertexBuffer[2] = static_cast<float>(x2);
 	bufferInfo.vertexBuffer[3] = static_cast<float>(y2);
 
-	bufferInfo.vertexBuffer[4] = static_cast<float>(mLineColor.GetRed());
-	bufferInfo.vertexBuffer[5] = static_cast<float>(mLineColor.GetGreen());
-	bufferInfo.vertexBuffer[6] = static_cast<float>(mLineColor.GetBlue());
-	bufferInfo.vertexBuffer[7] = static_cast<float>(mLineColor.GetAlpha());
-
-	bufferInfo.vertexBuffer[8] = static_cast<float>(mLineColor.GetRed());
-	bufferInfo.vertexBuffer[9] = static_cast<float>(mLineColor.GetGreen());
-	bufferInfo.vertexBuffer[10] = static_cast<float>(mLineColor.GetBlue());
-	bufferInfo.vertexBuffer[11] = static_cast<float>(mLineColor.GetAlpha());
+	if (!mCompact)
+	{
+		bufferInfo.vertexBuffer[4] = static_cast<float>(mLineColor.GetRed());
+		bufferInfo.vertexBuffer[5] = static_cast<float>(mLineColor.GetGreen());
+		bufferInfo.vertexBuffer[6] = static_cast<float>(mLineColor.GetBlue());
+		bufferInfo.vertexBuffer[7] = static_cast<float>(mLineColor.GetAlpha());
+
+		bufferInfo.vertexBuffer[8] = static_cast<float>(mLineColor.GetRed());
+		bufferInfo.vertexBuffer[9] = static_cast<float>(mLineColor.GetGreen());
+		bufferInfo.vertexBuffer[10] = static_cast<float>(mLineColor.GetBlue());
+		bufferInfo.vertexBuffer[11] = static_cast<float>(mLineColor.GetAlpha());
+	}
 
 	if (update != UpdateMethod::Immediate)
 		return;
 
-	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
-
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), mHint);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(), 2, GL_FLOAT, GL_FALSE, 0, 0);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
-		(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * bufferInfo.vertexCount));
-
+	Upload(bufferInfo);
 	glLineWidth(2.0 * mHalfWidth);
-
-	glBindVertexArray(0);
-
-	assert(!RenderWindow::GLHasError());
 }
 
 //=============================================================================
@@ -447,7 +696,8 @@ void Line::DoUglyDraw(const double &x1, const double &y1,
 // Description:		Draws a line strip using OpenGL lines.
 //
 // Input Arguments:
-//		points	= const std::vector<std::pair<double, double>>&
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
 //		update	= const UpdateMethod&
 //
 // Output Arguments:
@@ -457,18 +707,22 @@ void Line::DoUglyDraw(const double &x1, const double &y1,
 //		None
 //
 //=============================================================================
-void Line::DoUglyDraw(const std::vector<std::pair<double, double>> &points,
-	const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const
+void Line::DoUglyDraw(const std::vector<double>& x,
+	const std::vector<double>& y, const UpdateMethod& update,
+	Primitive::BufferInfo& bufferInfo) const
 {
-	AllocateBuffer(points.size(), 0, bufferInfo);
+	AllocateBuffer(x.size(), 0, bufferInfo);
 
 	const unsigned int dimension(mRenderWindow.GetVertexDimension());
-	const unsigned int start(points.size() * dimension);
+	const unsigned int start(x.size() * dimension);
 	unsigned int i;
-	for (i = 0; i < points.size(); ++i)
+	for (i = 0; i < x.size(); ++i)
 	{
-		bufferInfo.vertexBuffer[i * dimension] = static_cast<float>(points[i].first);
-		bufferInfo.vertexBuffer[i * dimension + 1] = static_cast<float>(points[i].second);
+		bufferInfo.vertexBuffer[i * dimension] = static_cast<float>(x[i]);
+		bufferInfo.vertexBuffer[i * dimension + 1] = static_cast<float>(y[i]);
+
+		if (mCompact)
+			continue;
 
 		bufferInfo.vertexBuffer[start + i * 4] = static_cast<float>(mLineColor.GetRed());
 		bufferInfo.vertexBuffer[start + i * 4 + 1] = static_cast<float>(mLineColor.GetGreen());
@@ -479,24 +733,8 @@ void Line::DoUglyDraw(const std::vector<std::pair<double, double>> &points,
 	if (update != UpdateMethod::Immediate)
 		return;
 
-	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
-
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), mHint);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(), 2, GL_FLOAT, GL_FALSE, 0, 0);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
-		(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * bufferInfo.vertexCount));
-
+	Upload(bufferInfo);
 	glLineWidth(2.0 * mHalfWidth);
-
-	glBindVertexArray(0);
-
-	assert(!RenderWindow::GLHasError());
 }
 
 //=============================================================================
@@ -506,7 +744,8 @@ void Line::DoUglyDraw(const std::vector<std::pair<double, double>> &points,
 // Description:		Draws a line strip using OpenGL triangles.
 //
 // Input Arguments:
-//		points	= const std::vector<std::pair<double, double>>&
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
 //		update	= const UpdateMethod&
 //
 // Output Arguments:
@@ -516,11 +755,10 @@ void Line::DoUglyDraw(const std::vector<std::pair<double, double>> &points,
 //		None
 //
 //=============================================================================
-void Line::DoPrettyDraw(const std::vector<std::pair<double, double>> &points,
-	const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const
+void Line::DoPrettyDraw(const std::vector<double>& x,
+	const std::vector<double>& y, const UpdateMethod& update,
+	Primitive::BufferInfo& bufferInfo) const
 {
-	std::vector<Offsets> offsets(points.size());
-
 	/* Draw the line as follows:
 
 	3+----+7
@@ -541,61 +779,20 @@ void Line::DoPrettyDraw(const std::vector<std::pair<double, double>> &points,
 	0+----+4
 	*/
 
-	AllocateBuffer(points.size() * 4, 6 * (points.size() - 1), bufferInfo);
-	AssignVertexData(points, LineStyle::Continuous, bufferInfo);
-
-	unsigned int i;
-	for (i = 0; i < points.size() - 1; ++i)
-	{
-		bufferInfo.indexBuffer[i * 18] = i * 4;
-		bufferInfo.indexBuffer[i * 18 + 1] = i * 4 + 1;
-		bufferInfo.indexBuffer[i * 18 + 2] = (i + 1) * 4;
-
-		bufferInfo.indexBuffer[i * 18 + 3] = i * 4 + 1;
-		bufferInfo.indexBuffer[i * 18 + 4] = i * 4 + 2;
-		bufferInfo.indexBuffer[i * 18 + 5] = (i + 1) * 4 + 1;
-
-		bufferInfo.indexBuffer[i * 18 + 6] = i * 4 + 2;
-		bufferInfo.indexBuffer[i * 18 + 7] = i * 4 + 3;
-		bufferInfo.indexBuffer[i * 18 + 8] = (i + 1) * 4 + 2;
-
-		bufferInfo.indexBuffer[i * 18 + 9] = i * 4 + 1;
-		bufferInfo.indexBuffer[i * 18 + 10] = (i + 1) * 4 + 1;
-		bufferInfo.indexBuffer[i * 18 + 11] = (i + 1) * 4;
+	mPrettyStyle = LineStyle::Continuous;
+	const unsigned int indexCount(18 * (x.size() - 1));
+	AllocateBuffer(x.size() * 4, mShareIndices ? 0 : indexCount / 3, bufferInfo);
+	AssignVertexData(x, y, LineStyle::Continuous, bufferInfo);
 
-		bufferInfo.indexBuffer[i * 18 + 12] = i * 4 + 2;
-		bufferInfo.indexBuffer[i * 18 + 13] = (i + 1) * 4 + 2;
-		bufferInfo.indexBuffer[i * 18 + 14] = (i + 1) * 4 + 1;
-
-		bufferInfo.indexBuffer[i * 18 + 15] = i * 4 + 3;
-		bufferInfo.indexBuffer[i * 18 + 16] = (i + 1) * 4 + 3;
-		bufferInfo.indexBuffer[i * 18 + 17] = (i + 1) * 4 + 2;
-	}
+	if (mShareIndices)
+		bufferInfo.sharedIndexCount = indexCount;
+	else
+		AssignContinuousIndices(bufferInfo.indexBuffer);
 
 	if (update != UpdateMethod::Immediate)
 		return;
 
-	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
-
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), mHint);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(),
-		mRenderWindow.GetVertexDimension(), GL_FLOAT, GL_FALSE, 0, 0);
-
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
-		(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * 4 * points.size()));
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferInfo.GetIndexBufferIndex());
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * bufferInfo.indexBuffer.size(),
-		bufferInfo.indexBuffer.data(), mHint);
-
-	glBindVertexArray(0);
-
-	assert(!RenderWindow::GLHasError());
+	Upload(bufferInfo);
 }
 
 //=============================================================================
@@ -605,7 +802,8 @@ void Line::DoPrettyDraw(const std::vector<std::pair<double, double>> &points,
 // Description:		Draws disconnected lines using OpenGL triangles.
 //
 // Input Arguments:
-//		points	= const std::vector<std::pair<double, double>>&
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
 //		update	= const UpdateMethod&
 //
 // Output Arguments:
@@ -615,8 +813,9 @@ void Line::DoPrettyDraw(const std::vector<std::pair<double, double>> &points,
 //		None
 //
 //=============================================================================
-void Line::DoPrettySegmentDraw(const std::vector<std::pair<double, double>> &points,
-	const UpdateMethod& update, Primitive::BufferInfo& bufferInfo) const
+void Line::DoPrettySegmentDraw(const std::vector<double>& x,
+	const std::vector<double>& y, const UpdateMethod& update,
+	Primitive::BufferInfo& bufferInfo) const
 {
 	assert(!RenderWindow::GLHasError());
 	/* Draw the segments as follows:
@@ -639,73 +838,184 @@ void Line::DoPrettySegmentDraw(const std::vector<std::pair<double, double>> &poi
 	0+----+4
 	*/
 
-	assert(points.size() % 2 == 0);
-	AllocateBuffer(points.size() * 4, 6 * (points.size() / 2), bufferInfo);
-	AssignVertexData(points, LineStyle::Segments, bufferInfo);
+	assert(x.size() % 2 == 0);
+	mPrettyStyle = LineStyle::Segments;
+	const unsigned int indexCount(18 * (x.size() / 2));
+	AllocateBuffer(x.size() * 4, mShareIndices ? 0 : indexCount / 3, bufferInfo);
+	AssignVertexData(x, y, LineStyle::Segments, bufferInfo);
 
-	unsigned int i;
-	for (i = 0; i < points.size() / 2; ++i)
-	{
-		bufferInfo.indexBuffer[i * 18] = i * 8;
-		bufferInfo.indexBuffer[i * 18 + 1] = i * 8 + 1;
-		bufferInfo.indexBuffer[i * 18 + 2] = i * 8 + 4;
+	if (mShareIndices)
+		bufferInfo.sharedIndexCount = indexCount;
+	else
+		AssignSegmentIndices(bufferInfo.indexBuffer);
 
-		bufferInfo.indexBuffer[i * 18 + 3] = i * 8 + 1;
-		bufferInfo.indexBuffer[i * 18 + 4] = i * 8 + 2;
-		bufferInfo.indexBuffer[i * 18 + 5] = i * 8 + 5;
+	if (update != UpdateMethod::Immediate)
+		return;
 
-		bufferInfo.indexBuffer[i * 18 + 6] = i * 8 + 2;
-		bufferInfo.indexBuffer[i * 18 + 7] = i * 8 + 3;
-		bufferInfo.indexBuffer[i * 18 + 8] = i * 8 + 6;
+	Upload(bufferInfo);
+}
 
-		bufferInfo.indexBuffer[i * 18 + 9] = i * 8 + 1;
-		bufferInfo.indexBuffer[i * 18 + 10] = i * 8 + 5;
-		bufferInfo.indexBuffer[i * 18 + 11] = i * 8 + 4;
+//=============================================================================
+// Class:			Line
+// Function:		AssignContinuousIndices
+//
+// Description:		Fills the specified vector with the indices for rendering
+//					a continuous pretty line (18 per segment).  The indices
+//					depend only on the number of segments, so one set may be
+//					shared among all lines.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		indices	= std::vector<unsigned int>& (already sized as required)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::AssignContinuousIndices(std::vector<unsigned int>& indices)
+{
+	assert(indices.size() % 18 == 0);
 
-		bufferInfo.indexBuffer[i * 18 + 12] = i * 8 + 2;
-		bufferInfo.indexBuffer[i * 18 + 13] = i * 8 + 6;
-		bufferInfo.indexBuffer[i * 18 + 14] = i * 8 + 5;
+	RenderWindow::GetThreadPool().ParallelFor(indices.size() / 18,
+		mPointsPerBlock, [&indices](const unsigned int& begin,
+		const unsigned int& end)
+	{
+		unsigned int i;
+		for (i = begin; i < end; ++i)
+		{
+			indices[i * 18] = i * 4;
+			indices[i * 18 + 1] = i * 4 + 1;
+			indices[i * 18 + 2] = (i + 1) * 4;
+
+			indices[i * 18 + 3] = i * 4 + 1;
+			indices[i * 18 + 4] = i * 4 + 2;
+			indices[i * 18 + 5] = (i + 1) * 4 + 1;
+
+			indices[i * 18 + 6] = i * 4 + 2;
+			indices[i * 18 + 7] = i * 4 + 3;
+			indices[i * 18 + 8] = (i + 1) * 4 + 2;
+
+			indices[i * 18 + 9] = i * 4 + 1;
+			indices[i * 18 + 10] = (i + 1) * 4 + 1;
+			indices[i * 18 + 11] = (i + 1) * 4;
+
+			indices[i * 18 + 12] = i * 4 + 2;
+			indices[i * 18 + 13] = (i + 1) * 4 + 2;
+			indices[i * 18 + 14] = (i + 1) * 4 + 1;
+
+			indices[i * 18 + 15] = i * 4 + 3;
+			indices[i * 18 + 16] = (i + 1) * 4 + 3;
+			indices[i * 18 + 17] = (i + 1) * 4 + 2;
+		}
+	});
+}
 
-		bufferInfo.indexBuffer[i * 18 + 15] = i * 8 + 3;
-		bufferInfo.indexBuffer[i * 18 + 16] = i * 8 + 7;
-		bufferInfo.indexBuffer[i * 18 + 17] = i * 8 + 6;
-	}
+//=============================================================================
+// Class:			Line
+// Function:		AssignSegmentIndices
+//
+// Description:		Fills the specified vector with the indices for rendering
+//					disconnected pretty line segments (18 per segment).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		indices	= std::vector<unsigned int>& (already sized as required)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::AssignSegmentIndices(std::vector<unsigned int>& indices)
+{
+	assert(indices.size() % 18 == 0);
 
-	if (update != UpdateMethod::Immediate)
-		return;
+	unsigned int i;
+	for (i = 0; i < indices.size() / 18; ++i)
+	{
+		indices[i * 18] = i * 8;
+		indices[i * 18 + 1] = i * 8 + 1;
+		indices[i * 18 + 2] = i * 8 + 4;
 
-	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+		indices[i * 18 + 3] = i * 8 + 1;
+		indices[i * 18 + 4] = i * 8 + 2;
+		indices[i * 18 + 5] = i * 8 + 5;
 
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), mHint);
+		indices[i * 18 + 6] = i * 8 + 2;
+		indices[i * 18 + 7] = i * 8 + 3;
+		indices[i * 18 + 8] = i * 8 + 6;
 
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(),
-		mRenderWindow.GetVertexDimension(), GL_FLOAT, GL_FALSE, 0, 0);
+		indices[i * 18 + 9] = i * 8 + 1;
+		indices[i * 18 + 10] = i * 8 + 5;
+		indices[i * 18 + 11] = i * 8 + 4;
 
-	glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
-	glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
-		(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * 4 * points.size()));
+		indices[i * 18 + 12] = i * 8 + 2;
+		indices[i * 18 + 13] = i * 8 + 6;
+		indices[i * 18 + 14] = i * 8 + 5;
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferInfo.GetIndexBufferIndex());
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * bufferInfo.indexBuffer.size(),
-		bufferInfo.indexBuffer.data(), mHint);
+		indices[i * 18 + 15] = i * 8 + 3;
+		indices[i * 18 + 16] = i * 8 + 7;
+		indices[i * 18 + 17] = i * 8 + 6;
+	}
+}
 
-	glBindVertexArray(0);
+//=============================================================================
+// Class:			Line
+// Function:		AssignVertexData
+//
+// Description:		Assigns vertex data to the vertex buffer (pretty lines).
+//					Long lines are split into blocks which are processed by
+//					the shared thread pool.
+//
+// Input Arguments:
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
+//		style	= const LineStyle&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::AssignVertexData(const std::vector<double>& x,
+	const std::vector<double>& y, const LineStyle& style,
+	Primitive::BufferInfo& bufferInfo) const
+{
+	assert(x.size() == y.size());
+	assert(x.size() > 1);
 
-	assert(!RenderWindow::GLHasError());
+	RenderWindow::GetThreadPool().ParallelFor(x.size(), mPointsPerBlock,
+		[this, &x, &y, &style, &bufferInfo](
+		const unsigned int& begin, const unsigned int& end)
+	{
+		AssignVertexData(x, y, style, begin, end, bufferInfo);
+	});
 }
 
 //=============================================================================
 // Class:			Line
 // Function:		AssignVertexData
 //
-// Description:		Assigns vertex data to the vertex buffer (pretty lines).
+// Description:		Assigns vertex data for the specified range of points to
+//					the vertex buffer (pretty lines).  Reads only from the
+//					point lists and writes only to the portion of the buffer
+//					corresponding to the specified range, so multiple ranges
+//					may be processed concurrently.  The offsets are computed
+//					with array operations, and the loop which expands each
+//					point into vertices has no branches, so both can make use
+//					of SIMD instructions.
 //
 // Input Arguments:
-//		points	= const std::vector<std::pair<double, double>>&
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
 //		style	= const LineStyle&
+//		begin	= const unsigned int&
+//		end		= const unsigned int&
 //
 // Output Arguments:
 //		bufferInfo	= Primitive::BufferInfo&
@@ -714,62 +1024,88 @@ void Line::DoPrettySegmentDraw(const std::vector<std::pair<double, double>> &poi
 //		None
 //
 //=============================================================================
-void Line::AssignVertexData(const std::vector<std::pair<double, double>>& points,
-	const LineStyle& style, Primitive::BufferInfo& bufferInfo) const
+void Line::AssignVertexData(const std::vector<double>& x,
+	const std::vector<double>& y, const LineStyle& style,
+	const unsigned int& begin, const unsigned int& end,
+	Primitive::BufferInfo& bufferInfo) const
 {
-	std::vector<Offsets> offsets(points.size());
-	const unsigned int dimension(mRenderWindow.GetVertexDimension());
-	const unsigned int colorStart(dimension * 4 * points.size());
-	unsigned int i;
-	for (i = 0; i < points.size(); ++i)
+	assert(mRenderWindow.GetVertexDimension() == 2);
+
+	const Eigen::Index count(end - begin);
+	Eigen::ArrayXd dxLine(count);
+	Eigen::ArrayXd dyLine(count);
+	if (style == LineStyle::Segments)
+		ComputeSegmentOffsets(x, y, begin, end, dxLine, dyLine);
+	else
+		ComputeContinuousOffsets(x, y, begin, end, dxLine, dyLine);
+
+	// The edge vertices are further along the same direction
+	const double edgeScale((mHalfWidth + mFadeDistance) / mHalfWidth);
+
+	// Each point becomes four two-dimensional vertices, ordered edge, line,
+	// line, edge
+	const double* xPoint(x.data() + begin);
+	const double* yPoint(y.data() + begin);
+	const double* dx(dxLine.data());
+	const double* dy(dyLine.data());
+	float* vertex(bufferInfo.vertexBuffer.data() + begin * 8);
+
+	Eigen::Index i;
+	for (i = 0; i < count; ++i)
 	{
-		if (i == 0 || (style == LineStyle::Segments && i % 2 == 0))
-			ComputeOffsets(points[i].first, points[i].second, points[i + 1].first,
-				points[i + 1].second, offsets[i].dxLine, offsets[i].dyLine,
-				offsets[i].dxEdge, offsets[i].dyEdge);
-		else if (style == LineStyle::Segments)
-			offsets[i] = offsets[i - 1];
-		else if (i == points.size() - 1)
-			ComputeOffsets(points[i - 1].first, points[i - 1].second, points[i].first,
-				points[i].second, offsets[i].dxLine, offsets[i].dyLine,
-				offsets[i].dxEdge, offsets[i].dyEdge);
-		else
-			ComputeOffsets(points[i - 1].first, points[i - 1].second,
-				points[i].first, points[i].second, points[i + 1].first,
-				points[i + 1].second, offsets[i].dxLine, offsets[i].dyLine,
-				offsets[i].dxEdge, offsets[i].dyEdge);
-
-		bufferInfo.vertexBuffer[i * dimension * 4] = static_cast<float>((points[i].first + offsets[i].dxEdge));
-		bufferInfo.vertexBuffer[i * dimension * 4 + 1] = static_cast<float>((points[i].second + offsets[i].dyEdge));
-
-		bufferInfo.vertexBuffer[i * dimension * 4 + dimension] = static_cast<float>((points[i].first + offsets[i].dxLine));
-		bufferInfo.vertexBuffer[i * dimension * 4 + dimension + 1] = static_cast<float>((points[i].second + offsets[i].dyLine));
-
-		bufferInfo.vertexBuffer[i * dimension * 4 + 2 * dimension] = static_cast<float>((points[i].first - offsets[i].dxLine));
-		bufferInfo.vertexBuffer[i * dimension * 4 + 2 * dimension + 1] = static_cast<float>((points[i].second - offsets[i].dyLine));
-
-		bufferInfo.vertexBuffer[i * dimension * 4 + 3 * dimension] = static_cast<float>((points[i].first - offsets[i].dxEdge));
-		bufferInfo.vertexBuffer[i * dimension * 4 + 3 * dimension + 1] = static_cast<float>((points[i].second - offsets[i].dyEdge));
-
-		bufferInfo.vertexBuffer[colorStart + i * 16] = static_cast<float>(mBackgroundColor.GetRed());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 1] = static_cast<float>(mBackgroundColor.GetGreen());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 2] = static_cast<float>(mBackgroundColor.GetBlue());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 3] = static_cast<float>(mBackgroundColor.GetAlpha());
-
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 4] = static_cast<float>(mLineColor.GetRed());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 5] = static_cast<float>(mLineColor.GetGreen());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 6] = static_cast<float>(mLineColor.GetBlue());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 7] = static_cast<float>(mLineColor.GetAlpha());
-
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 8] = static_cast<float>(mLineColor.GetRed());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 9] = static_cast<float>(mLineColor.GetGreen());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 10] = static_cast<float>(mLineColor.GetBlue());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 11] = static_cast<float>(mLineColor.GetAlpha());
-
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 12] = static_cast<float>(mBackgroundColor.GetRed());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 13] = static_cast<float>(mBackgroundColor.GetGreen());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 14] = static_cast<float>(mBackgroundColor.GetBlue());
-		bufferInfo.vertexBuffer[colorStart + i * 16 + 15] = static_cast<float>(mBackgroundColor.GetAlpha());
+		const double dxEdge(dx[i] * edgeScale);
+		const double dyEdge(dy[i] * edgeScale);
+
+		vertex[i * 8] = static_cast<float>(xPoint[i] + dxEdge);
+		vertex[i * 8 + 1] = static_cast<float>(yPoint[i] + dyEdge);
+
+		vertex[i * 8 + 2] = static_cast<float>(xPoint[i] + dx[i]);
+		vertex[i * 8 + 3] = static_cast<float>(yPoint[i] + dy[i]);
+
+		vertex[i * 8 + 4] = static_cast<float>(xPoint[i] - dx[i]);
+		vertex[i * 8 + 5] = static_cast<float>(yPoint[i] - dy[i]);
+
+		vertex[i * 8 + 6] = static_cast<float>(xPoint[i] - dxEdge);
+		vertex[i * 8 + 7] = static_cast<float>(yPoint[i] - dyEdge);
+	}
+
+	if (mCompact)
+		return;
+
+	const float lineRed(static_cast<float>(mLineColor.GetRed()));
+	const float lineGreen(static_cast<float>(mLineColor.GetGreen()));
+	const float lineBlue(static_cast<float>(mLineColor.GetBlue()));
+	const float lineAlpha(static_cast<float>(mLineColor.GetAlpha()));
+	const float backgroundRed(static_cast<float>(mBackgroundColor.GetRed()));
+	const float backgroundGreen(static_cast<float>(mBackgroundColor.GetGreen()));
+	const float backgroundBlue(static_cast<float>(mBackgroundColor.GetBlue()));
+	const float backgroundAlpha(static_cast<float>(mBackgroundColor.GetAlpha()));
+
+	const unsigned int colorStart(8 * x.size());
+	float* color(bufferInfo.vertexBuffer.data() + colorStart + begin * 16);
+	for (i = 0; i < count; ++i)
+	{
+		color[0] = backgroundRed;
+		color[1] = backgroundGreen;
+		color[2] = backgroundBlue;
+		color[3] = backgroundAlpha;
+
+		color[4] = lineRed;
+		color[5] = lineGreen;
+		color[6] = lineBlue;
+		color[7] = lineAlpha;
+
+		color[8] = lineRed;
+		color[9] = lineGreen;
+		color[10] = lineBlue;
+		color[11] = lineAlpha;
+
+		color[12] = backgroundRed;
+		color[13] = backgroundGreen;
+		color[14] = backgroundBlue;
+		color[15] = backgroundAlpha;
+
+		color += 16;
 	}
 }
 
@@ -849,4 +1185,85 @@ void Line::DoPrettyDraw(const unsigned int& indexCount)
 	assert(!RenderWindow::GLHasError());
 }
 
+//=============================================================================
+// Class:			Line
+// Function:		UseCompactProgram
+//
+// Description:		Activates the program for rendering compact geometry and
+//					loads the uniforms.
+//
+// Input Arguments:
+//		modelview	= const Eigen::Matrix4d&
+//		lineColor	= const Color&
+//		edgeColor	= const Color&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Line::UseCompactProgram(const Eigen::Matrix4d& modelview,
+	const Color& lineColor, const Color& edgeColor)
+{
+	mRenderWindow.InitializePrimitiveType(*this);
+	mRenderWindow.UseProgram(mRenderWindow.GetPrimitiveTypeProgram<Line>());
+	const auto& uniforms(mRenderWindow.GetActiveProgramInfo().uniformLocations);
+
+	RenderWindow::SendUniformMatrix(modelview,
+		uniforms.find(RenderWindow::mModelviewName)->second);
+	glUniform4f(uniforms.find(mLineColorName)->second,
+		static_cast<GLfloat>(lineColor.GetRed()),
+		static_cast<GLfloat>(lineColor.GetGreen()),
+		static_cast<GLfloat>(lineColor.GetBlue()),
+		static_cast<GLfloat>(lineColor.GetAlpha()));
+	glUniform4f(uniforms.find(mEdgeColorName)->second,
+		static_cast<GLfloat>(edgeColor.GetRed()),
+		static_cast<GLfloat>(edgeColor.GetGreen()),
+		static_cast<GLfloat>(edgeColor.GetBlue()),
+		static_cast<GLfloat>(edgeColor.GetAlpha()));
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			Line
+// Function:		DoGLInitialization
+//
+// Description:		Performs necessary context-state initialization (creates
+//					the program for rendering compact geometry).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint Line::DoGLInitialization()
+{
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mCompactVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mCompactFragmentShader));
+
+	RenderWindow::ShaderInfo s;
+	s.programId = mRenderWindow.BuildProgram(shaders);
+	s.needsModelview = false;
+	s.needsProjection = true;
+	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
+	s.uniformLocations[RenderWindow::mModelviewName] = glGetUniformLocation(s.programId, RenderWindow::mModelviewName.c_str());
+	s.uniformLocations[mLineColorName] = glGetUniformLocation(s.programId, mLineColorName.c_str());
+	s.uniformLocations[mEdgeColorName] = glGetUniformLocation(s.programId, mEdgeColorName.c_str());
+
+	assert(!RenderWindow::GLHasError());
+
+	s.attributeLocations["position"] = mCompactPositionLocation;
+
+	return mRenderWindow.AddShader(s);
+}
+
 }// namespace LibPlot2D
@@ -0,0 +1,288 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  marker.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Object representing data markers, drawn as instanced quads with the
+//        shape determined by the fragment shader.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/marker.h"
+#include "lp2d/renderer/renderWindow.h"
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			Marker
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for Marker class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string Marker::mHalfSizeName("halfSize");
+const std::string Marker::mShapeName("shape");
+const std::string Marker::mMarkerColorName("markerColor");
+
+const GLuint Marker::mCenterLocation(0);
+
+const unsigned int Marker::mVerticesPerMarker(4);
+
+//=============================================================================
+// Class:			Marker
+// Function:		mVertexShader
+//
+// Description:		Marker vertex shader.  Each instance is one marker, drawn
+//					as a triangle strip of four vertices.  The quad extends
+//					one pixel beyond the marker to leave room for
+//					anti-aliasing.  Offsets are computed in pixels, so the
+//					modelview matrix must take marker positions to pixels.
+//
+// Input Arguments:
+//		0	= center
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string Marker::mVertexShader(
+	"#version 400\n"
+	"\n"
+	"uniform mat4 projectionMatrix;\n"
+	"uniform mat4 modelviewMatrix;\n"
+	"uniform float halfSize;\n"
+	"\n"
+	"layout(location = 0) in vec2 center;\n"
+	"\n"
+	"out vec2 offset;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    vec2 corner = vec2((gl_VertexID & 1) == 1 ? 1.0 : -1.0,\n"
+	"        (gl_VertexID & 2) == 2 ? 1.0 : -1.0);\n"
+	"    offset = corner * (halfSize + 1.0);\n"
+	"\n"
+	"    vec2 point = (modelviewMatrix * vec4(center, 0.0, 1.0)).xy + offset;\n"
+	"    gl_Position = projectionMatrix * vec4(point, 0.0, 1.0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			Marker
+// Function:		mFragmentShader
+//
+// Description:		Marker fragment shader.  Computes the fraction of each
+//					pixel covered by the marker shape (0 = square,
+//					1 = circle, 2 = cross).
+//
+// Input Arguments:
+//		0	= offset
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string Marker::mFragmentShader(
+	"#version 400\n"
+	"\n"
+	"uniform float halfSize;\n"
+	"uniform int shape;\n"
+	"uniform vec4 markerColor;\n"
+	"\n"
+	"in vec2 offset;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    vec2 distance = abs(offset);\n"
+	"    float coverage = clamp(halfSize + 0.5 - max(distance.x, distance.y), 0.0, 1.0);\n"
+	"    if (shape == 1)\n"
+	"        coverage = clamp(halfSize + 0.5 - length(offset), 0.0, 1.0);\n"
+	"    else if (shape == 2)\n"
+	"    {\n"
+	"        float armHalfWidth = max(0.5, 0.2 * halfSize);\n"
+	"        coverage = min(coverage,\n"
+	"            clamp(armHalfWidth + 0.5 - min(distance.x, distance.y), 0.0, 1.0));\n"
+	"    }\n"
+	"\n"
+	"    if (coverage <= 0.0)\n"
+	"        discard;\n"
+	"\n"
+	"    outputColor = vec4(markerColor.rgb, markerColor.a * coverage);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			Marker
+// Function:		Marker
+//
+// Description:		Constructor for Marker class.
+//
+// Input Arguments:
+//		renderWindow	= RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+Marker::Marker(RenderWindow& renderWindow) : mRenderWindow(renderWindow),
+	mHint(GL_DYNAMIC_DRAW)
+{
+	SetSize(4.0);
+}
+
+//=============================================================================
+// Class:			Marker
+// Function:		Upload
+//
+// Description:		Sends the marker positions to OpenGL and configures the
+//					vertex array.
+//
+// Input Arguments:
+//		first	= const std::vector<float>::size_type&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Marker::Upload(Primitive::BufferInfo& bufferInfo,
+	const std::vector<float>::size_type& first)
+{
+	if (bufferInfo.vertexCount == 0)
+		return;
+
+	bufferInfo.GetOpenGLIndices();
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+
+	bufferInfo.BufferVertexData(mHint, first);
+
+	// One position per instance
+	glEnableVertexAttribArray(mCenterLocation);
+	glVertexAttribPointer(mCenterLocation, 2, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribDivisor(mCenterLocation, 1);
+
+	glBindVertexArray(0);
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			Marker
+// Function:		Draw
+//
+// Description:		Renders the markers.
+//
+// Input Arguments:
+//		bufferInfo	= const Primitive::BufferInfo&
+//		modelview	= const Eigen::Matrix4d&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Marker::Draw(const Primitive::BufferInfo& bufferInfo,
+	const Eigen::Matrix4d& modelview)
+{
+	if (bufferInfo.vertexCount == 0)
+		return;
+
+	mRenderWindow.InitializePrimitiveType(*this);
+	mRenderWindow.UseProgram(mRenderWindow.GetPrimitiveTypeProgram<Marker>());
+	const auto& uniforms(mRenderWindow.GetActiveProgramInfo().uniformLocations);
+
+	RenderWindow::SendUniformMatrix(modelview,
+		uniforms.find(RenderWindow::mModelviewName)->second);
+	glUniform1f(uniforms.find(mHalfSizeName)->second,
+		static_cast<GLfloat>(mHalfSize));
+	glUniform1i(uniforms.find(mShapeName)->second, static_cast<GLint>(mShape));
+	glUniform4f(uniforms.find(mMarkerColorName)->second,
+		static_cast<GLfloat>(mColor.GetRed()),
+		static_cast<GLfloat>(mColor.GetGreen()),
+		static_cast<GLfloat>(mColor.GetBlue()),
+		static_cast<GLfloat>(mColor.GetAlpha()));
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, mVerticesPerMarker,
+		bufferInfo.vertexCount);
+	glBindVertexArray(0);
+
+	mRenderWindow.UseDefaultProgram();
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			Marker
+// Function:		DoGLInitialization
+//
+// Description:		Performs necessary context-state initialization.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint Marker::DoGLInitialization()
+{
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mFragmentShader));
+
+	RenderWindow::ShaderInfo s;
+	s.programId = mRenderWindow.BuildProgram(shaders);
+	s.needsModelview = false;
+	s.needsProjection = true;
+	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
+	s.uniformLocations[RenderWindow::mModelviewName] = glGetUniformLocation(s.programId, RenderWindow::mModelviewName.c_str());
+	s.uniformLocations[mHalfSizeName] = glGetUniformLocation(s.programId, mHalfSizeName.c_str());
+	s.uniformLocations[mShapeName] = glGetUniformLocation(s.programId, mShapeName.c_str());
+	s.uniformLocations[mMarkerColorName] = glGetUniformLocation(s.programId, mMarkerColorName.c_str());
+
+	assert(!RenderWindow::GLHasError());
+
+	s.attributeLocations["center"] = mCenterLocation;
+
+	return mRenderWindow.AddShader(s);
+}
+
+}// namespace LibPlot2D
@@ -25,6 +25,7 @@
 #include <wx/file.h>
 #include <wx/clipbrd.h>
 #include <wx/colordlg.h>
+#include <wx/display.h>
 
 // Local headers
 #include "lp2d/renderer/plotRenderer.h"
@@ -36,8 +37,11 @@
 #include "lp2d/renderer/primitives/plotCursor.h"
 #include "lp2d/renderer/primitives/axis.h"
 #include "lp2d/renderer/primitives/legend.h"
+#include "lp2d/renderer/primitives/textRendering.h"
 #include "lp2d/utilities/math/plotMath.h"
 #include "lp2d/utilities/guiUtilities.h"
+#include "lp2d/utilities/dataset2D.h"
+#include "lp2d/utilities/tiledDataset.h"
 
 namespace LibPlot2D
 {
@@ -60,6 +64,9 @@ namespace LibPlot2D
 //=============================================================================
 const unsigned int PlotRenderer::mMaxXTicks(7);
 const unsigned int PlotRenderer::mMaxYTicks(10);
+const int PlotRenderer::mDefaultRefreshRate(60);// [Hz]
+const unsigned int PlotRenderer::mMinPreviewPoints(10000);
+const unsigned int PlotRenderer::mMaxPreviewPoints(10000000);
 
 //=============================================================================
 // Class:			PlotRenderer
@@ -117,7 +124,8 @@ const std::string PlotRenderer::mDefaultVertexShader(
 //=============================================================================
 PlotRenderer::PlotRenderer(GuiInterface& guiInterface, wxWindow &parent,
 	wxWindowID id, const wxGLAttributes& attr) : RenderWindow(parent, id, attr,
-	wxDefaultPosition, wxDefaultSize), mGuiInterface(guiInterface)
+	wxDefaultPosition, wxDefaultSize), mFrameTimer(this, idFrameTimer),
+	mRefinementTimer(this, idRefinementTimer), mGuiInterface(guiInterface)
 {
 	SetView3D(false);
 	SetDropTarget(static_cast<wxDropTarget*>(new DropTarget(guiInterface)));
@@ -125,6 +133,30 @@ PlotRenderer::PlotRenderer(GuiInterface& guiInterface, wxWindow &parent,
 	guiInterface.SetRenderWindow(this);
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		~PlotRenderer
+//
+// Description:		Destructor for PlotRenderer class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+PlotRenderer::~PlotRenderer()
+{
+	// Drawing uses methods of this class, so it must finish before the
+	// members are destroyed (but there's no point applying queued changes)
+	DiscardSceneChanges();
+	WaitForRenderThread();
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		Event Tables
@@ -143,6 +175,9 @@ PlotRenderer::PlotRenderer(GuiInterface& guiInterface, wxWindow &parent,
 //=============================================================================
 BEGIN_EVENT_TABLE(PlotRenderer, RenderWindow)
 	EVT_SIZE(PlotRenderer::OnSize)
+	EVT_PAINT(PlotRenderer::OnPaint)
+	EVT_TIMER(idFrameTimer,							PlotRenderer::OnFrameTimer)
+	EVT_TIMER(idRefinementTimer,					PlotRenderer::OnRefinementTimer)
 
 	// Interaction events
 	EVT_MOUSEWHEEL(									PlotRenderer::OnMouseWheelEvent)
@@ -208,6 +243,9 @@ END_EVENT_TABLE()
 // Function:		UpdateDisplay
 //
 // Description:		Updates the displayed plots to match the current data.
+//					The scene is rendered before returning, unless a frame is
+//					being drawn, in which case the update is combined with
+//					the frame which follows it.
 //
 // Input Arguments:
 //		None
@@ -220,6 +258,354 @@ END_EVENT_TABLE()
 //
 //=============================================================================
 void PlotRenderer::UpdateDisplay()
+{
+	// Rather than waiting for the frame being drawn, the update is made when
+	// the window is next painted (after queued scene changes are applied)
+	if (IsFrameInProgress())
+	{
+		mFrameTimer.Stop();
+		mUpdatePending = true;
+		mPlotUpdatePending = true;
+		Refresh();
+		return;
+	}
+
+	// Satisfies any scheduled update, too
+	mFrameTimer.Stop();
+	mUpdatePending = false;
+	mPlotUpdatePending = false;
+
+	UpdatePlot();
+	Refresh();
+	Update();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		ScheduleUpdate
+//
+// Description:		Requests that the displayed plots be updated in response
+//					to user input.  Rendering is deferred until the window is
+//					next painted (after pending events have been handled), and
+//					is limited to once per display refresh interval.
+//
+// Input Arguments:
+//		userInput	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::ScheduleUpdate(const bool& userInput)
+{
+	mPlotUpdatePending = true;
+	ScheduleFrame(userInput);
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		ScheduleFrame
+//
+// Description:		Requests that the scene be rendered, subject to the same
+//					limits as ScheduleUpdate(), but without updating the plot.
+//					Used when only overlays (cursors, legend, zoom box) have
+//					changed, so the cached image of the plot can be re-used.
+//
+// Input Arguments:
+//		userInput	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::ScheduleFrame(const bool& userInput)
+{
+	const auto now(std::chrono::steady_clock::now());
+	if (userInput && !mInputPending)
+	{
+		mOldestInputTime = now;
+		mInputPending = true;
+	}
+
+	// If a frame has already been requested, it will reflect this input, too
+	if (mUpdatePending)
+		return;
+
+	mUpdatePending = true;
+	const auto elapsed(now - mLastFrameTime);
+	const auto interval(GetFrameInterval());
+	if (elapsed >= interval)
+		Refresh();
+	else
+		mFrameTimer.StartOnce(static_cast<int>(std::chrono::duration_cast<
+			std::chrono::milliseconds>(interval - elapsed).count()) + 1);
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetFrameInterval
+//
+// Description:		Returns the refresh interval of the display on which this
+//					window is shown.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::chrono::steady_clock::duration
+//
+//=============================================================================
+std::chrono::steady_clock::duration PlotRenderer::GetFrameInterval() const
+{
+	int refreshRate(0);
+	const int display(wxDisplay::GetFromWindow(this));
+	if (display != wxNOT_FOUND)
+		refreshRate = wxDisplay(static_cast<unsigned int>(display)).GetCurrentMode().refresh;
+
+	// Not all platforms report the refresh rate
+	if (refreshRate <= 0)
+		refreshRate = mDefaultRefreshRate;
+
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::microseconds(1000000 / refreshRate));
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		OnFrameTimer
+//
+// Description:		Handles timer events for deferred frames.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::OnFrameTimer(wxTimerEvent& WXUNUSED(event))
+{
+	Refresh();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		OnPaint
+//
+// Description:		Handles EVT_PAINT events for this class.  Performs any
+//					scheduled update prior to rendering.
+//
+// Input Arguments:
+//		event	= wxPaintEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::OnPaint(wxPaintEvent& WXUNUSED(event))
+{
+	// The scene can't be updated until the frame being drawn is complete, so
+	// the paint is only noted (another frame follows the current one)
+	if (IsFrameInProgress())
+	{
+		Render();
+		return;
+	}
+
+	mFrameStart = std::chrono::steady_clock::now();
+	if (mUpdatePending)
+	{
+		mFrameTimer.Stop();
+		mUpdatePending = false;
+		if (mPlotUpdatePending)
+		{
+			mPlotUpdatePending = false;
+			UpdatePlot();
+		}
+	}
+
+	if (mShowStatistics && mStatisticsText)
+		UpdateStatisticsOverlay();
+
+	Render();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		FrameRendered
+//
+// Description:		Records the input-to-display latency once a frame has been
+//					displayed.  When drawing previews, the time required for
+//					the frame is used to adjust the level of detail for
+//					subsequent frames.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::FrameRendered()
+{
+	mLastFrameTime = std::chrono::steady_clock::now();
+	if (mInputPending)
+	{
+		mInputLatency = std::chrono::duration<double>(
+			mLastFrameTime - mOldestInputTime).count();
+		mInputPending = false;
+
+		if (GetRenderStatistics())
+			GetRenderStatistics()->RecordInputLatency(mInputLatency);
+	}
+
+	if (mPlot->GetPreviewCurves())
+		AdjustPreviewBudget(std::chrono::duration<double>(
+			mLastFrameTime - mFrameStart).count());
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		BeginInteraction
+//
+// Description:		Switches to drawing curve previews (if progressive
+//					rendering is enabled) and restarts the refinement timer.
+//					Called for each interaction event.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::BeginInteraction()
+{
+	if (!mPlot->GetProgressiveCurves())
+		return;
+
+	mPlot->SetPreviewCurves(true);
+	mRefinementTimer.StartOnce(static_cast<int>(mRefinementDelay * 1000.0));
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		EndInteraction
+//
+// Description:		Switches back to drawing full-fidelity curves.  The caller
+//					is responsible for updating the display.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::EndInteraction()
+{
+	mRefinementTimer.Stop();
+	mPlot->SetPreviewCurves(false);
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		OnRefinementTimer
+//
+// Description:		Handles timer events indicating that interaction has
+//					stopped long enough for curves to be refined.
+//
+// Input Arguments:
+//		event	= wxTimerEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::OnRefinementTimer(wxTimerEvent& WXUNUSED(event))
+{
+	EndInteraction();
+	ScheduleUpdate(false);
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		AdjustPreviewBudget
+//
+// Description:		Scales the number of points used for curve previews so
+//					that frames are rendered within the preview frame budget.
+//					Changes are limited per frame (and small errors are
+//					ignored) to avoid oscillating between levels of detail.
+//
+// Input Arguments:
+//		frameTime	= const double& [sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::AdjustPreviewBudget(const double& frameTime)
+{
+	if (frameTime <= 0.0 || (frameTime <= mPreviewFrameBudget &&
+		frameTime >= 0.5 * mPreviewFrameBudget))
+		return;
+
+	const double factor(std::min(std::max(mPreviewFrameBudget / frameTime,
+		0.5), 2.0));
+	const double budget(mPlot->GetPreviewPointBudget() * factor);
+	mPlot->SetPreviewPointBudget(static_cast<unsigned int>(std::min(std::max(
+		budget, static_cast<double>(mMinPreviewPoints)),
+		static_cast<double>(mMaxPreviewPoints))));
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		UpdatePlot
+//
+// Description:		Updates the plot objects to match the current data and
+//					settings (without rendering).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::UpdatePlot()
 {
 	if (GetXLogarithmic())
 		mXScaleFunction = DoLogarithmicScale;
@@ -236,9 +622,12 @@ void PlotRenderer::UpdateDisplay()
 	else
 		mRightYScaleFunction = DoLineaerScale;
 
+	const auto start(std::chrono::steady_clock::now());
 	mPlot->Update();
-	Refresh();
-	Update();
+
+	if (GetRenderStatistics())
+		GetRenderStatistics()->RecordSceneUpdate(std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count());
 }
 
 //=============================================================================
@@ -302,21 +691,50 @@ void PlotRenderer::OnSize(wxSizeEvent &event)
 {
 	mIgnoreNextMouseMove = true;
 
-	if (mLeftCursor->GetIsVisible())
-		mLeftCursor->SetVisibility(true);
-	if (mRightCursor->GetIsVisible())
-		mRightCursor->SetVisibility(true);
+	ModifyScene([this]()
+	{
+		if (mLeftCursor->GetIsVisible())
+			mLeftCursor->SetVisibility(true);
+		if (mRightCursor->GetIsVisible())
+			mRightCursor->SetVisibility(true);
 
-	if (mLegend)
-		mLegend->SetModified();
+		if (mLegend)
+			mLegend->SetModified();
 
-	mPlot->UpdatePlotAreaSize();
+		mPlot->UpdatePlotAreaSize();
+	});
 	UpdateDisplay();
 
 	// Skip this event so the base class OnSize event fires, too
 	event.Skip();
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		UpdateRenderSize
+//
+// Description:		Updates the plot layout when the render size changes
+//					without a size event (i.e. for offscreen rendering).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::UpdateRenderSize()
+{
+	if (mLegend)
+		mLegend->SetModified();
+
+	mPlot->UpdatePlotAreaSize();
+	UpdatePlot();
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		OnMouseWheelEvent
@@ -366,7 +784,8 @@ void PlotRenderer::OnMouseWheelEvent(wxMouseEvent &event)
 	mPlot->SetRightYMin(mPlot->GetRightYMin() + yRightDelta);
 	mPlot->SetRightYMax(mPlot->GetRightYMax() - yRightDelta);
 
-	UpdateDisplay();
+	BeginInteraction();
+	ScheduleUpdate();
 }
 
 //=============================================================================
@@ -406,30 +825,66 @@ void PlotRenderer::OnMouseMoveEvent(wxMouseEvent &event)
 		return;
 	}
 
+	// Dragging the legend, cursors or zoom box changes only the overlays, so
+	// the plot itself is not updated (the overlays are modified once any
+	// frame being drawn is complete)
+	bool overlayOnly(true);
 	if (mDraggingLegend && mLegend)
-		mLegend->SetDeltaPosition(event.GetX() - mLastMousePosition[0], mLastMousePosition[1] - event.GetY());
-	else if (mDraggingLeftCursor)
-		mLeftCursor->SetLocation(event.GetX());
-	else if (mDraggingRightCursor)
-		mRightCursor->SetLocation(event.GetX());
+	{
+		const double deltaX(event.GetX() - mLastMousePosition[0]);
+		const double deltaY(mLastMousePosition[1] - event.GetY());
+		ModifyScene([this, deltaX, deltaY]()
+		{
+			mLegend->SetDeltaPosition(deltaX, deltaY);
+		});
+	}
+	else if (mDraggingLeftCursor || mDraggingRightCursor)
+	{
+		const int location(event.GetX());
+		const bool leftCursor(mDraggingLeftCursor);
+		ModifyScene([this, location, leftCursor]()
+		{
+			if (leftCursor)
+				mLeftCursor->SetLocation(location);
+			else
+				mRightCursor->SetLocation(location);
+
+			mGuiInterface.UpdateCursorValues(GetLeftCursorVisible(),
+				GetRightCursorVisible(), GetLeftCursorValue(), GetRightCursorValue());
+		});
+	}
 	// ZOOM:  Left or Right mouse button + CTRL or SHIFT
 	else if ((event.ControlDown() || event.ShiftDown()) && (event.RightIsDown() || event.LeftIsDown()))
+	{
 		ProcessZoom(event);
+		overlayOnly = false;
+	}
 	// ZOOM WITH BOX: Right mouse button
 	else if (event.RightIsDown())
 		ProcessZoomWithBox(event);
 	// PAN:  Left mouse button (includes with any buttons not caught above)
 	else if (event.LeftIsDown())
+	{
 		ProcessPan(event);
+		overlayOnly = false;
+	}
 	else// Not recognized
 	{
 		StoreMousePosition(event);
 		return;
 	}
 
+	if (overlayOnly)
+	{
+		StoreMousePosition(event);
+		ScheduleFrame(true);
+		return;
+	}
+
 	mPlot->SetPrettyCurves((mCurveQuality & CurveQuality::HighDrag) != 0);
+	BeginInteraction();
 	StoreMousePosition(event);
-	UpdateDisplay();
+	ScheduleUpdate();
 }
 
 //=============================================================================
@@ -457,15 +912,25 @@ void PlotRenderer::OnRightButtonUpEvent(wxMouseEvent &event)
 
 	mPlot->SetPrettyCurves((mCurveQuality & CurveQuality::HighStatic) != 0);
 
-	if (!mZoomBox->GetIsVisible())// TODO:  And if not zooming by dragging right mouse button
+	// The zoom box may not be shown until the frame being drawn is complete,
+	// so the decision is deferred, too (menus can't be shown while changes
+	// are applied)
+	ModifyScene([this, event]()
 	{
-		ProcessRightClick(event);
-		return;
-	}
+		if (!mZoomBox->GetIsVisible())// TODO:  And if not zooming by dragging right mouse button
+		{
+			CallAfter([this, event]() mutable
+			{
+				ProcessRightClick(event);
+			});
+			return;
+		}
 
-	ProcessZoomBoxEnd();
-	SaveCurrentZoom();
-	UpdateDisplay();
+		ProcessZoomBoxEnd();
+		SaveCurrentZoom();
+		EndInteraction();
+		UpdateDisplay();
+	});
 }
 
 //=============================================================================
@@ -682,7 +1147,10 @@ bool PlotRenderer::GetMinorGridOn() const
 //=============================================================================
 void PlotRenderer::SetMajorGridOn()
 {
-	mPlot->SetMajorGrid(true);
+	ModifyScene([this]()
+	{
+		mPlot->SetMajorGrid(true);
+	});
 	UpdateDisplay();
 }
 
@@ -704,7 +1172,10 @@ void PlotRenderer::SetMajorGridOn()
 //=============================================================================
 void PlotRenderer::SetMinorGridOn()
 {
-	mPlot->SetMinorGrid(true);
+	ModifyScene([this]()
+	{
+		mPlot->SetMinorGrid(true);
+	});
 	UpdateDisplay();
 }
 
@@ -726,7 +1197,10 @@ void PlotRenderer::SetMinorGridOn()
 //=============================================================================
 void PlotRenderer::SetMajorGridOff()
 {
-	mPlot->SetMajorGrid(false);
+	ModifyScene([this]()
+	{
+		mPlot->SetMajorGrid(false);
+	});
 	UpdateDisplay();
 }
 
@@ -748,7 +1222,10 @@ void PlotRenderer::SetMajorGridOff()
 //=============================================================================
 void PlotRenderer::SetMinorGridOff()
 {
-	mPlot->SetMinorGrid(false);
+	ModifyScene([this]()
+	{
+		mPlot->SetMinorGrid(false);
+	});
 	UpdateDisplay();
 }
 
@@ -774,6 +1251,357 @@ void PlotRenderer::SetCurveQuality(const CurveQuality& curveQuality)
 	mPlot->SetPrettyCurves((mCurveQuality & CurveQuality::HighStatic) != 0);
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetResidentCurves
+//
+// Description:		Sets the flag indicating whether or not curve geometry
+//					should be kept resident on the GPU.
+//
+// Input Arguments:
+//		resident	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetResidentCurves(const bool& resident)
+{
+	mPlot->SetResidentCurves(resident);
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetResidentCurves
+//
+// Description:		Returns the flag indicating whether or not curve geometry
+//					is kept resident on the GPU.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotRenderer::GetResidentCurves() const
+{
+	return mPlot->GetResidentCurves();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetShaderLines
+//
+// Description:		Sets the flag indicating whether or not curves should be
+//					expanded into triangles on the GPU.
+//
+// Input Arguments:
+//		shaderLines	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetShaderLines(const bool& shaderLines)
+{
+	mPlot->SetShaderLines(shaderLines);
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetShaderLines
+//
+// Description:		Returns the flag indicating whether or not curves are
+//					expanded into triangles on the GPU.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotRenderer::GetShaderLines() const
+{
+	return mPlot->GetShaderLines();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetBatchCurves
+//
+// Description:		Sets the flag indicating whether or not the lines of
+//					curves which share a y-axis should be drawn together.
+//
+// Input Arguments:
+//		batch	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetBatchCurves(const bool& batch)
+{
+	mPlot->SetBatchCurves(batch);
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetBatchCurves
+//
+// Description:		Returns the flag indicating whether or not the lines of
+//					curves which share a y-axis are drawn together.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotRenderer::GetBatchCurves() const
+{
+	return mPlot->GetBatchCurves();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetDensityCurves
+//
+// Description:		Sets the flag indicating whether or not curves should be
+//					drawn as density maps.
+//
+// Input Arguments:
+//		density	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetDensityCurves(const bool& density)
+{
+	mPlot->SetDensityCurves(density);
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetDensityCurves
+//
+// Description:		Returns the flag indicating whether or not curves are
+//					drawn as density maps.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotRenderer::GetDensityCurves() const
+{
+	return mPlot->GetDensityCurves();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetProgressiveRendering
+//
+// Description:		Sets the flag indicating whether or not curves are
+//					rendered progressively.
+//
+// Input Arguments:
+//		progressive	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetProgressiveRendering(const bool& progressive)
+{
+	EndInteraction();
+	mPlot->SetProgressiveCurves(progressive);
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetProgressiveRendering
+//
+// Description:		Returns the flag indicating whether or not curves are
+//					rendered progressively.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotRenderer::GetProgressiveRendering() const
+{
+	return mPlot->GetProgressiveCurves();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetPreviewFrameBudget
+//
+// Description:		Sets the time allowed for rendering each frame during
+//					interaction.
+//
+// Input Arguments:
+//		budget	= const double& [sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetPreviewFrameBudget(const double& budget)
+{
+	assert(budget > 0.0);
+	mPreviewFrameBudget = budget;
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetRefinementDelay
+//
+// Description:		Sets the time after the most recent interaction before
+//					curves are refined.
+//
+// Input Arguments:
+//		delay	= const double& [sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetRefinementDelay(const double& delay)
+{
+	assert(delay >= 0.0);
+	mRefinementDelay = delay;
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetShowStatistics
+//
+// Description:		Shows or hides the rendering statistics overlay.
+//
+// Input Arguments:
+//		show	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetShowStatistics(const bool& show)
+{
+	ModifyScene([this, show]()
+	{
+		mShowStatistics = show;
+		if (show)
+		{
+			SetCollectStatistics(true);
+			if (!mStatisticsText && !mPlot->GetAxisFont().empty())
+			{
+				mStatisticsText = new TextRendering(*this);
+				mStatisticsText->InitializeFonts(mPlot->GetAxisFont(), 12);
+				mStatisticsText->SetDrawOrder(3100);// Above the legend
+				mStatisticsText->SetOverlay(true);// Updated every frame
+			}
+		}
+
+		if (mStatisticsText)
+			mStatisticsText->SetVisibility(show);
+	});
+
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		UpdateStatisticsOverlay
+//
+// Description:		Updates the text of the statistics overlay with the most
+//					recent complete frame statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::UpdateStatisticsOverlay()
+{
+	const FrameStatistics statistics(GetFrameStatistics());
+	const wxString text(wxString::Format(_T("%0.1f fps   %u vertices   ")
+		_T("%0.1f kB uploaded   %u rebuilds   CPU %0.2f ms   GPU %0.2f ms   ")
+		_T("latency %0.1f ms"), statistics.framesPerSecond,
+		statistics.vertexCount, statistics.bytesUploaded / 1024.0,
+		statistics.rebuildCount, statistics.cpuTime * 1000.0,
+		std::max(statistics.gpuTime, 0.0) * 1000.0, mInputLatency * 1000.0));
+
+	// Avoid rebuilding the text if nothing has changed
+	if (text == mStatisticsText->GetText())
+		return;
+
+	const unsigned int offset(5);
+	mStatisticsText->SetText(text);
+	mStatisticsText->SetPosition(
+		mPlot->GetLeftYAxis()->GetOffsetFromWindowEdge() + offset,
+		GetRenderSize().GetHeight() - mPlot->GetTopAxis()->GetOffsetFromWindowEdge()
+		- offset - mStatisticsText->GetTextHeight());
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		LegendIsVisible
@@ -817,7 +1645,11 @@ void PlotRenderer::SetLegendOn()
 {
 	if (!mLegend)
 		return;
-	mLegend->SetVisibility(true);
+
+	ModifyScene([this]()
+	{
+		mLegend->SetVisibility(true);
+	});
 }
 
 //=============================================================================
@@ -840,7 +1672,11 @@ void PlotRenderer::SetLegendOff()
 {
 	if (!mLegend)
 		return;
-	mLegend->SetVisibility(false);
+
+	ModifyScene([this]()
+	{
+		mLegend->SetVisibility(false);
+	});
 }
 
 //=============================================================================
@@ -861,8 +1697,13 @@ void PlotRenderer::SetLegendOff()
 //=============================================================================
 void PlotRenderer::UpdateLegend(const std::vector<Legend::LegendEntryInfo> &entries)
 {
-	if (mLegend)
+	if (!mLegend)
+		return;
+
+	ModifyScene([this, entries]()
+	{
 		mLegend->SetContents(entries);
+	});
 }
 
 //=============================================================================
@@ -1009,7 +1850,10 @@ bool PlotRenderer::GetRightMinorGrid() const
 //=============================================================================
 void PlotRenderer::SetBottomMajorGrid(const bool &grid)
 {
-	mPlot->SetXMajorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetXMajorGrid(grid);
+	});
 	UpdateDisplay();
 }
 
@@ -1031,7 +1875,10 @@ void PlotRenderer::SetBottomMajorGrid(const bool &grid)
 //=============================================================================
 void PlotRenderer::SetBottomMinorGrid(const bool &grid)
 {
-	mPlot->SetXMinorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetXMinorGrid(grid);
+	});
 	UpdateDisplay();
 }
 
@@ -1053,7 +1900,10 @@ void PlotRenderer::SetBottomMinorGrid(const bool &grid)
 //=============================================================================
 void PlotRenderer::SetLeftMajorGrid(const bool &grid)
 {
-	mPlot->SetLeftYMajorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetLeftYMajorGrid(grid);
+	});
 	UpdateDisplay();
 }
 
@@ -1075,7 +1925,10 @@ void PlotRenderer::SetLeftMajorGrid(const bool &grid)
 //=============================================================================
 void PlotRenderer::SetLeftMinorGrid(const bool &grid)
 {
-	mPlot->SetLeftYMinorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetLeftYMinorGrid(grid);
+	});
 	UpdateDisplay();
 }
 
@@ -1097,7 +1950,10 @@ void PlotRenderer::SetLeftMinorGrid(const bool &grid)
 //=============================================================================
 void PlotRenderer::SetRightMajorGrid(const bool &grid)
 {
-	mPlot->SetRightYMajorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetRightYMajorGrid(grid);
+	});
 	UpdateDisplay();
 }
 
@@ -1119,7 +1975,10 @@ void PlotRenderer::SetRightMajorGrid(const bool &grid)
 //=============================================================================
 void PlotRenderer::SetRightMinorGrid(const bool &grid)
 {
-	mPlot->SetRightYMinorGrid(grid);
+	ModifyScene([this, grid]()
+	{
+		mPlot->SetRightYMinorGrid(grid);
+	});
 	UpdateDisplay();
 	SaveCurrentZoom();
 }
@@ -1282,7 +2141,105 @@ void PlotRenderer::SetCurveProperties(const unsigned int &index, const Color &co
 									  const bool &visible, const bool &rightAxis,
 									  const double &lineSize, const int &markerSize)
 {
-	mPlot->SetCurveProperties(index, color, visible, rightAxis, lineSize, markerSize);
+	ModifyScene([this, index, color, visible, rightAxis, lineSize, markerSize]()
+	{
+		mPlot->SetCurveProperties(index, color, visible, rightAxis, lineSize, markerSize);
+	});
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetCurveDataModified
+//
+// Description:		Indicates that the data for the specified curve has been
+//					modified in place.
+//
+// Input Arguments:
+//		index	= const unsigned int& specifying the curve
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetCurveDataModified(const unsigned int &index)
+{
+	CurveSource& source(mCurveSources[index]);
+	if (!source.copied)
+	{
+		// The curve references the caller's data, which may be modified again
+		// once we return
+		WaitForRenderThread();
+		mPlot->SetCurveDataModified(index);
+		UpdateDisplay();
+		return;
+	}
+
+	// Otherwise, the curve's copy is replaced once the frame is complete
+	auto copy(std::make_shared<Dataset2D>(*source.data));
+	source.pointCount = copy->GetNumberOfPoints();
+	ModifyScene([this, index, copy]()
+	{
+		mPlot->SetCurveDataModified(index, std::move(*copy));
+	});
+
+	UpdateDisplay();
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		SetCurveDataAppended
+//
+// Description:		Indicates that points have been added to the end of the
+//					data for the specified curve.
+//
+// Input Arguments:
+//		index	= const unsigned int& specifying the curve
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::SetCurveDataAppended(const unsigned int &index)
+{
+	CurveSource& source(mCurveSources[index]);
+	if (!source.copied)
+	{
+		// As with SetCurveDataModified()
+		WaitForRenderThread();
+		mPlot->SetCurveDataAppended(index);
+		UpdateDisplay();
+		return;
+	}
+
+	const std::vector<double>::size_type start(source.pointCount);
+	const std::vector<double>::size_type count(
+		source.data->GetNumberOfPoints());
+	if (count < start)
+	{
+		SetCurveDataModified(index);
+		return;
+	}
+
+	// Only the new points are copied
+	auto appended(std::make_shared<Dataset2D>(count - start));
+	std::copy(source.data->GetX().begin() + start, source.data->GetX().end(),
+		appended->GetX().begin());
+	std::copy(source.data->GetY().begin() + start, source.data->GetY().end(),
+		appended->GetY().begin());
+	source.pointCount = count;
+
+	ModifyScene([this, index, appended]()
+	{
+		mPlot->SetCurveDataAppended(index, *appended);
+	});
+
 	UpdateDisplay();
 }
 
@@ -1403,7 +2360,67 @@ void PlotRenderer::SetRightYLimits(const double &min, const double &max)
 //=============================================================================
 void PlotRenderer::AddCurve(const Dataset2D &data)
 {
-	mPlot->AddCurve(data);
+	// While frames are drawn on another thread, the curve draws a copy of the
+	// data, so the caller's data is never read by the render thread
+	const bool copy(GetThreadedRendering());
+	mCurveSources.push_back({ &data, nullptr, copy,
+		data.GetNumberOfPoints() });
+
+	if (!copy)
+	{
+		mPlot->AddCurve(data);
+		return;
+	}
+
+	auto snapshot(std::make_shared<Dataset2D>(data));
+	++mQueuedCurveChanges;
+	ModifyScene([this, snapshot]()
+	{
+		mPlot->AddCurve(snapshot);
+		--mQueuedCurveChanges;
+	});
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		AddCurve
+//
+// Description:		Adds an out-of-core curve to the plot.
+//
+// Input Arguments:
+//		data	= TiledDataset& to be plotted
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::AddCurve(TiledDataset &data)
+{
+	const bool copy(GetThreadedRendering());
+	mCurveSources.push_back({ &data.GetData(), &data, copy, 0 });
+
+	if (!copy)
+	{
+		mPlot->AddCurve(data);
+		return;
+	}
+
+	// No curve draws the data set's own view, so it can be built now (and
+	// the curve's copy is refreshed from it as the view changes)
+	mPlot->PrepareTiledDataset(data);
+	auto snapshot(std::make_shared<Dataset2D>(data.GetData()));
+	mCurveSources.back().pointCount = snapshot->GetNumberOfPoints();
+
+	TiledDataset* tiled(&data);
+	++mQueuedCurveChanges;
+	ModifyScene([this, snapshot, tiled]()
+	{
+		mPlot->AddCurve(snapshot, tiled);
+		--mQueuedCurveChanges;
+	});
 }
 
 //=============================================================================
@@ -1424,10 +2441,33 @@ void PlotRenderer::AddCurve(const Dataset2D &data)
 //=============================================================================
 void PlotRenderer::RemoveAllCurves()
 {
-	mPlot->RemoveExistingPlots();
+	bool copied(true);
+	for (const auto& source : mCurveSources)
+	{
+		copied = copied && source.copied;
+		if (source.copied && source.tiled)
+			source.tiled->SetLoadCallback(nullptr);
+	}
 
-	if (mPlot->GetCurveCount() == 0)
+	mCurveSources.clear();
+
+	// Curves which reference the caller's data must be removed before the
+	// data is destroyed
+	if (!copied)
+	{
+		WaitForRenderThread();
+		mPlot->RemoveExistingPlots();
+		ClearZoomStack();
+		return;
+	}
+
+	++mQueuedCurveChanges;
+	ModifyScene([this]()
+	{
+		mPlot->RemoveExistingPlots();
 		ClearZoomStack();
+		--mQueuedCurveChanges;
+	});
 }
 
 //=============================================================================
@@ -1448,10 +2488,33 @@ void PlotRenderer::RemoveAllCurves()
 //=============================================================================
 void PlotRenderer::RemoveCurve(const unsigned int& index)
 {
-	mPlot->RemovePlot(index);
+	const CurveSource source(mCurveSources[index]);
+	mCurveSources.erase(mCurveSources.begin() + index);
 
-	if (mPlot->GetCurveCount() == 0)
-		ClearZoomStack();
+	// As in RemoveAllCurves()
+	if (!source.copied)
+	{
+		WaitForRenderThread();
+		mPlot->RemovePlot(index);
+
+		if (mPlot->GetCurveCount() == 0)
+			ClearZoomStack();
+		return;
+	}
+
+	// Otherwise, the curve's copy lives on until the frame is complete
+	if (source.tiled)
+		source.tiled->SetLoadCallback(nullptr);
+
+	++mQueuedCurveChanges;
+	ModifyScene([this, index]()
+	{
+		mPlot->RemovePlot(index);
+
+		if (mPlot->GetCurveCount() == 0)
+			ClearZoomStack();
+		--mQueuedCurveChanges;
+	});
 }
 
 //=============================================================================
@@ -1582,7 +2645,10 @@ void PlotRenderer::SetXLabel(wxString text)
 	// Also, when moved to bottom corners of the plot area, depending on window size, best anchor is reported as left/right middle instead of bottom
 	// Better solution would anchor mLegend to corner of plot area if placed within plot area, or corner of window if placed outside of plot area
 
-	mPlot->SetXLabel(text);
+	ModifyScene([this, text]()
+	{
+		mPlot->SetXLabel(text);
+	});
 	UpdateDisplay();
 }
 
@@ -1604,22 +2670,25 @@ void PlotRenderer::SetXLabel(wxString text)
 //=============================================================================
 void PlotRenderer::SetLeftYLabel(wxString text)
 {
-	const int oldOffset(mPlot->GetHorizontalAxisOffset(!mPlot->GetLeftYLabel().IsEmpty()));
-	const int newOffset(mPlot->GetHorizontalAxisOffset(!text.IsEmpty()));
-
-	if (oldOffset != newOffset)
+	ModifyScene([this, text]()
 	{
-		if (mLegend->GetWindowReference() == Legend::PositionReference::BottomCenter ||
-			mLegend->GetWindowReference() == Legend::PositionReference::Center ||
-			mLegend->GetWindowReference() == Legend::PositionReference::TopCenter)
-			mLegend->SetDeltaPosition((newOffset - oldOffset) / 2, 0);
-		else if (mLegend->GetWindowReference() == Legend::PositionReference::BottomLeft ||
-			mLegend->GetWindowReference() == Legend::PositionReference::MiddleLeft ||
-			mLegend->GetWindowReference() == Legend::PositionReference::TopLeft)
-			mLegend->SetDeltaPosition(newOffset - oldOffset, 0);
-	}
+		const int oldOffset(mPlot->GetHorizontalAxisOffset(!mPlot->GetLeftYLabel().IsEmpty()));
+		const int newOffset(mPlot->GetHorizontalAxisOffset(!text.IsEmpty()));
+
+		if (oldOffset != newOffset)
+		{
+			if (mLegend->GetWindowReference() == Legend::PositionReference::BottomCenter ||
+				mLegend->GetWindowReference() == Legend::PositionReference::Center ||
+				mLegend->GetWindowReference() == Legend::PositionReference::TopCenter)
+				mLegend->SetDeltaPosition((newOffset - oldOffset) / 2, 0);
+			else if (mLegend->GetWindowReference() == Legend::PositionReference::BottomLeft ||
+				mLegend->GetWindowReference() == Legend::PositionReference::MiddleLeft ||
+				mLegend->GetWindowReference() == Legend::PositionReference::TopLeft)
+				mLegend->SetDeltaPosition(newOffset - oldOffset, 0);
+		}
 
-	mPlot->SetLeftYLabel(text);
+		mPlot->SetLeftYLabel(text);
+	});
 	UpdateDisplay();
 }
 
@@ -1641,22 +2710,25 @@ void PlotRenderer::SetLeftYLabel(wxString text)
 //=============================================================================
 void PlotRenderer::SetRightYLabel(wxString text)
 {
-	const int oldOffset(mPlot->GetHorizontalAxisOffset(!mPlot->GetRightYLabel().IsEmpty()));
-	const int newOffset(mPlot->GetHorizontalAxisOffset(!text.IsEmpty()));
-
-	if (oldOffset != newOffset)
+	ModifyScene([this, text]()
 	{
-		if (mLegend->GetWindowReference() == Legend::PositionReference::BottomCenter ||
-			mLegend->GetWindowReference() == Legend::PositionReference::Center ||
-			mLegend->GetWindowReference() == Legend::PositionReference::TopCenter)
-			mLegend->SetDeltaPosition((newOffset - oldOffset) / 2, 0);
-		else if (mLegend->GetWindowReference() == Legend::PositionReference::BottomRight ||
-			mLegend->GetWindowReference() == Legend::PositionReference::MiddleRight ||
-			mLegend->GetWindowReference() == Legend::PositionReference::TopRight)
-			mLegend->SetDeltaPosition(oldOffset - newOffset, 0);
-	}
+		const int oldOffset(mPlot->GetHorizontalAxisOffset(!mPlot->GetRightYLabel().IsEmpty()));
+		const int newOffset(mPlot->GetHorizontalAxisOffset(!text.IsEmpty()));
+
+		if (oldOffset != newOffset)
+		{
+			if (mLegend->GetWindowReference() == Legend::PositionReference::BottomCenter ||
+				mLegend->GetWindowReference() == Legend::PositionReference::Center ||
+				mLegend->GetWindowReference() == Legend::PositionReference::TopCenter)
+				mLegend->SetDeltaPosition((newOffset - oldOffset) / 2, 0);
+			else if (mLegend->GetWindowReference() == Legend::PositionReference::BottomRight ||
+				mLegend->GetWindowReference() == Legend::PositionReference::MiddleRight ||
+				mLegend->GetWindowReference() == Legend::PositionReference::TopRight)
+				mLegend->SetDeltaPosition(oldOffset - newOffset, 0);
+		}
 
-	mPlot->SetRightYLabel(text);
+		mPlot->SetRightYLabel(text);
+	});
 	UpdateDisplay();
 }
 
@@ -1696,7 +2768,10 @@ void PlotRenderer::SetTitle(wxString text)
 	// Also, when moved to bottom corners of the plot area, depending on window size, best anchor is reported as left/right middle instead of bottom
 	// Better solution would anchor mLegend to corner of plot area if placed within plot area, or corner of window if placed outside of plot area
 
-	mPlot->SetTitle(text);
+	ModifyScene([this, text]()
+	{
+		mPlot->SetTitle(text);
+	});
 	UpdateDisplay();
 }
 
@@ -1719,8 +2794,11 @@ void PlotRenderer::SetTitle(wxString text)
 void PlotRenderer::OnMouseLeaveWindowEvent(wxMouseEvent& WXUNUSED(event))
 {
 	// Hide the mZoom box (but only if it's not already hidden!)
-	if (mZoomBox->GetIsVisible())
-		mZoomBox->SetVisibility(false);
+	ModifyScene([this]()
+	{
+		if (mZoomBox->GetIsVisible())
+			mZoomBox->SetVisibility(false);
+	});
 
 	// TODO:  Why were these lines added?  Removed them due to bug:
 	// Drag mLegend, move cursor off of screen (holding left button down), move
@@ -1755,14 +2833,20 @@ void PlotRenderer::OnDoubleClickEvent(wxMouseEvent &event)
 	unsigned int x = event.GetX();
 	unsigned int y = event.GetY();
 
-	// If the click is within the plot area, move a cursor there and make it visible
-	if (x > mPlot->GetLeftYAxis()->GetOffsetFromWindowEdge() &&
-		x < GetSize().GetWidth() - mPlot->GetRightYAxis()->GetOffsetFromWindowEdge() &&
-		y > mPlot->GetTopAxis()->GetOffsetFromWindowEdge() &&
-		y < GetSize().GetHeight() - mPlot->GetBottomAxis()->GetOffsetFromWindowEdge())
-		ProcessPlotAreaDoubleClick(x);
-	else
-		ProcessOffPlotDoubleClick(x, y);
+	ModifyScene([this, x, y]()
+	{
+		// If the click is within the plot area, move a cursor there and make it visible
+		if (x > mPlot->GetLeftYAxis()->GetOffsetFromWindowEdge() &&
+			x < GetSize().GetWidth() - mPlot->GetRightYAxis()->GetOffsetFromWindowEdge() &&
+			y > mPlot->GetTopAxis()->GetOffsetFromWindowEdge() &&
+			y < GetSize().GetHeight() - mPlot->GetBottomAxis()->GetOffsetFromWindowEdge())
+			ProcessPlotAreaDoubleClick(x);
+		else// Dialogs can't be shown while changes are applied
+			CallAfter([this, x, y]()
+			{
+				ProcessOffPlotDoubleClick(x, y);
+			});
+	});
 
 	UpdateDisplay();
 }
@@ -1825,7 +2909,10 @@ void PlotRenderer::OnLeftButtonUpEvent(wxMouseEvent& event)
 	{
 		// TODO:  If mLegend is off screen, reset to default position and turn visibility off
 
-		UpdateLegendAnchor();
+		ModifyScene([this]()
+		{
+			UpdateLegendAnchor();
+		});
 	}
 
 	mDraggingLegend = false;
@@ -1833,6 +2920,7 @@ void PlotRenderer::OnLeftButtonUpEvent(wxMouseEvent& event)
 	mDraggingRightCursor = false;
 
 	SaveCurrentZoom();
+	EndInteraction();
 	UpdateDisplay();
 }
 
@@ -1996,13 +3084,16 @@ double PlotRenderer::GetRightCursorValue() const
 //=============================================================================
 void PlotRenderer::UpdateCursors()
 {
-	// Tell the cursors they need to recalculate
-	mLeftCursor->SetModified();
-	mRightCursor->SetModified();
+	ModifyScene([this]()
+	{
+		// Tell the cursors they need to recalculate
+		mLeftCursor->SetModified();
+		mRightCursor->SetModified();
 
-	// Calculations are performed on Draw
-	mLeftCursor->Recalculate();
-	mRightCursor->Recalculate();
+		// Calculations are performed on Draw
+		mLeftCursor->Recalculate();
+		mRightCursor->Recalculate();
+	});
 
 	Refresh();
 }
@@ -2172,7 +3263,10 @@ Color PlotRenderer::GetGridColor() const
 //=============================================================================
 void PlotRenderer::SetGridColor(const Color &color)
 {
-	mPlot->SetGridColor(color);
+	ModifyScene([this, color]()
+	{
+		mPlot->SetGridColor(color);
+	});
 }
 
 //=============================================================================
@@ -2193,7 +3287,10 @@ void PlotRenderer::SetGridColor(const Color &color)
 //=============================================================================
 void PlotRenderer::SetAxesVisibility(const bool& axesVisible)
 {
-	mPlot->SetAxesVisibility(axesVisible);
+	ModifyScene([this, axesVisible]()
+	{
+		mPlot->SetAxesVisibility(axesVisible);
+	});
 }
 
 //=============================================================================
@@ -2289,7 +3386,10 @@ bool PlotRenderer::GetRightLogarithmic() const
 //=============================================================================
 void PlotRenderer::SetXLogarithmic(const bool &log)
 {
-	mPlot->SetXLogarithmic(log);
+	ModifyScene([this, log]()
+	{
+		mPlot->SetXLogarithmic(log);
+	});
 
 	UpdateDisplay();
 }
@@ -2312,7 +3412,10 @@ void PlotRenderer::SetXLogarithmic(const bool &log)
 //=============================================================================
 void PlotRenderer::SetLeftLogarithmic(const bool &log)
 {
-	mPlot->SetLeftLogarithmic(log);
+	ModifyScene([this, log]()
+	{
+		mPlot->SetLeftLogarithmic(log);
+	});
 
 	UpdateDisplay();
 }
@@ -2335,7 +3438,10 @@ void PlotRenderer::SetLeftLogarithmic(const bool &log)
 //=============================================================================
 void PlotRenderer::SetRightLogarithmic(const bool &log)
 {
-	mPlot->SetRightLogarithmic(log);
+	ModifyScene([this, log]()
+	{
+		mPlot->SetRightLogarithmic(log);
+	});
 
 	UpdateDisplay();
 }
@@ -2454,25 +3560,35 @@ void PlotRenderer::ProcessZoom(wxMouseEvent &event)
 //=============================================================================
 void PlotRenderer::ProcessZoomWithBox(wxMouseEvent &event)
 {
-	unsigned int x;
-	unsigned int y;
+	// The mouse positions are captured now, because the box may not be
+	// modified until the frame being drawn is complete
+	const unsigned int anchorX(mLastMousePosition[0]);
+	const unsigned int anchorY(mLastMousePosition[1]);
+	const unsigned int floatX(event.GetX());
+	const unsigned int floatY(event.GetY());
 
-	if (!mZoomBox->GetIsVisible())
+	ModifyScene([this, anchorX, anchorY, floatX, floatY]()
 	{
-		x = mLastMousePosition[0];
-		y = mLastMousePosition[1];
-		ForcePointWithinPlotArea(x, y);
+		unsigned int x;
+		unsigned int y;
 
-		mZoomBox->SetVisibility(true);
-		mZoomBox->SetAnchorCorner(x, GetSize().GetHeight() - y);
-	}
+		if (!mZoomBox->GetIsVisible())
+		{
+			x = anchorX;
+			y = anchorY;
+			ForcePointWithinPlotArea(x, y);
+
+			mZoomBox->SetVisibility(true);
+			mZoomBox->SetAnchorCorner(x, GetSize().GetHeight() - y);
+		}
 
-	x = event.GetX();
-	y = event.GetY();
-	ForcePointWithinPlotArea(x, y);
+		x = floatX;
+		y = floatY;
+		ForcePointWithinPlotArea(x, y);
 
-	// Tell the zoom box where to draw the floaing corner
-	mZoomBox->SetFloatingCorner(x, GetSize().GetHeight() - y);
+		// Tell the zoom box where to draw the floaing corner
+		mZoomBox->SetFloatingCorner(x, GetSize().GetHeight() - y);
+	});
 }
 
 //=============================================================================
@@ -2522,14 +3638,11 @@ void PlotRenderer::PanBottomXAxis(wxMouseEvent &event)
 
 	if (mPlot->GetBottomAxis()->IsLogarithmic())
 	{
-		const int pixelDelta(event.GetX() - mLastMousePosition[0]);
-		mPlot->SetXMin(mPlot->GetBottomAxis()->PixelToValue(
-			static_cast<int>(mPlot->GetLeftYAxis()->GetOffsetFromWindowEdge())
-			- pixelDelta));
-		mPlot->SetXMax(mPlot->GetBottomAxis()->PixelToValue(
-			GetSize().GetWidth()
-			- static_cast<int>(mPlot->GetRightYAxis()->GetOffsetFromWindowEdge())
-			- pixelDelta));
+		double min(mPlot->GetXMin()), max(mPlot->GetXMax());
+		PanLogarithmicRange(min, max,
+			-static_cast<double>(event.GetX() - mLastMousePosition[0]) / width);
+		mPlot->SetXMin(min);
+		mPlot->SetXMax(max);
 	}
 	else
 	{
@@ -2564,14 +3677,11 @@ void PlotRenderer::PanLeftYAxis(wxMouseEvent &event)
 
 	if (mPlot->GetLeftYAxis()->IsLogarithmic())
 	{
-		const int pixelDelta(event.GetY() - mLastMousePosition[1]);
-		mPlot->SetLeftYMin(mPlot->GetLeftYAxis()->PixelToValue(
-			static_cast<int>(mPlot->GetBottomAxis()->GetOffsetFromWindowEdge())
-			+ pixelDelta));
-		mPlot->SetLeftYMax(mPlot->GetLeftYAxis()->PixelToValue(
-			GetSize().GetHeight()
-			- static_cast<int>(mPlot->GetTopAxis()->GetOffsetFromWindowEdge())
-			+ pixelDelta));
+		double min(mPlot->GetLeftYMin()), max(mPlot->GetLeftYMax());
+		PanLogarithmicRange(min, max,
+			static_cast<double>(event.GetY() - mLastMousePosition[1]) / height);
+		mPlot->SetLeftYMin(min);
+		mPlot->SetLeftYMax(max);
 	}
 	else
 	{
@@ -2606,14 +3716,11 @@ void PlotRenderer::PanRightYAxis(wxMouseEvent &event)
 
 	if (mPlot->GetRightYAxis()->IsLogarithmic())
 	{
-		const int pixelDelta(event.GetY() - mLastMousePosition[1]);
-		mPlot->SetRightYMin(mPlot->GetRightYAxis()->PixelToValue(
-			static_cast<int>(mPlot->GetBottomAxis()->GetOffsetFromWindowEdge())
-			+ pixelDelta));
-		mPlot->SetRightYMax(mPlot->GetRightYAxis()->PixelToValue(
-			GetSize().GetHeight()
-			- static_cast<int>(mPlot->GetTopAxis()->GetOffsetFromWindowEdge())
-			+ pixelDelta));
+		double min(mPlot->GetRightYMin()), max(mPlot->GetRightYMax());
+		PanLogarithmicRange(min, max,
+			static_cast<double>(event.GetY() - mLastMousePosition[1]) / height);
+		mPlot->SetRightYMin(min);
+		mPlot->SetRightYMax(max);
 	}
 	else
 	{
@@ -2625,6 +3732,36 @@ void PlotRenderer::PanRightYAxis(wxMouseEvent &event)
 	}
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		PanLogarithmicRange
+//
+// Description:		Shifts a logarithmic range by the specified fraction of
+//					the range.  Computed from the limits directly (rather than
+//					with Axis::PixelToValue()) so that multiple pans between
+//					frames accumulate correctly.
+//
+// Input Arguments:
+//		fraction	= const double&, fraction of the range (in log space)
+//
+// Output Arguments:
+//		min			= double&
+//		max			= double&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::PanLogarithmicRange(double &min, double &max,
+	const double &fraction)
+{
+	const double logMin(log10(min));
+	const double logMax(log10(max));
+	const double delta(fraction * (logMax - logMin));
+	min = pow(10.0, logMin + delta);
+	max = pow(10.0, logMax + delta);
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		ProcessPlotAreaDoubleClick
@@ -3043,6 +4180,47 @@ wxImage PlotRenderer::GetImage() const
 	return newImage;
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		RenderOffscreen
+//
+// Description:		Renders the plot offscreen at the specified size.
+//
+// Input Arguments:
+//		width	= const unsigned int&
+//		height	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxImage
+//
+//=============================================================================
+wxImage PlotRenderer::RenderOffscreen(const unsigned int& width,
+	const unsigned int& height)
+{
+	WaitForRenderThread();
+
+	// Previews and background refinement would leave the image incomplete
+	EndInteraction();
+	const bool progressive(mPlot->GetProgressiveCurves());
+	mPlot->SetProgressiveCurves(false);
+	mPlot->SetPrettyCurves((mCurveQuality & CurveQuality::HighWrite) != 0);
+	if (mStatisticsText)
+		mStatisticsText->SetVisibility(false);
+
+	wxImage image(RenderWindow::RenderOffscreen(width, height));
+
+	if (mStatisticsText)
+		mStatisticsText->SetVisibility(mShowStatistics);
+	mPlot->SetProgressiveCurves(progressive);
+	mPlot->SetPrettyCurves((mCurveQuality & CurveQuality::HighStatic) != 0);
+	UpdateDisplay();
+
+	return image;
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		GetTotalPointCount
@@ -3102,6 +4280,77 @@ void PlotRenderer::LoadModelviewUniform(const Modelview& mv)
 	glUniformMatrix4fv(mShaders[0].uniformLocations[mModelviewName], 1, GL_FALSE, glModelviewMatrix);
 }
 
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		LoadModelviewUniform
+//
+// Description:		Loads the specified modelview matrix to the openGL uniform,
+//					after applying a translation to the specified origin.  The
+//					translation is applied in double precision, so vertices
+//					may be stored as small offsets from the origin.
+//
+// Input Arguments:
+//		mv		= const Modelview&
+//		xOrigin	= const double&
+//		yOrigin	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotRenderer::LoadModelviewUniform(const Modelview& mv,
+	const double& xOrigin, const double& yOrigin)
+{
+	float glModelviewMatrix[16];
+	ConvertMatrixToGL(GetModelviewMatrix(mv, xOrigin, yOrigin), glModelviewMatrix);
+	glUniformMatrix4fv(mShaders[0].uniformLocations[mModelviewName], 1, GL_FALSE, glModelviewMatrix);
+}
+
+//=============================================================================
+// Class:			PlotRenderer
+// Function:		GetModelviewMatrix
+//
+// Description:		Returns the specified modelview matrix, after applying a
+//					translation to the specified origin.
+//
+// Input Arguments:
+//		mv		= const Modelview&
+//		xOrigin	= const double&
+//		yOrigin	= const double&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Eigen::Matrix4d
+//
+//=============================================================================
+Eigen::Matrix4d PlotRenderer::GetModelviewMatrix(const Modelview& mv,
+	const double& xOrigin, const double& yOrigin) const
+{
+	Eigen::Matrix4d modelview;
+	switch(mv)
+	{
+	case Modelview::Left:
+		modelview = mLeftModelview;
+		break;
+
+	case Modelview::Right:
+		modelview = mRightModelview;
+		break;
+
+	default:
+	case Modelview::Fixed:
+		modelview = mModelviewMatrix;
+	}
+
+	Translate(modelview, Eigen::Vector3d(xOrigin, yOrigin, 0.0));
+	return modelview;
+}
+
 //=============================================================================
 // Class:			PlotRenderer
 // Function:		ContextWriteImageFile
@@ -3128,7 +4377,16 @@ void PlotRenderer::ContextWriteImageFile(wxCommandEvent& WXUNUSED(event))
 	if (pathAndFileName.IsEmpty())
 		return;
 
-	WriteImageToFile(pathAndFileName[0]);
+	// Pixels are read back asynchronously, so rendering isn't stalled
+	const wxString fileName(pathAndFileName[0]);
+	RequestImage([fileName](const wxImage& image)
+	{
+		if (!image.IsOk())
+			return;
+
+		wxInitAllImageHandlers();
+		image.SaveFile(fileName);
+	});
 }
 
 //=============================================================================
@@ -3892,7 +5150,10 @@ void PlotRenderer::ContextPlotBGColor(wxCommandEvent& WXUNUSED(event))
     {
 		Color color;
 		color.Set(dialog.GetColourData().GetColour());
-		SetBackgroundColor(color);
+		ModifyScene([this, color]()
+		{
+			SetBackgroundColor(color);
+		});
 		UpdateDisplay();
 	}
 }
@@ -4087,12 +5348,19 @@ void PlotRenderer::ContextEditRightLabel(wxCommandEvent& WXUNUSED(event))
 //=============================================================================
 void PlotRenderer::DoCopy()
 {
-	wxInitAllImageHandlers();
-	if (wxTheClipboard->Open())
+	// Pixels are read back asynchronously, so rendering isn't stalled
+	RequestImage([](const wxImage& image)
 	{
-		wxTheClipboard->SetData(new wxBitmapDataObject(GetImage()));
-		wxTheClipboard->Close();
-	}
+		if (!image.IsOk())
+			return;
+
+		wxInitAllImageHandlers();
+		if (wxTheClipboard->Open())
+		{
+			wxTheClipboard->SetData(new wxBitmapDataObject(image));
+			wxTheClipboard->Close();
+		}
+	});
 }
 
 //=============================================================================
@@ -4141,8 +5409,10 @@ void PlotRenderer::DoPaste()
 //		bool
 //
 //=============================================================================
-bool PlotRenderer::CurveMarkersVisible(const unsigned int& i) const
+bool PlotRenderer::CurveMarkersVisible(const unsigned int& i)
 {
+	if (mQueuedCurveChanges > 0)
+		WaitForRenderThread();
 	return mPlot->CurveMarkersVisible(i);
 }
 
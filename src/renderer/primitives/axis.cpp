@@ -25,6 +25,24 @@
 namespace LibPlot2D
 {
 
+//=============================================================================
+// Class:			Axis
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for Axis class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const unsigned int Axis::mMaxTickLabelExtents(256);
+
 //=============================================================================
 // Class:			Axis
 // Function:		Axis
@@ -65,10 +83,10 @@ Axis::Axis(RenderWindow &mRenderWindow) : Primitive(mRenderWindow),
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if the buffer was rebuilt
 //
 //=============================================================================
-void Axis::Update(const unsigned int& i)
+bool Axis::Update(const unsigned int& i)
 {
 	if (i == 0)// Axis and ticks
 	{
@@ -89,16 +107,18 @@ void Axis::Update(const unsigned int& i)
 	{
 		mGridLines.BuildSegments(mGridPoints, mBufferInfo[i]);
 	}
-	else if (i == 2 && mValueText.IsOK())// Values
+	else if (i == 2 && mValueText.IsOK() && DrawTickLabels())// Values
 	{
-		DrawTickLabels();
 		mBufferInfo[i] = mValueText.BuildText();
 	}
-	else if (i == 3 && mLabelText.IsOK())// Label
+	else if (i == 3 && mLabelText.IsOK() && DrawAxisLabel())// Label
 	{
-		DrawAxisLabel();
 		mBufferInfo[i] = mLabelText.BuildText();
 	}
+	else
+		return false;
+
+	return true;
 }
 
 //=============================================================================
@@ -121,17 +141,17 @@ void Axis::Update(const unsigned int& i)
 void Axis::GenerateGeometry()
 {
 	// Draw gridlines first
-	if ((mMajorGrid || mMinorGrid) && mBufferInfo[1].indexBuffer.size() > 0)
+	if ((mMajorGrid || mMinorGrid) && mBufferInfo[1].GetIndexCount() > 0)
 	{
 		glBindVertexArray(mBufferInfo[1].GetVertexArrayIndex());
-		Line::DoPrettyDraw(mBufferInfo[1].indexBuffer.size());
+		Line::DoPrettyDraw(mBufferInfo[1].GetIndexCount());
 	}
 
 	// Axis and ticks next
 	if (mBufferInfo[0].vertexCount > 0)
 	{
 		glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
-		Line::DoPrettyDraw(mBufferInfo[0].indexBuffer.size());
+		Line::DoPrettyDraw(mBufferInfo[0].GetIndexCount());
 	}
 
 	if (mValueText.IsOK() && mBufferInfo[2].vertexCount > 0 && mTickStyle != TickStyle::NoTicks)
@@ -214,10 +234,10 @@ int Axis::ComputeMainAxisLocation() const
 	if (mOrientation == Orientation::Bottom || mOrientation == Orientation::Left)
 		return mOffsetFromWindowEdge;
 	else if (mOrientation == Orientation::Right)
-		return mRenderWindow.GetSize().GetWidth() - mOffsetFromWindowEdge;
+		return mRenderWindow.GetRenderSize().GetWidth() - mOffsetFromWindowEdge;
 
 	//else// OrientationTop
-	return mRenderWindow.GetSize().GetHeight() - mOffsetFromWindowEdge;
+	return mRenderWindow.GetRenderSize().GetHeight() - mOffsetFromWindowEdge;
 }
 
 //=============================================================================
@@ -287,13 +307,13 @@ void Axis::DrawMainAxis(const int &mainAxisLocation)
 	if (IsHorizontal())
 	{
 		mAxisPoints.push_back(std::make_pair(mMinAxis->GetOffsetFromWindowEdge(), mainAxisLocation));
-		mAxisPoints.push_back(std::make_pair(mRenderWindow.GetSize().GetWidth()
+		mAxisPoints.push_back(std::make_pair(mRenderWindow.GetRenderSize().GetWidth()
 			- mMaxAxis->GetOffsetFromWindowEdge(), mainAxisLocation));
 	}
 	else
 	{
 		mAxisPoints.push_back(std::make_pair(mainAxisLocation, mMinAxis->GetOffsetFromWindowEdge()));
-		mAxisPoints.push_back(std::make_pair(mainAxisLocation, mRenderWindow.GetSize().GetHeight() -
+		mAxisPoints.push_back(std::make_pair(mainAxisLocation, mRenderWindow.GetRenderSize().GetHeight() -
 			mMaxAxis->GetOffsetFromWindowEdge()));
 	}
 }
@@ -364,12 +384,12 @@ void Axis::DrawHorizontalGrid(const unsigned int &count)
 			location = ValueToPixel(GetNextTickValue(false, false, grid + 1));
 
 		if (location <= mMinAxis->GetOffsetFromWindowEdge() ||
-			location >= mRenderWindow.GetSize().GetWidth() - mMaxAxis->GetOffsetFromWindowEdge())
+			location >= mRenderWindow.GetRenderSize().GetWidth() - mMaxAxis->GetOffsetFromWindowEdge())
 			continue;
 
 		mGridPoints.push_back(std::make_pair(location, static_cast<double>(mOffsetFromWindowEdge)));
 		mGridPoints.push_back(std::make_pair(location,
-			static_cast<double>(mRenderWindow.GetSize().GetHeight() - mOppositeAxis->GetOffsetFromWindowEdge())));
+			static_cast<double>(mRenderWindow.GetRenderSize().GetHeight() - mOppositeAxis->GetOffsetFromWindowEdge())));
 	}
 }
 
@@ -400,7 +420,7 @@ void Axis::DrawHorizontalTicks(const unsigned int &count, const int &mainAxisLoc
 	{
 		double location(ValueToPixel(GetNextTickValue(false, false, tick + 1)));
 		if (location <= mMinAxis->GetOffsetFromWindowEdge() ||
-			location >= mRenderWindow.GetSize().GetWidth() - mMaxAxis->GetOffsetFromWindowEdge())
+			location >= mRenderWindow.GetRenderSize().GetWidth() - mMaxAxis->GetOffsetFromWindowEdge())
 			continue;
 
 		mAxisPoints.push_back(std::make_pair(location, static_cast<double>(mainAxisLocation - mTickSize * outsideTick * sign)));
@@ -436,11 +456,11 @@ void Axis::DrawVerticalGrid(const unsigned int &count)
 			location = ValueToPixel(GetNextTickValue(false, false, grid + 1));
 
 		if (location <= mMinAxis->GetOffsetFromWindowEdge() ||
-			location >= mRenderWindow.GetSize().GetHeight() - mMaxAxis->GetOffsetFromWindowEdge())
+			location >= mRenderWindow.GetRenderSize().GetHeight() - mMaxAxis->GetOffsetFromWindowEdge())
 			continue;
 
 		mGridPoints.push_back(std::make_pair(static_cast<double>(mOffsetFromWindowEdge), location));
-		mGridPoints.push_back(std::make_pair(static_cast<double>(mRenderWindow.GetSize().GetWidth()
+		mGridPoints.push_back(std::make_pair(static_cast<double>(mRenderWindow.GetRenderSize().GetWidth()
 			- mOppositeAxis->GetOffsetFromWindowEdge()), location));
 	}
 }
@@ -472,7 +492,7 @@ void Axis::DrawVerticalTicks(const unsigned int &count, const int &mainAxisLocat
 	{
 		double location(ValueToPixel(GetNextTickValue(false, false, tick + 1)));
 		if (location <= mMinAxis->GetOffsetFromWindowEdge() ||
-			location >= mRenderWindow.GetSize().GetHeight() - mMaxAxis->GetOffsetFromWindowEdge())
+			location >= mRenderWindow.GetRenderSize().GetHeight() - mMaxAxis->GetOffsetFromWindowEdge())
 			continue;
 
 		mAxisPoints.push_back(std::make_pair(static_cast<double>(mainAxisLocation - mTickSize * outsideTick * sign), location));
@@ -523,7 +543,8 @@ void Axis::GetNextLogValue(const bool &first, double &value) const
 // Class:			Axis
 // Function:		DrawAxisLabel
 //
-// Description:		Draws the label text for the axis.
+// Description:		Draws the label text for the axis.  Nothing is done if the
+//					label, fonts and layout are unchanged since the last call.
 //
 // Input Arguments:
 //		None
@@ -532,13 +553,18 @@ void Axis::GetNextLogValue(const bool &first, double &value) const
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if the label text must be rebuilt
 //
 //=============================================================================
-void Axis::DrawAxisLabel()
+bool Axis::DrawAxisLabel()
 {
 	if (mLabel.IsEmpty())
-		return;
+		return false;
+
+	const TextLayout layout(GetTextLayout());
+	if (layout == mLabelLayout && mLabel == mLayoutLabel &&
+		mLabelFontRevision == mFontRevision)
+		return false;
 
 	double fontOffsetFromWindowEdge = mOffsetFromWindowEdge / 3.0;
 	if (!IsHorizontal())
@@ -549,22 +575,28 @@ void Axis::DrawAxisLabel()
 	const double edgeOffset(GetAxisLabelTranslation(fontOffsetFromWindowEdge,
 		boundingBox.yUp));
 
-	boundingBox = mLabelText.GetBoundingBox(mLabel.ToStdString());
+	boundingBox = mLabelText.GetBoundingBox(mLabel.ToUTF8().data());
 	const double textWidth = boundingBox.xRight - boundingBox.xLeft;
 	const double plotOffset = static_cast<double>(mMinAxis->GetOffsetFromWindowEdge())
 		- static_cast<double>(mMaxAxis->GetOffsetFromWindowEdge());
 
 	if (IsHorizontal())
-		mLabelText.SetPosition(0.5 * (mRenderWindow.GetSize().GetWidth()
+		mLabelText.SetPosition(0.5 * (mRenderWindow.GetRenderSize().GetWidth()
 			- textWidth + plotOffset), edgeOffset);
 	else
 	{
 		mLabelText.SetOrientation(M_PI * 0.5);
-		mLabelText.SetPosition(0.5 * (mRenderWindow.GetSize().GetHeight()
+		mLabelText.SetPosition(0.5 * (mRenderWindow.GetRenderSize().GetHeight()
 			- textWidth + plotOffset), -edgeOffset);
 	}
 
-	mLabelText.SetText(mLabel.ToStdString());
+	mLabelText.SetText(mLabel.ToUTF8().data());
+
+	mLabelLayout = layout;
+	mLayoutLabel = mLabel;
+	mLabelFontRevision = mFontRevision;
+
+	return true;
 }
 
 //=============================================================================
@@ -596,10 +628,10 @@ double Axis::GetAxisLabelTranslation(const double &offset,
 		return offset + fontHeight;
 
 	case Orientation::Top:
-		return mRenderWindow.GetSize().GetHeight() - offset - fontHeight;
+		return mRenderWindow.GetRenderSize().GetHeight() - offset - fontHeight;
 
 	case Orientation::Right:
-		return mRenderWindow.GetSize().GetWidth() - offset;
+		return mRenderWindow.GetRenderSize().GetWidth() - offset;
 
 	default:
 		assert(false);
@@ -611,13 +643,12 @@ double Axis::GetAxisLabelTranslation(const double &offset,
 // Class:			Axis
 // Function:		DrawTickLabels
 //
-// Description:		Draws the numeric labels for each axis tick.  This also
-//					determines the precision for each tick label.  The goal
-//					is to provide just enough precision so that adjacent tick
-//					marks are distinguishable, and then add just a hair more.
-//					Here we also reset the axis min and max values to be exactly
-//					the vales of the min and max labels after rounding (keeps
-//					tick labels accurate).
+// Description:		Draws the numeric labels for each axis tick.  Tick values
+//					and strings are regenerated only if the range, resolution
+//					or fonts have changed, and the text is positioned only if
+//					those or the layout have changed.  As a side effect, the
+//					axis limits are set to the rounded values of the min and
+//					max labels (see ComputeTickLabels()).
 //
 // Input Arguments:
 //		None
@@ -626,35 +657,209 @@ double Axis::GetAxisLabelTranslation(const double &offset,
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if the value text must be rebuilt
 //
 //=============================================================================
-void Axis::DrawTickLabels()
+bool Axis::DrawTickLabels()
 {
+	TickRange range;
+	range.minimum = mMinimum;
+	range.maximum = mMaximum;
+	range.majorResolution = mMajorResolution;
+	range.logarithmic = mLogarithmic;
+	range.fontRevision = mFontRevision;
+
+	const bool rangeChanged(!(range == mTickRange));
+	if (rangeChanged)
+	{
+		ComputeTickLabels();
+		mTickRange = range;
+	}
+
+	// Positions are computed with the rounded minimum, but the maximum is not
+	// rounded until the labels are placed
+	mMinimum = mTickLabelMinimum;
+
+	const TextLayout layout(GetTextLayout());
+	if (!rangeChanged && layout == mTickLayout)
+	{
+		mMaximum = mTickLabelMaximum;
+		return false;
+	}
+
 	float xTranslation, yTranslation;
+	const double valueOffsetFromEdge(mOffsetFromWindowEdge * 0.8);
+	for (const auto& label : mTickLabels)
+	{
+		// TODO:  Don't draw it if it's too close to the maximum (based on text size)
+		ComputeTranslations(label.value, xTranslation, yTranslation,
+			label.boundingBox, valueOffsetFromEdge);
+		mValueText.SetPosition(xTranslation, yTranslation);
+		mValueText.AppendText(label.text);
+	}
+
+	mMaximum = mTickLabelMaximum;
+	mTickLayout = layout;
+
+	return true;
+}
+
+//=============================================================================
+// Class:			Axis
+// Function:		ComputeTickLabels
+//
+// Description:		Computes the value and string for each tick label.  This
+//					also determines the precision for each tick label.  The
+//					goal is to provide just enough precision so that adjacent
+//					tick marks are distinguishable, and then add just a hair
+//					more.  Here we also determine the axis min and max values
+//					exactly matching the min and max labels after rounding
+//					(keeps tick labels accurate).  On return, mMinimum is set
+//					to the rounded value.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Axis::ComputeTickLabels()
+{
 	const unsigned int precision(GetPrecision());
 
-	mMinimum = GetPrecisionLimitedMinimum();
+	mTickLabelMinimum = GetPrecisionLimitedMinimum();
+	mMinimum = mTickLabelMinimum;
 
 	wxString valueLabel;
-	double valueOffsetFromEdge = mOffsetFromWindowEdge * 0.8;
 	unsigned int tick, numberOfTicks;
 	ComputeGridAndTickCounts(numberOfTicks);
+	mTickLabels.resize(numberOfTicks + 2);
 	for (tick = 0; tick < numberOfTicks + 2; ++tick)
 	{
-		double value(std::min(GetNextTickValue(tick == 0,
-			tick == numberOfTicks + 1, tick), mMaximum));
-		valueLabel.Printf("%0.*f", precision, value);
-
-		// TODO:  Don't draw it if it's too close to the maximum (based on text size)
-		ComputeTranslations(value, xTranslation, yTranslation,
-			mValueText.GetBoundingBox(valueLabel.ToStdString()),
-			valueOffsetFromEdge);
-		mValueText.SetPosition(xTranslation, yTranslation);
-		mValueText.AppendText(valueLabel.ToStdString());
+		TickLabel& label(mTickLabels[tick]);
+		label.value = std::min(GetNextTickValue(tick == 0,
+			tick == numberOfTicks + 1, tick), mMaximum);
+		valueLabel.Printf("%0.*f", precision, label.value);
+		label.text = valueLabel.ToUTF8().data();
+		label.boundingBox = GetTickLabelExtents(label.text);
 	}
 
-	mMaximum = GetPrecisionLimitedMaximum();
+	mTickLabelMaximum = GetPrecisionLimitedMaximum();
+}
+
+//=============================================================================
+// Class:			Axis
+// Function:		GetTickLabelExtents
+//
+// Description:		Returns the bounding box for the specified value string,
+//					using previously computed results when available.
+//
+// Input Arguments:
+//		text	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Text::BoundingBox&
+//
+//=============================================================================
+const Text::BoundingBox& Axis::GetTickLabelExtents(const std::string& text)
+{
+	const auto it(mTickLabelExtents.find(text));
+	if (it != mTickLabelExtents.end())
+		return it->second;
+
+	// Panning can generate an unlimited number of strings
+	if (mTickLabelExtents.size() >= mMaxTickLabelExtents)
+		mTickLabelExtents.clear();
+
+	return mTickLabelExtents.emplace(text,
+		mValueText.GetBoundingBox(text)).first->second;
+}
+
+//=============================================================================
+// Class:			Axis
+// Function:		GetTextLayout
+//
+// Description:		Returns the current values of the inputs which determine
+//					the placement of the value and label text.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		TextLayout
+//
+//=============================================================================
+Axis::TextLayout Axis::GetTextLayout() const
+{
+	TextLayout layout;
+	layout.windowWidth = mRenderWindow.GetRenderSize().GetWidth();
+	layout.windowHeight = mRenderWindow.GetRenderSize().GetHeight();
+	layout.orientation = mOrientation;
+	layout.offset = mOffsetFromWindowEdge;
+	layout.minAxisOffset = mMinAxis->GetOffsetFromWindowEdge();
+	layout.maxAxisOffset = mMaxAxis->GetOffsetFromWindowEdge();
+	return layout;
+}
+
+//=============================================================================
+// Class:			Axis::TextLayout
+// Function:		operator==
+//
+// Description:		Equality comparison operator.
+//
+// Input Arguments:
+//		l	= const TextLayout&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if all fields are equal
+//
+//=============================================================================
+bool Axis::TextLayout::operator==(const TextLayout& l) const
+{
+	return windowWidth == l.windowWidth &&
+		windowHeight == l.windowHeight &&
+		orientation == l.orientation &&
+		offset == l.offset &&
+		minAxisOffset == l.minAxisOffset &&
+		maxAxisOffset == l.maxAxisOffset;
+}
+
+//=============================================================================
+// Class:			Axis::TickRange
+// Function:		operator==
+//
+// Description:		Equality comparison operator.
+//
+// Input Arguments:
+//		r	= const TickRange&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if all fields are equal
+//
+//=============================================================================
+bool Axis::TickRange::operator==(const TickRange& r) const
+{
+	return minimum == r.minimum &&
+		maximum == r.maximum &&
+		majorResolution == r.majorResolution &&
+		logarithmic == r.logarithmic &&
+		fontRevision == r.fontRevision;
 }
 
 //=============================================================================
@@ -803,7 +1008,7 @@ void Axis::ComputeTranslations(const double &value, float &xTranslation,
 		if (mOrientation == Orientation::Bottom)
 			yTranslation = offset - boundingBox.yUp;
 		else
-			yTranslation = mRenderWindow.GetSize().GetHeight() - offset;
+			yTranslation = mRenderWindow.GetRenderSize().GetHeight() - offset;
 
 		xTranslation = ValueToPixel(value) -
 			(boundingBox.xRight - boundingBox.xLeft) / 2.0;
@@ -813,7 +1018,7 @@ void Axis::ComputeTranslations(const double &value, float &xTranslation,
 		if (mOrientation == Orientation::Left)
 			xTranslation = offset - boundingBox.xRight;
 		else
-			xTranslation = mRenderWindow.GetSize().GetWidth() - offset;
+			xTranslation = mRenderWindow.GetRenderSize().GetWidth() - offset;
 
 		yTranslation = ValueToPixel(value) -
 			(boundingBox.yUp - boundingBox.yDown) / 2.0;
@@ -898,11 +1103,11 @@ double Axis::ValueToPixel(const double &value) const
 	// Get the plot size
 	int plotDimension;
 	if (IsHorizontal())
-		plotDimension = mRenderWindow.GetSize().GetWidth()
+		plotDimension = mRenderWindow.GetRenderSize().GetWidth()
 				- mMinAxis->GetOffsetFromWindowEdge()
 				- mMaxAxis->GetOffsetFromWindowEdge();
 	else
-		plotDimension = mRenderWindow.GetSize().GetHeight()
+		plotDimension = mRenderWindow.GetRenderSize().GetHeight()
 				- mMinAxis->GetOffsetFromWindowEdge()
 				- mMaxAxis->GetOffsetFromWindowEdge();
 
@@ -946,13 +1151,13 @@ double Axis::PixelToValue(const int &pixel) const
 	if (IsHorizontal())
 		fraction = (static_cast<double>(pixel)
 			- mMinAxis->GetOffsetFromWindowEdge())
-			/ (static_cast<double>(mRenderWindow.GetSize().GetWidth())
+			/ (static_cast<double>(mRenderWindow.GetRenderSize().GetWidth())
 			- mMinAxis->GetOffsetFromWindowEdge()
 			- mMaxAxis->GetOffsetFromWindowEdge());
 	else
 		fraction = (static_cast<double>(pixel)
 			- mMinAxis->GetOffsetFromWindowEdge())
-			/ (static_cast<double>(mRenderWindow.GetSize().GetHeight())
+			/ (static_cast<double>(mRenderWindow.GetRenderSize().GetHeight())
 			- mMinAxis->GetOffsetFromWindowEdge()
 			- mMaxAxis->GetOffsetFromWindowEdge());
 
@@ -1009,13 +1214,13 @@ unsigned int Axis::GetAxisLength() const
 {
 	if (mOrientation == Orientation::Top || mOrientation == Orientation::Bottom)
 	{
-		return mRenderWindow.GetSize().GetWidth()
+		return mRenderWindow.GetRenderSize().GetWidth()
 			- mMinAxis->GetOffsetFromWindowEdge()
 			- mMaxAxis->GetOffsetFromWindowEdge();
 	}
 	else
 	{
-		return mRenderWindow.GetSize().GetHeight()
+		return mRenderWindow.GetRenderSize().GetHeight()
 			- mMinAxis->GetOffsetFromWindowEdge()
 			- mMaxAxis->GetOffsetFromWindowEdge();
 	}
@@ -1059,6 +1264,11 @@ bool Axis::InitializeFonts(const std::string& fontFileName, const double& size)
 	mLabelText.SetScale(1.0 / factor);
 	mValueText.SetScale(1.0 / factor);
 
+	// Forces text to be rebuilt
+	++mFontRevision;
+	mTickLabelExtents.clear();
+	Invalidate(Change::Style);
+
 	return true;
 }
 
@@ -0,0 +1,561 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  curveBatch.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Derived from Primitive for drawing the lines of many plot curves
+//        with a single set of draw calls.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/primitives/curveBatch.h"
+#include "lp2d/renderer/primitives/plotCurve.h"
+#include "lp2d/renderer/primitives/axis.h"
+#include "lp2d/renderer/renderWindow.h"
+#include "lp2d/renderer/plotRenderer.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for the CurveBatch class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const GLuint CurveBatch::mCurveIndexLocation(1);
+const std::string CurveBatch::mCurveTableName("curveTable");
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		mVertexShader
+//
+// Description:		Vertex shader for batched curves.  The color and the
+//					offset of each vertex are looked up in the curve table
+//					using the curve index attribute.  As with compact lines,
+//					the edge vertices of pretty lines are identified by their
+//					index (each curve's vertices begin on a multiple of four).
+//
+// Input Arguments:
+//		0	= position
+//		1	= curveIndex
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string CurveBatch::mVertexShader(
+	"#version 400\n"
+	"\n"
+	"uniform mat4 modelviewMatrix;\n"
+	"uniform mat4 projectionMatrix;\n"
+	"uniform samplerBuffer curveTable;\n"
+	"\n"
+	"layout(location = 0) in vec2 position;\n"
+	"layout(location = 1) in uint curveIndex;\n"
+	"\n"
+	"out vec4 vertexColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    int row = 2 * int(curveIndex);\n"
+	"    vec4 lineColor = texelFetch(curveTable, row);\n"
+	"    vec4 placement = texelFetch(curveTable, row + 1);\n"
+	"    int level = gl_VertexID & 3;\n"
+	"    if (level == 0 || level == 3)\n"
+	"        vertexColor = vec4(lineColor.rgb, lineColor.a * placement.z);\n"
+	"    else\n"
+	"        vertexColor = lineColor;\n"
+	"    gl_Position = projectionMatrix * modelviewMatrix * vec4(position + placement.xy, 0.0, 1.0);\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		mFragmentShader
+//
+// Description:		Fragment shader for batched curves.
+//
+// Input Arguments:
+//		0	= vertexColor
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string CurveBatch::mFragmentShader(
+	"#version 400\n"
+	"\n"
+	"in vec4 vertexColor;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    outputColor = vertexColor;\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		CurveBatch
+//
+// Description:		Constructor for the CurveBatch class.
+//
+// Input Arguments:
+//		renderWindow	= RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+CurveBatch::CurveBatch(RenderWindow &renderWindow) : Primitive(renderWindow),
+	mLine(renderWindow)
+{
+	mLine.SetBufferHint(GL_STATIC_DRAW);
+	mLine.SetCompact(true);
+
+	// Drawn after the curves, which build the geometry
+	SetDrawOrder(1001);
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		~CurveBatch
+//
+// Description:		Destructor for the CurveBatch class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+CurveBatch::~CurveBatch()
+{
+	if (mCurveIndexBuffer != 0)
+		glDeleteBuffers(1, &mCurveIndexBuffer);
+
+	if (mCurveTableTexture != 0)
+	{
+		glDeleteTextures(1, &mCurveTableTexture);
+		glDeleteBuffers(1, &mCurveTableBuffer);
+	}
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		SetCurves
+//
+// Description:		Sets the curves whose lines are drawn by this object.  The
+//					packed geometry is only rebuilt if the list has changed.
+//
+// Input Arguments:
+//		curves	= const std::vector<PlotCurve*>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void CurveBatch::SetCurves(const std::vector<PlotCurve*>& curves)
+{
+	if (curves == mCurves)
+		return;
+
+	for (auto& curve : mCurves)
+	{
+		if (std::find(curves.begin(), curves.end(), curve) == curves.end())
+			curve->SetBatch(nullptr);
+	}
+
+	mCurves = curves;
+	for (auto& curve : mCurves)
+		curve->SetBatch(this);
+
+	Invalidate(Change::Data);
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		RemoveCurve
+//
+// Description:		Removes the specified curve from this object.
+//
+// Input Arguments:
+//		curve	= PlotCurve*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void CurveBatch::RemoveCurve(PlotCurve* curve)
+{
+	const auto it(std::find(mCurves.begin(), mCurves.end(), curve));
+	if (it == mCurves.end())
+		return;
+
+	curve->SetBatch(nullptr);
+	mCurves.erase(it);
+	Invalidate(Change::Data);
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		HasValidParameters
+//
+// Description:		Checks to see if the information about this object is
+//					valid and complete (gives permission to create the object).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for OK to draw, false otherwise
+//
+//=============================================================================
+bool CurveBatch::HasValidParameters()
+{
+	return !mCurves.empty();
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		Update
+//
+// Description:		Packs the line geometry of the member curves into a single
+//					vertex buffer and sends it to OpenGL.  Called whenever a
+//					member curve has new line geometry.  Hidden curves are
+//					included, so showing and hiding curves only changes the
+//					draw lists.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the batch has geometry to draw
+//
+//=============================================================================
+bool CurveBatch::Update(const unsigned int& i)
+{
+	const unsigned int dimension(mRenderWindow.GetVertexDimension());
+	BufferInfo& bufferInfo(mBufferInfo[i]);
+
+	mSlots.assign(mCurves.size(), Slot());
+	bufferInfo.vertexCount = 0;
+	bufferInfo.sharedIndexCount = 0;
+
+	unsigned int j;
+	for (j = 0; j < mCurves.size(); ++j)
+	{
+		const PlotCurve& curve(*mCurves[j]);
+		if (!curve.LineIsBatched())
+			continue;
+
+		// Pretty lines have four vertices per point, and the shader relies
+		// on the vertex index to identify the edges
+		mSlots[j].firstVertex = static_cast<GLint>((bufferInfo.vertexCount + 3) & ~3U);
+		mSlots[j].vertexCount = curve.mBufferInfo[0].vertexCount;
+		mSlots[j].indexCount = curve.mBufferInfo[0].sharedIndexCount;
+		mSlots[j].xOrigin = curve.mXOrigin;
+		mSlots[j].yOrigin = curve.mYOrigin;
+
+		bufferInfo.vertexCount = mSlots[j].firstVertex + mSlots[j].vertexCount;
+		bufferInfo.sharedIndexCount = std::max(bufferInfo.sharedIndexCount,
+			curve.mBufferInfo[0].sharedIndexCount);
+	}
+
+	bufferInfo.vertexBuffer.assign(bufferInfo.vertexCount * dimension, 0.0f);
+	mCurveIndices.assign(bufferInfo.vertexCount, 0);
+	for (j = 0; j < mSlots.size(); ++j)
+	{
+		if (mSlots[j].vertexCount == 0)
+			continue;
+
+		const std::vector<float>& source(mCurves[j]->mBufferInfo[0].vertexBuffer);
+		assert(source.size() >= mSlots[j].vertexCount * dimension);
+		std::copy(source.begin(), source.begin() + mSlots[j].vertexCount * dimension,
+			bufferInfo.vertexBuffer.begin() + mSlots[j].firstVertex * dimension);
+		std::fill(mCurveIndices.begin() + mSlots[j].firstVertex,
+			mCurveIndices.begin() + mSlots[j].firstVertex + mSlots[j].vertexCount, j);
+	}
+
+	const auto first(std::find_if(mSlots.begin(), mSlots.end(),
+		[](const Slot& s) { return s.vertexCount > 0; }));
+	if (first == mSlots.end())
+		return false;
+
+	mXOrigin = first->xOrigin;
+	mYOrigin = first->yOrigin;
+
+	mLine.Upload(bufferInfo);
+
+	if (mCurveIndexBuffer == 0)
+		glGenBuffers(1, &mCurveIndexBuffer);
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+	glBindBuffer(GL_ARRAY_BUFFER, mCurveIndexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * mCurveIndices.size(),
+		mCurveIndices.data(), GL_STATIC_DRAW);
+	bufferInfo.AddBytesUploaded(sizeof(GLuint) * mCurveIndices.size());
+
+	glEnableVertexAttribArray(mCurveIndexLocation);
+	glVertexAttribIPointer(mCurveIndexLocation, 1, GL_UNSIGNED_INT, 0, 0);
+	glBindVertexArray(0);
+
+	assert(!RenderWindow::GLHasError());
+	return true;
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		GenerateGeometry
+//
+// Description:		Creates the OpenGL instructions to create this object in
+//					the scene.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void CurveBatch::GenerateGeometry()
+{
+	BuildDrawLists();
+	if (mPrettyDraws.count.empty() && mUglyDraws.empty())
+		return;
+
+	// All members share a y-axis, so the orientation of any of them will do
+	const Eigen::Matrix4d modelview(dynamic_cast<PlotRenderer&>(
+		mRenderWindow).GetModelviewMatrix(mCurves.front()->mYAxis->GetOrientation()
+		== Axis::Orientation::Left ? PlotRenderer::Modelview::Left :
+		PlotRenderer::Modelview::Right, mXOrigin, mYOrigin));
+
+	mRenderWindow.InitializePrimitiveType(*this);
+	mRenderWindow.UseProgram(mRenderWindow.GetPrimitiveTypeProgram<CurveBatch>());
+	const auto& uniforms(mRenderWindow.GetActiveProgramInfo().uniformLocations);
+	RenderWindow::SendUniformMatrix(modelview,
+		uniforms.find(RenderWindow::mModelviewName)->second);
+	glUniform1i(uniforms.find(mCurveTableName)->second, 0);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_BUFFER, mCurveTableTexture);
+	glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
+	glEnable(GL_SCISSOR_TEST);
+
+	if (!mPrettyDraws.count.empty())
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, mPrettyDraws.count.data(),
+			GL_UNSIGNED_INT, mPrettyDraws.indices.data(),
+			static_cast<GLsizei>(mPrettyDraws.count.size()),
+			mPrettyDraws.first.data());
+
+	for (const auto& draws : mUglyDraws)
+	{
+		glLineWidth(draws.first);
+		glMultiDrawArrays(GL_LINE_STRIP, draws.second.first.data(),
+			draws.second.count.data(),
+			static_cast<GLsizei>(draws.second.count.size()));
+	}
+	glLineWidth(1.0f);
+
+	glDisable(GL_SCISSOR_TEST);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	mRenderWindow.UseDefaultProgram();
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		BuildDrawLists
+//
+// Description:		Builds the lists of curves to draw and the curve table
+//					from the current state of the member curves.  This is
+//					inexpensive compared to drawing the curves individually,
+//					so it is done every frame.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void CurveBatch::BuildDrawLists()
+{
+	mPrettyDraws = DrawList();
+	mUglyDraws.clear();
+
+	std::vector<GLfloat> table(8 * mCurves.size(), 0.0f);
+	unsigned int i;
+	for (i = 0; i < mCurves.size(); ++i)
+	{
+		PlotCurve& curve(*mCurves[i]);
+		const Slot& slot(mSlots[i]);
+		if (slot.vertexCount == 0 || !curve.LineIsBatched() ||
+			!curve.GetIsVisible() || !curve.HasValidParameters() ||
+			!(curve.mLineSize > 0.0))
+			continue;
+
+		const Color color(curve.GetColor());
+		table[8 * i] = static_cast<GLfloat>(color.GetRed());
+		table[8 * i + 1] = static_cast<GLfloat>(color.GetGreen());
+		table[8 * i + 2] = static_cast<GLfloat>(color.GetBlue());
+		table[8 * i + 3] = static_cast<GLfloat>(color.GetAlpha());
+		table[8 * i + 4] = static_cast<GLfloat>(slot.xOrigin - mXOrigin);
+		table[8 * i + 5] = static_cast<GLfloat>(slot.yOrigin - mYOrigin);
+		table[8 * i + 6] = curve.mPretty ? 0.0f : 1.0f;
+
+		if (curve.mPretty)
+		{
+			mPrettyDraws.first.push_back(slot.firstVertex);
+			mPrettyDraws.count.push_back(slot.indexCount);
+			mPrettyDraws.indices.push_back(nullptr);
+		}
+		else
+		{
+			DrawList& draws(mUglyDraws[static_cast<GLfloat>(
+				curve.mLineSize * PlotCurve::mLineSizeScale)]);
+			draws.first.push_back(slot.firstVertex);
+			draws.count.push_back(slot.vertexCount);
+		}
+	}
+
+	if (table != mCurveTable)
+		SendCurveTable(table);
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		SendCurveTable
+//
+// Description:		Sends the specified curve table to OpenGL.
+//
+// Input Arguments:
+//		table	= const std::vector<GLfloat>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void CurveBatch::SendCurveTable(const std::vector<GLfloat>& table)
+{
+	if (mCurveTableTexture == 0)
+	{
+		glGenBuffers(1, &mCurveTableBuffer);
+		glGenTextures(1, &mCurveTableTexture);
+		glBindTexture(GL_TEXTURE_BUFFER, mCurveTableTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, mCurveTableBuffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+
+	// The texture refers to the buffer object, so it sees the new storage
+	glBindBuffer(GL_TEXTURE_BUFFER, mCurveTableBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(GLfloat) * table.size(),
+		table.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	mBufferInfo[0].AddBytesUploaded(sizeof(GLfloat) * table.size());
+
+	mCurveTable = table;
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			CurveBatch
+// Function:		DoGLInitialization
+//
+// Description:		Performs necessary context-state initialization (creates
+//					the program for rendering batched curves).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint CurveBatch::DoGLInitialization()
+{
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mFragmentShader));
+
+	RenderWindow::ShaderInfo s;
+	s.programId = mRenderWindow.BuildProgram(shaders);
+	s.needsModelview = false;
+	s.needsProjection = true;
+	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
+	s.uniformLocations[RenderWindow::mModelviewName] = glGetUniformLocation(s.programId, RenderWindow::mModelviewName.c_str());
+	s.uniformLocations[mCurveTableName] = glGetUniformLocation(s.programId, mCurveTableName.c_str());
+
+	assert(!RenderWindow::GLHasError());
+
+	s.attributeLocations["position"] = Line::mCompactPositionLocation;
+	s.attributeLocations["curveIndex"] = mCurveIndexLocation;
+
+	return mRenderWindow.AddShader(s);
+}
+
+}// namespace LibPlot2D
@@ -59,6 +59,8 @@ Legend::Legend(RenderWindow &mRenderWindow) : Primitive(mRenderWindow),
 	mText(mRenderWindow), mLines(mRenderWindow)
 {
 	SetDrawOrder(3000);// Draw this last
+	SetOverlay(true);// Dragged without changing the rest of the plot
+	mLines.SetShareIndices(false);// Indices are needed to assemble the buffers
 	mBufferInfo.push_back(BufferInfo());// Text
 }
 
@@ -75,15 +77,15 @@ Legend::Legend(RenderWindow &mRenderWindow) : Primitive(mRenderWindow),
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if the buffer was rebuilt
 //
 //=============================================================================
-void Legend::Update(const unsigned int& i)
+bool Legend::Update(const unsigned int& i)
 {
 	// TODO:  Alternative approach is to only update if mEntries change
 	// and to use local modelview to handle position changes.
 	if (!mText.IsOK())
-		return;
+		return false;
 
 	if (i == 0)// Background, border, mLines and markers
 	{
@@ -114,6 +116,7 @@ void Legend::Update(const unsigned int& i)
 	}
 
 	mBufferInfo[i].vertexCountModified = false;
+	return true;
 }
 
 //=============================================================================
@@ -232,7 +235,7 @@ void Legend::UpdateBoundingBox()
 	unsigned int maxStringWidth(0);
 	for (const auto& entry : mEntries)
 	{
-		boundingBox = mText.GetBoundingBox(entry.text.ToStdString());
+		boundingBox = mText.GetBoundingBox(entry.text.ToUTF8().data());
 		if (boundingBox.xRight > static_cast<int>(maxStringWidth))
 			maxStringWidth = boundingBox.xRight;
 	}
@@ -341,13 +344,13 @@ void Legend::GetAdjustedPosition(double &x, double &y) const
 	case PositionReference::BottomCenter:
 	case PositionReference::Center:
 	case PositionReference::TopCenter:
-		x = mRenderWindow.GetSize().GetWidth() * 0.5 + mX;
+		x = mRenderWindow.GetRenderSize().GetWidth() * 0.5 + mX;
 		break;
 
 	case PositionReference::BottomRight:
 	case PositionReference::MiddleRight:
 	case PositionReference::TopRight:
-		x = mRenderWindow.GetSize().GetWidth() - mX;
+		x = mRenderWindow.GetRenderSize().GetWidth() - mX;
 		break;
 	}
 
@@ -363,13 +366,13 @@ void Legend::GetAdjustedPosition(double &x, double &y) const
 	case PositionReference::MiddleLeft:
 	case PositionReference::Center:
 	case PositionReference::MiddleRight:
-		y = mRenderWindow.GetSize().GetHeight() * 0.5 + mY;
+		y = mRenderWindow.GetRenderSize().GetHeight() * 0.5 + mY;
 		break;
 
 	case PositionReference::TopLeft:
 	case PositionReference::TopCenter:
 	case PositionReference::TopRight:
-		y = mRenderWindow.GetSize().GetHeight() - mY;
+		y = mRenderWindow.GetRenderSize().GetHeight() - mY;
 		break;
 	}
 
@@ -565,13 +568,13 @@ void Legend::GetPosition(const PositionReference& legendRef,
 	case PositionReference::BottomCenter:
 	case PositionReference::Center:
 	case PositionReference::TopCenter:
-		x = mRenderWindow.GetSize().GetWidth() * 0.5 + mX;
+		x = mRenderWindow.GetRenderSize().GetWidth() * 0.5 + mX;
 		break;
 
 	case PositionReference::BottomRight:
 	case PositionReference::MiddleRight:
 	case PositionReference::TopRight:
-		x = mRenderWindow.GetSize().GetWidth() - mX;
+		x = mRenderWindow.GetRenderSize().GetWidth() - mX;
 		break;
 	}
 
@@ -587,13 +590,13 @@ void Legend::GetPosition(const PositionReference& legendRef,
 	case PositionReference::MiddleLeft:
 	case PositionReference::Center:
 	case PositionReference::MiddleRight:
-		y = mRenderWindow.GetSize().GetHeight() * 0.5 + mY;
+		y = mRenderWindow.GetRenderSize().GetHeight() * 0.5 + mY;
 		break;
 
 	case PositionReference::TopLeft:
 	case PositionReference::TopCenter:
 	case PositionReference::TopRight:
-		y = mRenderWindow.GetSize().GetHeight() - mY;
+		y = mRenderWindow.GetRenderSize().GetHeight() - mY;
 		break;
 	}
 
@@ -656,13 +659,13 @@ void Legend::GetPosition(const PositionReference& legendRef,
 	case PositionReference::BottomCenter:
 	case PositionReference::Center:
 	case PositionReference::TopCenter:
-		x -= mRenderWindow.GetSize().GetWidth() * 0.5;
+		x -= mRenderWindow.GetRenderSize().GetWidth() * 0.5;
 		break;
 
 	case PositionReference::BottomRight:
 	case PositionReference::MiddleRight:
 	case PositionReference::TopRight:
-		x = mRenderWindow.GetSize().GetWidth() - x;
+		x = mRenderWindow.GetRenderSize().GetWidth() - x;
 		break;
 	}
 
@@ -677,13 +680,13 @@ void Legend::GetPosition(const PositionReference& legendRef,
 	case PositionReference::MiddleLeft:
 	case PositionReference::Center:
 	case PositionReference::MiddleRight:
-		y -= mRenderWindow.GetSize().GetHeight() * 0.5;
+		y -= mRenderWindow.GetRenderSize().GetHeight() * 0.5;
 		break;
 
 	case PositionReference::TopLeft:
 	case PositionReference::TopCenter:
 	case PositionReference::TopRight:
-		y = mRenderWindow.GetSize().GetHeight() - y;
+		y = mRenderWindow.GetRenderSize().GetHeight() - y;
 		break;
 	}
 
@@ -1049,9 +1052,7 @@ void Legend::ConfigureVertexArray(Primitive::BufferInfo& bufferInfo) const
 	bufferInfo.GetOpenGLIndices(true);
 	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
 
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), GL_DYNAMIC_DRAW);
+	bufferInfo.BufferVertexData(GL_DYNAMIC_DRAW);
 
 	glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
 	glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(),
@@ -1061,9 +1062,7 @@ void Legend::ConfigureVertexArray(Primitive::BufferInfo& bufferInfo) const
 	glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
 		(void*)(sizeof(GLfloat) * bufferInfo.vertexCount * mRenderWindow.GetVertexDimension()));
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferInfo.GetIndexBufferIndex());
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * bufferInfo.indexBuffer.size(),
-		bufferInfo.indexBuffer.data(), GL_DYNAMIC_DRAW);
+	bufferInfo.BufferIndexData(GL_DYNAMIC_DRAW);
 
 	glBindVertexArray(0);
 }
@@ -1094,7 +1093,7 @@ void Legend::BuildLabelStrings()
 	{
 		y -= mEntrySpacing + mTextHeight;
 		mText.SetPosition(x + 2 * mEntrySpacing + mSampleLength, y);
-		mText.AppendText(entry.text.ToStdString());
+		mText.AppendText(entry.text.ToUTF8().data());
 	}
 }
 
@@ -1116,7 +1115,7 @@ void Legend::BuildLabelStrings()
 //=============================================================================
 void Legend::RequiresRedraw()
 {
-	mModified = true;
+	SetModified();
 	for (auto& buffer : mBufferInfo)
 		buffer.vertexCountModified = true;
 }
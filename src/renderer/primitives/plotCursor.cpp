@@ -47,6 +47,7 @@ PlotCursor::PlotCursor(RenderWindow &mRenderWindow, const Axis &axis)
 	mLine.SetLineColor(mColor);
 
 	SetDrawOrder(2800);
+	SetOverlay(true);// Dragged without changing the rest of the plot
 }
 
 //=============================================================================
@@ -62,27 +63,28 @@ PlotCursor::PlotCursor(RenderWindow &mRenderWindow, const Axis &axis)
 //		None
 //
 // Return Value:
-//		None
+//		bool, true (the buffer is always rebuilt)
 //
 //=============================================================================
-void PlotCursor::Update(const unsigned int& /*i*/)
+bool PlotCursor::Update(const unsigned int& /*i*/)
 {
 	if (mAxis.IsHorizontal())
 	{
 		mLine.Build(mLocationAlongAxis, mAxis.GetOffsetFromWindowEdge(),
-			mLocationAlongAxis, mRenderWindow.GetSize().GetHeight()
+			mLocationAlongAxis, mRenderWindow.GetRenderSize().GetHeight()
 			- mAxis.GetOppositeAxis()->GetOffsetFromWindowEdge(), mBufferInfo[0]);
 	}
 	else
 	{
 		mLine.Build(mAxis.GetOffsetFromWindowEdge(), mLocationAlongAxis,
-			mRenderWindow.GetSize().GetWidth()
+			mRenderWindow.GetRenderSize().GetWidth()
 			- mAxis.GetOppositeAxis()->GetOffsetFromWindowEdge(),
 			mLocationAlongAxis, mBufferInfo[0]);
 	}
 
 	// Update the value of the cursor (required for accuracy when zoom changes, for example)
 	Recalculate();
+	return true;
 }
 
 //=============================================================================
@@ -128,7 +130,7 @@ void PlotCursor::GenerateGeometry()
 		return;
 
 	glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
-	Line::DoPrettyDraw(mBufferInfo[0].indexBuffer.size());
+	Line::DoPrettyDraw(mBufferInfo[0].GetIndexCount());
 	glBindVertexArray(0);
 }
 
@@ -213,7 +215,7 @@ void PlotCursor::SetLocation(const int& location)
 {
 	mLocationAlongAxis = location;
 	mValue = mAxis.PixelToValue(location);
-	mModified = true;
+	Invalidate(Change::Transform);
 }
 
 }// namespace LibPlot2D
@@ -19,12 +19,41 @@
 #include "lp2d/renderer/renderWindow.h"
 #include "lp2d/renderer/plotRenderer.h"
 #include "lp2d/renderer/primitives/axis.h"
+#include "lp2d/renderer/primitives/curveBatch.h"
 #include "lp2d/utilities/dataset2D.h"
 #include "lp2d/utilities/math/plotMath.h"
 
+// Standard C++ headers
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+// Eigen headers
+#include <Eigen/Core>
+
 namespace LibPlot2D
 {
 
+//=============================================================================
+// Class:			PlotCurve
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for the PlotCurve class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const unsigned int PlotCurve::mDecimationFactor(4);
+const double PlotCurve::mScaleTolerance(1.0e-6);
+const double PlotCurve::mLineSizeScale(1.2);
+
 //=============================================================================
 // Class:			PlotCurve
 // Function:		PlotCurve
@@ -43,9 +72,13 @@ namespace LibPlot2D
 //
 //=============================================================================
 PlotCurve::PlotCurve(RenderWindow &renderWindow, const Dataset2D& data)
-	: Primitive(renderWindow), mData(data), mLine(renderWindow)
+	: Primitive(renderWindow), mData(data), mLine(renderWindow),
+	mShaderLine(renderWindow), mMarker(renderWindow), mDensityMap(renderWindow)
 {
 	mLine.SetBufferHint(GL_STATIC_DRAW);
+	mLine.SetCompact(true);
+	mShaderLine.SetBufferHint(GL_STATIC_DRAW);
+	mMarker.SetBufferHint(GL_STATIC_DRAW);
 	mBufferInfo.resize(2);// First one for lines, second one for the markers
 }
 
@@ -66,19 +99,22 @@ PlotCurve::PlotCurve(RenderWindow &renderWindow, const Dataset2D& data)
 //
 //=============================================================================
 PlotCurve::PlotCurve(const PlotCurve &plotCurve) : Primitive(plotCurve),
-	mData(plotCurve.mData), mLine(mRenderWindow)
+	mData(plotCurve.mData), mLine(mRenderWindow), mShaderLine(mRenderWindow),
+	mMarker(mRenderWindow), mDensityMap(mRenderWindow)
 {
 	*this = plotCurve;
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		InitializeMarkerVertexBuffer
+// Function:		~PlotCurve
 //
-// Description:		Initializes the vertex buffer for storing the marker information.
+// Description:		Destructor for the PlotCurve class.  Waits for any
+//					refinement in progress before the members are destroyed,
+//					so the outcome doesn't depend on the member order.
 //
 // Input Arguments:
-//		i	= const unsigned int&
+//		None
 //
 // Output Arguments:
 //		None
@@ -87,23 +123,22 @@ PlotCurve::PlotCurve(const PlotCurve &plotCurve) : Primitive(plotCurve),
 //		None
 //
 //=============================================================================
-void PlotCurve::InitializeMarkerVertexBuffer()
+PlotCurve::~PlotCurve()
 {
-	mBufferInfo[1].GetOpenGLIndices();
-
-	mBufferInfo[1].vertexCount = mData.GetNumberOfPoints() * 6;
-	mBufferInfo[1].vertexBuffer.resize(mBufferInfo[1].vertexCount
-		* (mRenderWindow.GetVertexDimension() + 4));
-	assert(mRenderWindow.GetVertexDimension() == 2);
-
-	mBufferInfo[1].vertexCountModified = false;
+	if (mRefinement.valid())
+		mRefinement.wait();
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		Update
+// Function:		PrepareUpdate
 //
-// Description:		Updates the GL buffers associated with this object.
+// Description:		Builds the geometry for the specified buffer.  May be
+//					called from a worker thread, so no OpenGL calls (or calls
+//					to wxWidgets) are made here; the results are sent to
+//					OpenGL in Update().  The line geometry is only rebuilt if
+//					the data or one of the inputs recorded in the BuildState
+//					has changed.
 //
 // Input Arguments:
 //		i	= const unsigned int&
@@ -115,12 +150,12 @@ void PlotCurve::InitializeMarkerVertexBuffer()
 //		None
 //
 //=============================================================================
-void PlotCurve::Update(const unsigned int& i)
+void PlotCurve::PrepareUpdate(const unsigned int& i)
 {
 	if (i == 0)
 	{
-		int width, height;
-		mRenderWindow.GetSize(&width, &height);
+		int width(mRenderWindow.GetSceneSize().GetWidth());
+		int height(mRenderWindow.GetSceneSize().GetHeight());
 		width -= mYAxis->GetOffsetFromWindowEdge()
 			+ mYAxis->GetOppositeAxis()->GetOffsetFromWindowEdge();
 		height -= mXAxis->GetOffsetFromWindowEdge()
@@ -136,82 +171,279 @@ void PlotCurve::Update(const unsigned int& i)
 		else
 			mYScale = (mYAxis->GetMaximum() - mYAxis->GetMinimum()) / height;
 
-		if (mLineSize > 0.0)
+		// The data may have been modified in place (or assigned from another
+		// data set of the same size), so the storage can't be used to tell
+		// whether the sorted check is still valid (unless points were only
+		// appended, in which case only the new points need to be checked)
+		const bool dataChanged(HasChanged(Change::Data));
+		const bool dataAppended(dataChanged && mDataAppended);
+		mDataAppended = false;
+		mAppendedFrom = 0;
+		if (dataAppended)
+			CheckAppendedXData();
+		else if (dataChanged)
+			mSortCheckData = nullptr;
+
+		const BuildState state(GetBuildState(width));
+		if (dataChanged)
+		{
+			if (mRefinement.valid())
+				mRefinement.get();// Built from the old data
+			mRefinementDisplayed = false;
+		}
+
+		UpdateScaledData(state, dataChanged, dataAppended);
+
+		// The line geometry is retained while drawing the density, so it can
+		// be used again if the view hasn't changed in the meantime
+		if (mDensity)
 		{
-			const double lineSizeScale(1.2);
+			if (BuildDensity(state, height, dataChanged))
+				mDensityUploadRequired = true;
+			mRebuildRequired = false;
+			return;
+		}
 
-			mLine.SetLineColor(mColor);
-			mLine.SetBackgroundColorForAlphaFade();
-			mLine.SetWidth(mLineSize * lineSizeScale);
-			mLine.SetXScale(mXScale);
-			mLine.SetYScale(mYScale);
+		// Streaming data is extended with the new points instead of rebuilt
+		if (dataAppended && AppendLineGeometry(state))
+			return;
 
-			std::vector<double> xLogData;
-			std::vector<double> yLogData;
-			const std::vector<double>& xRef([this, &xLogData]()
-			{
-				if (mXAxis->IsLogarithmic())
-				{
-					xLogData = std::move(DoLogarithmicScale(mData.GetX()));
-					return xLogData;
-				}
-				else
-					return mData.GetX();
-			}());
-
-			const std::vector<double>& yRef([this, &yLogData]()
-			{
-				if (mYAxis->IsLogarithmic())
-				{
-					yLogData = std::move(DoLogarithmicScale(mData.GetY()));
-					return yLogData;
-				}
-				else
-					return mData.GetY();
-			}());
-
-			mLine.Build(xRef, yRef, mBufferInfo[i]);
+		// When only the style has changed (i.e. the color), or the view is
+		// unchanged, the existing geometry can be used as-is
+		if (!dataChanged && ((mResident && GeometryIsCurrent(state)) ||
+			(!mBufferInfo[i].vertexCountModified &&
+			BuildStatesMatch(state, mLastBuild))))
+		{
+			mRebuildRequired = false;
+			return;
+		}
+
+		// Large curves are refined in the background when not previewing, so
+		// the current geometry is drawn until the refined geometry is ready.
+		// If the current geometry was built for different data or a different
+		// view (i.e. a new curve, or limits set without previewing), it can't
+		// stand in for the refinement, so a preview is built here instead.
+		unsigned int pointLimit(mPreview ? mPreviewPointBudget : 0);
+		if (mBackgroundRefinement && !mPreview && mLineSize > 0.0 &&
+			mData.GetNumberOfPoints() > mPreviewPointBudget)
+		{
+			BuildState current(state);
+			current.preview = mLastBuild.preview;
+			const bool standIn(!dataChanged &&
+				((mResident && GeometryIsCurrent(current)) ||
+				BuildStatesMatch(current, mLastBuild)));
+
+			UpdateRefinement(state);
+			if (standIn || mRefinementDisplayed)
+				return;
+
+			pointLimit = mPreviewPointBudget;
+		}
+
+		mRebuildRequired = true;
+		mRefinementDisplayed = false;
+		mLastBuild = state;
+		mLastBuild.preview = pointLimit > 0;
+		ComputeOrigin(state, mXOrigin, mYOrigin);
+
+		if (mLineSize > 0.0)
+		{
+			ConfigureLines();
+			mLineBuiltWithShaderLine = mPretty && mShaderLines;
+
+			std::vector<double> x;
+			std::vector<double> y;
+			GetVisibleData(state, mXOrigin, mYOrigin, x, y);
+			mLastBuild.decimated = BuildLineGeometry(state, x, y,
+				pointLimit, mLine, mShaderLine, mBufferInfo[i]);
+			mLineUploadRequired = true;
+			mLineUploadStart = 0;
 		}
 		else
 			mLine.SetWidth(0.0);
 	}
 	else
 	{
-		if (mBufferInfo[i].vertexCountModified)
-			InitializeMarkerVertexBuffer();
+		if (mDensity)
+			return;
+
+		if (mAppendedFrom > 0)
+		{
+			AppendMarkers(mAppendedFrom);
+			mMarkerUploadRequired = true;
+			return;
+		}
+
+		if (!mRebuildRequired && !mBufferInfo[i].vertexCountModified)
+			return;
+
+		BuildMarkers(mLastBuild);
+		mMarkerUploadRequired = true;
+	}
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		AppendLineGeometry
+//
+// Description:		Extends the existing line geometry with the points added
+//					to the data since it was built, if the geometry can be
+//					extended (resident lines expanded on the GPU, with the
+//					same origin and decimation as the existing geometry).
+//					When the data is decimated, the points kept for the last
+//					pixel column of the existing data may change, so they are
+//					replaced along with the new points.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the geometry was extended; false if it must be rebuilt
+//
+//=============================================================================
+bool PlotCurve::AppendLineGeometry(const BuildState& state)
+{
+	typedef std::vector<double>::size_type IndexType;
+	const IndexType previousCount(mLastBuild.pointCount);
+	if (!mResident || mLineSize <= 0.0 || !mLineBuiltWithShaderLine ||
+		!state.pretty || !state.shaderLines ||
+		mBufferInfo[0].vertexCount == 0 || previousCount < 2 ||
+		state.pointCount <= previousCount ||
+		(state.preview && state.pointCount > mPreviewPointBudget))
+		return false;
+
+	// The existing geometry must be current for the existing points
+	BuildState previous(state);
+	previous.xData = mLastBuild.xData;
+	previous.yData = mLastBuild.yData;
+	previous.pointCount = previousCount;
+	if (!GeometryIsCurrent(previous))
+		return false;
+
+	// Geometry which was not decimated is rebuilt when it needs to be (once)
+	const bool decimate(state.plotWidth > 0 && state.pointCount >
+		mDecimationFactor * static_cast<unsigned int>(state.plotWidth));
+	if (decimate != mLastBuild.decimated)
+		return false;
+
+	double xOrigin, yOrigin;
+	ComputeOrigin(state, xOrigin, yOrigin);
+	if (xOrigin != mXOrigin || yOrigin != mYOrigin)
+		return false;
+
+	const std::vector<double>& x(GetScaledX(state.xLogarithmic));
+	const std::vector<double>& y(GetScaledY(state.yLogarithmic));
 
-		BuildMarkers();
+	// Find the start of the last run of points in the same pixel column (see
+	// DecimateForPixelColumns(), using the same arithmetic)
+	IndexType start(previousCount);
+	const double pixelsPerUnit(mLastBuild.decimated ?
+		1.0 / mLastBuild.xScale : 0.0);
+	if (mLastBuild.decimated && PlotMath::IsValid(x[start - 1]) &&
+		PlotMath::IsValid(y[start - 1]))
+	{
+		const double column(floor((x[start - 1] - mXOrigin) * pixelsPerUnit));
+		while (start > 1 && PlotMath::IsValid(x[start - 2]) &&
+			PlotMath::IsValid(y[start - 2]) &&
+			floor((x[start - 2] - mXOrigin) * pixelsPerUnit) == column)
+			--start;
+		--start;
+	}
 
-		glBindVertexArray(mBufferInfo[i].GetVertexArrayIndex());
+	std::vector<double> xNew(x.begin() + start, x.end());
+	std::vector<double> yNew(y.begin() + start, y.end());
+	for (auto& v : xNew)
+		v -= mXOrigin;
+	for (auto& v : yNew)
+		v -= mYOrigin;
 
-		glBindBuffer(GL_ARRAY_BUFFER, mBufferInfo[i].GetVertexBufferIndex());
-		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * mBufferInfo[i].vertexBuffer.size(),
-			mBufferInfo[i].vertexBuffer.data(), GL_DYNAMIC_DRAW);
+	unsigned int replacedPoints(0);
+	if (mLastBuild.decimated)
+	{
+		const IndexType runSize(previousCount - start);
+		std::vector<double> xDecimated, yDecimated;
+		DecimateForPixelColumns(
+			std::vector<double>(xNew.begin(), xNew.begin() + runSize),
+			std::vector<double>(yNew.begin(), yNew.begin() + runSize),
+			0.0, mLastBuild.xScale, xDecimated, yDecimated);
+		replacedPoints = static_cast<unsigned int>(xDecimated.size());
+
+		DecimateForPixelColumns(xNew, yNew, 0.0, mLastBuild.xScale,
+			xDecimated, yDecimated);
+		xNew.swap(xDecimated);
+		yNew.swap(yDecimated);
+	}
 
-		glEnableVertexAttribArray(mRenderWindow.GetDefaultPositionLocation());
-		glVertexAttribPointer(mRenderWindow.GetDefaultPositionLocation(), 2, GL_FLOAT, GL_FALSE, 0, 0);
+	mLineUploadStart = mShaderLine.Append(xNew, yNew, replacedPoints,
+		mBufferInfo[0], Line::UpdateMethod::Manual);
+	mLineUploadRequired = true;
 
-		glEnableVertexAttribArray(mRenderWindow.GetDefaultColorLocation());
-		glVertexAttribPointer(mRenderWindow.GetDefaultColorLocation(), 4, GL_FLOAT, GL_FALSE, 0,
-			(void*)(sizeof(GLfloat) * mRenderWindow.GetVertexDimension() * mBufferInfo[i].vertexCount));
+	mLastBuild.xData = state.xData;
+	mLastBuild.yData = state.yData;
+	mLastBuild.pointCount = state.pointCount;
+	mAppendedFrom = previousCount;
+	mRebuildRequired = false;
 
-		/*glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mBufferInfo[i].indexBufferIndex);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mBufferInfo[i].indexBuffer.size(),
-			mBufferInfo[i].indexBuffer.data(), GL_DYNAMIC_DRAW);*/
-		// TODO:  Why doesn't this work?  Similar code worked just fine before switching to std::vector
+	return true;
+}
 
-		glBindVertexArray(0);
+//=============================================================================
+// Class:			PlotCurve
+// Function:		AppendMarkers
+//
+// Description:		Adds markers for the points appended to the data.  The
+//					markers for resident geometry include every point, so the
+//					existing markers are retained.
+//
+// Input Arguments:
+//		previousCount	= const std::vector<double>::size_type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::AppendMarkers(const std::vector<double>::size_type& previousCount)
+{
+	Primitive::BufferInfo& bufferInfo(mBufferInfo[1]);
+	if (bufferInfo.vertexCount != previousCount)
+	{
+		BuildMarkers(mLastBuild);
+		return;
 	}
 
-	assert(!RenderWindow::GLHasError());
+	const unsigned int dimension(mRenderWindow.GetVertexDimension());
+	assert(dimension == 2);
+
+	bufferInfo.SetStreaming(true);
+	bufferInfo.vertexCount = static_cast<unsigned int>(mLastBuild.pointCount);
+	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * dimension);
+	mMarkerUploadStart = previousCount * dimension;
+
+	const std::vector<double>& x(GetScaledX(mLastBuild.xLogarithmic));
+	const std::vector<double>& y(GetScaledY(mLastBuild.yLogarithmic));
+
+	std::vector<double>::size_type i;
+	for (i = previousCount; i < bufferInfo.vertexCount; ++i)
+	{
+		bufferInfo.vertexBuffer[i * dimension] = static_cast<float>(
+			x[i] - mXOrigin);
+		bufferInfo.vertexBuffer[i * dimension + 1] = static_cast<float>(
+			y[i] - mYOrigin);
+	}
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		GenerateGeometry
+// Function:		ConfigureLines
 //
-// Description:		Creates the OpenGL instructions to create this object in
-//					the scene.
+// Description:		Applies the current line size and scale to the line
+//					objects.
 //
 // Input Arguments:
 //		None
@@ -223,125 +455,246 @@ void PlotCurve::Update(const unsigned int& i)
 //		None
 //
 //=============================================================================
-void PlotCurve::GenerateGeometry()
+void PlotCurve::ConfigureLines()
 {
-	if (mYAxis->GetOrientation() == Axis::Orientation::Left)
-		dynamic_cast<PlotRenderer&>(mRenderWindow).LoadModelviewUniform(PlotRenderer::Modelview::Left);
-	else
-		dynamic_cast<PlotRenderer&>(mRenderWindow).LoadModelviewUniform(PlotRenderer::Modelview::Right);
+	mLine.SetWidth(mLineSize * mLineSizeScale);
+	mLine.SetXScale(mXScale);
+	mLine.SetYScale(mYScale);
 
-	glEnable(GL_SCISSOR_TEST);
+	mShaderLine.SetWidth(mLineSize * mLineSizeScale);
+}
 
-	if (mLineSize > 0.0)
+//=============================================================================
+// Class:			PlotCurve
+// Function:		BuildLineGeometry
+//
+// Description:		Builds the line geometry for the specified state from the
+//					visible data (see GetVisibleData()).  When there are more
+//					points than pixels, most segments collapse onto the same
+//					column of pixels, so only the points that define what is
+//					actually visible are kept.  When a point limit is
+//					specified (i.e. for previews), the columns are widened as
+//					necessary to respect the limit.  Only the arguments are
+//					accessed, so it may be called from any thread.
+//
+// Input Arguments:
+//		state		= const BuildState&
+//		x			= const std::vector<double>&
+//		y			= const std::vector<double>&
+//		pointLimit	= const unsigned int&, zero for no limit
+//		line		= Line&
+//		shaderLine	= ShaderLine&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		bool, true if the data was decimated
+//
+//=============================================================================
+bool PlotCurve::BuildLineGeometry(const BuildState& state,
+	const std::vector<double>& x, const std::vector<double>& y,
+	const unsigned int& pointLimit, Line& line, ShaderLine& shaderLine,
+	Primitive::BufferInfo& bufferInfo)
+{
+	auto buildLine([&state, &line, &shaderLine, &bufferInfo](
+		const std::vector<double>& x, const std::vector<double>& y)
 	{
-		glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
-
-		if (mPretty)
-			Line::DoPrettyDraw(mBufferInfo[0].indexBuffer.size());
+		if (state.pretty && state.shaderLines)
+			shaderLine.Build(x, y, bufferInfo, Line::UpdateMethod::Manual);
 		else
-			Line::DoUglyDraw(mBufferInfo[0].vertexCount);
-	}
+			line.Build(x, y, bufferInfo, Line::UpdateMethod::Manual);
+	});
 
-	if (NeedsMarkersDrawn())
+	if (x.size() < 2)
 	{
-		glBindVertexArray(mBufferInfo[1].GetVertexArrayIndex());
-		glDrawArrays(GL_TRIANGLES, 0, mBufferInfo[1].vertexCount);
+		// Nothing to draw within the visible range
+		bufferInfo.vertexCount = 0;
+		bufferInfo.indexBuffer.clear();
+		return false;
 	}
 
-	glBindVertexArray(0);
-	glDisable(GL_SCISSOR_TEST);
+	double columnWidth(0.0);
+	if (state.plotWidth > 0 && x.size() > mDecimationFactor
+		* static_cast<unsigned int>(state.plotWidth))
+		columnWidth = state.xScale;
 
-	assert(!RenderWindow::GLHasError());
+	if (pointLimit > 0 && x.size() > pointLimit)
+		columnWidth = std::max(columnWidth, GetPreviewColumnWidth(x, pointLimit));
+
+	if (!(columnWidth > 0.0))
+	{
+		buildLine(x, y);
+		return false;
+	}
 
-	dynamic_cast<PlotRenderer&>(mRenderWindow).LoadModelviewUniform(PlotRenderer::Modelview::Fixed);
+	// Pixel columns are measured from the vertex origin, so they don't move
+	// (and resident geometry remains valid) when panning
+	std::vector<double> xDecimated;
+	std::vector<double> yDecimated;
+	DecimateForPixelColumns(x, y, 0.0, columnWidth, xDecimated, yDecimated);
+	buildLine(xDecimated, yDecimated);
+
+	return true;
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		PointIsValid
+// Function:		GetPreviewColumnWidth
 //
-// Description:		Checks to see if the specified point is a real, finite number.
+// Description:		Computes the column width required to decimate the
+//					specified data to approximately the specified number of
+//					points.
 //
 // Input Arguments:
-//		i	= const unsigned int&
+//		x			= const std::vector<double>&
+//		pointLimit	= const unsigned int&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		bool, true for valid, false otherwise
+//		double
 //
 //=============================================================================
-bool PlotCurve::PointIsValid(const unsigned int &i) const
+double PlotCurve::GetPreviewColumnWidth(const std::vector<double>& x,
+	const unsigned int& pointLimit)
 {
-	assert(i < mData.GetNumberOfPoints());
+	assert(pointLimit > 0);
 
-	return PlotMath::IsValid<double>(mData.GetX()[i]) &&
-		PlotMath::IsValid<double>(mData.GetY()[i]);
+	double minimum(0.0), maximum(0.0);
+	bool first(true);
+	for (const auto& v : x)
+	{
+		if (!PlotMath::IsValid(v))
+			continue;
+
+		if (first)
+		{
+			minimum = v;
+			maximum = v;
+			first = false;
+		}
+		else if (v < minimum)
+			minimum = v;
+		else if (v > maximum)
+			maximum = v;
+	}
+
+	// Up to mDecimationFactor points are kept for each column
+	const double columnCount(std::max(1.0,
+		static_cast<double>(pointLimit) / mDecimationFactor));
+	return (maximum - minimum) / columnCount;
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		HasValidParameters
+// Function:		UpdateRefinement
 //
-// Description:		Checks to see if the information about this object is
-//					valid and complete (gives permission to create the object).
+// Description:		Handles the line geometry for curves which are refined in
+//					the background.  Completed refinements are adopted if they
+//					are still valid for the current state; otherwise, a new
+//					refinement is started.  The existing geometry is drawn
+//					until the refinement is complete.
 //
 // Input Arguments:
-//		None
+//		state	= const BuildState&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		bool, true for OK to draw, false otherwise
+//		None
 //
 //=============================================================================
-bool PlotCurve::HasValidParameters()
+void PlotCurve::UpdateRefinement(const BuildState& state)
 {
-	if (mXAxis != nullptr && mYAxis != nullptr && mData.GetNumberOfPoints() > 1)
+	mRebuildRequired = false;
+
+	if (mRefinement.valid())
 	{
-		if (mXAxis->IsHorizontal() && !mYAxis->IsHorizontal())
-			return true;
+		if (mRefinement.wait_for(std::chrono::seconds(0))
+			!= std::future_status::ready)
+			return;
+
+		std::unique_ptr<Refinement> refinement(mRefinement.get());
+		if (BuildStatesMatch(refinement->state, state))
+		{
+			AdoptRefinement(*refinement);
+			return;
+		}
 	}
 
-	return false;
+	if (mRefinementDisplayed && BuildStatesMatch(mLastBuild, state))
+		return;
+
+	StartRefinement(state);
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		operator=
+// Function:		StartRefinement
 //
-// Description:		Assignment operator for PlotCurve class.
+// Description:		Starts building the full-fidelity line geometry for the
+//					specified state on a worker thread.  The visible data is
+//					copied here, so the worker never reads the Dataset2D (which
+//					the caller may modify at any time) or the cached
+//					logarithms.  When complete, an update is scheduled so the
+//					geometry can be adopted.
 //
 // Input Arguments:
-//		plotCurve	= const PlotCurve& to assign to this object
+//		state	= const BuildState&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		PlotCurve&, reference to this object
+//		None
 //
 //=============================================================================
-PlotCurve& PlotCurve::operator=(const PlotCurve &plotCurve)
+void PlotCurve::StartRefinement(const BuildState& state)
 {
-	if (this == &plotCurve)
-		return *this;
+	assert(!mRefinement.valid());
 
-	this->Primitive::operator=(plotCurve);
+	std::unique_ptr<Refinement> refinement(new Refinement);
+	refinement->state = state;
+	refinement->shaderLine = mPretty && mShaderLines;
+	ComputeOrigin(state, refinement->xOrigin, refinement->yOrigin);
 
-	return *this;
+	std::vector<double> x;
+	std::vector<double> y;
+	GetVisibleData(state, refinement->xOrigin, refinement->yOrigin, x, y);
+
+	// The worker uses its own copies of the line objects
+	ConfigureLines();
+
+	PlotRenderer& renderer(dynamic_cast<PlotRenderer&>(mRenderWindow));
+	mRefinement = std::async(std::launch::async, [&renderer,
+		line = mLine, shaderLine = mShaderLine, x = std::move(x),
+		y = std::move(y), refinement = std::move(refinement)]() mutable
+	{
+		refinement->state.decimated = BuildLineGeometry(refinement->state,
+			x, y, 0, line, shaderLine, refinement->bufferInfo);
+
+		renderer.CallAfter([&renderer]()
+		{
+			renderer.ScheduleUpdate(false);
+		});
+
+		return std::move(refinement);
+	});
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		BuildMarkers
+// Function:		AdoptRefinement
 //
-// Description:		Plots markers at all un-interpolated points.
+// Description:		Replaces the line geometry with the specified refined
+//					geometry.  The OpenGL objects are retained, so the new
+//					geometry is sent to the existing buffers.
 //
 // Input Arguments:
-//		None
+//		refinement	= Refinement&
 //
 // Output Arguments:
 //		None
@@ -350,103 +703,1058 @@ PlotCurve& PlotCurve::operator=(const PlotCurve &plotCurve)
 //		None
 //
 //=============================================================================
-void PlotCurve::BuildMarkers()
+void PlotCurve::AdoptRefinement(Refinement& refinement)
 {
-	float halfMarkerYSize = 2 * mMarkerSize * mYScale;
-	float halfMarkerXSize = 2 * mMarkerSize * mXScale;
-	const unsigned int dimension(mRenderWindow.GetVertexDimension());
-	const unsigned int colorStart(mData.GetNumberOfPoints() * dimension * 6);
+	Primitive::BufferInfo& bufferInfo(mBufferInfo[0]);
+	bufferInfo.vertexCount = refinement.bufferInfo.vertexCount;
+	bufferInfo.vertexBuffer.swap(refinement.bufferInfo.vertexBuffer);
+	bufferInfo.indexBuffer.swap(refinement.bufferInfo.indexBuffer);
+	bufferInfo.sharedIndexCount = refinement.bufferInfo.sharedIndexCount;
+	bufferInfo.vertexCountModified = false;
+	mLineUploadStart = 0;
+
+	mLastBuild = refinement.state;
+	mXOrigin = refinement.xOrigin;
+	mYOrigin = refinement.yOrigin;
+	mLineBuiltWithShaderLine = refinement.shaderLine;
+	mLineUploadRequired = true;
+	mRefinementDisplayed = true;
+
+	// Markers are stored relative to the origin, too
+	mRebuildRequired = true;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		Update
+//
+// Description:		Sends the geometry built by PrepareUpdate() to OpenGL.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if new geometry was sent to OpenGL
+//
+//=============================================================================
+bool PlotCurve::Update(const unsigned int& i)
+{
+	if (i == 0)
+	{
+		if (mDensity)
+		{
+			if (!mDensityUploadRequired)
+				return false;
+			mDensityUploadRequired = false;
 
-	// Use function pointers to save a few checks in the loop
-	PlotRenderer::ScalingFunction xScaleFunction(
-		dynamic_cast<PlotRenderer&>(mRenderWindow).GetXScaleFunction());
-	PlotRenderer::ScalingFunction yScaleFunction;
+			mDensityMap.Upload();
+			return true;
+		}
 
-	if (mYAxis->GetOrientation() == Axis::Orientation::Left)
-		yScaleFunction = dynamic_cast<PlotRenderer&>(mRenderWindow).GetLeftYScaleFunction();
-	else
-		yScaleFunction = dynamic_cast<PlotRenderer&>(mRenderWindow).GetRightYScaleFunction();
+		if (!mLineUploadRequired)
+			return false;
+		mLineUploadRequired = false;
 
-	unsigned int i;
-	for (i = 0; i < mData.GetNumberOfPoints(); ++i)
-	{
-		float x(static_cast<float>(xScaleFunction(mData.GetX()[i])));
-		float y(static_cast<float>(yScaleFunction(mData.GetY()[i])));
+		std::vector<float>::size_type first(mLineUploadStart);
+		mLineUploadStart = 0;
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension] = x + halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 1] = y + halfMarkerYSize;
+		// The vertex attribute layouts of the two line types are not
+		// compatible, so start with a fresh vertex array when switching
+		if (mLineBuiltWithShaderLine != mLineBufferHasShaderLine)
+		{
+			mBufferInfo[i].FreeOpenGLObjects();
+			mLineBufferHasShaderLine = mLineBuiltWithShaderLine;
+			first = 0;
+		}
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + dimension] = x - halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + dimension + 1] = y + halfMarkerYSize;
+		if (LineIsBatched())
+		{
+			// The batch sends the vertices to OpenGL along with those of the
+			// other curves in the batch (and counts the update)
+			mBufferInfo[i].FreeOpenGLObjects();
+			mBatch->Invalidate(Change::Data);
+			return false;
+		}
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 2 * dimension] = x - halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 2 * dimension + 1] = y - halfMarkerYSize;
+		if (mBufferInfo[i].vertexCount == 0)
+			return false;
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 3 * dimension] = x + halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 3 * dimension + 1] = y + halfMarkerYSize;
+		if (mLineBufferHasShaderLine)
+			mShaderLine.Upload(mBufferInfo[i], first);
+		else
+			mLine.Upload(mBufferInfo[i]);
+	}
+	else
+	{
+		if (!mMarkerUploadRequired)
+			return false;
+		mMarkerUploadRequired = false;
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 4 * dimension] = x - halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 4 * dimension + 1] = y - halfMarkerYSize;
+		mMarker.Upload(mBufferInfo[i], mMarkerUploadStart);
+		mMarkerUploadStart = 0;
+	}
 
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 5 * dimension] = x + halfMarkerXSize;
-		mBufferInfo[1].vertexBuffer[i * 6 * dimension + 5 * dimension + 1] = y - halfMarkerYSize;
+	assert(!RenderWindow::GLHasError());
+	return true;
+}
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 1] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 2] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 3] = static_cast<float>(mColor.GetAlpha());
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GenerateGeometry
+//
+// Description:		Creates the OpenGL instructions to create this object in
+//					the scene.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::GenerateGeometry()
+{
+	const PlotRenderer::Modelview orientation(mYAxis->GetOrientation()
+		== Axis::Orientation::Left ? PlotRenderer::Modelview::Left :
+		PlotRenderer::Modelview::Right);
+	const PlotRenderer& renderer(dynamic_cast<PlotRenderer&>(mRenderWindow));
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 4] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 5] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 6] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 7] = static_cast<float>(mColor.GetAlpha());
+	glEnable(GL_SCISSOR_TEST);
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 8] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 9] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 10] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 11] = static_cast<float>(mColor.GetAlpha());
+	if (mDensity)
+	{
+		const DensityMap::Extents& extents(mDensityMap.GetExtents());
+		mDensityMap.Draw(renderer.GetModelviewMatrix(orientation,
+			extents.xMinimum, extents.yMinimum));
+		glDisable(GL_SCISSOR_TEST);
+		return;
+	}
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 12] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 13] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 14] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 15] = static_cast<float>(mColor.GetAlpha());
+	const Eigen::Matrix4d modelview(renderer.GetModelviewMatrix(orientation,
+		mXOrigin, mYOrigin));
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 16] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 17] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 18] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 19] = static_cast<float>(mColor.GetAlpha());
+	if (mLineSize > 0.0 && mBufferInfo[0].vertexCount > 0 && !LineIsBatched())
+	{
+		if (mLineBufferHasShaderLine)
+		{
+			// The geometry may not have been rebuilt for a new line size
+			mShaderLine.SetWidth(mLineSize * mLineSizeScale);
+			mShaderLine.SetLineColor(mColor);
+			mShaderLine.Draw(mBufferInfo[0], modelview);
+		}
+		else
+		{
+			Color edgeColor(mColor);
+			if (mPretty)
+				edgeColor.SetAlpha(0.0);
+			mLine.UseCompactProgram(modelview, mColor, edgeColor);
+			glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
+
+			if (mPretty)
+				Line::DoPrettyDraw(mBufferInfo[0].GetIndexCount());
+			else
+			{
+				// The geometry may not have been rebuilt (which is where the
+				// line width would otherwise be set)
+				glLineWidth(static_cast<GLfloat>(mLineSize * mLineSizeScale));
+				Line::DoUglyDraw(mBufferInfo[0].vertexCount);
+			}
+
+			glBindVertexArray(0);
+			mRenderWindow.UseDefaultProgram();
+		}
+	}
 
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 20] = static_cast<float>(mColor.GetRed());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 21] = static_cast<float>(mColor.GetGreen());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 22] = static_cast<float>(mColor.GetBlue());
-		mBufferInfo[1].vertexBuffer[colorStart + i * 24 + 23] = static_cast<float>(mColor.GetAlpha());
+	if (NeedsMarkersDrawn())
+	{
+		mMarker.SetColor(mColor);
+		mMarker.SetSize(4.0 * fabs(mMarkerSize));
+		mMarker.Draw(mBufferInfo[1], modelview);
 	}
+
+	glDisable(GL_SCISSOR_TEST);
+
+	assert(!RenderWindow::GLHasError());
 }
 
 //=============================================================================
 // Class:			PlotCurve
-// Function:		DoLogarithmicScale
+// Function:		SetDensity
 //
-// Description:		Handles scaling for arrays of logarithmic data.
+// Description:		Sets the flag indicating whether or not the curve should
+//					be drawn as a density map.
 //
 // Input Arguments:
-//		value	= const std::vector<double>&
+//		density	= const bool&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		std::vector<double>
+//		None
 //
 //=============================================================================
-std::vector<double> PlotCurve::DoLogarithmicScale(
-	const std::vector<double>& values)
+void PlotCurve::SetDensity(const bool &density)
 {
-	std::vector<double> scaledValues(values);
-	for (auto& v : scaledValues)
-		v = PlotRenderer::DoLogarithmicScale(v);
+	if (density == mDensity)
+		return;
+
+	mDensity = density;
+
+	// The line is not sent to OpenGL (or to the batch) while drawing the
+	// density, so it must be sent when switching back
+	mLineUploadRequired = true;
+	Invalidate(Change::Style);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		BuildDensity
+//
+// Description:		Counts the points for the density map.  Only points
+//					within the visible range are considered when the x-data
+//					is sorted, and only a subset of the points is counted when
+//					previewing, so the cost of counting is bounded while the
+//					user zooms and pans.  Nothing is done if the view and data
+//					are unchanged.
+//
+// Input Arguments:
+//		state		= const BuildState&
+//		plotHeight	= const int& [pixels]
+//		dataChanged	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the density map was rebuilt
+//
+//=============================================================================
+bool PlotCurve::BuildDensity(const BuildState& state, const int& plotHeight,
+	const bool& dataChanged)
+{
+	DensityMap::Extents extents;
+	extents.xMinimum = state.xLogarithmic ? log10(state.xMinimum) : state.xMinimum;
+	extents.yMinimum = state.yLogarithmic ? log10(state.yMinimum) : state.yMinimum;
+	extents.xScale = state.xScale;
+	extents.yScale = state.yScale;
+	extents.columns = static_cast<unsigned int>(std::max(state.plotWidth, 0));
+	extents.rows = static_cast<unsigned int>(std::max(plotHeight, 0));
+
+	const std::vector<double>& xData(mData.GetX());
+	auto first(xData.begin());
+	auto last(xData.end());
+	if (state.xSorted)
+	{
+		first = std::lower_bound(xData.begin(), xData.end(), state.xMinimum);
+		last = std::upper_bound(first, xData.end(), state.xMaximum);
+	}
+
+	const std::size_t start(std::distance(xData.begin(), first));
+	const std::size_t count(std::distance(first, last));
+
+	unsigned int stride(1);
+	if (state.preview && mPreviewPointBudget > 0 && count > mPreviewPointBudget)
+		stride = static_cast<unsigned int>(
+			(count + mPreviewPointBudget - 1) / mPreviewPointBudget);
+
+	return mDensityMap.Build(GetScaledX(state.xLogarithmic).data() + start,
+		GetScaledY(state.yLogarithmic).data() + start, count, stride, extents,
+		dataChanged);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		SetBatch
+//
+// Description:		Sets the batch which draws this curve's line (nullptr to
+//					draw the line with this object).  Should only be called by
+//					the batch.
+//
+// Input Arguments:
+//		batch	= CurveBatch*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::SetBatch(CurveBatch* batch)
+{
+	if (batch == mBatch)
+		return;
+
+	mBatch = batch;
+
+	// The existing geometry is sent to OpenGL by the new owner
+	mLineUploadRequired = true;
+	Invalidate(Change::Style);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		LineIsBatched
+//
+// Description:		Checks to see if this curve's line is drawn by a batch.
+//					Only compact lines which use the shared index buffer (or
+//					no indices) can be combined with other curves.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the line is drawn by the batch
+//
+//=============================================================================
+bool PlotCurve::LineIsBatched() const
+{
+	return mBatch && !mDensity && !mLineBufferHasShaderLine &&
+		mBufferInfo[0].indexBuffer.empty();
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		PointIsValid
+//
+// Description:		Checks to see if the specified point is a real, finite number.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for valid, false otherwise
+//
+//=============================================================================
+bool PlotCurve::PointIsValid(const unsigned int &i) const
+{
+	assert(i < mData.GetNumberOfPoints());
+
+	return PlotMath::IsValid<double>(mData.GetX()[i]) &&
+		PlotMath::IsValid<double>(mData.GetY()[i]);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		HasValidParameters
+//
+// Description:		Checks to see if the information about this object is
+//					valid and complete (gives permission to create the object).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for OK to draw, false otherwise
+//
+//=============================================================================
+bool PlotCurve::HasValidParameters()
+{
+	if (mXAxis != nullptr && mYAxis != nullptr && mData.GetNumberOfPoints() > 1)
+	{
+		if (mXAxis->IsHorizontal() && !mYAxis->IsHorizontal())
+			return true;
+	}
+
+	return false;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		operator=
+//
+// Description:		Assignment operator for PlotCurve class.
+//
+// Input Arguments:
+//		plotCurve	= const PlotCurve& to assign to this object
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PlotCurve&, reference to this object
+//
+//=============================================================================
+PlotCurve& PlotCurve::operator=(const PlotCurve &plotCurve)
+{
+	if (this == &plotCurve)
+		return *this;
+
+	this->Primitive::operator=(plotCurve);
+
+	return *this;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		BuildMarkers
+//
+// Description:		Plots markers at the un-interpolated points within the
+//					range used for the line geometry.  Only the marker
+//					positions are stored; the markers are sized and shaped on
+//					the GPU.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::BuildMarkers(const BuildState& state)
+{
+	std::vector<double>::size_type startIndex, endIndex;
+	GetVisibleRange(state, startIndex, endIndex);
+
+	const unsigned int dimension(mRenderWindow.GetVertexDimension());
+	assert(dimension == 2);
+
+	Primitive::BufferInfo& bufferInfo(mBufferInfo[1]);
+	bufferInfo.vertexCount = static_cast<unsigned int>(endIndex - startIndex);
+	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * dimension);
+	bufferInfo.vertexCountModified = false;
+	mMarkerUploadStart = 0;
+
+	const std::vector<double>& x(GetScaledX(state.xLogarithmic));
+	const std::vector<double>& y(GetScaledY(state.yLogarithmic));
+
+	unsigned int i;
+	for (i = 0; i < bufferInfo.vertexCount; ++i)
+	{
+		bufferInfo.vertexBuffer[i * dimension] = static_cast<float>(
+			x[startIndex + i] - mXOrigin);
+		bufferInfo.vertexBuffer[i * dimension + 1] = static_cast<float>(
+			y[startIndex + i] - mYOrigin);
+	}
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		XDataIsSorted
+//
+// Description:		Checks to see if the x-data is sorted in ascending order.
+//					The result is cached, as the check requires looking at
+//					every point.  Invalid values cause the data to be treated
+//					as unsorted.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool PlotCurve::XDataIsSorted() const
+{
+	const std::vector<double>& x(mData.GetX());
+	if (mSortCheckData == x.data() && mSortCheckSize == x.size())
+		return mXIsSorted;
+
+	mSortCheckData = x.data();
+	mSortCheckSize = x.size();
+	mXIsSorted = true;
+
+	std::vector<double>::size_type i;
+	for (i = 1; i < x.size(); ++i)
+	{
+		// Written this way so that NaNs also result in false
+		if (!(x[i] >= x[i - 1]))
+		{
+			mXIsSorted = false;
+			break;
+		}
+	}
+
+	return mXIsSorted;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		CheckAppendedXData
+//
+// Description:		Updates the cached result of the sorted check for points
+//					appended to the data.  Only the new points are checked.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::CheckAppendedXData() const
+{
+	const std::vector<double>& x(mData.GetX());
+	if (!mSortCheckData || mSortCheckSize > x.size())
+	{
+		mSortCheckData = nullptr;
+		return;
+	}
+
+	if (mXIsSorted)
+	{
+		std::vector<double>::size_type i;
+		for (i = std::max<std::vector<double>::size_type>(mSortCheckSize, 1);
+			i < x.size(); ++i)
+		{
+			if (!(x[i] >= x[i - 1]))
+			{
+				mXIsSorted = false;
+				break;
+			}
+		}
+	}
+
+	mSortCheckData = x.data();
+	mSortCheckSize = x.size();
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GetVisibleRange
+//
+// Description:		Determines the range of indices of the data that lies
+//					within the x-axis limits (plus one point on each side, so
+//					lines leaving the plot area are still drawn).  If the
+//					x-data is not sorted or if the geometry is to be kept
+//					resident, the range includes all of the data.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//
+// Output Arguments:
+//		startIndex	= std::vector<double>::size_type&
+//		endIndex	= std::vector<double>::size_type& (one past the last)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::GetVisibleRange(const BuildState& state,
+	std::vector<double>::size_type& startIndex,
+	std::vector<double>::size_type& endIndex) const
+{
+	const std::vector<double>& xData(mData.GetX());
+
+	auto first(xData.begin());
+	auto last(xData.end());
+	if (!state.resident && state.xSorted)
+	{
+		first = std::lower_bound(xData.begin(), xData.end(), state.xMinimum);
+		if (first != xData.begin())
+			--first;
+
+		last = std::upper_bound(first, xData.end(), state.xMaximum);
+		if (last != xData.end())
+			++last;
+	}
+
+	startIndex = std::distance(xData.begin(), first);
+	endIndex = std::distance(xData.begin(), last);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GetVisibleData
+//
+// Description:		Copies the portion of the data within the range given by
+//					GetVisibleRange() to the specified vectors.  Data
+//					associated with logarithmic axes is taken from the cached
+//					logarithms, and the result is made relative to the vertex
+//					origin.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//		xOrigin	= const double&
+//		yOrigin	= const double&
+//
+// Output Arguments:
+//		x	= std::vector<double>&
+//		y	= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::GetVisibleData(const BuildState& state, const double& xOrigin,
+	const double& yOrigin, std::vector<double>& x,
+	std::vector<double>& y) const
+{
+	std::vector<double>::size_type startIndex, endIndex;
+	GetVisibleRange(state, startIndex, endIndex);
+
+	const std::vector<double>& xScaled(GetScaledX(state.xLogarithmic));
+	const std::vector<double>& yScaled(GetScaledY(state.yLogarithmic));
+	x.assign(xScaled.begin() + startIndex, xScaled.begin() + endIndex);
+	y.assign(yScaled.begin() + startIndex, yScaled.begin() + endIndex);
+
+	for (auto& v : x)
+		v -= xOrigin;
+
+	for (auto& v : y)
+		v -= yOrigin;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		ComputeOrigin
+//
+// Description:		Determines the point relative to which vertices are stored.
+//					Vertices are stored as single-precision floats, so keeping
+//					them small preserves precision for data with large offsets.
+//					For resident geometry, the first valid data point is used
+//					(so the origin doesn't change when panning).  Otherwise,
+//					the minimum of the visible range is used.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//
+// Output Arguments:
+//		xOrigin	= double&
+//		yOrigin	= double&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::ComputeOrigin(const BuildState& state, double& xOrigin,
+	double& yOrigin) const
+{
+	if (!state.resident)
+	{
+		xOrigin = state.xLogarithmic ?
+			PlotRenderer::DoLogarithmicScale(state.xMinimum) : state.xMinimum;
+		yOrigin = state.yLogarithmic ?
+			PlotRenderer::DoLogarithmicScale(state.yMinimum) : state.yMinimum;
+		return;
+	}
+
+	xOrigin = 0.0;
+	yOrigin = 0.0;
+
+	const std::vector<double>& x(GetScaledX(state.xLogarithmic));
+	const std::vector<double>& y(GetScaledY(state.yLogarithmic));
+
+	std::vector<double>::size_type i;
+	for (i = 0; i < mData.GetNumberOfPoints(); ++i)
+	{
+		if (PlotMath::IsValid(x[i]) && PlotMath::IsValid(y[i]))
+		{
+			xOrigin = x[i];
+			yOrigin = y[i];
+			break;
+		}
+	}
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GetBuildState
+//
+// Description:		Collects the inputs which affect the geometry of this curve.
+//
+// Input Arguments:
+//		plotWidth	= const int& [pixels]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PlotCurve::BuildState
+//
+//=============================================================================
+PlotCurve::BuildState PlotCurve::GetBuildState(const int& plotWidth) const
+{
+	BuildState state;
+	state.xData = mData.GetX().data();
+	state.yData = mData.GetY().data();
+	state.pointCount = mData.GetNumberOfPoints();
+	state.lineSize = mLineSize;
+	state.pretty = mPretty;
+	state.resident = mResident;
+	state.shaderLines = mShaderLines;
+	state.xLogarithmic = mXAxis->IsLogarithmic();
+	state.yLogarithmic = mYAxis->IsLogarithmic();
+	state.preview = mPreview;
+	state.xSorted = XDataIsSorted();
+	state.xScale = mXScale;
+	state.yScale = mYScale;
+	state.plotWidth = plotWidth;
+	state.xMinimum = mXAxis->GetMinimum();
+	state.xMaximum = mXAxis->GetMaximum();
+	state.yMinimum = mYAxis->GetMinimum();
+
+	return state;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GeometryIsCurrent
+//
+// Description:		Checks to see if the most recently built geometry is still
+//					valid for the specified state.  Panning never invalidates
+//					the geometry, but changes to the scale (i.e. zooming) do
+//					when line widths are expressed in plot units (pretty lines
+//					built on the CPU) and for decimated data.  Markers are
+//					sized on the GPU, so they never depend on the scale.
+//
+// Input Arguments:
+//		state	= const BuildState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the geometry does not need to be rebuilt
+//
+//=============================================================================
+bool PlotCurve::GeometryIsCurrent(const BuildState& state) const
+{
+	if (state.xData != mLastBuild.xData ||
+		state.yData != mLastBuild.yData ||
+		state.pointCount != mLastBuild.pointCount ||
+		!LineSizesMatch(state, mLastBuild) ||
+		state.pretty != mLastBuild.pretty ||
+		state.resident != mLastBuild.resident ||
+		state.shaderLines != mLastBuild.shaderLines ||
+		state.xLogarithmic != mLastBuild.xLogarithmic ||
+		state.yLogarithmic != mLastBuild.yLogarithmic ||
+		state.preview != mLastBuild.preview)
+		return false;
+
+	// Lines expanded on the GPU are sized in pixels by the shader
+	const bool lineDependsOnScale(state.pretty && !state.shaderLines);
+	if (!lineDependsOnScale && !mLastBuild.decimated)
+		return true;
+
+	auto scaleMatches([](const double& current, const double& previous)
+	{
+		return fabs(current - previous) <= mScaleTolerance * fabs(previous);
+	});
+
+	return scaleMatches(state.xScale, mLastBuild.xScale) &&
+		scaleMatches(state.yScale, mLastBuild.yScale);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		BuildStatesMatch
+//
+// Description:		Checks to see if geometry built for one state is exactly
+//					valid for another, including the view (which matters for
+//					geometry that is not resident).
+//
+// Input Arguments:
+//		a	= const BuildState&
+//		b	= const BuildState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the states match
+//
+//=============================================================================
+bool PlotCurve::BuildStatesMatch(const BuildState& a, const BuildState& b)
+{
+	// The decimated flag is a result of the build, so it is not compared
+	return a.xData == b.xData &&
+		a.yData == b.yData &&
+		a.pointCount == b.pointCount &&
+		LineSizesMatch(a, b) &&
+		a.pretty == b.pretty &&
+		a.resident == b.resident &&
+		a.shaderLines == b.shaderLines &&
+		a.xLogarithmic == b.xLogarithmic &&
+		a.yLogarithmic == b.yLogarithmic &&
+		a.preview == b.preview &&
+		a.xScale == b.xScale &&
+		a.yScale == b.yScale &&
+		a.plotWidth == b.plotWidth &&
+		a.xMinimum == b.xMinimum &&
+		a.xMaximum == b.xMaximum &&
+		a.yMinimum == b.yMinimum;
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		LineSizesMatch
+//
+// Description:		Checks to see if geometry built with the line size of one
+//					state is valid for the line size of another.  Only pretty
+//					lines built on the CPU have the width built into the
+//					geometry; other lines are sized when they are drawn.
+//					Markers are sized on the GPU, so the marker size is not
+//					part of the state at all.
+//
+// Input Arguments:
+//		a	= const BuildState&
+//		b	= const BuildState&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the line sizes are compatible
+//
+//=============================================================================
+bool PlotCurve::LineSizesMatch(const BuildState& a, const BuildState& b)
+{
+	if (a.lineSize == b.lineSize)
+		return true;
+
+	// Line geometry is only built for lines with a size
+	return a.lineSize > 0.0 && b.lineSize > 0.0 && !(a.pretty && !a.shaderLines);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		DecimateForPixelColumns
+//
+// Description:		Reduces the specified data to the first, last, minimum and
+//					maximum points within each consecutive run of points that
+//					fall into the same column of pixels.  Points are returned
+//					in their original order, so the line drawn through the
+//					decimated data covers exactly the same pixels as the line
+//					drawn through the full data set.  Invalid points break runs
+//					and are passed through unchanged.
+//
+// Input Arguments:
+//		x			= const std::vector<double>& (already scaled, if logarithmic)
+//		y			= const std::vector<double>& (already scaled, if logarithmic)
+//		xOrigin		= const double& x-value corresponding to the left edge of
+//					  the first pixel column
+//		columnWidth	= const double& width of each column in plot units
+//
+// Output Arguments:
+//		xOut	= std::vector<double>&
+//		yOut	= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::DecimateForPixelColumns(const std::vector<double>& x,
+	const std::vector<double>& y, const double& xOrigin,
+	const double& columnWidth, std::vector<double>& xOut,
+	std::vector<double>& yOut)
+{
+	assert(x.size() == y.size());
+	assert(columnWidth > 0.0);
+
+	typedef std::vector<double>::size_type IndexType;
+
+	xOut.clear();
+	yOut.clear();
+
+	const double pixelsPerUnit(1.0 / columnWidth);
+	auto getColumn([xOrigin, pixelsPerUnit](const double& value)
+	{
+		return floor((value - xOrigin) * pixelsPerUnit);
+	});
+
+	auto appendPoint([&x, &y, &xOut, &yOut](const IndexType& i)
+	{
+		xOut.push_back(x[i]);
+		yOut.push_back(y[i]);
+	});
+
+	IndexType first(0);
+	while (first < x.size())
+	{
+		if (!PlotMath::IsValid(x[first]) || !PlotMath::IsValid(y[first]))
+		{
+			appendPoint(first++);
+			continue;
+		}
+
+		const double column(getColumn(x[first]));
+		IndexType minIndex(first), maxIndex(first), last(first);
+		IndexType i;
+		for (i = first + 1; i < x.size(); ++i)
+		{
+			if (!PlotMath::IsValid(x[i]) || !PlotMath::IsValid(y[i]) ||
+				getColumn(x[i]) != column)
+				break;
+
+			if (y[i] < y[minIndex])
+				minIndex = i;
+			else if (y[i] > y[maxIndex])
+				maxIndex = i;
+			last = i;
+		}
+
+		std::array<IndexType, 4> keep = {{ first, minIndex, maxIndex, last }};
+		std::sort(keep.begin(), keep.end());
+		appendPoint(keep[0]);
+		unsigned int j;
+		for (j = 1; j < keep.size(); ++j)
+		{
+			if (keep[j] != keep[j - 1])
+				appendPoint(keep[j]);
+		}
+
+		first = i;
+	}
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		UpdateScaledData
+//
+// Description:		Ensures the cached logarithms are current for each column
+//					plotted against a logarithmic axis (and releases them for
+//					columns which are not).
+//
+// Input Arguments:
+//		state			= const BuildState&
+//		dataChanged		= const bool&, true if the data was modified in place
+//		dataAppended	= const bool&, true if points were only appended
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::UpdateScaledData(const BuildState& state,
+	const bool& dataChanged, const bool& dataAppended)
+{
+	UpdateScaledColumn(mData.GetX(), state.xLogarithmic, dataChanged,
+		dataAppended, mLogX);
+	UpdateScaledColumn(mData.GetY(), state.yLogarithmic, dataChanged,
+		dataAppended, mLogY);
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		UpdateScaledColumn
+//
+// Description:		Recomputes the logarithms of the specified column if the
+//					data has changed since they were last computed (only for
+//					the new points, if points were appended).  Eigen's array
+//					operations are used, so the computation is vectorized
+//					where the instruction set allows.
+//
+// Input Arguments:
+//		data			= const std::vector<double>&
+//		logarithmic		= const bool&
+//		dataChanged		= const bool&
+//		dataAppended	= const bool&
+//
+// Output Arguments:
+//		column	= ScaledColumn&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void PlotCurve::UpdateScaledColumn(const std::vector<double>& data,
+	const bool& logarithmic, const bool& dataChanged,
+	const bool& dataAppended, ScaledColumn& column)
+{
+	const bool current(column.source == data.data() &&
+		column.size == data.size() && !dataChanged);
+	if ((logarithmic && current) || (!logarithmic && !column.source))
+		return;
+
+	if (!logarithmic)
+	{
+		column = ScaledColumn();
+		return;
+	}
+
+	std::vector<double>::size_type start(0);
+	if (dataAppended && column.source && column.size <= data.size())
+		start = column.size;
+
+	column.values.resize(data.size());
+	const Eigen::Index size(static_cast<Eigen::Index>(data.size() - start));
+	Eigen::Map<Eigen::ArrayXd>(column.values.data() + start, size) =
+		Eigen::Map<const Eigen::ArrayXd>(data.data() + start, size).log10();
+
+	column.source = data.data();
+	column.size = data.size();
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GetScaledX
+//
+// Description:		Returns the x-data, scaled for the axis type.
+//
+// Input Arguments:
+//		logarithmic	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const std::vector<double>&
+//
+//=============================================================================
+const std::vector<double>& PlotCurve::GetScaledX(const bool& logarithmic) const
+{
+	if (logarithmic)
+	{
+		assert(mLogX.source == mData.GetX().data());
+		return mLogX.values;
+	}
+
+	return mData.GetX();
+}
+
+//=============================================================================
+// Class:			PlotCurve
+// Function:		GetScaledY
+//
+// Description:		Returns the y-data, scaled for the axis type.
+//
+// Input Arguments:
+//		logarithmic	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const std::vector<double>&
+//
+//=============================================================================
+const std::vector<double>& PlotCurve::GetScaledY(const bool& logarithmic) const
+{
+	if (logarithmic)
+	{
+		assert(mLogY.source == mData.GetY().data());
+		return mLogY.values;
+	}
 
-	return scaledValues;
+	return mData.GetY();
 }
 
 //=============================================================================
@@ -517,7 +1825,7 @@ PlotCurve::RangeSize PlotCurve::XRangeIsSmall() const
 	if (points == 0)
 		return RangeSize::Small;
 
-	const unsigned int spacing((mRenderWindow.GetSize().GetWidth()
+	const unsigned int spacing((mRenderWindow.GetRenderSize().GetWidth()
 		- mXAxis->GetAxisAtMaxEnd()->GetOffsetFromWindowEdge()
 		- mXAxis->GetAxisAtMinEnd()->GetOffsetFromWindowEdge()) / points);
 
@@ -557,7 +1865,7 @@ PlotCurve::RangeSize PlotCurve::YRangeIsSmall() const
 	if (points == 0)
 		return RangeSize::Small;
 
-	const unsigned int spacing((mRenderWindow.GetSize().GetHeight()
+	const unsigned int spacing((mRenderWindow.GetRenderSize().GetHeight()
 		- mYAxis->GetAxisAtMaxEnd()->GetOffsetFromWindowEdge()
 		- mYAxis->GetAxisAtMinEnd()->GetOffsetFromWindowEdge()) / points);
 
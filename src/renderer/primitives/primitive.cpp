@@ -18,6 +18,10 @@
 #include "lp2d/renderer/primitives/primitive.h"
 #include "lp2d/renderer/renderWindow.h"
 
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+
 namespace LibPlot2D
 {
 
@@ -134,20 +138,182 @@ void Primitive::Draw()
 	if (!HasValidParameters() || !mIsVisible)
 		return;
 
+	RenderStatistics* statistics(mRenderWindow.GetRenderStatistics());
+	if (statistics)
+		statistics->BeginPrimitive(*this);
+
+	if (!mPrepared)
+		Prepare();
+
+	unsigned int rebuildCount(0);
 	unsigned int i;
 	for (i = 0; i < mBufferInfo.size(); ++i)
 	{
-		if (mBufferInfo[i].vertexCountModified || mModified)
-			Update(i);
+		if ((mPrepared || BufferNeedsUpdate(i)) && Update(i))
+			++rebuildCount;
 		assert(!RenderWindow::GLHasError());
 	}
 
-	mModified = false;
+	if (statistics)
+		statistics->EndPrimitiveUpdate();
+
+	mPrepared = false;
 	GenerateGeometry();
+	mChanges = Change::None;
+
+	if (statistics)
+	{
+		unsigned int vertexCount(0);
+		std::size_t bytesUploaded(0);
+		for (auto& b : mBufferInfo)
+		{
+			vertexCount += b.vertexCount;
+			bytesUploaded += b.TakeBytesUploaded();
+		}
+
+		statistics->EndPrimitive(vertexCount, rebuildCount, bytesUploaded);
+	}
 
 	assert(!RenderWindow::GLHasError());
 }
 
+//=============================================================================
+// Class:			Primitive
+// Function:		Prepare
+//
+// Description:		Performs the CPU-only portion of the buffer updates for
+//					types with a preparation stage.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::Prepare()
+{
+	if (!NeedsPreparation())
+		return;
+
+	unsigned int i;
+	for (i = 0; i < mBufferInfo.size(); ++i)
+	{
+		if (BufferNeedsUpdate(i))
+			PrepareUpdate(i);
+	}
+
+	mPrepared = true;
+}
+
+//=============================================================================
+// Class:			Primitive
+// Function:		NeedsPreparation
+//
+// Description:		Checks to see if this object has buffers which need to be
+//					prepared prior to drawing.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool Primitive::NeedsPreparation()
+{
+	if (mPrepared || !HasPreparationStage() || !mIsVisible ||
+		!HasValidParameters())
+		return false;
+
+	unsigned int i;
+	for (i = 0; i < mBufferInfo.size(); ++i)
+	{
+		if (BufferNeedsUpdate(i))
+			return true;
+	}
+
+	return false;
+}
+
+//=============================================================================
+// Class:			Primitive
+// Function:		BufferNeedsUpdate
+//
+// Description:		Checks to see if the specified buffer needs to be updated.
+//
+// Input Arguments:
+//		i	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool Primitive::BufferNeedsUpdate(const unsigned int& i) const
+{
+	return mBufferInfo[i].vertexCountModified ||
+		HasChanged(GetRebuildChanges());
+}
+
+//=============================================================================
+// Class:			Primitive
+// Function:		Invalidate
+//
+// Description:		Marks the specified aspects of this object as changed.
+//
+// Input Arguments:
+//		change	= const Change&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::Invalidate(const Change& change)
+{
+	// While a frame is drawn on another thread, changes must be made through
+	// RenderWindow::ModifyScene() (or after waiting for the render thread)
+	assert(mRenderWindow.IsSceneModifiable());
+	mChanges |= change;
+
+	// Changes to overlays are drawn over the cached image of the scene
+	if (!mIsOverlay)
+		mRenderWindow.InvalidateStaticLayer();
+}
+
+//=============================================================================
+// Class:			Primitive
+// Function:		HasChanged
+//
+// Description:		Checks to see if any of the specified aspects of this
+//					object have changed since it was last drawn.
+//
+// Input Arguments:
+//		change	= const Change&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool Primitive::HasChanged(const Change& change) const
+{
+	return (mChanges & change) != Change::None;
+}
+
 //=============================================================================
 // Class:			Primitive
 // Function:		SetVisibility
@@ -166,8 +332,11 @@ void Primitive::Draw()
 //=============================================================================
 void Primitive::SetVisibility(const bool &isVisible)
 {
+	if (isVisible == mIsVisible)
+		return;
+
 	mIsVisible = isVisible;
-	mModified = true;
+	Invalidate(Change::Visibility);
 }
 
 //=============================================================================
@@ -190,7 +359,7 @@ void Primitive::SetColor(const Color &color)
 {
 	mColor = color;
 	mRenderWindow.SetNeedAlphaSort();
-	mModified = true;
+	Invalidate(Change::Style);
 }
 
 //=============================================================================
@@ -215,6 +384,32 @@ void Primitive::SetDrawOrder(const unsigned int& drawOrder)
 	mRenderWindow.SetNeedOrderSort();
 }
 
+//=============================================================================
+// Class:			Primitive
+// Function:		SetOverlay
+//
+// Description:		Sets the flag indicating whether or not this object is
+//					drawn as part of the overlay layer.
+//
+// Input Arguments:
+//		overlay	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::SetOverlay(const bool& overlay)
+{
+	if (overlay == mIsOverlay)
+		return;
+
+	mIsOverlay = overlay;
+	mRenderWindow.InvalidateStaticLayer();
+}
+
 //=============================================================================
 // Class:			Primitive
 // Function:		operator=
@@ -240,11 +435,13 @@ Primitive& Primitive::operator=(const Primitive &primitive)
 	// Perform the assignment
 	mIsVisible	= primitive.mIsVisible;
 	mColor		= primitive.mColor;
-	mModified	= true;
+	mChanges	= Change::All;
 	mDrawOrder	= primitive.mDrawOrder;
+	mIsOverlay	= primitive.mIsOverlay;
 
 	mRenderWindow.SetNeedAlphaSort();
 	mRenderWindow.SetNeedOrderSort();
+	mRenderWindow.InvalidateStaticLayer();
 
 	return *this;
 }
@@ -274,12 +471,14 @@ Primitive& Primitive::operator=(Primitive &&primitive)
 	// Perform the assignment
 	mIsVisible	= std::move(primitive.mIsVisible);
 	mColor		= std::move(primitive.mColor);
-	mModified	= true;
+	mChanges	= Change::All;
 	mDrawOrder	= std::move(primitive.mDrawOrder);
+	mIsOverlay	= std::move(primitive.mIsOverlay);
 	mBufferInfo	= std::move(primitive.mBufferInfo);
 
 	mRenderWindow.SetNeedAlphaSort();
 	mRenderWindow.SetNeedOrderSort();
+	mRenderWindow.InvalidateStaticLayer();
 
 	return *this;
 }
@@ -398,6 +597,7 @@ Primitive::BufferInfo& Primitive::BufferInfo::operator=(BufferInfo&& b)
 	vertexBuffer = std::move(b.vertexBuffer);
 	indexBuffer = std::move(b.indexBuffer);
 	vertexCountModified = std::move(b.vertexCountModified);
+	sharedIndexCount = b.sharedIndexCount;
 
 	vertexBufferIndex = std::move(b.vertexBufferIndex);
 	vertexArrayIndex = std::move(b.vertexArrayIndex);
@@ -405,9 +605,17 @@ Primitive::BufferInfo& Primitive::BufferInfo::operator=(BufferInfo&& b)
 
 	glVertexBufferExists = b.glVertexBufferExists;
 	glIndexBufferExists = b.glIndexBufferExists;
+	isStreaming = b.isStreaming;
+
+	vertexBufferCapacity = b.vertexBufferCapacity;
+	indexBufferCapacity = b.indexBufferCapacity;
+	bytesUploaded = b.bytesUploaded;
 
 	b.glVertexBufferExists = false;
 	b.glIndexBufferExists = false;
+	b.vertexBufferCapacity = 0;
+	b.indexBufferCapacity = 0;
+	b.bytesUploaded = 0;
 
 	return *this;
 }
@@ -469,15 +677,124 @@ void Primitive::BufferInfo::FreeOpenGLObjects()
 		glDeleteVertexArrays(1, &vertexArrayIndex);
 		glDeleteBuffers(1, &vertexBufferIndex);
 		glVertexBufferExists = false;
+		vertexBufferCapacity = 0;
 	}
 
 	if (glIndexBufferExists)
 	{
 		glDeleteBuffers(1, &indexBufferIndex);
 		glIndexBufferExists = false;
+		indexBufferCapacity = 0;
 	}
 
 	//assert(!RenderWindow::GLHasError());
 }
 
+//=============================================================================
+// Class:			Primitive::BufferInfo
+// Function:		BufferVertexData
+//
+// Description:		Sends the vertex buffer to OpenGL, reusing the existing
+//					storage when possible.
+//
+// Input Arguments:
+//		hint	= const unsigned int&
+//		first	= const std::vector<float>::size_type&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::BufferInfo::BufferVertexData(const unsigned int& hint,
+	const std::vector<float>::size_type& first)
+{
+	assert(glVertexBufferExists);
+	assert(first <= vertexBuffer.size());
+
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBufferIndex);
+	SendData(GL_ARRAY_BUFFER, hint, sizeof(GLfloat) * vertexBuffer.size(),
+		sizeof(GLfloat) * first, vertexBuffer.data(), vertexBufferCapacity);
+}
+
+//=============================================================================
+// Class:			Primitive::BufferInfo
+// Function:		BufferIndexData
+//
+// Description:		Sends the index buffer to OpenGL, reusing the existing
+//					storage when possible.
+//
+// Input Arguments:
+//		hint	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::BufferInfo::BufferIndexData(const unsigned int& hint)
+{
+	assert(glIndexBufferExists);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferIndex);
+	SendData(GL_ELEMENT_ARRAY_BUFFER, hint, sizeof(GLuint) * indexBuffer.size(),
+		0, indexBuffer.data(), indexBufferCapacity);
+}
+
+//=============================================================================
+// Class:			Primitive::BufferInfo
+// Function:		SendData
+//
+// Description:		Sends data to the buffer currently bound to the specified
+//					target.  If the data fits within the existing storage, only
+//					the data beyond the specified offset is sent, with
+//					glBufferSubData; otherwise, new storage is allocated and
+//					all of the data is sent.  The amount of data sent is
+//					recorded for the rendering statistics.
+//
+// Input Arguments:
+//		target		= const unsigned int&
+//		hint		= const unsigned int&
+//		size		= const std::size_t& [bytes]
+//		offset		= const std::size_t& [bytes]
+//		data		= const void*
+//
+// Output Arguments:
+//		capacity	= std::size_t& [bytes]
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void Primitive::BufferInfo::SendData(const unsigned int& target,
+	const unsigned int& hint, const std::size_t& size,
+	const std::size_t& offset, const void* data, std::size_t& capacity)
+{
+	if (size > capacity)
+	{
+		capacity = isStreaming ? std::max(size, 2 * capacity) : size;
+		if (capacity == size)
+			glBufferData(target, size, data, hint);
+		else
+		{
+			glBufferData(target, capacity, nullptr, hint);
+			glBufferSubData(target, 0, size, data);
+		}
+
+		bytesUploaded += size;
+	}
+	else if (size > offset)
+	{
+		glBufferSubData(target, offset, size - offset,
+			static_cast<const char*>(data) + offset);
+		bytesUploaded += size - offset;
+	}
+
+	assert(!RenderWindow::GLHasError());
+}
+
 }// namespace LibPlot2D
@@ -58,14 +58,14 @@ TextRendering::TextRendering(RenderWindow &renderWindow)
 //		None
 //
 // Return Value:
-//		None
+//		bool, true (the buffer is always rebuilt)
 //
 //=============================================================================
-void TextRendering::Update(const unsigned int& /*i*/)
+bool TextRendering::Update(const unsigned int& /*i*/)
 {
 	mFont.SetColor(mColor);
 	mFont.SetOrientation(mAngle);
-	mFont.SetText(mText.ToStdString());
+	mFont.SetText(mText.ToUTF8().data());
 
 	if (mCentered)
 	{
@@ -79,6 +79,7 @@ void TextRendering::Update(const unsigned int& /*i*/)
 		mFont.SetPosition(mX, mY);
 
 	mBufferInfo[0] = mFont.BuildText();
+	return true;
 }
 
 //=============================================================================
@@ -158,7 +159,7 @@ double TextRendering::GetTextHeight()
 	if (!mFont.IsOK())
 		return 0.0;
 
-	Text::BoundingBox boundingBox(mFont.GetBoundingBox(mText.ToStdString()));
+	Text::BoundingBox boundingBox(mFont.GetBoundingBox(mText.ToUTF8().data()));
 
 	return boundingBox.yUp - boundingBox.yDown;
 }
@@ -185,7 +186,7 @@ double TextRendering::GetTextWidth()
 	if (!mFont.IsOK())
 		return 0.0;
 
-	Text::BoundingBox boundingBox(mFont.GetBoundingBox(mText.ToStdString()));
+	Text::BoundingBox boundingBox(mFont.GetBoundingBox(mText.ToUTF8().data()));
 
 	return boundingBox.xRight - boundingBox.xLeft;
 }
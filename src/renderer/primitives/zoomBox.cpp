@@ -43,6 +43,8 @@ ZoomBox::ZoomBox(RenderWindow &renderWindow) : Primitive(renderWindow),
 	// Initially, we don't want to draw this
 	mIsVisible = false;
 	mColor = Color::ColorBlack;
+
+	SetOverlay(true);// Resized without changing the rest of the plot
 }
 
 //=============================================================================
@@ -58,10 +60,10 @@ ZoomBox::ZoomBox(RenderWindow &renderWindow) : Primitive(renderWindow),
 //		None
 //
 // Return Value:
-//		None
+//		bool, true (the buffer is always rebuilt)
 //
 //=============================================================================
-void ZoomBox::Update(const unsigned int& /*i*/)
+bool ZoomBox::Update(const unsigned int& /*i*/)
 {
 	std::vector<std::pair<double, double>> points;
 	points.push_back(std::make_pair(mXAnchor, mYAnchor));
@@ -70,6 +72,7 @@ void ZoomBox::Update(const unsigned int& /*i*/)
 	points.push_back(std::make_pair(mXAnchor, mYFloat));
 	points.push_back(std::make_pair(mXAnchor, mYAnchor));
 	box.Build(points, mBufferInfo[0]);
+	return true;
 }
 
 //=============================================================================
@@ -91,7 +94,7 @@ void ZoomBox::Update(const unsigned int& /*i*/)
 void ZoomBox::GenerateGeometry()
 {
 	glBindVertexArray(mBufferInfo[0].GetVertexArrayIndex());
-	Line::DoPrettyDraw(mBufferInfo[0].indexBuffer.size());
+	Line::DoPrettyDraw(mBufferInfo[0].GetIndexCount());
 	glBindVertexArray(0);
 }
 
@@ -143,7 +146,7 @@ void ZoomBox::SetAnchorCorner(const unsigned int &xAnchor, const unsigned int &y
 	mXAnchor = xAnchor;
 	mYAnchor = yAnchor;
 
-	mModified = true;
+	Invalidate(Change::Transform);
 }
 
 //=============================================================================
@@ -168,7 +171,7 @@ void ZoomBox::SetFloatingCorner(const unsigned int &xFloat, const unsigned int &
 	mXFloat = xFloat;
 	mYFloat = yFloat;
 
-	mModified = true;
+	Invalidate(Change::Transform);
 }
 
 }// namespace LibPlot2D
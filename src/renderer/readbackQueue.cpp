@@ -0,0 +1,294 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  readbackQueue.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Queue of requests for images of a rendered scene, with pixels read
+//        back asynchronously through pixel buffer objects.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/readbackQueue.h"
+
+// Standard C++ headers
+#include <cassert>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for ReadbackQueue class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const GLuint64 ReadbackQueue::mWaitTimeout(1000000000);// 1 sec
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Request
+//
+// Description:		Adds a request for an image of the next rendered frame.
+//
+// Input Arguments:
+//		callback	= const RenderWindow::ImageCallback&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ReadbackQueue::Request(const RenderWindow::ImageCallback& callback)
+{
+	mRequests.push_back(callback);
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		IsBusy
+//
+// Description:		Checks to see if any transfers are in progress.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if a transfer has not yet been completed
+//
+//=============================================================================
+bool ReadbackQueue::IsBusy() const
+{
+	for (const auto& t : mTransfers)
+	{
+		if (t.fence)
+			return true;
+	}
+
+	return false;
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Begin
+//
+// Description:		Starts copying the current read framebuffer into the next
+//					pixel buffer object.  If that buffer is still in use by an
+//					earlier transfer, we wait for the earlier transfer to
+//					complete first (its image is appended to the completed
+//					list).  The wait is repeated until the fence is signaled,
+//					so the buffer, fence and callbacks of a busy transfer are
+//					never overwritten.
+//
+// Input Arguments:
+//		width	= const int&
+//		height	= const int&
+//
+// Output Arguments:
+//		completed	= std::vector<CompletedImage>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ReadbackQueue::Begin(const int& width, const int& height,
+	std::vector<CompletedImage>& completed)
+{
+	if (mRequests.empty() || width <= 0 || height <= 0)
+		return;
+
+	// If both buffers are busy, we need to wait here
+	Transfer& transfer(mTransfers[mNextTransfer]);
+	while (transfer.fence)
+		Complete(transfer, true, completed);
+
+	const unsigned int size(width * height * 3);
+	if (transfer.buffer == 0)
+		glGenBuffers(1, &transfer.buffer);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer);
+	if (size > transfer.capacity)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+		transfer.capacity = size;
+	}
+
+	// With a pack buffer bound, the last argument is an offset into the buffer
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	transfer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	transfer.width = width;
+	transfer.height = height;
+	transfer.callbacks = std::move(mRequests);
+	mRequests.clear();
+
+	mNextTransfer = (mNextTransfer + 1) % mTransfers.size();
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Complete
+//
+// Description:		Retrieves the images from any transfers which have
+//					completed, oldest first.
+//
+// Input Arguments:
+//		wait		= const bool&, true to block until all transfers complete
+//
+// Output Arguments:
+//		completed	= std::vector<CompletedImage>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ReadbackQueue::Complete(std::vector<CompletedImage>& completed,
+	const bool& wait)
+{
+	unsigned int i;
+	for (i = 0; i < mTransfers.size(); ++i)
+	{
+		Transfer& transfer(mTransfers[(mNextTransfer + i) % mTransfers.size()]);
+		if (transfer.fence)
+			Complete(transfer, wait, completed);
+	}
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Complete
+//
+// Description:		Copies the pixels out of the specified transfer's buffer,
+//					if the transfer has completed.
+//
+// Input Arguments:
+//		transfer	= Transfer&
+//		wait		= const bool&, true to block until the transfer completes
+//
+// Output Arguments:
+//		completed	= std::vector<CompletedImage>&
+//
+// Return Value:
+//		bool, true if the transfer was completed
+//
+//=============================================================================
+bool ReadbackQueue::Complete(Transfer& transfer, const bool& wait,
+	std::vector<CompletedImage>& completed)
+{
+	assert(transfer.fence);
+
+	const GLenum status(glClientWaitSync(transfer.fence,
+		wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? mWaitTimeout : 0));
+	if (status == GL_TIMEOUT_EXPIRED)
+		return false;
+
+	glDeleteSync(transfer.fence);
+	transfer.fence = nullptr;
+
+	wxImage image;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, transfer.buffer);
+	const unsigned char* pixels(static_cast<const unsigned char*>(
+		glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+		transfer.width * transfer.height * 3, GL_MAP_READ_BIT)));
+	if (status != GL_WAIT_FAILED && pixels)
+	{
+		image.Create(transfer.width, transfer.height, false);
+		RenderWindow::CopyFlipped(pixels,
+			wxRect(0, 0, transfer.width, transfer.height), image);
+	}
+
+	if (pixels)
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	assert(!RenderWindow::GLHasError());
+
+	// Failed transfers are still reported (with an invalid image) so that
+	// callers are not left waiting
+	completed.push_back(std::make_pair(image, std::move(transfer.callbacks)));
+	transfer.callbacks.clear();
+
+	return true;
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		Deliver
+//
+// Description:		Passes completed images to the functions which requested
+//					them.
+//
+// Input Arguments:
+//		completed	= const std::vector<CompletedImage>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ReadbackQueue::Deliver(const std::vector<CompletedImage>& completed)
+{
+	for (const auto& c : completed)
+	{
+		for (const auto& callback : c.second)
+			callback(c.first);
+	}
+}
+
+//=============================================================================
+// Class:			ReadbackQueue
+// Function:		FreeOpenGLObjects
+//
+// Description:		Deletes the pixel buffer objects and fences.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ReadbackQueue::FreeOpenGLObjects()
+{
+	for (auto& t : mTransfers)
+	{
+		if (t.fence)
+			glDeleteSync(t.fence);
+		if (t.buffer != 0)
+			glDeleteBuffers(1, &t.buffer);
+		t = Transfer();
+	}
+}
+
+}// namespace LibPlot2D
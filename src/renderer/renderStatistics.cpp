@@ -0,0 +1,391 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  renderStatistics.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Collection of per-frame and per-primitive rendering statistics,
+//        including CPU timers and OpenGL timer queries.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/renderStatistics.h"
+#include "lp2d/renderer/renderWindow.h"
+
+// Standard C++ headers
+#include <cassert>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for RenderStatistics class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const unsigned int RenderStatistics::mMaxPendingFrames(4);
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		BeginFrame
+//
+// Description:		Publishes the statistics for earlier frames whose query
+//					results are available and begins collecting statistics for
+//					a new frame.  Results are read without blocking unless the
+//					GPU has fallen several frames behind.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::BeginFrame()
+{
+	assert(!mFrameActive);
+
+	while (!mPendingFrames.empty())
+	{
+		const bool wait(mPendingFrames.size() >= mMaxPendingFrames);
+		if (!ResolvePendingFrame(mPendingFrames.front(), wait))
+			break;
+
+		mPublished = std::move(mPendingFrames.front().statistics);
+		mPendingFrames.pop_front();
+	}
+
+	mPendingFrames.emplace_back();
+	FrameStatistics& statistics(mPendingFrames.back().statistics);
+	statistics.frameNumber = ++mFrameCount;
+	statistics.sceneUpdateTime = mSceneUpdateTime;
+	mSceneUpdateTime = 0.0;
+
+	mFrameActive = true;
+	mFrameStart = Clock::now();
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		EndFrame
+//
+// Description:		Finishes collecting CPU statistics for the current frame.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::EndFrame()
+{
+	if (!mFrameActive)
+		return;
+
+	const Clock::time_point now(Clock::now());
+	FrameStatistics& statistics(mPendingFrames.back().statistics);
+	statistics.cpuTime = std::chrono::duration<double>(now - mFrameStart).count();
+
+	mRecentFrames.push_back(now);
+	while (now - mRecentFrames.front() > std::chrono::seconds(1))
+		mRecentFrames.pop_front();
+
+	if (mRecentFrames.size() > 1)
+		statistics.framesPerSecond = (mRecentFrames.size() - 1)
+			/ std::chrono::duration<double>(now - mRecentFrames.front()).count();
+
+	mFrameActive = false;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		RecordPreparation
+//
+// Description:		Records the time spent preparing buffers for the current
+//					frame.
+//
+// Input Arguments:
+//		time	= const double& [sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::RecordPreparation(const double& time)
+{
+	if (mFrameActive)
+		mPendingFrames.back().statistics.preparationTime += time;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		RecordInputLatency
+//
+// Description:		Records the input-to-display latency of the most recent
+//					frame.
+//
+// Input Arguments:
+//		latency	= const double& [sec]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::RecordInputLatency(const double& latency)
+{
+	if (mPendingFrames.empty())
+		mPublished.inputLatency = latency;
+	else
+		mPendingFrames.back().statistics.inputLatency = latency;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		BeginPrimitive
+//
+// Description:		Starts the CPU timer and a GPU timer query for drawing the
+//					specified primitive.
+//
+// Input Arguments:
+//		primitive	= const Primitive&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::BeginPrimitive(const Primitive& primitive)
+{
+	if (!mFrameActive)
+		return;
+
+	assert(!mPrimitiveActive);
+	mPrimitiveActive = true;
+
+	PendingFrame& frame(mPendingFrames.back());
+	frame.statistics.primitives.push_back(PrimitiveStatistics());
+	frame.statistics.primitives.back().primitive = &primitive;
+
+	// Only one GL_TIME_ELAPSED query may be active at a time, so primitives
+	// must not be drawn from within other primitives
+	frame.queries.push_back(AcquireQuery());
+	glBeginQuery(GL_TIME_ELAPSED, frame.queries.back());
+
+	mPrimitiveStart = Clock::now();
+	mUpdateEnd = mPrimitiveStart;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		EndPrimitiveUpdate
+//
+// Description:		Marks the end of the buffer updates for the current
+//					primitive.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::EndPrimitiveUpdate()
+{
+	if (mPrimitiveActive)
+		mUpdateEnd = Clock::now();
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		EndPrimitive
+//
+// Description:		Stops the timers for the current primitive and records
+//					the primitive's statistics.
+//
+// Input Arguments:
+//		vertexCount		= const unsigned int&
+//		rebuildCount	= const unsigned int&
+//		bytesUploaded	= const std::size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::EndPrimitive(const unsigned int& vertexCount,
+	const unsigned int& rebuildCount, const std::size_t& bytesUploaded)
+{
+	if (!mPrimitiveActive)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	const Clock::time_point now(Clock::now());
+
+	FrameStatistics& frame(mPendingFrames.back().statistics);
+	PrimitiveStatistics& statistics(frame.primitives.back());
+	statistics.cpuTime = std::chrono::duration<double>(now - mPrimitiveStart).count();
+	statistics.updateTime = std::chrono::duration<double>(mUpdateEnd - mPrimitiveStart).count();
+	statistics.vertexCount = vertexCount;
+	statistics.rebuildCount = rebuildCount;
+	statistics.bytesUploaded = bytesUploaded;
+
+	frame.vertexCount += vertexCount;
+	frame.rebuildCount += rebuildCount;
+	frame.bytesUploaded += bytesUploaded;
+
+	mPrimitiveActive = false;
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		FreeOpenGLObjects
+//
+// Description:		Deletes the timer queries and discards statistics for
+//					frames which have not yet been published.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderStatistics::FreeOpenGLObjects()
+{
+	if (mPrimitiveActive)
+		glEndQuery(GL_TIME_ELAPSED);
+
+	if (!mAllQueries.empty())
+		glDeleteQueries(static_cast<GLsizei>(mAllQueries.size()), mAllQueries.data());
+
+	mAllQueries.clear();
+	mFreeQueries.clear();
+	mPendingFrames.clear();
+	mFrameActive = false;
+	mPrimitiveActive = false;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		AcquireQuery
+//
+// Description:		Returns an unused query object, creating one if necessary.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int
+//
+//=============================================================================
+unsigned int RenderStatistics::AcquireQuery()
+{
+	if (!mFreeQueries.empty())
+	{
+		const unsigned int query(mFreeQueries.back());
+		mFreeQueries.pop_back();
+		return query;
+	}
+
+	GLuint query;
+	glGenQueries(1, &query);
+	mAllQueries.push_back(query);
+	return query;
+}
+
+//=============================================================================
+// Class:			RenderStatistics
+// Function:		ResolvePendingFrame
+//
+// Description:		Reads the query results for the specified frame, if they
+//					are available, and returns the queries to the pool.
+//					Queries complete in the order in which they are issued, so
+//					only the last one needs to be checked.
+//
+// Input Arguments:
+//		frame	= PendingFrame&
+//		wait	= const bool&, true to block until the results are available
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the frame's statistics are complete
+//
+//=============================================================================
+bool RenderStatistics::ResolvePendingFrame(PendingFrame& frame,
+	const bool& wait)
+{
+	if (!frame.queries.empty() && !wait)
+	{
+		GLint available;
+		glGetQueryObjectiv(frame.queries.back(), GL_QUERY_RESULT_AVAILABLE,
+			&available);
+		if (available == GL_FALSE)
+			return false;
+	}
+
+	frame.statistics.gpuTime = 0.0;
+
+	unsigned int i;
+	for (i = 0; i < frame.queries.size(); ++i)
+	{
+		GLuint64 elapsed;// [nsec]
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed);
+		frame.statistics.primitives[i].gpuTime = elapsed * 1.0e-9;
+		frame.statistics.gpuTime += frame.statistics.primitives[i].gpuTime;
+		mFreeQueries.push_back(frame.queries[i]);
+	}
+
+	frame.queries.clear();
+
+	assert(!RenderWindow::GLHasError());
+	return true;
+}
+
+}// namespace LibPlot2D
@@ -0,0 +1,265 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  renderThread.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Thread which owns a render window's OpenGL context and draws its
+//        frames, so drawing does not block the event loop.
+
+// GLEW headers
+#include <GL/glew.h>// Must be included before gl.h (so, before renderWindow.h)
+
+// Local headers
+#include "lp2d/renderer/renderThread.h"
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for RenderThread class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+// The main thread posts at most one frame at a time, and waits for other work
+// to complete, so the queue never holds more than one frame and one task
+const std::size_t RenderThread::mQueueCapacity(2);
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		RenderThread
+//
+// Description:		Constructor for the RenderThread class.
+//
+// Input Arguments:
+//		window	= RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+RenderThread::RenderThread(RenderWindow& window) : mWindow(window),
+	mQueue(mQueueCapacity), mPendingCount(0),
+	mThread(&RenderThread::ThreadEntry, this)
+{
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		~RenderThread
+//
+// Description:		Destructor for the RenderThread class.  Waits for posted
+//					work to complete before stopping the thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+RenderThread::~RenderThread()
+{
+	WaitForIdle();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+
+	mWakeCondition.notify_one();
+	mThread.join();
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		PostFrame
+//
+// Description:		Posts a request to draw a frame.
+//
+// Input Arguments:
+//		frame	= std::shared_ptr<const FrameSnapshot>
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderThread::PostFrame(std::shared_ptr<const FrameSnapshot> frame)
+{
+	Request request;
+	request.frame = std::move(frame);
+	Post(std::move(request));
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		Execute
+//
+// Description:		Executes the specified function on this thread, and waits
+//					for it to complete.
+//
+// Input Arguments:
+//		task	= const std::function<void()>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderThread::Execute(const std::function<void()>& task)
+{
+	if (IsCurrentThread())
+	{
+		task();
+		return;
+	}
+
+	Request request;
+	request.task = task;
+	Post(std::move(request));
+	WaitForIdle();
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		WaitForIdle
+//
+// Description:		Blocks until all posted work has been completed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderThread::WaitForIdle()
+{
+	if (IsCurrentThread())
+		return;
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mIdleCondition.wait(lock, [this]() { return mPendingCount.load() == 0; });
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		Post
+//
+// Description:		Adds the request to the queue and wakes the thread.
+//
+// Input Arguments:
+//		request	= Request&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderThread::Post(Request&& request)
+{
+	++mPendingCount;
+	while (!mQueue.Push(std::move(request)))
+	{
+		// The queue is full, so wait for the thread to complete something
+		std::unique_lock<std::mutex> lock(mMutex);
+		const unsigned int pending(mPendingCount.load());
+		mIdleCondition.wait(lock, [this, pending]()
+		{
+			return mPendingCount.load() < pending;
+		});
+	}
+
+	// Taking the lock (even briefly) ensures the thread is either waiting or
+	// has not yet checked the queue, so the notification can't be missed
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+	}
+
+	mWakeCondition.notify_one();
+}
+
+//=============================================================================
+// Class:			RenderThread
+// Function:		ThreadEntry
+//
+// Description:		Entry point for the thread.  Executes requests as they
+//					are posted.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderThread::ThreadEntry()
+{
+	Request request;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWakeCondition.wait(lock, [this]()
+			{
+				return mStopping || !mQueue.IsEmpty();
+			});
+
+			if (mQueue.IsEmpty())
+				return;
+		}
+
+		while (mQueue.Pop(request))
+		{
+			if (request.frame)
+				mWindow.DrawFrame(*request.frame);
+			if (request.task)
+				request.task();
+			request = Request();
+
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				--mPendingCount;
+			}
+
+			mIdleCondition.notify_all();
+		}
+	}
+}
+
+}// namespace LibPlot2D
@@ -20,7 +20,13 @@
 
 // Local headers
 #include "lp2d/renderer/renderWindow.h"
+#include "lp2d/renderer/readbackQueue.h"
+#include "lp2d/renderer/layerCache.h"
+#include "lp2d/renderer/contextGroup.h"
+#include "lp2d/renderer/renderThread.h"
+#include "lp2d/renderer/headlessContext.h"
 #include "lp2d/utilities/math/plotMath.h"
+#include "lp2d/utilities/threadPool.h"
 
 // Eigen headers
 #include <Eigen/Geometry>
@@ -34,6 +40,9 @@
 #include <algorithm>
 #include <iostream>
 #include <typeinfo>
+#include <thread>
+#include <cstring>
+#include <chrono>
 
 wxDEFINE_EVENT(RENDERED_EVENT, wxCommandEvent);
 
@@ -62,7 +71,8 @@ const std::string RenderWindow::mPositionName("position");
 const std::string RenderWindow::mColorName("color");
 
 const double RenderWindow::mExactPixelShift(0.375);
-std::mutex RenderWindow::renderMutex;
+const int RenderWindow::mMaxTileSize(4096);// [pixels]
+const int RenderWindow::mReadbackPollInterval(2);// [msec]
 
 //=============================================================================
 // Class:			RenderWindow
@@ -152,7 +162,7 @@ const std::string RenderWindow::mDefaultFragmentShader(
 RenderWindow::RenderWindow(wxWindow &parent, wxWindowID id,
 	const wxGLAttributes& attr, const wxPoint& position, const wxSize& size,
 	long style) : wxGLCanvas(&parent, attr, id, position, size,
-		style | wxFULL_REPAINT_ON_RESIZE)
+		style | wxFULL_REPAINT_ON_RESIZE), mReadbackTimer(this, idReadbackTimer)
 {
 	AutoSetFrustum();
 
@@ -182,6 +192,11 @@ RenderWindow::RenderWindow(wxWindow &parent, wxWindowID id,
 RenderWindow::~RenderWindow()
 {
 	FreeOpenGLObjects();
+
+	if (mContextGroup && mContext)
+		mContextGroup->RemoveContext(*this, mContext.get());
+
+	mRenderThread.reset();
 }
 
 //=============================================================================
@@ -202,14 +217,92 @@ RenderWindow::~RenderWindow()
 //=============================================================================
 void RenderWindow::FreeOpenGLObjects()
 {
-	for (auto& s : mShaders)
-		glDeleteProgram(s.programId);
-	mShaders.clear();
-
 	// Need to ensure the proper context is active when OpenGL objects are freed
-	std::lock_guard<std::mutex> lock(renderMutex);
-	MakeCurrent();
-	mPrimitiveList.Clear();
+	ExecuteWithContext([this]()
+	{
+		// Programs built within a context group are used by the other windows
+		if (!mContextGroup)
+		{
+			for (auto& s : mShaders)
+				glDeleteProgram(s.programId);
+		}
+		mShaders.clear();
+
+		mPrimitiveList.Clear();
+
+		for (auto& b : mSharedIndexBuffers)
+			glDeleteBuffers(1, &b.second.bufferIndex);
+		mSharedIndexBuffers.clear();
+
+		if (mReadbackQueue)
+			mReadbackQueue->FreeOpenGLObjects();
+
+		if (mRenderStatistics)
+			mRenderStatistics->FreeOpenGLObjects();
+
+		if (mLayerCache)
+			mLayerCache->FreeOpenGLObjects();
+		mStaticLayerValid = false;
+	});
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetSharedIndexBuffer
+//
+// Description:		Returns the shared index buffer with the specified name,
+//					creating or growing it as necessary.  Growth is geometric,
+//					so a window with many curves of increasing size only
+//					regenerates the indices a few times.  Within a context
+//					group, the buffers are shared by all of the windows.
+//
+// Input Arguments:
+//		name		= const std::string&
+//		indexCount	= const unsigned int&
+//		generator	= const std::function<void(std::vector<unsigned int>&)>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint RenderWindow::GetSharedIndexBuffer(const std::string& name,
+	const unsigned int& indexCount,
+	const std::function<void(std::vector<unsigned int>&)>& generator)
+{
+	std::unique_lock<std::mutex> groupLock;
+	if (mContextGroup)
+		groupLock = std::unique_lock<std::mutex>(mContextGroup->mMutex);
+
+	auto& buffers(mContextGroup ? mContextGroup->mIndexBuffers
+		: mSharedIndexBuffers);
+	auto it(buffers.find(name));
+	if (it == buffers.end())
+	{
+		SharedIndexBuffer buffer;
+		glGenBuffers(1, &buffer.bufferIndex);
+		it = buffers.insert(std::make_pair(name, buffer)).first;
+	}
+
+	SharedIndexBuffer& buffer(it->second);
+	if (indexCount <= buffer.indexCount)
+		return buffer.bufferIndex;
+
+	std::vector<unsigned int> indices(std::max(indexCount, 2 * buffer.indexCount));
+	generator(indices);
+	buffer.indexCount = indices.size();
+
+	// Use the copy target so the bound vertex array (which captures the
+	// element array binding) is not affected
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.bufferIndex);
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeof(GLuint) * indices.size(),
+		indices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	assert(!GLHasError());
+	return buffer.bufferIndex;
 }
 
 //=============================================================================
@@ -233,6 +326,7 @@ BEGIN_EVENT_TABLE(RenderWindow, wxGLCanvas)
 	EVT_SIZE(				RenderWindow::OnSize)
 	EVT_PAINT(				RenderWindow::OnPaint)
 	EVT_ENTER_WINDOW(		RenderWindow::OnEnterWindow)
+	EVT_TIMER(idReadbackTimer,	RenderWindow::OnReadbackTimer)
 
 	// Interaction events
 	EVT_MOUSEWHEEL(			RenderWindow::OnMouseWheelEvent)
@@ -249,6 +343,8 @@ END_EVENT_TABLE()
 // Function:		GetContext
 //
 // Description:		Gets (or creates, if it doesn't yet exist) the GL context.
+//					Within a context group, the new context shares objects
+//					with the other contexts in the group.
 //
 // Input Arguments:
 //		None
@@ -262,11 +358,15 @@ END_EVENT_TABLE()
 //=============================================================================
 wxGLContext* RenderWindow::GetContext()
 {
+	assert(!mHeadless);
 	if (!mContext)
 	{
 		wxGLContextAttrs attributes;
 		attributes.PlatformDefaults().OGLVersion(4, 0).EndList();
-		mContext = std::make_unique<wxGLContext>(this, nullptr, &attributes);
+		if (mContextGroup)
+			mContext.reset(mContextGroup->CreateContext(*this, attributes));
+		else
+			mContext = std::make_unique<wxGLContext>(this, nullptr, &attributes);
 		assert(mContext->IsOK() && "Minimum OpenGL verison not met (requires 4.0)");
 	}
 
@@ -275,9 +375,10 @@ wxGLContext* RenderWindow::GetContext()
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		SetViewportCount
+// Function:		GetHeadlessContext
 //
-// Description:		Sets the number of viewports.
+// Description:		Gets (or creates, if it doesn't yet exist) the context
+//					used for headless rendering.
 //
 // Input Arguments:
 //		None
@@ -286,21 +387,26 @@ wxGLContext* RenderWindow::GetContext()
 //		None
 //
 // Return Value:
-//		None
+//		HeadlessContext*, nullptr if the context could not be created
 //
 //=============================================================================
-void RenderWindow::SetViewportCount(const unsigned int& count)
+HeadlessContext* RenderWindow::GetHeadlessContext()
 {
-	assert(count > 0);
-	viewportCount = count;
+	assert(mHeadless);
+	if (!mHeadlessContext)
+		mHeadlessContext = std::make_unique<HeadlessContext>();
+
+	if (!mHeadlessContext->IsOK())
+		return nullptr;
+	return mHeadlessContext.get();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		Render
+// Function:		MakeContextCurrent
 //
-// Description:		Updates the scene with all of this object's options and
-//					re-draws the image.
+// Description:		Makes the context current on the calling thread (the
+//					headless context, if rendering is headless).
 //
 // Input Arguments:
 //		None
@@ -309,137 +415,25 @@ void RenderWindow::SetViewportCount(const unsigned int& count)
 //		None
 //
 // Return Value:
-//		None
+//		bool, true for success, false otherwise
 //
 //=============================================================================
-void RenderWindow::Render()
+bool RenderWindow::MakeContextCurrent() const
 {
-	if (!GetContext() || !IsShownOnScreen())
-		return;
-
-	const unsigned int shaderCount(mShaders.size());
-
-	{
-		std::lock_guard<std::mutex> lock(renderMutex);
-
-		SetCurrent(*mContext);
-		wxPaintDC(this);
-
-		assert(!GLHasError());
-
-		if (!mGlewInitialized)
-		{
-			glewExperimental = GL_TRUE;
-			if (glewInit() != GLEW_OK)
-				return;
-
-			// According to https://www.khronos.org/opengl/wiki/OpenGL_Loading_Library, glewInit() may cause
-			// OpenGL error GL_INVALID_ENUM (which we observe) even if everything is actually OK.
-			// So check for errors to clear the error flag.
-#ifdef _DEBUG
-			int e =
-#endif// _DEBUG
-				glGetError();
-
-#ifdef _DEBUG
-			assert(e == GL_NO_ERROR || e == GL_INVALID_ENUM);
-			GetGLInfo();
-#endif// _DEBUG
-			BuildShaders();
-			mGlewInitialized = true;
-		}
-
-		for (unsigned int viewport = 0; viewport < viewportCount; ++viewport)
-		{
-			if (mSizeUpdateRequired || viewport != lastViewportConfigured)
-				DoResize(viewport);
-
-			if (mModified || viewport != lastViewportConfigured)
-				Initialize(viewport);
-			else if (mModelviewModified)
-				UpdateModelviewMatrix();
-
-			if (viewport == 0)
-			{
-				glClearColor(static_cast<float>(mBackgroundColor.GetRed()),
-					static_cast<float>(mBackgroundColor.GetGreen()),
-					static_cast<float>(mBackgroundColor.GetBlue()),
-					static_cast<float>(mBackgroundColor.GetAlpha()));
-
-				if (mView3D)
-					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-				else
-					glClear(GL_COLOR_BUFFER_BIT);
-			}
-
-			// Sort the primitives by Color.GetAlpha to ensure that transparent objects are rendered last
-			Primitive* firstTransparentPrimitive(nullptr);
-			if (mNeedAlphaSort)
-			{
-				std::sort(mPrimitiveList.begin(), mPrimitiveList.end(), AlphaSortPredicate);
-				mNeedAlphaSort = false;
-
-				if (mView3D)
-				{
-					for (const auto& p : mPrimitiveList)
-					{
-						if (p->GetColor().GetAlpha() < 1.0)
-						{
-							firstTransparentPrimitive = p.get();
-							break;
-						}
-					}
-				}
-			}
-
-			// Generally, all objects will have the same draw order and this won't do anything,
-			// but for some cases we do want to override the draw order just before rendering
-			if (mNeedOrderSort)
-			{
-				std::stable_sort(mPrimitiveList.begin(), mPrimitiveList.end(), OrderSortPredicate);
-				mNeedOrderSort = false;
-			}
-
-			// NOTE:  Any primitive that uses it's own program should re-load the default program
-			// by calling RenderWindow::UseDefaultProgram() at the end of GenerateGeometry()
-			for (auto& p : mPrimitiveList)
-			{
-				if (firstTransparentPrimitive && p.get() == firstTransparentPrimitive)
-					glDepthMask(GL_FALSE);
-				p->Draw();
-			}
-
-			if (firstTransparentPrimitive)
-				glDepthMask(GL_TRUE);
-
-			lastViewportConfigured = viewport;
-		}
-
-		SwapBuffers();// TODO:  Memory leak here?
-	}
-
-	// If shaders are added mid-render, we need to re-render to ensure everything gets displayed
-	if (mShaders.size() != shaderCount)
-		Render();
-
-	if (mRenderedEvent)
-	{
-		wxCommandEvent event(RENDERED_EVENT, GetId());
-		event.SetEventObject(this);
-		ProcessWindowEvent(event);
-	}
-
-	assert(!GLHasError());
+	if (mHeadlessContext)
+		return mHeadlessContext->MakeCurrent();
+	return SetCurrent(*mContext);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		GetGLInfo
+// Function:		SetHeadless
 //
-// Description:		Gets useful GL version info and puts it in a string (for debugging).
+// Description:		Enables or disables rendering with a context which does
+//					not belong to this window.
 //
 // Input Arguments:
-//		None
+//		headless	= const bool&
 //
 // Output Arguments:
 //		None
@@ -448,25 +442,23 @@ void RenderWindow::Render()
 //		None
 //
 //=============================================================================
-void RenderWindow::GetGLInfo()
+void RenderWindow::SetHeadless(const bool& headless)
 {
-	std::string info;
-	info.append("Vendor:          " + std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + '\n');
-	info.append("Renderer:        " + std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) + '\n');
-	info.append("OpenGL version:  " + std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION))) + '\n');
-	info.append("GLSL version:    " + std::string(reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION))) + '\n');
-	std::cerr << info;
+	assert(!HasContext() && "Headless rendering must be set before rendering");
+	assert((!headless || (!mContextGroup && !mRenderThread)) &&
+		"Headless windows can't be in a context group or render on a thread");
+	mHeadless = headless;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnPaint
+// Function:		SetContextGroup
 //
-// Description:		Event handler for the paint event.  Obtains the device
-//					context and re-renders the scene.
+// Description:		Sets the group of windows with which this window shares
+//					OpenGL objects.
 //
 // Input Arguments:
-//		event	= wxPaintEvent& (UNUSED)
+//		group	= std::shared_ptr<ContextGroup>
 //
 // Output Arguments:
 //		None
@@ -475,41 +467,48 @@ void RenderWindow::GetGLInfo()
 //		None
 //
 //=============================================================================
-void RenderWindow::OnPaint(wxPaintEvent& WXUNUSED(event))
+void RenderWindow::SetContextGroup(std::shared_ptr<ContextGroup> group)
 {
-    Render();
+	assert(!mContext && "Context group must be set before rendering");
+	assert((!group || !mHeadless) &&
+		"Headless windows can't be in a context group");
+	assert((!group || !mRenderThread) &&
+		"Windows in a context group must render on the same thread");
+	mContextGroup = std::move(group);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnSize
+// Function:		GetSharingKey
 //
-// Description:		Event handler for the window re-size event.
+// Description:		Returns a value identifying the set of windows which share
+//					this window's OpenGL objects.
 //
 // Input Arguments:
-//		event	= wxSizeEvent& (unused)
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		const void*
 //
 //=============================================================================
-void RenderWindow::OnSize(wxSizeEvent& WXUNUSED(event))
+const void* RenderWindow::GetSharingKey() const
 {
-    mSizeUpdateRequired = true;
-	Refresh();
+	if (mContextGroup)
+		return mContextGroup.get();
+	return this;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoResize
+// Function:		SetThreadedRendering
 //
-// Description:		Handles actions required to update the screen after resizing.
+// Description:		Enables or disables drawing on a dedicated thread.
 //
 // Input Arguments:
-//		viewportId	= const unsigned int&
+//		threaded	= const bool&
 //
 // Output Arguments:
 //		None
@@ -518,30 +517,32 @@ void RenderWindow::OnSize(wxSizeEvent& WXUNUSED(event))
 //		None
 //
 //=============================================================================
-void RenderWindow::DoResize(const unsigned int& /*viewportId*/)
+void RenderWindow::SetThreadedRendering(const bool& threaded)
 {
-	assert(viewportCount == 1);
-
-	// set GL viewport (not called by wxGLCanvas::OnSize on all platforms...)
-	int w, h;
-	GetClientSize(&w, &h);
-	glViewport(0, 0, w, h);
+	assert(!mContext && "Threaded rendering must be set before rendering");
+	assert((!threaded || !mHeadless) &&
+		"Headless windows can't render on a thread");
+	assert((!threaded || !mContextGroup) &&
+		"Windows in a context group must render on the same thread");
 
-	AutoSetFrustum();// This takes care of any change in aspect ratio
+	if (threaded == GetThreadedRendering())
+		return;
 
-	mSizeUpdateRequired = false;
-	mModelviewModified = true;
-	mModified = true;
+	if (threaded)
+		mRenderThread = std::make_unique<RenderThread>(*this);
+	else
+		mRenderThread.reset();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnEnterWindow
+// Function:		WaitForRenderThread
 //
-// Description:		Event handler for the enter window event.
+// Description:		Blocks until the render thread has finished with the
+//					scene, then applies any queued changes.
 //
 // Input Arguments:
-//		event	= wxEraseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -550,141 +551,133 @@ void RenderWindow::DoResize(const unsigned int& /*viewportId*/)
 //		None
 //
 //=============================================================================
-void RenderWindow::OnEnterWindow(wxMouseEvent &event)
+void RenderWindow::WaitForRenderThread()
 {
-	mObservedLeftButtonDown = false;
-	mObservedRightButtonDown = false;
-	//SetFocus();
-	event.Skip();
+	if (!mRenderThread || mRenderThread->IsCurrentThread())
+		return;
+
+	mRenderThread->WaitForIdle();
+	mSceneInUse = false;
+	ApplySceneChanges();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		RemoveActor
+// Function:		ModifyScene
 //
-// Description:		Removes the specified actor from the display list, if it
-//					is in the list.
+// Description:		Applies the specified change to the scene, or queues it
+//					if a frame is being drawn.
 //
 // Input Arguments:
-//		toRemove	= Primitive* pointing to the object to be removed
+//		change	= std::function<void()>
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		bool, true for success, false otherwise
+//		None
 //
 //=============================================================================
-bool RenderWindow::RemoveActor(Primitive *toRemove)
+void RenderWindow::ModifyScene(std::function<void()> change)
 {
-	if (!toRemove)
-		return false;
-
-	unsigned int i;
-	for (i = 0; i < mPrimitiveList.GetCount(); ++i)
-	{
-		if (toRemove == mPrimitiveList[i].get())
-		{
-			mPrimitiveList.Remove(i);
-			return true;
-		}
-	}
+	assert(!IsRenderThread());
 
-	return false;
+	// Changes made by queued changes are applied immediately, in order
+	if (mFrameInProgress && !mApplyingSceneChanges)
+		mSceneChanges.push_back(std::move(change));
+	else
+		change();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		Initialize
+// Function:		ApplySceneChanges
 //
-// Description:		Sets up the renderer's parameters.  Called on startup
-//					and any time an option changes (wireframe vs. polygon, etc.)
+// Description:		Applies the changes queued by ModifyScene(), in order.
+//					Must only be called while the render thread is idle, and
+//					before the frame is marked complete.
 //
 // Input Arguments:
-//		viewportId	= const unsigned int&
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if any changes were applied
 //
 //=============================================================================
-void RenderWindow::Initialize(const unsigned int& viewportId)
+bool RenderWindow::ApplySceneChanges()
 {
-	Eigen::Matrix4d projectionMatrix;
-	if (mView3D)
-	{
-		Initialize3D();
-		projectionMatrix = Generate3DProjectionMatrix(viewportId);
-	}
-	else
-	{
-		Initialize2D();
-		projectionMatrix = Generate2DProjectionMatrix();
-	}
-
-	if (mWireFrame)
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	else
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-	float glModelViewMatrix[16];
-	ConvertMatrixToGL(mModelviewMatrix, glModelViewMatrix);
-	float glProjectionMatrix[16];
-	ConvertMatrixToGL(projectionMatrix, glProjectionMatrix);
-	assert(!GLHasError());
-	GLuint i;
-	for (i = mShaders.size(); i > 0; --i)
-	{
-		if (mShaders[i - 1].needsModelview || mShaders[i - 1].needsProjection)
-			UseProgram(i - 1);
-		assert(!GLHasError());
+	if (mSceneChanges.empty() || mApplyingSceneChanges)
+		return false;
 
-		if (mShaders[i - 1].needsModelview)
-			DoModelviewUpdate(mShaders[i - 1].uniformLocations[mModelviewName], glModelViewMatrix);
-		assert(!GLHasError());
+	// Changes may wait for the render thread, so the list is emptied first
+	std::vector<std::function<void()>> changes;
+	changes.swap(mSceneChanges);
 
-		if (mShaders[i - 1].needsProjection)
-			glUniformMatrix4fv(mShaders[i - 1].uniformLocations[mProjectionName], 1, GL_FALSE, glProjectionMatrix);
-		assert(!GLHasError());
-	}
+	mApplyingSceneChanges = true;
+	for (const auto& change : changes)
+		change();
+	mApplyingSceneChanges = false;
 
-	mModelviewModified = false;
-	mModified = false;
+	return true;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnMouseWheelEvent
+// Function:		IsRenderThread
 //
-// Description:		Event handler for the mouse wheel event.
+// Description:		Checks to see if the caller is executing on the render
+//					thread.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
+//		bool, true if called from the render thread
+//
+//=============================================================================
+bool RenderWindow::IsRenderThread() const
+{
+	return mRenderThread && mRenderThread->IsCurrentThread();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		IsSceneModifiable
+//
+// Description:		Checks to see if the caller may modify the scene.
+//
+// Input Arguments:
 //		None
 //
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the render thread is not using the scene
+//
 //=============================================================================
-void RenderWindow::OnMouseWheelEvent(wxMouseEvent &event)
+bool RenderWindow::IsSceneModifiable() const
 {
-	PerformInteraction(Interaction::DollyWheel, event);
+	// The flag belongs to the main thread, so it is only checked there
+	return IsRenderThread() || !mSceneInUse;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnMouseMoveEvent
+// Function:		ExecuteWithContext
 //
-// Description:		Event handler for the mouse move event.  Only used to
-//					capture drag events for rotating, panning, or dollying
-//					the scene.
+// Description:		Calls the specified function with the context current
+//					and the render mutex held, on the render thread if there
+//					is one.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		task	= const std::function<void()>&
 //
 // Output Arguments:
 //		None
@@ -693,49 +686,59 @@ void RenderWindow::OnMouseWheelEvent(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::OnMouseMoveEvent(wxMouseEvent &event)
+void RenderWindow::ExecuteWithContext(const std::function<void()>& task) const
 {
-	if (!event.Dragging() ||
-		(!mObservedLeftButtonDown && event.LeftIsDown()) ||
-		(!mObservedRightButtonDown && event.RightIsDown()))
+	// Without a context, no OpenGL objects can exist
+	if (!HasContext())
 	{
-		StoreMousePosition(event);
+		task();
 		return;
 	}
 
-	Interaction interaction;
-	if (mView3D)
+	const auto execute([this, &task]()
 	{
-		if (!Determine3DInteraction(event, interaction))
-		{
-			StoreMousePosition(event);
-			return;
-		}
-	}
+		std::lock_guard<std::mutex> lock(mRenderMutex);
+		MakeContextCurrent();
+		task();
+	});
+
+	if (mRenderThread)
+		mRenderThread->Execute(execute);
 	else
-	{
-		if (!Determine2DInteraction(event, interaction))
-		{
-			StoreMousePosition(event);
-			return;
-		}
-	}
+		execute();
+}
 
-	PerformInteraction(interaction, event);
-	StoreMousePosition(event);
+//=============================================================================
+// Class:			RenderWindow
+// Function:		SetViewportCount
+//
+// Description:		Sets the number of viewports.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::SetViewportCount(const unsigned int& count)
+{
+	assert(count > 0);
+	viewportCount = count;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		PerformInteraction
+// Function:		Render
 //
-// Description:		Performs the specified interaction.
-//					NOTE:  Modifying the modelview matrix moves the scene
-//					relative to the eyepoint in the scene's coordinate system!
+// Description:		Updates the scene with all of this object's options and
+//					re-draws the image.
 //
 // Input Arguments:
-//		interaction	= Interaction specifying which type of motion to create
-//		event		= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -744,39 +747,76 @@ void RenderWindow::OnMouseMoveEvent(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::PerformInteraction(Interaction interaction, wxMouseEvent &event)
+void RenderWindow::Render()
 {
-	SetCurrent(*GetContext());
+	if (mHeadless || !GetContext() || !IsShownOnScreen())
+		return;
+
+	if (mRenderThread)
+	{
+		RequestFrame();
+		return;
+	}
+
+	const unsigned int shaderCount(mShaders.size());
+	std::vector<ReadbackQueue::CompletedImage> completedImages;
 
-	if (!mIsInteracting)
 	{
-		// TODO:  Get focal point in order to perform interactions around the cursor
-		//FocalPoint.Set(0.0, 0.0, 0.0);
+		std::lock_guard<std::mutex> lock(mRenderMutex);
+
+		SetCurrent(*mContext);
+		wxPaintDC(this);
+
+		assert(!GLHasError());
+
+		if (!InitializeGLEW())
+			return;
+
+		if (mRenderStatistics)
+			mRenderStatistics->BeginFrame();
+
+		DrawScene();
+
+		if (mRenderStatistics)
+			mRenderStatistics->EndFrame();
+
+		// Start reading the back buffer before it is swapped; transfers are
+		// completed later, when polled by the readback timer
+		if (mReadbackQueue && mReadbackQueue->HasRequests())
+			mReadbackQueue->Begin(GetSize().GetWidth(), GetSize().GetHeight(),
+				completedImages);
+
+		SwapBuffers();// TODO:  Memory leak here?
+	}
+
+	// Callbacks are made without holding the lock, since they may render
+	ReadbackQueue::Deliver(completedImages);
+
+	if (mReadbackQueue && mReadbackQueue->IsBusy())
+		mReadbackTimer.Start(mReadbackPollInterval);
 
-		// Don't re-compute the focal point until the next interaction
-		mIsInteracting = true;
+	// If shaders are added mid-render, we need to re-render to ensure everything gets displayed
+	if (mShaders.size() != shaderCount)
+	{
+		Render();
+		return;
 	}
 
-	if (interaction == Interaction::DollyWheel)
-		DoWheelDolly(event);
-	else if (interaction == Interaction::DollyDrag)
-		DoDragDolly(event);
-	else if (interaction == Interaction::Pan)
-		DoPan(event);
-	else if (interaction == Interaction::Rotate)
-		DoRotate(event);
+	NotifyFrameRendered();
 
-	Refresh();
+	assert(!GLHasError());
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		StoreMousePosition
+// Function:		RequestFrame
 //
-// Description:		Stores the current mouse position to a class member.
+// Description:		Posts a frame to the render thread, along with the state
+//					of the window.  If a frame is already being drawn, another
+//					frame is requested when it is complete.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -785,20 +825,37 @@ void RenderWindow::PerformInteraction(Interaction interaction, wxMouseEvent &eve
 //		None
 //
 //=============================================================================
-void RenderWindow::StoreMousePosition(wxMouseEvent &event)
+void RenderWindow::RequestFrame()
 {
-	mLastMousePosition[0] = event.GetX();
-	mLastMousePosition[1] = event.GetY();
+	wxPaintDC dc(this);// Validates the window, even though drawing is deferred
+
+	if (mFrameInProgress)
+	{
+		mFramePending = true;
+		return;
+	}
+
+	auto frame(std::make_shared<FrameSnapshot>());
+	frame->size = GetSize();
+	frame->clientSize = GetClientSize();
+	frame->imageRequests.swap(mImageRequests);
+
+	mFrameInProgress = true;
+	mSceneInUse = true;
+	mFramePending = false;
+	mRenderThread->PostFrame(std::move(frame));
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnMouseUpEvent
+// Function:		DrawFrame
 //
-// Description:		Event handler for a button becoming "unclicked."
+// Description:		Draws a frame requested by RequestFrame().  Called from the
+//					render thread; the results are passed back to the main
+//					thread through the event loop.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		frame	= const FrameSnapshot&
 //
 // Output Arguments:
 //		None
@@ -807,25 +864,68 @@ void RenderWindow::StoreMousePosition(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::OnMouseUpEvent(wxMouseEvent& event)
+void RenderWindow::DrawFrame(const FrameSnapshot& frame)
 {
-	mIsInteracting = false;
+	const unsigned int shaderCount(mShaders.size());
+	auto completedImages(
+		std::make_shared<std::vector<ReadbackQueue::CompletedImage>>());
 
-	if (event.GetButton() == wxMOUSE_BTN_LEFT)
-		mObservedLeftButtonDown = false;
+	{
+		std::lock_guard<std::mutex> lock(mRenderMutex);
 
-	if (event.GetButton() == wxMOUSE_BTN_RIGHT)
-		mObservedRightButtonDown = false;
+		SetCurrent(*mContext);
+		assert(!GLHasError());
+
+		if (InitializeGLEW())
+		{
+			if (frame.size != mFrameSize || frame.clientSize != mFrameClientSize)
+			{
+				mFrameSize = frame.size;
+				mFrameClientSize = frame.clientSize;
+				mSizeUpdateRequired = true;
+			}
+
+			if (!frame.imageRequests.empty())
+			{
+				if (!mReadbackQueue)
+					mReadbackQueue = std::make_unique<ReadbackQueue>();
+				for (const auto& callback : frame.imageRequests)
+					mReadbackQueue->Request(callback);
+			}
+
+			if (mRenderStatistics)
+				mRenderStatistics->BeginFrame();
+
+			DrawScene();
+
+			if (mRenderStatistics)
+				mRenderStatistics->EndFrame();
+
+			if (mReadbackQueue && mReadbackQueue->HasRequests())
+				mReadbackQueue->Begin(mFrameSize.GetWidth(),
+					mFrameSize.GetHeight(), *completedImages);
+
+			SwapBuffers();
+		}
+	}
+
+	const bool redraw(mShaders.size() != shaderCount);
+	CallAfter([this, completedImages, redraw]()
+	{
+		FinishFrame(completedImages, redraw);
+	});
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		OnMouseDownEvent
+// Function:		FinishFrame
 //
-// Description:		Event handler for a button becoming "clicked."
+// Description:		Completes a frame drawn by the render thread.  Called from
+//					the main thread.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		completedImages	= std::shared_ptr<std::vector<ReadbackQueue::CompletedImage>>
+//		redraw			= const bool&, true if another frame is required
 //
 // Output Arguments:
 //		None
@@ -834,24 +934,41 @@ void RenderWindow::OnMouseUpEvent(wxMouseEvent& event)
 //		None
 //
 //=============================================================================
-void RenderWindow::OnMouseDownEvent(wxMouseEvent& event)
+void RenderWindow::FinishFrame(
+	std::shared_ptr<std::vector<ReadbackQueue::CompletedImage>> completedImages,
+	const bool& redraw)
 {
-	if (event.GetButton() == wxMOUSE_BTN_LEFT)
-		mObservedLeftButtonDown = true;
+	// The thread may not have quite finished with the request
+	mRenderThread->WaitForIdle();
+	mSceneInUse = false;
 
-	if (event.GetButton() == wxMOUSE_BTN_RIGHT)
-		mObservedRightButtonDown = true;
+	// Applied before the frame is marked complete, so the changes can't
+	// start another frame part way through
+	const bool sceneModified(ApplySceneChanges());
+	mFrameInProgress = false;
+
+	ReadbackQueue::Deliver(*completedImages);
+
+	if (mReadbackQueue && mReadbackQueue->IsBusy())
+		mReadbackTimer.Start(mReadbackPollInterval);
+
+	// If shaders are added mid-render, or the window was painted or the
+	// scene was modified while the frame was drawn, another frame is required
+	if (redraw || mFramePending || sceneModified)
+		Refresh();
+
+	NotifyFrameRendered();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoRotate
+// Function:		NotifyFrameRendered
 //
-// Description:		Performs the rotate event.  Read through comments below
-//					for more information.
+// Description:		Informs the derived class (and, if requested, the
+//					application) that a frame has been displayed.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -860,59 +977,80 @@ void RenderWindow::OnMouseDownEvent(wxMouseEvent& event)
 //		None
 //
 //=============================================================================
-void RenderWindow::DoRotate(wxMouseEvent &event)
+void RenderWindow::NotifyFrameRendered()
 {
-	if (!mView3D)
-		return;
-
-	Eigen::Vector3d upDirection(0.0, 1.0, 0.0);
-	Eigen::Vector3d normal(0.0, 0.0, 1.0);
-
-	upDirection = TransformToModel(upDirection);
-	normal = TransformToModel(normal);
-	Eigen::Vector3d leftDirection{ normal.cross(upDirection) };
+	FrameRendered();
 
-	Eigen::Vector3d mouseVector{ upDirection *
-		static_cast<double>(GetSize().GetHeight() / 2 - event.GetY())
-		+ leftDirection *
-		static_cast<double>(GetSize().GetWidth() / 2 - event.GetX()) };
-	Eigen::Vector3d lastMouseVector{ upDirection *
-		static_cast<double>(GetSize().GetHeight() / 2 - mLastMousePosition[1])
-		+ leftDirection *
-		static_cast<double>(GetSize().GetWidth() / 2 - mLastMousePosition[0]) };
+	if (mRenderedEvent)
+	{
+		wxCommandEvent event(RENDERED_EVENT, GetId());
+		event.SetEventObject(this);
+		ProcessWindowEvent(event);
+	}
+}
 
-	// Get a vector that represents the mouse motion (projected onto a plane with the camera
-	// position as a normal)
-	Eigen::Vector3d mouseMotion{ mouseVector - lastMouseVector };
-	Eigen::Vector3d axisOfRotation{ normal.cross(mouseMotion) };
+//=============================================================================
+// Class:			RenderWindow
+// Function:		InitializeGLEW
+//
+// Description:		Initializes GLEW and builds the default shaders, if this
+//					has not already been done.  The context must be current.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool RenderWindow::InitializeGLEW()
+{
+	if (mGlewInitialized)
+		return true;
+
+	glewExperimental = GL_TRUE;
+	const GLenum result(glewInit());
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// GLEW loads the GLX extensions last, which fails without an X display
+	// (i.e. with a headless context), but the OpenGL functions are loaded
+	if (result != GLEW_OK && !(mHeadless && result == GLEW_ERROR_NO_GLX_DISPLAY))
+#else
+	if (result != GLEW_OK)
+#endif// GLEW_ERROR_NO_GLX_DISPLAY
+		return false;
 
-	long xDistance{ GetSize().GetWidth() / 2 - event.GetX() };
-	long yDistance{ GetSize().GetHeight() / 2 - event.GetY() };
-	long lastXDistance{ GetSize().GetWidth() / 2 - mLastMousePosition[0] };
-	long lastYDistance{ GetSize().GetHeight() / 2 - mLastMousePosition[1] };
+	// According to https://www.khronos.org/opengl/wiki/OpenGL_Loading_Library, glewInit() may cause
+	// OpenGL error GL_INVALID_ENUM (which we observe) even if everything is actually OK.
+	// So check for errors to clear the error flag.
+#ifdef _DEBUG
+	int e =
+#endif// _DEBUG
+		glGetError();
 
-	// The angle is determined by how much the mouse moved.  800 pixels of movement will result in
-	// a full 360 degrees rotation.
-	// TODO:  Add user-adjustable rotation sensitivity (actually, all of the interactions can be adjustable)
-	const double angle{ sqrt(fabs(static_cast<double>(
-		(xDistance - lastXDistance) * (xDistance - lastXDistance)
-		+ (yDistance - lastYDistance) * (yDistance - lastYDistance))))
-		/ 800.0 * 360.0 };// [deg]
+#ifdef _DEBUG
+	assert(e == GL_NO_ERROR || e == GL_INVALID_ENUM);
+	GetGLInfo();
+#endif// _DEBUG
+	BuildShaders();
+	mGlewInitialized = true;
 
-	Translate(mModelviewMatrix, mFocalPoint);
-	Rotate(mModelviewMatrix, angle * M_PI / 180.0, axisOfRotation);
-	Translate(mModelviewMatrix, -mFocalPoint);
-	mModelviewModified = true;
+	return true;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoWheelDolly
+// Function:		DrawScene
 //
-// Description:		Performs a dolly event triggered by a mouse wheel roll.
+// Description:		Draws the scene into the currently bound framebuffer.  The
+//					context must be current.  When the static layer is
+//					cached, only the overlays are drawn unless something else
+//					has changed.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -921,29 +1059,97 @@ void RenderWindow::DoRotate(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::DoWheelDolly(wxMouseEvent &event)
+void RenderWindow::DrawScene()
 {
-	// Handle 3D dollying differently than 2D dollying
-	if (mView3D)
+	// Primitives may be prepared on worker threads, which must not query the
+	// window for its size
+	mSceneSize = GetRenderSize();
+
+	if (mRenderStatistics)
 	{
-		const double dollyFactor(0.05);
-		const double nominalWheelRotation(120.0);
-		SetTopMinusBottom(mTopMinusBottom * (1.0 + event.GetWheelRotation() / nominalWheelRotation * dollyFactor));
+		const auto start(std::chrono::steady_clock::now());
+		PreparePrimitives();
+		mRenderStatistics->RecordPreparation(std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count());
 	}
 	else
+		PreparePrimitives();
+
+	// Changes to the window invalidate the cached image, too
+	if (mModified || mModelviewModified || mSizeUpdateRequired ||
+		mNeedAlphaSort || mNeedOrderSort)
+		InvalidateStaticLayer();
+
+	// Another window in the group may have changed the matrices stored in the
+	// shared programs; this doesn't affect the cached image
+	const bool reclaimPrograms(mContextGroup
+		&& mContextGroup->ClaimPrograms(*this));
+
+	const bool cacheLayers(UseStaticLayerCache());
+	for (unsigned int viewport = 0; viewport < viewportCount; ++viewport)
 	{
-		// Nothing here!
+		if (mSizeUpdateRequired || viewport != lastViewportConfigured)
+			DoResize(viewport);
+
+		if (mModified || reclaimPrograms || viewport != lastViewportConfigured)
+			Initialize(viewport);
+		else if (mModelviewModified)
+			UpdateModelviewMatrix();
+
+		// The scissor area is specified relative to the full render target
+		if (!mScissorArea.IsEmpty())
+			glScissor(mScissorArea.GetX() - mRenderRegion.GetX(),
+				mScissorArea.GetY() - mRenderRegion.GetY(),
+				mScissorArea.GetWidth(), mScissorArea.GetHeight());
+
+		if (viewport == 0 && !cacheLayers)
+			ClearBuffers();
+
+		// Sort the primitives by Color.GetAlpha to ensure that transparent objects are rendered last
+		Primitive* firstTransparentPrimitive(nullptr);
+		if (mNeedAlphaSort)
+		{
+			std::sort(mPrimitiveList.begin(), mPrimitiveList.end(), AlphaSortPredicate);
+			mNeedAlphaSort = false;
+
+			if (mView3D)
+			{
+				for (const auto& p : mPrimitiveList)
+				{
+					if (p->GetColor().GetAlpha() < 1.0)
+					{
+						firstTransparentPrimitive = p.get();
+						break;
+					}
+				}
+			}
+		}
+
+		// Generally, all objects will have the same draw order and this won't do anything,
+		// but for some cases we do want to override the draw order just before rendering
+		if (mNeedOrderSort)
+		{
+			std::stable_sort(mPrimitiveList.begin(), mPrimitiveList.end(), OrderSortPredicate);
+			mNeedOrderSort = false;
+		}
+
+		if (cacheLayers)
+			DrawCachedLayers();
+		else
+			DrawPrimitives(Layer::All, firstTransparentPrimitive);
+
+		lastViewportConfigured = viewport;
 	}
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoDragDolly
+// Function:		ClearBuffers
 //
-// Description:		Performs a dolly event triggered by mouse movement.
+// Description:		Clears the bound framebuffer to the background color.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		None
 //
 // Output Arguments:
 //		None
@@ -952,28 +1158,30 @@ void RenderWindow::DoWheelDolly(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::DoDragDolly(wxMouseEvent &event)
+void RenderWindow::ClearBuffers()
 {
+	glClearColor(static_cast<float>(mBackgroundColor.GetRed()),
+		static_cast<float>(mBackgroundColor.GetGreen()),
+		static_cast<float>(mBackgroundColor.GetBlue()),
+		static_cast<float>(mBackgroundColor.GetAlpha()));
+
 	if (mView3D)
-	{
-		const double dollyFactor(0.05);
-		double deltaMouse = mLastMousePosition[1] - event.GetY();
-		SetTopMinusBottom(mTopMinusBottom * (1.0 + deltaMouse * dollyFactor));
-	}
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	else
-	{
-		// Nothing here!
-	}
+		glClear(GL_COLOR_BUFFER_BIT);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoPan
+// Function:		DrawPrimitives
 //
-// Description:		Performs a pan event.
+// Description:		Draws the primitives belonging to the specified layer, in
+//					order.
 //
 // Input Arguments:
-//		event	= wxMouseEvent&
+//		layer						= const Layer&
+//		firstTransparentPrimitive	= const Primitive*, depth buffer writes
+//									  are disabled from this object onward
 //
 // Output Arguments:
 //		None
@@ -982,19 +1190,767 @@ void RenderWindow::DoDragDolly(wxMouseEvent &event)
 //		None
 //
 //=============================================================================
-void RenderWindow::DoPan(wxMouseEvent &event)
+void RenderWindow::DrawPrimitives(const Layer& layer,
+	const Primitive* firstTransparentPrimitive)
 {
-	// Handle 3D panning differently from 2D panning
-	if (mView3D)
+	// NOTE:  Any primitive that uses it's own program should re-load the default program
+	// by calling RenderWindow::UseDefaultProgram() at the end of GenerateGeometry()
+	for (auto& p : mPrimitiveList)
 	{
-		// Convert up and normal vectors from openGL coordinates to model
-		// coordinates
-		Eigen::Vector3d upDirection(0.0, 1.0, 0.0);
-		Eigen::Vector3d normal(0.0, 0.0, 1.0);
+		if ((layer == Layer::Static && p->GetIsOverlay()) ||
+			(layer == Layer::Overlay && !p->GetIsOverlay()))
+			continue;
 
-		upDirection = TransformToModel(upDirection);
-		normal = TransformToModel(normal);
-		const Eigen::Vector3d leftDirection{ normal.cross(upDirection) };
+		if (firstTransparentPrimitive && p.get() == firstTransparentPrimitive)
+			glDepthMask(GL_FALSE);
+		p->Draw();
+	}
+
+	if (firstTransparentPrimitive)
+		glDepthMask(GL_TRUE);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		UseStaticLayerCache
+//
+// Description:		Determines whether or not the static layer can be cached
+//					for the current frame.  The cache holds only color, so it
+//					is not used for 3D scenes; it is also bypassed when
+//					rendering offscreen (where each tile is drawn once).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//=============================================================================
+bool RenderWindow::UseStaticLayerCache() const
+{
+	return mCacheStaticLayer && !mView3D && viewportCount == 1 &&
+		mOffscreenSize.GetWidth() == 0;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DrawCachedLayers
+//
+// Description:		Draws the static layer to the cache if it has changed,
+//					then composites the cached image with the overlays.  If
+//					the cache can't be created, everything is drawn directly.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DrawCachedLayers()
+{
+	if (!mLayerCache)
+		mLayerCache = std::make_unique<LayerCache>();
+
+	const int width(mRenderRegion.GetWidth());
+	const int height(mRenderRegion.GetHeight());
+	if (!mStaticLayerValid || !mLayerCache->Matches(width, height))
+	{
+		if (!mLayerCache->Begin(width, height))
+		{
+			ClearBuffers();
+			DrawPrimitives(Layer::All);
+			return;
+		}
+
+		// Set prior to drawing, so anything invalidated while drawing (i.e.
+		// newly initialized programs) is drawn again on the next frame
+		mStaticLayerValid = true;
+		const unsigned int shaderCount(mShaders.size());
+
+		ClearBuffers();
+		DrawPrimitives(Layer::Static);
+		mLayerCache->End();
+
+		if (mShaders.size() != shaderCount)
+			InvalidateStaticLayer();
+	}
+
+	mLayerCache->Composite(GetActiveProgramInfo().programId);
+	DrawPrimitives(Layer::Overlay);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		PreparePrimitives
+//
+// Description:		Performs the CPU-only portion of the updates for all
+//					primitives which need it, in parallel.  OpenGL calls are
+//					left for Primitive::Draw(), which is called on this thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::PreparePrimitives()
+{
+	std::vector<Primitive*> pending;
+	for (auto& p : mPrimitiveList)
+	{
+		if (p->NeedsPreparation())
+			pending.push_back(p.get());
+	}
+
+	// With fewer objects (or cores), there is nothing to gain over preparing
+	// each object as it is drawn
+	if (pending.size() < 2 || GetThreadPool().GetThreadCount() < 2)
+		return;
+
+	GetThreadPool().ParallelFor(pending.size(), 1, [&pending](
+		const unsigned int& begin, const unsigned int& end)
+	{
+		unsigned int i;
+		for (i = begin; i < end; ++i)
+			pending[i]->Prepare();
+	});
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetThreadPool
+//
+// Description:		Returns the thread pool shared by all windows.  Created
+//					the first time it is needed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		ThreadPool&
+//
+//=============================================================================
+ThreadPool& RenderWindow::GetThreadPool()
+{
+	static ThreadPool pool(std::max(1U, std::thread::hardware_concurrency()));
+	return pool;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetGLInfo
+//
+// Description:		Gets useful GL version info and puts it in a string (for debugging).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::GetGLInfo()
+{
+	std::string info;
+	info.append("Vendor:          " + std::string(reinterpret_cast<const char*>(glGetString(GL_VENDOR))) + '\n');
+	info.append("Renderer:        " + std::string(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) + '\n');
+	info.append("OpenGL version:  " + std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION))) + '\n');
+	info.append("GLSL version:    " + std::string(reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION))) + '\n');
+	std::cerr << info;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnPaint
+//
+// Description:		Event handler for the paint event.  Obtains the device
+//					context and re-renders the scene.
+//
+// Input Arguments:
+//		event	= wxPaintEvent& (UNUSED)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnPaint(wxPaintEvent& WXUNUSED(event))
+{
+    Render();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnSize
+//
+// Description:		Event handler for the window re-size event.
+//
+// Input Arguments:
+//		event	= wxSizeEvent& (unused)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnSize(wxSizeEvent& WXUNUSED(event))
+{
+	// When rendering is threaded, the render thread detects the new size
+	if (!mRenderThread)
+		mSizeUpdateRequired = true;
+	Refresh();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoResize
+//
+// Description:		Handles actions required to update the screen after resizing.
+//
+// Input Arguments:
+//		viewportId	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoResize(const unsigned int& /*viewportId*/)
+{
+	assert(viewportCount == 1);
+
+	// When rendering offscreen, the region is set for each tile
+	// The render thread uses the size captured when the frame was requested
+	if (mOffscreenSize.GetWidth() == 0 && IsRenderThread())
+		mRenderRegion = wxRect(wxPoint(0, 0), mFrameClientSize);
+	else if (mOffscreenSize.GetWidth() == 0)
+	{
+		int w, h;
+		GetClientSize(&w, &h);
+		mRenderRegion = wxRect(0, 0, w, h);
+	}
+
+	// set GL viewport (not called by wxGLCanvas::OnSize on all platforms...)
+	glViewport(0, 0, mRenderRegion.GetWidth(), mRenderRegion.GetHeight());
+
+	AutoSetFrustum();// This takes care of any change in aspect ratio
+
+	mSizeUpdateRequired = false;
+	mModelviewModified = true;
+	mModified = true;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnEnterWindow
+//
+// Description:		Event handler for the enter window event.
+//
+// Input Arguments:
+//		event	= wxEraseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnEnterWindow(wxMouseEvent &event)
+{
+	mObservedLeftButtonDown = false;
+	mObservedRightButtonDown = false;
+	//SetFocus();
+	event.Skip();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		RemoveActor
+//
+// Description:		Removes the specified actor from the display list, if it
+//					is in the list.
+//
+// Input Arguments:
+//		toRemove	= Primitive* pointing to the object to be removed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool RenderWindow::RemoveActor(Primitive *toRemove)
+{
+	if (!toRemove)
+		return false;
+
+	WaitForRenderThread();
+
+	unsigned int i;
+	for (i = 0; i < mPrimitiveList.GetCount(); ++i)
+	{
+		if (toRemove == mPrimitiveList[i].get())
+		{
+			// The primitive frees its OpenGL objects when it is deleted
+			ExecuteWithContext([this, i]()
+			{
+				mPrimitiveList.Remove(i);
+			});
+
+			InvalidateStaticLayer();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		Initialize
+//
+// Description:		Sets up the renderer's parameters.  Called on startup
+//					and any time an option changes (wireframe vs. polygon, etc.)
+//
+// Input Arguments:
+//		viewportId	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::Initialize(const unsigned int& viewportId)
+{
+	Eigen::Matrix4d projectionMatrix;
+	if (mView3D)
+	{
+		Initialize3D();
+		projectionMatrix = Generate3DProjectionMatrix(viewportId);
+	}
+	else
+	{
+		Initialize2D();
+		projectionMatrix = Generate2DProjectionMatrix();
+	}
+
+	projectionMatrix = GenerateRegionMatrix() * projectionMatrix;
+
+	if (mWireFrame)
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	else
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+	float glModelViewMatrix[16];
+	ConvertMatrixToGL(mModelviewMatrix, glModelViewMatrix);
+	float glProjectionMatrix[16];
+	ConvertMatrixToGL(projectionMatrix, glProjectionMatrix);
+	assert(!GLHasError());
+	GLuint i;
+	for (i = mShaders.size(); i > 0; --i)
+	{
+		if (mShaders[i - 1].needsModelview || mShaders[i - 1].needsProjection)
+			UseProgram(i - 1);
+		assert(!GLHasError());
+
+		if (mShaders[i - 1].needsModelview)
+			DoModelviewUpdate(mShaders[i - 1].uniformLocations[mModelviewName], glModelViewMatrix);
+		assert(!GLHasError());
+
+		if (mShaders[i - 1].needsProjection)
+			glUniformMatrix4fv(mShaders[i - 1].uniformLocations[mProjectionName], 1, GL_FALSE, glProjectionMatrix);
+		assert(!GLHasError());
+	}
+
+	mModelviewModified = false;
+	mModified = false;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnMouseWheelEvent
+//
+// Description:		Event handler for the mouse wheel event.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnMouseWheelEvent(wxMouseEvent &event)
+{
+	PerformInteraction(Interaction::DollyWheel, event);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnMouseMoveEvent
+//
+// Description:		Event handler for the mouse move event.  Only used to
+//					capture drag events for rotating, panning, or dollying
+//					the scene.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnMouseMoveEvent(wxMouseEvent &event)
+{
+	if (!event.Dragging() ||
+		(!mObservedLeftButtonDown && event.LeftIsDown()) ||
+		(!mObservedRightButtonDown && event.RightIsDown()))
+	{
+		StoreMousePosition(event);
+		return;
+	}
+
+	Interaction interaction;
+	if (mView3D)
+	{
+		if (!Determine3DInteraction(event, interaction))
+		{
+			StoreMousePosition(event);
+			return;
+		}
+	}
+	else
+	{
+		if (!Determine2DInteraction(event, interaction))
+		{
+			StoreMousePosition(event);
+			return;
+		}
+	}
+
+	PerformInteraction(interaction, event);
+	StoreMousePosition(event);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		PerformInteraction
+//
+// Description:		Performs the specified interaction.
+//					NOTE:  Modifying the modelview matrix moves the scene
+//					relative to the eyepoint in the scene's coordinate system!
+//
+// Input Arguments:
+//		interaction	= Interaction specifying which type of motion to create
+//		event		= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::PerformInteraction(Interaction interaction, wxMouseEvent &event)
+{
+	if (!mRenderThread)
+		SetCurrent(*GetContext());
+
+	// The matrices are used while drawing, so the interaction may have to be
+	// applied after the current frame, but with the mouse positions from
+	// this event
+	const long lastX(mLastMousePosition[0]);
+	const long lastY(mLastMousePosition[1]);
+	ModifyScene([this, interaction, event, lastX, lastY]() mutable
+	{
+		if (!mIsInteracting)
+		{
+			// TODO:  Get focal point in order to perform interactions around the cursor
+			//FocalPoint.Set(0.0, 0.0, 0.0);
+
+			// Don't re-compute the focal point until the next interaction
+			mIsInteracting = true;
+		}
+
+		const long currentX(mLastMousePosition[0]);
+		const long currentY(mLastMousePosition[1]);
+		mLastMousePosition[0] = lastX;
+		mLastMousePosition[1] = lastY;
+
+		if (interaction == Interaction::DollyWheel)
+			DoWheelDolly(event);
+		else if (interaction == Interaction::DollyDrag)
+			DoDragDolly(event);
+		else if (interaction == Interaction::Pan)
+			DoPan(event);
+		else if (interaction == Interaction::Rotate)
+			DoRotate(event);
+
+		mLastMousePosition[0] = currentX;
+		mLastMousePosition[1] = currentY;
+
+		Refresh();
+	});
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		StoreMousePosition
+//
+// Description:		Stores the current mouse position to a class member.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::StoreMousePosition(wxMouseEvent &event)
+{
+	mLastMousePosition[0] = event.GetX();
+	mLastMousePosition[1] = event.GetY();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnMouseUpEvent
+//
+// Description:		Event handler for a button becoming "unclicked."
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnMouseUpEvent(wxMouseEvent& event)
+{
+	mIsInteracting = false;
+
+	if (event.GetButton() == wxMOUSE_BTN_LEFT)
+		mObservedLeftButtonDown = false;
+
+	if (event.GetButton() == wxMOUSE_BTN_RIGHT)
+		mObservedRightButtonDown = false;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		OnMouseDownEvent
+//
+// Description:		Event handler for a button becoming "clicked."
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::OnMouseDownEvent(wxMouseEvent& event)
+{
+	if (event.GetButton() == wxMOUSE_BTN_LEFT)
+		mObservedLeftButtonDown = true;
+
+	if (event.GetButton() == wxMOUSE_BTN_RIGHT)
+		mObservedRightButtonDown = true;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoRotate
+//
+// Description:		Performs the rotate event.  Read through comments below
+//					for more information.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoRotate(wxMouseEvent &event)
+{
+	if (!mView3D)
+		return;
+
+	Eigen::Vector3d upDirection(0.0, 1.0, 0.0);
+	Eigen::Vector3d normal(0.0, 0.0, 1.0);
+
+	upDirection = TransformToModel(upDirection);
+	normal = TransformToModel(normal);
+	Eigen::Vector3d leftDirection{ normal.cross(upDirection) };
+
+	Eigen::Vector3d mouseVector{ upDirection *
+		static_cast<double>(GetSize().GetHeight() / 2 - event.GetY())
+		+ leftDirection *
+		static_cast<double>(GetSize().GetWidth() / 2 - event.GetX()) };
+	Eigen::Vector3d lastMouseVector{ upDirection *
+		static_cast<double>(GetSize().GetHeight() / 2 - mLastMousePosition[1])
+		+ leftDirection *
+		static_cast<double>(GetSize().GetWidth() / 2 - mLastMousePosition[0]) };
+
+	// Get a vector that represents the mouse motion (projected onto a plane with the camera
+	// position as a normal)
+	Eigen::Vector3d mouseMotion{ mouseVector - lastMouseVector };
+	Eigen::Vector3d axisOfRotation{ normal.cross(mouseMotion) };
+
+	long xDistance{ GetSize().GetWidth() / 2 - event.GetX() };
+	long yDistance{ GetSize().GetHeight() / 2 - event.GetY() };
+	long lastXDistance{ GetSize().GetWidth() / 2 - mLastMousePosition[0] };
+	long lastYDistance{ GetSize().GetHeight() / 2 - mLastMousePosition[1] };
+
+	// The angle is determined by how much the mouse moved.  800 pixels of movement will result in
+	// a full 360 degrees rotation.
+	// TODO:  Add user-adjustable rotation sensitivity (actually, all of the interactions can be adjustable)
+	const double angle{ sqrt(fabs(static_cast<double>(
+		(xDistance - lastXDistance) * (xDistance - lastXDistance)
+		+ (yDistance - lastYDistance) * (yDistance - lastYDistance))))
+		/ 800.0 * 360.0 };// [deg]
+
+	Translate(mModelviewMatrix, mFocalPoint);
+	Rotate(mModelviewMatrix, angle * M_PI / 180.0, axisOfRotation);
+	Translate(mModelviewMatrix, -mFocalPoint);
+	mModelviewModified = true;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoWheelDolly
+//
+// Description:		Performs a dolly event triggered by a mouse wheel roll.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoWheelDolly(wxMouseEvent &event)
+{
+	// Handle 3D dollying differently than 2D dollying
+	if (mView3D)
+	{
+		const double dollyFactor(0.05);
+		const double nominalWheelRotation(120.0);
+		SetTopMinusBottom(mTopMinusBottom * (1.0 + event.GetWheelRotation() / nominalWheelRotation * dollyFactor));
+	}
+	else
+	{
+		// Nothing here!
+	}
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoDragDolly
+//
+// Description:		Performs a dolly event triggered by mouse movement.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoDragDolly(wxMouseEvent &event)
+{
+	if (mView3D)
+	{
+		const double dollyFactor(0.05);
+		double deltaMouse = mLastMousePosition[1] - event.GetY();
+		SetTopMinusBottom(mTopMinusBottom * (1.0 + deltaMouse * dollyFactor));
+	}
+	else
+	{
+		// Nothing here!
+	}
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoPan
+//
+// Description:		Performs a pan event.
+//
+// Input Arguments:
+//		event	= wxMouseEvent&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoPan(wxMouseEvent &event)
+{
+	// Handle 3D panning differently from 2D panning
+	if (mView3D)
+	{
+		// Convert up and normal vectors from openGL coordinates to model
+		// coordinates
+		Eigen::Vector3d upDirection(0.0, 1.0, 0.0);
+		Eigen::Vector3d normal(0.0, 0.0, 1.0);
+
+		upDirection = TransformToModel(upDirection);
+		normal = TransformToModel(normal);
+		const Eigen::Vector3d leftDirection{ normal.cross(upDirection) };
 
 		// Get a vector that represents the mouse position relative to the
 		// center of the screen
@@ -1006,177 +1962,620 @@ void RenderWindow::DoPan(wxMouseEvent &event)
 			+ leftDirection
 			* (GetSize().GetWidth() * 0.5 - mLastMousePosition[0]) };
 
-		// Get a vector that represents the mouse motion (projected onto a
-		// plane with the camera position as a normal)
-		Eigen::Vector3d mouseMotion(mouseVector - lastMouseVector);
+		// Get a vector that represents the mouse motion (projected onto a
+		// plane with the camera position as a normal)
+		Eigen::Vector3d mouseMotion(mouseVector - lastMouseVector);
+
+		mouseMotion *= mPanFactor;
+
+		Translate(mModelviewMatrix, mouseMotion);
+		mModelviewModified = true;
+
+		mFocalPoint -= mouseMotion;
+	}
+	else
+	{
+		// Nothing here!
+	}
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		SetCameraView
+//
+// Description:		Sets the camera view as specified.
+//
+// Input Arguments:
+//		position	= const Eigen::Vector3d& specifying the camera position
+//		lookAt		= const Eigen::Vector3d& specifying the object at which the camera
+//					  is to be pointed
+//		upDirection	= const Eigen::Vector3d& used to specify the final camera orientation DOF
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::SetCameraView(const Eigen::Vector3d &position,
+	const Eigen::Vector3d &lookAt, const Eigen::Vector3d &upDirection)
+{
+	mModelviewModified = true;
+
+	// Compute the MODELVIEW matrix
+	// (Use calculations from gluLookAt documentation)
+	Eigen::Vector3d f{ (lookAt - position).normalized() };
+	Eigen::Vector3d up{ upDirection.normalized() };
+	Eigen::Vector3d s{ f.cross(up) };
+	if (!PlotMath::IsZero(s))
+	{
+		Eigen::Vector3d u{ s.cross(f) };
+		mModelviewMatrix << s(0), s(1), s(2), 0.0,
+							u(0), u(1), u(2), 0.0,
+							-f(0), -f(1), -f(2), 0.0,
+							0.0, 0.0, 0.0, 1.0;
+		
+		Translate(mModelviewMatrix, -position);
+		mModelviewModified = true;
+	}
+
+	mFocalPoint = lookAt;
+}
 
-		mouseMotion *= mPanFactor;
+//=============================================================================
+// Class:			RenderWindow
+// Function:		UpdateModelviewMatrix
+//
+// Description:		Makes the openGL calls to update the modelview matrix for
+//					all programs.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::UpdateModelviewMatrix()
+{
+	float glModelViewMatrix[16];
+	ConvertMatrixToGL(mModelviewMatrix, glModelViewMatrix);
 
-		Translate(mModelviewMatrix, mouseMotion);
-		mModelviewModified = true;
+	unsigned int i;
+	for (i = mShaders.size(); i > 0; --i)
+	{
+		if (mShaders[i - 1].needsModelview)
+		{
+			UseProgram(i - 1);
+			DoModelviewUpdate(mShaders[i - 1].uniformLocations[mModelviewName], glModelViewMatrix);
+		}
+	}
+
+	mModelviewModified = false;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		DoModelviewUpdate
+//
+// Description:		Updates the modelview uniform for the current program.
+//
+// Input Arguments:
+//		modelViewLocation	= const GLuint&
+//		glModelViewMatrix	= const float*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::DoModelviewUpdate(const GLuint& modelViewLocation, const float* glModelViewMatrix)
+{
+	glUniformMatrix4fv(modelViewLocation, 1, GL_FALSE, glModelViewMatrix);
+	assert(!GLHasError());
+	UpdateUniformWithModelView();
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		TransformToView
+//
+// Description:		Returns a vector equivalent to the specified vector
+//					(assumed to be in model coordinates) in view coordinates.
+//
+// Input Arguments:
+//		modelVector	= const Eigen::Vector3d& to be transformed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Eigen::Vector3d
+//
+//=============================================================================
+Eigen::Vector3d RenderWindow::TransformToView(
+	const Eigen::Vector3d &modelVector) const
+{
+	return mModelviewMatrix.topLeftCorner<3, 3>() * modelVector;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		TransformToModel
+//
+// Description:		Returns a vector equivalent to the specified vector
+//					(assumed to be in view coordinates) in model coordinates.
+//
+// Input Arguments:
+//		viewVector	= const Eigen::Vector3d& to be transformed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Eigen::Vector3d
+//
+//=============================================================================
+Eigen::Vector3d RenderWindow::TransformToModel(
+	const Eigen::Vector3d &viewVector) const
+{
+	return mModelviewMatrix.topLeftCorner<3, 3>().transpose() * viewVector;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetCameraPosition
+//
+// Description:		Extracts the camera position from the modelview matrix.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+Eigen::Vector3d RenderWindow::GetCameraPosition() const
+{
+	Eigen::Vector3d cameraPosition(mModelviewMatrix(0, 3),
+		mModelviewMatrix(1, 3), mModelviewMatrix(2, 3));
+	return TransformToModel(cameraPosition);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		AutoSetFrustum
+//
+// Description:		Updates the view frustum to correctly match the viewport size.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::AutoSetFrustum()
+{
+	mModified = true;
+
+	// This method is really for 3D renderers - for 2D, we just re-initialize to handle change in aspect ratio/size
+	if (!mView3D)
+		return;
+
+	const wxSize windowSize(GetRenderSize());
+	mAspectRatio = static_cast<double>(windowSize.GetWidth())
+		/ static_cast<double>(windowSize.GetHeight());
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetGLError
+//
+// Description:		Returns a string describing any openGL errors.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString containing the error description
+//
+//=============================================================================
+wxString RenderWindow::GetGLError()
+{
+	int e = glGetError();
+
+	return GetGLError(e);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		GetGLError
+//
+// Description:		Returns a string describing any openGL errors.
+//
+// Input Arguments:
+//		e	= const GLint&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		wxString containing the error description
+//
+//=============================================================================
+wxString RenderWindow::GetGLError(const GLint& e)
+{
+	if (e == GL_NO_ERROR)
+		return _T("No errors");
+	else if (e == GL_INVALID_ENUM)
+		return _T("Invalid enumeration");
+	else if (e == GL_INVALID_VALUE)
+		return _T("Invalid value");
+	else if (e == GL_INVALID_OPERATION)
+		return _T("Invalid operation");
+	else if (e == GL_STACK_OVERFLOW)
+		return _T("Stack overflow");
+	else if (e == GL_STACK_UNDERFLOW)
+		return _T("Stack underflow");
+	else if (e == GL_OUT_OF_MEMORY)
+		return _T("Out of memory");
+
+	return _T("Unrecognized error");
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		WriteImageToFile
+//
+// Description:		Writes the contents of the render window to file.  Various
+//					different file types are supported, specified by the file
+//					extension.
+//
+// Input Arguments:
+//		pathAndFileName	= wxString specifying the location to save the image to
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, indicating success (true) or failure (false)
+//
+//=============================================================================
+bool RenderWindow::WriteImageToFile(wxString pathAndFileName) const
+{
+	wxImage newImage(GetImage());
+	wxInitAllImageHandlers();
+	return newImage.SaveFile(pathAndFileName);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		WriteImageToFile
+//
+// Description:		Renders the scene offscreen at the specified size and
+//					writes the image to file.  Various different file types
+//					are supported, specified by the file extension.
+//
+// Input Arguments:
+//		pathAndFileName	= wxString specifying the location to save the image to
+//		width			= const unsigned int&
+//		height			= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, indicating success (true) or failure (false)
+//
+//=============================================================================
+bool RenderWindow::WriteImageToFile(wxString pathAndFileName,
+	const unsigned int& width, const unsigned int& height)
+{
+	wxImage newImage(RenderOffscreen(width, height));
+	if (!newImage.IsOk())
+		return false;
 
-		mFocalPoint -= mouseMotion;
-	}
-	else
-	{
-		// Nothing here!
-	}
+	wxInitAllImageHandlers();
+	return newImage.SaveFile(pathAndFileName);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		SetCameraView
+// Function:		RenderOffscreen
 //
-// Description:		Sets the camera view as specified.
+// Description:		Renders the scene to an offscreen framebuffer at the
+//					specified size and returns the image.  The scene is laid
+//					out for the requested size before rendering and for the
+//					window size afterwards.  If the context can't be created
+//					or made current (i.e. the window hasn't been realized,
+//					when not rendering headless), an invalid image is
+//					returned.
 //
 // Input Arguments:
-//		position	= const Eigen::Vector3d& specifying the camera position
-//		lookAt		= const Eigen::Vector3d& specifying the object at which the camera
-//					  is to be pointed
-//		upDirection	= const Eigen::Vector3d& used to specify the final camera orientation DOF
+//		width	= const unsigned int&
+//		height	= const unsigned int&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		wxImage
 //
 //=============================================================================
-void RenderWindow::SetCameraView(const Eigen::Vector3d &position,
-	const Eigen::Vector3d &lookAt, const Eigen::Vector3d &upDirection)
+wxImage RenderWindow::RenderOffscreen(const unsigned int& width,
+	const unsigned int& height)
 {
-	mModelviewModified = true;
+	assert(width > 0 && height > 0);
 
-	// Compute the MODELVIEW matrix
-	// (Use calculations from gluLookAt documentation)
-	Eigen::Vector3d f{ (lookAt - position).normalized() };
-	Eigen::Vector3d up{ upDirection.normalized() };
-	Eigen::Vector3d s{ f.cross(up) };
-	if (!PlotMath::IsZero(s))
+	wxImage image;
+	if (mHeadless ? !GetHeadlessContext() : !GetContext())
+		return image;
+
+	WaitForRenderThread();
+	mOffscreenSize = wxSize(width, height);
+	mSizeUpdateRequired = true;
+	UpdateRenderSize();
+
+	image.Create(width, height, false);
+
+	ExecuteWithContext([this, &image]()
 	{
-		Eigen::Vector3d u{ s.cross(f) };
-		mModelviewMatrix << s(0), s(1), s(2), 0.0,
-							u(0), u(1), u(2), 0.0,
-							-f(0), -f(1), -f(2), 0.0,
-							0.0, 0.0, 0.0, 1.0;
-		
-		Translate(mModelviewMatrix, -position);
-		mModelviewModified = true;
-	}
+		// The context was made current by ExecuteWithContext(), but that
+		// fails silently if the window hasn't been realized
+		if (!MakeContextCurrent())
+		{
+			image.Destroy();
+			return;
+		}
 
-	mFocalPoint = lookAt;
+		assert(!GLHasError());
+
+		if (!InitializeGLEW() || !RenderTiles(image))
+			image.Destroy();
+	});
+
+	mOffscreenSize = wxSize();
+	mSizeUpdateRequired = true;
+	UpdateRenderSize();
+
+	return image;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		UpdateModelviewMatrix
+// Function:		RenderTiles
 //
-// Description:		Makes the openGL calls to update the modelview matrix for
-//					all programs.
+// Description:		Renders the offscreen image in tiles no larger than the
+//					OpenGL implementation supports (and no larger than
+//					mMaxTileSize, to limit memory use).  Each tile is drawn to
+//					a framebuffer with the same number of samples as the
+//					window, resolved and then copied into the image.  The
+//					image rows are flipped (OpenGL's origin is the bottom
+//					left) as the tiles are copied.  The context must be
+//					current.
 //
 // Input Arguments:
 //		None
 //
 // Output Arguments:
-//		None
+//		image	= wxImage&, created with the desired size
 //
 // Return Value:
-//		None
+//		bool, true for success, false otherwise
 //
 //=============================================================================
-void RenderWindow::UpdateModelviewMatrix()
+bool RenderWindow::RenderTiles(wxImage& image)
 {
-	float glModelViewMatrix[16];
-	ConvertMatrixToGL(mModelviewMatrix, glModelViewMatrix);
-
-	unsigned int i;
-	for (i = mShaders.size(); i > 0; --i)
+	const int width(image.GetWidth());
+	const int height(image.GetHeight());
+
+	GLint maxRenderbufferSize, maxViewportSize[2], samples;
+	glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbufferSize);
+	glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewportSize);
+	glGetIntegerv(GL_SAMPLES, &samples);
+
+	const int tileSize(std::min({ mMaxTileSize, maxRenderbufferSize,
+		maxViewportSize[0], maxViewportSize[1] }));
+	const int tileWidth(std::min(tileSize, width));
+	const int tileHeight(std::min(tileSize, height));
+
+	// First framebuffer is drawn to; second is for resolving multisampling
+	GLuint framebuffers[2];
+	GLuint renderbuffers[3];
+	glGenFramebuffers(2, framebuffers);
+	glGenRenderbuffers(3, renderbuffers);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8,
+		tileWidth, tileHeight);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples,
+		GL_DEPTH_COMPONENT24, tileWidth, tileHeight);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[2]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, tileWidth, tileHeight);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[1]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_RENDERBUFFER, renderbuffers[2]);
+	bool complete(glCheckFramebufferStatus(GL_FRAMEBUFFER)
+		== GL_FRAMEBUFFER_COMPLETE);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[0]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_RENDERBUFFER, renderbuffers[0]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+		GL_RENDERBUFFER, renderbuffers[1]);
+	complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER)
+		== GL_FRAMEBUFFER_COMPLETE;
+
+	std::vector<GLubyte> tile;
+	if (complete)
+		tile.resize(tileWidth * tileHeight * 3);
+
+	int x, y;
+	for (y = 0; complete && y < height; y += tileHeight)
 	{
-		if (mShaders[i - 1].needsModelview)
+		for (x = 0; x < width; x += tileWidth)
 		{
-			UseProgram(i - 1);
-			DoModelviewUpdate(mShaders[i - 1].uniformLocations[mModelviewName], glModelViewMatrix);
+			mRenderRegion = wxRect(x, y, std::min(tileWidth, width - x),
+				std::min(tileHeight, height - y));
+			mSizeUpdateRequired = true;
+
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[0]);
+
+			// If shaders are added mid-render, we need to re-render to ensure everything gets drawn
+			unsigned int shaderCount;
+			do
+			{
+				shaderCount = mShaders.size();
+				DrawScene();
+			} while (mShaders.size() != shaderCount);
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+			glBlitFramebuffer(0, 0, mRenderRegion.GetWidth(),
+				mRenderRegion.GetHeight(), 0, 0, mRenderRegion.GetWidth(),
+				mRenderRegion.GetHeight(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[1]);
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(0, 0, mRenderRegion.GetWidth(),
+				mRenderRegion.GetHeight(), GL_RGB, GL_UNSIGNED_BYTE, tile.data());
+
+			CopyFlipped(tile.data(), mRenderRegion, image);
 		}
 	}
 
-	mModelviewModified = false;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(2, framebuffers);
+	glDeleteRenderbuffers(3, renderbuffers);
+
+	mRenderRegion = wxRect();
+
+	assert(!GLHasError());
+	return complete;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		DoModelviewUpdate
+// Function:		GetRenderSize
 //
-// Description:		Updates the modelview uniform for the current program.
+// Description:		Returns the size of the image being rendered.
 //
 // Input Arguments:
-//		modelViewLocation	= const GLuint&
-//		glModelViewMatrix	= const float*
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		wxSize
 //
 //=============================================================================
-void RenderWindow::DoModelviewUpdate(const GLuint& modelViewLocation, const float* glModelViewMatrix)
+wxSize RenderWindow::GetRenderSize() const
 {
-	glUniformMatrix4fv(modelViewLocation, 1, GL_FALSE, glModelViewMatrix);
-	assert(!GLHasError());
-	UpdateUniformWithModelView();
+	if (mOffscreenSize.GetWidth() > 0)
+		return mOffscreenSize;
+
+	// The render thread must not query the window
+	if (IsRenderThread())
+		return mFrameSize;
+	return GetSize();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		TransformToView
+// Function:		GenerateRegionMatrix
 //
-// Description:		Returns a vector equivalent to the specified vector
-//					(assumed to be in model coordinates) in view coordinates.
+// Description:		Returns the matrix which maps the full render target to
+//					the region covered by the viewport (i.e. the current tile,
+//					when rendering offscreen).  Applied after the projection,
+//					so it works for 2D and 3D scenes alike.
 //
 // Input Arguments:
-//		modelVector	= const Eigen::Vector3d& to be transformed
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		Eigen::Vector3d
+//		Eigen::Matrix4d
 //
 //=============================================================================
-Eigen::Vector3d RenderWindow::TransformToView(
-	const Eigen::Vector3d &modelVector) const
+Eigen::Matrix4d RenderWindow::GenerateRegionMatrix() const
 {
-	return mModelviewMatrix.topLeftCorner<3, 3>() * modelVector;
+	Eigen::Matrix4d regionMatrix(Eigen::Matrix4d::Identity());
+	if (mOffscreenSize.GetWidth() == 0)
+		return regionMatrix;
+
+	const wxSize size(GetRenderSize());
+	regionMatrix(0, 0) = static_cast<double>(size.GetWidth()) / mRenderRegion.GetWidth();
+	regionMatrix(1, 1) = static_cast<double>(size.GetHeight()) / mRenderRegion.GetHeight();
+	regionMatrix(0, 3) = static_cast<double>(size.GetWidth() - 2 * mRenderRegion.GetX())
+		/ mRenderRegion.GetWidth() - 1.0;
+	regionMatrix(1, 3) = static_cast<double>(size.GetHeight() - 2 * mRenderRegion.GetY())
+		/ mRenderRegion.GetHeight() - 1.0;
+
+	return regionMatrix;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		TransformToModel
+// Function:		CopyFlipped
 //
-// Description:		Returns a vector equivalent to the specified vector
-//					(assumed to be in view coordinates) in model coordinates.
+// Description:		Copies rows of pixels read from OpenGL (bottom row first)
+//					into the specified region of the image (top row first).
 //
 // Input Arguments:
-//		viewVector	= const Eigen::Vector3d& to be transformed
+//		source	= const unsigned char*, tightly packed RGB pixels
+//		region	= const wxRect&, y-coordinate measured from the bottom
 //
 // Output Arguments:
-//		None
+//		image	= wxImage&
 //
 // Return Value:
-//		Eigen::Vector3d
+//		None
 //
 //=============================================================================
-Eigen::Vector3d RenderWindow::TransformToModel(
-	const Eigen::Vector3d &viewVector) const
+void RenderWindow::CopyFlipped(const unsigned char* source,
+	const wxRect& region, wxImage& image)
 {
-	return mModelviewMatrix.topLeftCorner<3, 3>().transpose() * viewVector;
+	assert(region.GetX() + region.GetWidth() <= image.GetWidth());
+	assert(region.GetY() + region.GetHeight() <= image.GetHeight());
+
+	unsigned char* imageData(image.GetData());
+	const int width(image.GetWidth());
+	const int height(image.GetHeight());
+	const int rowSize(region.GetWidth() * 3);
+	int row;
+	for (row = 0; row < region.GetHeight(); ++row)
+		memcpy(imageData + ((height - 1 - region.GetY() - row) * width
+			+ region.GetX()) * 3, source + row * rowSize, rowSize);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		GetCameraPosition
+// Function:		GetImage
 //
-// Description:		Extracts the camera position from the modelview matrix.
+// Description:		Returns an image object representing the contents of the
+//					window.
 //
 // Input Arguments:
 //		None
@@ -1185,24 +2584,36 @@ Eigen::Vector3d RenderWindow::TransformToModel(
 //		None
 //
 // Return Value:
-//		None
+//		wxImage
 //
 //=============================================================================
-Eigen::Vector3d RenderWindow::GetCameraPosition() const
+wxImage RenderWindow::GetImage() const
 {
-	Eigen::Vector3d cameraPosition(mModelviewMatrix(0, 3),
-		mModelviewMatrix(1, 3), mModelviewMatrix(2, 3));
-	return TransformToModel(cameraPosition);
+	assert(!mHeadless && "Headless windows have no image to read");
+	const wxRect region(0, 0, GetSize().GetWidth(), GetSize().GetHeight());
+	std::vector<GLubyte> pixels(region.GetWidth() * region.GetHeight() * 3);
+	ExecuteWithContext([&region, &pixels]()
+	{
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, region.GetWidth(), region.GetHeight(), GL_RGB,
+			GL_UNSIGNED_BYTE, pixels.data());
+	});
+
+	wxImage image(region.GetWidth(), region.GetHeight(), false);
+	CopyFlipped(pixels.data(), region, image);
+
+	return image;
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		AutoSetFrustum
+// Function:		SetCollectStatistics
 //
-// Description:		Updates the view frustum to correctly match the viewport size.
+// Description:		Enables or disables the collection of rendering
+//					statistics.
 //
 // Input Arguments:
-//		None
+//		collect	= const bool&
 //
 // Output Arguments:
 //		None
@@ -1211,24 +2622,38 @@ Eigen::Vector3d RenderWindow::GetCameraPosition() const
 //		None
 //
 //=============================================================================
-void RenderWindow::AutoSetFrustum()
+void RenderWindow::SetCollectStatistics(const bool& collect)
 {
-	mModified = true;
+	if (collect == GetCollectStatistics())
+		return;
 
-	// This method is really for 3D renderers - for 2D, we just re-initialize to handle change in aspect ratio/size
-	if (!mView3D)
+	// The statistics are updated while drawing
+	WaitForRenderThread();
+
+	if (collect)
+	{
+		mRenderStatistics = std::make_unique<RenderStatistics>();
 		return;
+	}
 
-	const wxSize windowSize(GetSize());
-	mAspectRatio = static_cast<double>(windowSize.GetWidth())
-		/ static_cast<double>(windowSize.GetHeight());
+	// Need to ensure the proper context is active when the queries are freed
+	if (HasContext())
+	{
+		ExecuteWithContext([this]()
+		{
+			mRenderStatistics->FreeOpenGLObjects();
+		});
+	}
+
+	mRenderStatistics.reset();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		GetGLError
+// Function:		GetFrameStatistics
 //
-// Description:		Returns a string describing any openGL errors.
+// Description:		Returns the statistics for the most recent frame whose
+//					results are complete.
 //
 // Input Arguments:
 //		None
@@ -1237,109 +2662,108 @@ void RenderWindow::AutoSetFrustum()
 //		None
 //
 // Return Value:
-//		wxString containing the error description
+//		FrameStatistics
 //
 //=============================================================================
-wxString RenderWindow::GetGLError()
+FrameStatistics RenderWindow::GetFrameStatistics() const
 {
-	int e = glGetError();
-
-	return GetGLError(e);
+	if (!mRenderStatistics)
+		return FrameStatistics();
+	return mRenderStatistics->GetFrameStatistics();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		GetGLError
+// Function:		RequestImage
 //
-// Description:		Returns a string describing any openGL errors.
+// Description:		Requests an image of the next rendered frame.  The pixels
+//					are read back asynchronously and the callback is made
+//					(from the main thread) once they are available.
 //
 // Input Arguments:
-//		e	= const GLint&
+//		callback	= const ImageCallback&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		wxString containing the error description
+//		None
 //
 //=============================================================================
-wxString RenderWindow::GetGLError(const GLint& e)
+void RenderWindow::RequestImage(const ImageCallback& callback)
 {
-	if (e == GL_NO_ERROR)
-		return _T("No errors");
-	else if (e == GL_INVALID_ENUM)
-		return _T("Invalid enumeration");
-	else if (e == GL_INVALID_VALUE)
-		return _T("Invalid value");
-	else if (e == GL_INVALID_OPERATION)
-		return _T("Invalid operation");
-	else if (e == GL_STACK_OVERFLOW)
-		return _T("Stack overflow");
-	else if (e == GL_STACK_UNDERFLOW)
-		return _T("Stack underflow");
-	else if (e == GL_OUT_OF_MEMORY)
-		return _T("Out of memory");
+	assert(!mHeadless && "Headless windows are never drawn on screen");
+	// When rendering is threaded, requests are passed to the render thread
+	// with the next frame
+	if (mRenderThread)
+		mImageRequests.push_back(callback);
+	else
+	{
+		if (!mReadbackQueue)
+			mReadbackQueue = std::make_unique<ReadbackQueue>();
+		mReadbackQueue->Request(callback);
+	}
 
-	return _T("Unrecognized error");
+	Refresh();
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		WriteImageToFile
+// Function:		CompleteReadbacks
 //
-// Description:		Writes the contents of the render window to file.  Various
-//					different file types are supported, specified by the file
-//					extension.
+// Description:		Completes any asynchronous readbacks whose pixels are
+//					available and passes the images to the callbacks.  Does
+//					not block.
 //
 // Input Arguments:
-//		pathAndFileName	= wxString specifying the location to save the image to
+//		None
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		bool, indicating success (true) or failure (false)
+//		None
 //
 //=============================================================================
-bool RenderWindow::WriteImageToFile(wxString pathAndFileName) const
+void RenderWindow::CompleteReadbacks()
 {
-	wxImage newImage(GetImage());
-	wxInitAllImageHandlers();
-	return newImage.SaveFile(pathAndFileName);
+	std::vector<ReadbackQueue::CompletedImage> completedImages;
+	ExecuteWithContext([this, &completedImages]()
+	{
+		mReadbackQueue->Complete(completedImages);
+	});
+
+	ReadbackQueue::Deliver(completedImages);
 }
 
 //=============================================================================
 // Class:			RenderWindow
-// Function:		GetImage
+// Function:		OnReadbackTimer
 //
-// Description:		Returns an image object representing the contents of the
-//					window.
+// Description:		Handles timer events for polling asynchronous readbacks.
+//					Polling stops once all of the transfers are complete.
 //
 // Input Arguments:
-//		None
+//		event	= wxTimerEvent& (unused)
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		wxImage
+//		None
 //
 //=============================================================================
-wxImage RenderWindow::GetImage() const
+void RenderWindow::OnReadbackTimer(wxTimerEvent& WXUNUSED(event))
 {
-	unsigned int height = GetSize().GetHeight();
-	unsigned int width = GetSize().GetWidth();
-
-	GLubyte *imageBuffer = (GLubyte*)malloc(width * height * sizeof(GLubyte) * 3);
-	glPixelStorei(GL_PACK_ALIGNMENT, 1);
-	glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, imageBuffer);
-
-	wxImage newImage(width, height, imageBuffer, true);
-	newImage = newImage.Mirror(false);
+	// While a frame is being drawn, the queue belongs to the render thread
+	if (mFrameInProgress)
+		return;
 
-	free(imageBuffer);
+	if (mReadbackQueue && mReadbackQueue->IsBusy() && mContext)
+		CompleteReadbacks();
 
-	return newImage;
+	if (!mReadbackQueue || !mReadbackQueue->IsBusy() || !mContext)
+		mReadbackTimer.Stop();
 }
 
 //=============================================================================
@@ -1555,8 +2979,8 @@ Eigen::Matrix4d RenderWindow::Generate2DProjectionMatrix() const
 {
 	// Set up an orthogonal 2D projection matrix (this puts (0,0) at the lower left-hand corner of the window)
 	Eigen::Matrix4d projectionMatrix(Eigen::Matrix4d::Zero());
-	projectionMatrix(0, 0) = 2.0 / GetSize().GetWidth();
-	projectionMatrix(1, 1) = 2.0 / GetSize().GetHeight();
+	projectionMatrix(0, 0) = 2.0 / GetRenderSize().GetWidth();
+	projectionMatrix(1, 1) = 2.0 / GetRenderSize().GetHeight();
 	projectionMatrix(2, 2) = -2.0;
 	projectionMatrix(0, 3) = -1.0;
 	projectionMatrix(1, 3) = -1.0;
@@ -1838,6 +3262,7 @@ GLuint RenderWindow::CreateShader(const GLenum& type, const std::string& shaderC
 //
 // Input Arguments:
 //		shaderList	= const std::vector<GLuint>&
+//		retrievable	= const bool&
 //
 // Output Arguments:
 //		None
@@ -1846,12 +3271,16 @@ GLuint RenderWindow::CreateShader(const GLenum& type, const std::string& shaderC
 //		GLuint specifying the index of the program
 //
 //=============================================================================
-GLuint RenderWindow::CreateProgram(const std::vector<GLuint>& shaderList)
+GLuint RenderWindow::CreateProgram(const std::vector<GLuint>& shaderList,
+	const bool& retrievable)
 {
 	GLuint program = glCreateProgram();
 	for (const auto& shader : shaderList)
 		glAttachShader(program, shader);
 
+	if (retrievable)
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	glLinkProgram(program);
 	GLint status;
 	glGetProgramiv(program, GL_LINK_STATUS, &status);
@@ -1877,6 +3306,95 @@ GLuint RenderWindow::CreateProgram(const std::vector<GLuint>& shaderList)
 	return program;
 }
 
+//=============================================================================
+// Class:			RenderWindow
+// Function:		BuildProgram
+//
+// Description:		Compiles the specified shaders and creates a program using
+//					them, or loads the program from the group's cache.
+//
+// Input Arguments:
+//		shaders	= const std::vector<std::pair<GLenum, std::string>>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint specifying the index of the program
+//
+//=============================================================================
+GLuint RenderWindow::BuildProgram(
+	const std::vector<std::pair<GLenum, std::string>>& shaders)
+{
+	const bool useCache(mContextGroup && mContextGroup->UsesProgramCache());
+	std::uint64_t key(0);
+	if (useCache)
+	{
+		key = ContextGroup::ComputeProgramKey(shaders);
+		const GLuint program(mContextGroup->LoadProgram(key));
+		if (program != 0)
+			return program;
+	}
+
+	std::vector<GLuint> shaderList;
+	for (const auto& shader : shaders)
+		shaderList.push_back(CreateShader(shader.first, shader.second));
+
+	const GLuint program(CreateProgram(shaderList, useCache));
+	if (useCache)
+		mContextGroup->StoreProgram(key, program);
+
+	return program;
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		FindSharedProgram
+//
+// Description:		Looks up a program built by another window in this
+//					window's context group.
+//
+// Input Arguments:
+//		name	= const std::string&
+//
+// Output Arguments:
+//		shader	= ShaderInfo&
+//
+// Return Value:
+//		bool, true if the program was found
+//
+//=============================================================================
+bool RenderWindow::FindSharedProgram(const std::string& name,
+	ShaderInfo& shader) const
+{
+	return mContextGroup && mContextGroup->FindProgram(name, shader);
+}
+
+//=============================================================================
+// Class:			RenderWindow
+// Function:		ShareProgram
+//
+// Description:		Makes the specified program available to the other
+//					windows in this window's context group (if any).
+//
+// Input Arguments:
+//		name	= const std::string&
+//		shader	= const ShaderInfo&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void RenderWindow::ShareProgram(const std::string& name,
+	const ShaderInfo& shader)
+{
+	if (mContextGroup)
+		mContextGroup->AddProgram(name, shader);
+}
+
 //=============================================================================
 // Class:			RenderWindow
 // Function:		BuildShaders
@@ -1896,17 +3414,26 @@ GLuint RenderWindow::CreateProgram(const std::vector<GLuint>& shaderList)
 //=============================================================================
 void RenderWindow::BuildShaders()
 {
-	std::vector<GLuint> shaderList;
-	shaderList.push_back(CreateDefaultVertexShader());
-	shaderList.push_back(CreateDefaultFragmentShader());
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, GetDefaultVertexShader()));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, GetDefaultFragmentShader()));
 
 	if (HasGeometryShader())
-		shaderList.push_back(CreateDefaultGeometryShader());
+		shaders.push_back(std::make_pair(GL_GEOMETRY_SHADER, GetDefaultGeometryShader()));
+
+	// Derived classes may replace the default shaders, so the shared program
+	// is identified by its sources
+	const std::string name(std::to_string(
+		ContextGroup::ComputeProgramKey(shaders)));
 
 	ShaderInfo s;
-	s.programId = CreateProgram(shaderList);
+	if (!FindSharedProgram(name, s))
+	{
+		s.programId = BuildProgram(shaders);
+		AssignDefaultLocations(s);
+		ShareProgram(name, s);
+	}
 
-	AssignDefaultLocations(s);
 	AddShader(s);
 }
 
@@ -2206,6 +3733,8 @@ bool RenderWindow::GLHasError()
 //=============================================================================
 void RenderWindow::MakeCurrent()
 {
+	assert((!mRenderThread || IsRenderThread()) &&
+		"Context belongs to the render thread");
 	SetCurrent(*GetContext());
 }
 
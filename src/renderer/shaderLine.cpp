@@ -0,0 +1,488 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  shaderLine.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Object representing a line, drawn with triangles faded from line
+//        color to transparent, where the triangles are generated on the GPU
+//        from the raw line points.
+
+// GLEW headers
+#include <GL/glew.h>
+
+// Local headers
+#include "lp2d/renderer/shaderLine.h"
+#include "lp2d/renderer/renderWindow.h"
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for ShaderLine class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const double ShaderLine::mFadeDistance(0.05);
+
+const std::string ShaderLine::mHalfWidthName("halfWidth");
+const std::string ShaderLine::mFadeDistanceName("fadeDistance");
+const std::string ShaderLine::mLineColorName("lineColor");
+
+const GLuint ShaderLine::mPriorLocation(0);
+const GLuint ShaderLine::mStartLocation(1);
+const GLuint ShaderLine::mEndLocation(2);
+const GLuint ShaderLine::mNextLocation(3);
+
+const unsigned int ShaderLine::mVerticesPerSegment(8);
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		mVertexShader
+//
+// Description:		Line vertex shader.  Each instance is one line segment,
+//					drawn as a triangle strip of eight vertices.  The vertices
+//					alternate between the start and end of the segment and
+//					move across the line from one faded edge to the other:
+//
+//					0+----+1   faded edge (+)
+//					 |   /|
+//					2+----+3   line (+)
+//					 |   /|    __> Direction of segment
+//					4+----+5   line (-)
+//					 |   /|
+//					6+----+7   faded edge (-)
+//
+//					Offsets are computed in pixels, so the modelview matrix
+//					must take line points to pixels.
+//
+// Input Arguments:
+//		0	= priorPoint
+//		1	= startPoint
+//		2	= endPoint
+//		3	= nextPoint
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string ShaderLine::mVertexShader(
+	"#version 400\n"
+	"\n"
+	"uniform mat4 projectionMatrix;\n"
+	"uniform mat4 modelviewMatrix;\n"
+	"uniform float halfWidth;\n"
+	"uniform float fadeDistance;\n"
+	"uniform vec4 lineColor;\n"
+	"\n"
+	"layout(location = 0) in vec2 priorPoint;\n"
+	"layout(location = 1) in vec2 startPoint;\n"
+	"layout(location = 2) in vec2 endPoint;\n"
+	"layout(location = 3) in vec2 nextPoint;\n"
+	"\n"
+	"out vec4 vertexColor;\n"
+	"\n"
+	"vec2 ToPixels(vec2 p)\n"
+	"{\n"
+	"    return (modelviewMatrix * vec4(p, 0.0, 1.0)).xy;\n"
+	"}\n"
+	"\n"
+	"vec2 Direction(vec2 from, vec2 to)\n"
+	"{\n"
+	"    vec2 d = to - from;\n"
+	"    float l = length(d);\n"
+	"    return l > 0.0 ? d / l : vec2(0.0);\n"
+	"}\n"
+	"\n"
+	"// Returns the direction in which to offset the vertices, scaled to\n"
+	"// maintain the line width through the join\n"
+	"vec2 MiterOffset(vec2 dirPrior, vec2 dirNext)\n"
+	"{\n"
+	"    if (dirPrior == vec2(0.0))\n"
+	"        dirPrior = dirNext;\n"
+	"    if (dirNext == vec2(0.0))\n"
+	"        dirNext = dirPrior;\n"
+	"    if (dirPrior == vec2(0.0))\n"
+	"        return vec2(0.0, 1.0);\n"
+	"\n"
+	"    vec2 bisector = dirPrior + dirNext;\n"
+	"    float bisectorLength = length(bisector);\n"
+	"    if (bisectorLength < 1.0e-6)\n"
+	"        return dirPrior;// Line doubles back on itself\n"
+	"\n"
+	"    bisector /= bisectorLength;\n"
+	"    return vec2(-bisector.y, bisector.x) * 2.0 / bisectorLength;\n"
+	"}\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    bool atEnd = (gl_VertexID & 1) == 1;\n"
+	"    int level = gl_VertexID >> 1;\n"
+	"\n"
+	"    vec2 start = ToPixels(startPoint);\n"
+	"    vec2 end = ToPixels(endPoint);\n"
+	"    vec2 segmentDirection = Direction(start, end);\n"
+	"\n"
+	"    vec2 point;\n"
+	"    vec2 offset;\n"
+	"    if (atEnd)\n"
+	"    {\n"
+	"        point = end;\n"
+	"        offset = MiterOffset(segmentDirection, Direction(end, ToPixels(nextPoint)));\n"
+	"    }\n"
+	"    else\n"
+	"    {\n"
+	"        point = start;\n"
+	"        offset = MiterOffset(Direction(ToPixels(priorPoint), start), segmentDirection);\n"
+	"    }\n"
+	"\n"
+	"    bool isEdge = level == 0 || level == 3;\n"
+	"    float side = level < 2 ? 1.0 : -1.0;\n"
+	"    float distance = isEdge ? halfWidth + fadeDistance : halfWidth;\n"
+	"\n"
+	"    gl_Position = projectionMatrix * vec4(point + side * distance * offset, 0.0, 1.0);\n"
+	"    vertexColor = isEdge ? vec4(lineColor.rgb, 0.0) : lineColor;\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		mFragmentShader
+//
+// Description:		Line fragment shader.
+//
+// Input Arguments:
+//		0	= vertexColor
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const std::string ShaderLine::mFragmentShader(
+	"#version 400\n"
+	"\n"
+	"in vec4 vertexColor;\n"
+	"\n"
+	"out vec4 outputColor;\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"    outputColor = vertexColor;\n"
+	"}\n"
+);
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		ShaderLine
+//
+// Description:		Constructor for ShaderLine class.
+//
+// Input Arguments:
+//		renderWindow	= RenderWindow&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+ShaderLine::ShaderLine(RenderWindow& renderWindow)
+	: mRenderWindow(renderWindow), mHint(GL_DYNAMIC_DRAW)
+{
+	SetWidth(1.0);
+}
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		Build
+//
+// Description:		Fills the vertex buffer with the line points.  The first
+//					and last points are duplicated so every segment has a
+//					prior and a next point.
+//
+// Input Arguments:
+//		x		= const std::vector<double>&
+//		y		= const std::vector<double>&
+//		update	= const Line::UpdateMethod&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ShaderLine::Build(const std::vector<double>& x,
+	const std::vector<double>& y, Primitive::BufferInfo& bufferInfo,
+	const Line::UpdateMethod& update)
+{
+	assert(x.size() == y.size());
+
+	bufferInfo.indexBuffer.clear();
+	if (x.size() < 2)
+	{
+		bufferInfo.vertexCount = 0;
+		return;
+	}
+
+	bufferInfo.vertexCount = x.size() + 2;
+	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * 2);
+	bufferInfo.vertexCountModified = false;
+
+	bufferInfo.vertexBuffer[0] = static_cast<float>(x.front());
+	bufferInfo.vertexBuffer[1] = static_cast<float>(y.front());
+
+	unsigned int i;
+	for (i = 0; i < x.size(); ++i)
+	{
+		bufferInfo.vertexBuffer[2 * i + 2] = static_cast<float>(x[i]);
+		bufferInfo.vertexBuffer[2 * i + 3] = static_cast<float>(y[i]);
+	}
+
+	bufferInfo.vertexBuffer[2 * i + 2] = static_cast<float>(x.back());
+	bufferInfo.vertexBuffer[2 * i + 3] = static_cast<float>(y.back());
+
+	if (update == Line::UpdateMethod::Immediate)
+		Upload(bufferInfo);
+}
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		Append
+//
+// Description:		Adds points to the end of a line previously created with
+//					Build(), optionally replacing some of the existing points.
+//					The duplicated last point is overwritten, so only the new
+//					points (and the new duplicate) need to be sent to OpenGL.
+//					The buffer is marked as streaming, so its storage grows
+//					geometrically.
+//
+// Input Arguments:
+//		x				= const std::vector<double>&
+//		y				= const std::vector<double>&
+//		replacedPoints	= const unsigned int&
+//		update			= const Line::UpdateMethod&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		std::vector<float>::size_type, index of the first element of the
+//		vertex buffer which was modified
+//
+//=============================================================================
+std::vector<float>::size_type ShaderLine::Append(const std::vector<double>& x,
+	const std::vector<double>& y, const unsigned int& replacedPoints,
+	Primitive::BufferInfo& bufferInfo, const Line::UpdateMethod& update)
+{
+	assert(x.size() == y.size());
+
+	bufferInfo.SetStreaming(true);
+	if (bufferInfo.vertexCount == 0 ||
+		replacedPoints + 2 >= bufferInfo.vertexCount)
+	{
+		// None of the existing points are retained
+		Build(x, y, bufferInfo, update);
+		return 0;
+	}
+
+	if (x.empty() && replacedPoints == 0)
+		return bufferInfo.vertexBuffer.size();
+
+	bufferInfo.vertexCount -= replacedPoints;
+	if (x.empty())
+	{
+		// The new last point must be duplicated
+		const std::vector<float>::size_type last((bufferInfo.vertexCount - 2) * 2);
+		bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * 2);
+		bufferInfo.vertexBuffer[last + 2] = bufferInfo.vertexBuffer[last];
+		bufferInfo.vertexBuffer[last + 3] = bufferInfo.vertexBuffer[last + 1];
+
+		if (update == Line::UpdateMethod::Immediate)
+			Upload(bufferInfo, last + 2);
+
+		return last + 2;
+	}
+
+	const std::vector<float>::size_type first((bufferInfo.vertexCount - 1) * 2);
+	bufferInfo.vertexCount += x.size();
+	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * 2);
+
+	unsigned int i;
+	for (i = 0; i < x.size(); ++i)
+	{
+		bufferInfo.vertexBuffer[first + 2 * i] = static_cast<float>(x[i]);
+		bufferInfo.vertexBuffer[first + 2 * i + 1] = static_cast<float>(y[i]);
+	}
+
+	bufferInfo.vertexBuffer[first + 2 * i] = static_cast<float>(x.back());
+	bufferInfo.vertexBuffer[first + 2 * i + 1] = static_cast<float>(y.back());
+
+	if (update == Line::UpdateMethod::Immediate)
+		Upload(bufferInfo, first);
+
+	return first;
+}
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		Upload
+//
+// Description:		Sends the line points to OpenGL and configures the vertex
+//					array.
+//
+// Input Arguments:
+//		first	= const std::vector<float>::size_type&
+//
+// Output Arguments:
+//		bufferInfo	= Primitive::BufferInfo&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ShaderLine::Upload(Primitive::BufferInfo& bufferInfo,
+	const std::vector<float>::size_type& first)
+{
+	if (bufferInfo.vertexCount == 0)
+		return;
+
+	mRenderWindow.InitializePrimitiveType(*this);
+	bufferInfo.GetOpenGLIndices();
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+
+	bufferInfo.BufferVertexData(mHint, first);
+
+	// Each attribute views the same buffer, shifted by one point, and advances
+	// by one point per instance
+	const GLuint locations[] = { mPriorLocation, mStartLocation, mEndLocation,
+		mNextLocation };
+	unsigned int i;
+	for (i = 0; i < 4; ++i)
+	{
+		glEnableVertexAttribArray(locations[i]);
+		glVertexAttribPointer(locations[i], 2, GL_FLOAT, GL_FALSE,
+			2 * sizeof(GLfloat), (void*)(2 * sizeof(GLfloat) * i));
+		glVertexAttribDivisor(locations[i], 1);
+	}
+
+	glBindVertexArray(0);
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		Draw
+//
+// Description:		Renders the line.
+//
+// Input Arguments:
+//		bufferInfo	= const Primitive::BufferInfo&
+//		modelview	= const Eigen::Matrix4d&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ShaderLine::Draw(const Primitive::BufferInfo& bufferInfo,
+	const Eigen::Matrix4d& modelview)
+{
+	if (bufferInfo.vertexCount < 4)
+		return;
+
+	mRenderWindow.UseProgram(mRenderWindow.GetPrimitiveTypeProgram<ShaderLine>());
+	const auto& uniforms(mRenderWindow.GetActiveProgramInfo().uniformLocations);
+
+	RenderWindow::SendUniformMatrix(modelview,
+		uniforms.find(RenderWindow::mModelviewName)->second);
+	glUniform1f(uniforms.find(mHalfWidthName)->second,
+		static_cast<GLfloat>(mHalfWidth));
+	glUniform1f(uniforms.find(mFadeDistanceName)->second,
+		static_cast<GLfloat>(mFadeDistance));
+	glUniform4f(uniforms.find(mLineColorName)->second,
+		static_cast<GLfloat>(mLineColor.GetRed()),
+		static_cast<GLfloat>(mLineColor.GetGreen()),
+		static_cast<GLfloat>(mLineColor.GetBlue()),
+		static_cast<GLfloat>(mLineColor.GetAlpha()));
+
+	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, mVerticesPerSegment,
+		bufferInfo.vertexCount - 3);
+	glBindVertexArray(0);
+
+	mRenderWindow.UseDefaultProgram();
+
+	assert(!RenderWindow::GLHasError());
+}
+
+//=============================================================================
+// Class:			ShaderLine
+// Function:		DoGLInitialization
+//
+// Description:		Performs necessary context-state initialization.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint
+//
+//=============================================================================
+GLuint ShaderLine::DoGLInitialization()
+{
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mFragmentShader));
+
+	RenderWindow::ShaderInfo s;
+	s.programId = mRenderWindow.BuildProgram(shaders);
+	s.needsModelview = false;
+	s.needsProjection = true;
+	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
+	s.uniformLocations[RenderWindow::mModelviewName] = glGetUniformLocation(s.programId, RenderWindow::mModelviewName.c_str());
+	s.uniformLocations[mHalfWidthName] = glGetUniformLocation(s.programId, mHalfWidthName.c_str());
+	s.uniformLocations[mFadeDistanceName] = glGetUniformLocation(s.programId, mFadeDistanceName.c_str());
+	s.uniformLocations[mLineColorName] = glGetUniformLocation(s.programId, mLineColorName.c_str());
+
+	assert(!RenderWindow::GLHasError());
+
+	s.attributeLocations["priorPoint"] = mPriorLocation;
+	s.attributeLocations["startPoint"] = mStartLocation;
+	s.attributeLocations["endPoint"] = mEndLocation;
+	s.attributeLocations["nextPoint"] = mNextLocation;
+
+	return mRenderWindow.AddShader(s);
+}
+
+}// namespace LibPlot2D
@@ -22,9 +22,6 @@
 #include "lp2d/renderer/text.h"
 #include "lp2d/renderer/renderWindow.h"
 
-// Freetype headers
-#include FT_MODULE_H
-
 namespace LibPlot2D
 {
 
@@ -46,8 +43,8 @@ namespace LibPlot2D
 //=============================================================================
 GLint Text::mVertexLocation;
 GLint Text::mIndexLocation;
-FT_Library Text::mFt;
-unsigned int Text::mFtReferenceCount(0);
+std::map<Text::TextureKey, Text::GlyphTexture> Text::mGlyphTextures;
+std::mutex Text::mGlyphTextureMutex;
 
 const std::string Text::mTextColorName("textColor");
 const std::string Text::mVertexName("vertex");
@@ -94,7 +91,8 @@ const std::string Text::mVertexShader(
 // Class:			Text
 // Function:		mFragmentShader
 //
-// Description:		Text fragment shader.
+// Description:		Text fragment shader.  Texture coordinates are in pixels,
+//					so buffers remain valid when the texture is resized.
 //
 // Input Arguments:
 //		0	= texCoords
@@ -119,7 +117,8 @@ const std::string Text::mFragmentShader(
 	"\n"
 	"void main()\n"
 	"{\n"
-	"    highp vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, vec3(texCoords, index)).r);\n"
+	"    vec2 textureScale = 1.0 / vec2(textureSize(text, 0).xy);\n"
+	"    highp vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, vec3(texCoords * textureScale, index)).r);\n"
 	"    color = vec4(textColor, 1.0) * sampled;\n"
 	"}\n"
 );
@@ -143,7 +142,6 @@ const std::string Text::mFragmentShader(
 Text::Text(RenderWindow& renderer) : mRenderer(renderer)
 {
 	SetOrientation(0.0);
-	Initialize();
 }
 
 //=============================================================================
@@ -164,52 +162,45 @@ Text::Text(RenderWindow& renderer) : mRenderer(renderer)
 //=============================================================================
 Text::~Text()
 {
-	FreeFTResources();
-
-	if (glIsTexture(mTextureId))
-		glDeleteTextures(1, &mTextureId);
+	ReleaseGlyphTexture();
 }
 
 //=============================================================================
 // Class:			Text
-// Function:		Initialize
+// Function:		SetFace
 //
-// Description:		Initializes the Freetype back-end of this object.  Must
-//					be called prior to any other post-creation method.
+// Description:		Sets the font file to use for generating glyphs.
 //
 // Input Arguments:
-//		None
+//		fontFileName	= const std::string&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		bool, true if the font file can be loaded
 //
 //=============================================================================
-void Text::Initialize()
+bool Text::SetFace(const std::string& fontFileName)
 {
-	assert(!mGlyphsGenerated);
-	assert(mIsOK);
+	if (!GlyphCache::FaceIsValid(fontFileName))
+		return false;
 
-	if (mFtReferenceCount == 0)
-	{
-		if (FT_Init_FreeType(&mFt))
-			mIsOK = false;
-	}
+	mFontFileName = fontFileName;
+	AcquireGlyphs();
 
-	++mFtReferenceCount;
+	return true;
 }
 
 //=============================================================================
 // Class:			Text
-// Function:		SetFace
+// Function:		SetSize
 //
-// Description:		Initializes the Freetype back-end of this object.  Must
-//					be called prior to any other post-creation method.
+// Description:		Sets the width and height to use for the font.  Width is
+//					calculated to maintain proper aspect ratio.
 //
 // Input Arguments:
-//		None
+//		height	= const double&
 //
 // Output Arguments:
 //		None
@@ -218,23 +209,19 @@ void Text::Initialize()
 //		None
 //
 //=============================================================================
-bool Text::SetFace(const std::string& fontFileName)
+void Text::SetSize(const double& height)
 {
-	assert(!mGlyphsGenerated);
-	if (FT_New_Face(mFt, fontFileName.c_str(), 0, &mFace))
-		return false;
-
-	return true;
+	SetSize(0, height);
 }
 
 //=============================================================================
 // Class:			Text
 // Function:		SetSize
 //
-// Description:		Sets the width and height to use for the font.  Width is
-//					calculated to maintain proper aspect ratio.
+// Description:		Sets the width and height to use for the font.
 //
 // Input Arguments:
+//		width	= const double&
 //		height	= const double&
 //
 // Output Arguments:
@@ -244,20 +231,23 @@ bool Text::SetFace(const std::string& fontFileName)
 //		None
 //
 //=============================================================================
-void Text::SetSize(const double& height)
+void Text::SetSize(const double& width, const double& height)
 {
-	SetSize(0, height);
+	mWidth = static_cast<unsigned int>(width);
+	mHeight = static_cast<unsigned int>(height);
+	AcquireGlyphs();
 }
 
 //=============================================================================
 // Class:			Text
-// Function:		SetSize
+// Function:		AcquireGlyphs
 //
-// Description:		Sets the width and height to use for the font.
+// Description:		Obtains the glyph cache for the current font and size and
+//					registers this object as a user of the corresponding glyph
+//					texture.
 //
 // Input Arguments:
-//		width	= const double&
-//		height	= const double&
+//		None
 //
 // Output Arguments:
 //		None
@@ -266,17 +256,33 @@ void Text::SetSize(const double& height)
 //		None
 //
 //=============================================================================
-void Text::SetSize(const double& width, const double& height)
+void Text::AcquireGlyphs()
 {
-	assert(!mGlyphsGenerated);
-	FT_Set_Pixel_Sizes(mFace, width, height);
+	if (mFontFileName.empty() || mHeight == 0)
+		return;
+
+	std::shared_ptr<GlyphCache> glyphCache(
+		GlyphCache::Get(mFontFileName, mWidth, mHeight));
+	if (glyphCache == mGlyphCache)
+		return;
+
+	ReleaseGlyphTexture();
+	mGlyphCache = glyphCache;
+
+	if (mGlyphCache)
+	{
+		std::lock_guard<std::mutex> lock(mGlyphTextureMutex);
+		++mGlyphTextures[TextureKey(mRenderer.GetSharingKey(), mGlyphCache.get())].referenceCount;
+	}
 }
 
 //=============================================================================
 // Class:			Text
-// Function:		GenerateGlyphs
+// Function:		ReleaseGlyphTexture
 //
-// Description:		Generates the set of glyphs.
+// Description:		Releases this object's reference to the glyph texture
+//					(and to the glyph cache), deleting the texture if it is no
+//					longer in use.
 //
 // Input Arguments:
 //		None
@@ -285,105 +291,201 @@ void Text::SetSize(const double& width, const double& height)
 //		None
 //
 // Return Value:
-//		bool, true for success, false otherwise
+//		None
 //
 //=============================================================================
-bool Text::GenerateGlyphs()
+void Text::ReleaseGlyphTexture()
 {
-	assert(!RenderWindow::GLHasError());
-	assert(!mGlyphsGenerated);// Doing this twice could leak memory via OpenGL
+	if (!mGlyphCache)
+		return;
 
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-	Glyph g;
-	GLubyte c;
+	GLuint textureId(0);
 
-	mMaxXSize = 0;
-	mMaxYSize = 0;
+	{
+		std::lock_guard<std::mutex> lock(mGlyphTextureMutex);
+		const auto it(mGlyphTextures.find(TextureKey(mRenderer.GetSharingKey(), mGlyphCache.get())));
+		assert(it != mGlyphTextures.end());
+		assert(it->second.referenceCount > 0);
+		if (--it->second.referenceCount == 0)
+		{
+			textureId = it->second.textureId;
+			mGlyphTextures.erase(it);
+		}
+	}
 
-	if (FT_Select_Charmap(mFace, FT_ENCODING_UNICODE))
-		return false;
+	mGlyphCache.reset();
+	if (textureId == 0)
+		return;
 
-	// First loop determines max required image size
-	const unsigned int glyphCount(128);
-	for (c = 0; c < glyphCount; ++c)
+	const auto deleteTexture([textureId]()
 	{
-		if (FT_Load_Char(mFace, c, FT_LOAD_RENDER))
-			return false;
+		if (glIsTexture(textureId))
+			glDeleteTextures(1, &textureId);
+	});
+
+	// When the window renders on its own thread, the context is only current
+	// there (i.e. if the font was changed from the main thread)
+	if (mRenderer.GetThreadedRendering() && !mRenderer.IsRenderThread())
+		mRenderer.ExecuteWithContext(deleteTexture);
+	else
+		deleteTexture();
+}
 
-		mMaxXSize = std::max(mMaxXSize, mFace->glyph->bitmap.width);
-		mMaxYSize = std::max(mMaxYSize, mFace->glyph->bitmap.rows);
-	}
+//=============================================================================
+// Class:			Text
+// Function:		UpdateGlyphTexture
+//
+// Description:		Ensures that all glyphs in the cache have been sent to the
+//					shared glyph texture.  Only glyphs which were added to the
+//					cache since the last update are sent, unless the texture
+//					must grow (in which case all glyphs are sent again).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GLuint, texture id
+//
+//=============================================================================
+GLuint Text::UpdateGlyphTexture()
+{
+	assert(mGlyphCache);
+	assert(!RenderWindow::GLHasError());
+
+	std::lock_guard<std::mutex> lock(mGlyphTextureMutex);
+	GlyphTexture& texture(mGlyphTextures[TextureKey(mRenderer.GetSharingKey(), mGlyphCache.get())]);
+	const unsigned int glyphCount(mGlyphCache->GetGlyphCount());
+	if (texture.textureId != 0 && texture.glyphCount == glyphCount)
+		return texture.textureId;
+
+	unsigned int xSize, ySize;
+	mGlyphCache->GetMaximumSize(xSize, ySize);
+	unsigned int first(texture.glyphCount);
 
-	glGenTextures(1, &mTextureId);
-	glBindTexture(GL_TEXTURE_2D_ARRAY, mTextureId);
+	if (texture.textureId == 0)
+	{
+		glGenTextures(1, &texture.textureId);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture.textureId);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+	}
+	else
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture.textureId);
 
-	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RED, mMaxXSize, mMaxYSize, glyphCount,
-		0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
+	if (glyphCount > texture.layerCapacity ||
+		xSize > texture.xSize || ySize > texture.ySize)
+	{
+		texture.layerCapacity = std::max(glyphCount, 2 * texture.layerCapacity);
+		texture.xSize = std::max(xSize, 1U);
+		texture.ySize = std::max(ySize, 1U);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RED, texture.xSize,
+			texture.ySize, texture.layerCapacity, 0, GL_RED, GL_UNSIGNED_BYTE,
+			nullptr);
+		first = 0;
+	}
 
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-	// Second loop actually builds and stores the textures
-	for (c = 0; c < glyphCount; ++c)
+	unsigned int i;
+	for (i = first; i < glyphCount; ++i)
 	{
-		if (FT_Load_Char(mFace, c, FT_LOAD_RENDER))
-			return false;
-
-		int w, h, d;
-		glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_WIDTH, &w);
-		glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_HEIGHT, &h);
-		glGetTexLevelParameteriv(GL_TEXTURE_2D_ARRAY, 0, GL_TEXTURE_DEPTH, &d);
-
-		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, c,
-			mFace->glyph->bitmap.width, mFace->glyph->bitmap.rows, 1,
-			GL_RED, GL_UNSIGNED_BYTE, mFace->glyph->bitmap.buffer);// TODO:  Memory leak here
-
-		g.index = c;
-		g.xSize = mFace->glyph->bitmap.width;
-		g.ySize = mFace->glyph->bitmap.rows;
-		g.xBearing = mFace->glyph->bitmap_left;
-		g.yBearing = mFace->glyph->bitmap_top;
-		g.advance = mFace->glyph->advance.x;
-
-		mGlyphs.insert(std::make_pair(c, g));
+		const GlyphCache::Glyph& g(mGlyphCache->GetGlyph(i));
+		if (g.xSize > 0 && g.ySize > 0)
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, g.xSize, g.ySize,
+				1, GL_RED, GL_UNSIGNED_BYTE, g.bitmap.data());
 	}
 
+	texture.glyphCount = glyphCount;
 	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-	mGlyphsGenerated = true;
 
 	assert(!RenderWindow::GLHasError());
-	return true;
+	return texture.textureId;
 }
 
 //=============================================================================
 // Class:			Text
-// Function:		FreeFTResources
+// Function:		DecodeUTF8
 //
-// Description:		Frees previously allocated Freetype resources (with
-//					reference counting).
+// Description:		Converts the specified UTF-8 string into Unicode code
+//					points.  Bytes which are not part of a valid UTF-8
+//					sequence are treated as Latin-1 characters.
 //
 // Input Arguments:
-//		None
+//		s	= const std::string&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		None
+//		std::u32string
 //
 //=============================================================================
-void Text::FreeFTResources()
+std::u32string Text::DecodeUTF8(const std::string& s)
 {
-	FT_Done_Face(mFace);
+	std::u32string codePoints;
+	codePoints.reserve(s.length());
+
+	std::string::size_type i(0);
+	while (i < s.length())
+	{
+		const unsigned char lead(static_cast<unsigned char>(s[i]));
+		unsigned int length(0);
+		char32_t c(0);
+		if (lead < 0x80)
+		{
+			length = 1;
+			c = lead;
+		}
+		else if ((lead & 0xE0) == 0xC0)
+		{
+			length = 2;
+			c = lead & 0x1F;
+		}
+		else if ((lead & 0xF0) == 0xE0)
+		{
+			length = 3;
+			c = lead & 0x0F;
+		}
+		else if ((lead & 0xF8) == 0xF0)
+		{
+			length = 4;
+			c = lead & 0x07;
+		}
+
+		unsigned int j;
+		for (j = 1; j < length; ++j)
+		{
+			if (i + j >= s.length() ||
+				(static_cast<unsigned char>(s[i + j]) & 0xC0) != 0x80)
+			{
+				length = 0;
+				break;
+			}
+
+			c = (c << 6) | (static_cast<unsigned char>(s[i + j]) & 0x3F);
+		}
+
+		if (length == 0)
+		{
+			codePoints.push_back(lead);
+			++i;
+		}
+		else
+		{
+			codePoints.push_back(c);
+			i += length;
+		}
+	}
 
-	assert(mFtReferenceCount > 0);
-	--mFtReferenceCount;
-	if (mFtReferenceCount == 0)
-		FT_Done_FreeType(mFt);
+	return codePoints;
 }
 
 //=============================================================================
@@ -443,7 +545,7 @@ void Text::RenderBufferedGlyph(const unsigned int& vertexCount)
 	RenderWindow::SendUniformMatrix(mModelview, mRenderer.GetActiveProgramInfo().uniformLocations.find(RenderWindow::mModelviewName)->second);
 
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D_ARRAY, mTextureId);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, UpdateGlyphTexture());
 
 	glDrawArrays(GL_TRIANGLES, 0, vertexCount);
 
@@ -472,22 +574,22 @@ void Text::RenderBufferedGlyph(const unsigned int& vertexCount)
 //=============================================================================
 Text::BoundingBox Text::GetBoundingBox(const std::string& s)
 {
-	DoInternalInitialization();
-	mRenderer.InitializePrimitiveType(*this);
-
 	BoundingBox b;
 	b.xLeft = 0;
 	b.xRight = 0;
 	b.yUp = 0;
 	b.yDown = 0;
 
-	for (const auto& c : s)
+	if (!mGlyphCache)
+		return b;
+
+	for (const auto& c : DecodeUTF8(s))
 	{
-		const auto glyphIt(mGlyphs.find(c));
-		if (glyphIt == mGlyphs.end())
+		unsigned int index;
+		if (!mGlyphCache->GetGlyphIndex(c, index))
 			continue;
 
-		Glyph g = glyphIt->second;
+		const GlyphCache::Glyph& g(mGlyphCache->GetGlyph(index));
 
 		//b.xLeft += 0;
 		b.xRight += g.advance >> 6;
@@ -503,31 +605,6 @@ Text::BoundingBox Text::GetBoundingBox(const std::string& s)
 	return b;
 }
 
-//=============================================================================
-// Class:			Text
-// Function:		DoInternalInitialization
-//
-// Description:		Performs necessary static-state initialization.
-//
-// Input Arguments:
-//		None
-//
-// Output Arguments:
-//		None
-//
-// Return Value:
-//		None
-//
-//=============================================================================
-void Text::DoInternalInitialization()
-{
-	if (!mGlyphsGenerated)
-	{
-		if (!GenerateGlyphs())
-			mIsOK = false;
-	}
-}
-
 //=============================================================================
 // Class:			Text
 // Function:		DoGLInitialization
@@ -546,12 +623,12 @@ void Text::DoInternalInitialization()
 //=============================================================================
 GLuint Text::DoGLInitialization()
 {
-	std::vector<GLuint> shaderList;
-	shaderList.push_back(mRenderer.CreateShader(GL_VERTEX_SHADER, mVertexShader));
-	shaderList.push_back(mRenderer.CreateShader(GL_FRAGMENT_SHADER, mFragmentShader));
+	std::vector<std::pair<GLenum, std::string>> shaders;
+	shaders.push_back(std::make_pair(GL_VERTEX_SHADER, mVertexShader));
+	shaders.push_back(std::make_pair(GL_FRAGMENT_SHADER, mFragmentShader));
 
 	RenderWindow::ShaderInfo s;
-	s.programId = mRenderer.CreateProgram(shaderList);
+	s.programId = mRenderer.BuildProgram(shaders);
 	s.needsModelview = false;
 	s.needsProjection = true;
 	s.uniformLocations[RenderWindow::mProjectionName] = glGetUniformLocation(s.programId, RenderWindow::mProjectionName.c_str());
@@ -676,23 +753,29 @@ Primitive::BufferInfo Text::AssembleBuffers()
 //=============================================================================
 Primitive::BufferInfo Text::BuildLocalText()
 {
-	DoInternalInitialization();
 	mRenderer.InitializePrimitiveType(*this);
 
 	assert(sizeof(GLfloat) == sizeof(float));
 	assert(sizeof(GLuint) == sizeof(unsigned int));
 
 	Primitive::BufferInfo bufferInfo;
-	bufferInfo.vertexCount = 6 * mText.length();
-	bufferInfo.vertexBuffer.resize(bufferInfo.vertexCount * 4);
-	bufferInfo.indexBuffer.resize(bufferInfo.vertexCount);
+	if (!mGlyphCache)
+		return bufferInfo;
+
+	const std::u32string codePoints(DecodeUTF8(mText));
+	bufferInfo.vertexBuffer.resize(6 * codePoints.length() * 4);
+	bufferInfo.indexBuffer.resize(6 * codePoints.length());
 
 	double xStart(mX);
 
 	unsigned int i(0), texI(0);
-	for (const auto &c : mText)
+	for (const auto &c : codePoints)
 	{
-		Glyph g = mGlyphs[c];
+		unsigned int index;
+		if (!mGlyphCache->GetGlyphIndex(c, index))
+			continue;
+
+		const GlyphCache::Glyph& g(mGlyphCache->GetGlyph(index));
 
 		GLfloat xpos = xStart + g.xBearing * mScale;
 		GLfloat ypos = mY - (g.ySize - g.yBearing) * mScale;
@@ -700,17 +783,17 @@ Primitive::BufferInfo Text::BuildLocalText()
 		GLfloat w = g.xSize * mScale;
 		GLfloat h = g.ySize * mScale;
 
-		bufferInfo.indexBuffer[texI++] = g.index;
-		bufferInfo.indexBuffer[texI++] = g.index;
-		bufferInfo.indexBuffer[texI++] = g.index;
-		bufferInfo.indexBuffer[texI++] = g.index;
-		bufferInfo.indexBuffer[texI++] = g.index;
-		bufferInfo.indexBuffer[texI++] = g.index;
+		bufferInfo.indexBuffer[texI++] = index;
+		bufferInfo.indexBuffer[texI++] = index;
+		bufferInfo.indexBuffer[texI++] = index;
+		bufferInfo.indexBuffer[texI++] = index;
+		bufferInfo.indexBuffer[texI++] = index;
+		bufferInfo.indexBuffer[texI++] = index;
 
 		bufferInfo.vertexBuffer[i++] = xpos;
 		bufferInfo.vertexBuffer[i++] = ypos;
 		bufferInfo.vertexBuffer[i++] = 0.0;
-		bufferInfo.vertexBuffer[i++] = float(g.ySize) / float(mMaxYSize);
+		bufferInfo.vertexBuffer[i++] = float(g.ySize);
 
 		bufferInfo.vertexBuffer[i++] = xpos;
 		bufferInfo.vertexBuffer[i++] = ypos + h;
@@ -719,27 +802,31 @@ Primitive::BufferInfo Text::BuildLocalText()
 
 		bufferInfo.vertexBuffer[i++] = xpos + w;
 		bufferInfo.vertexBuffer[i++] = ypos + h;
-		bufferInfo.vertexBuffer[i++] = float(g.xSize) / float(mMaxXSize);
+		bufferInfo.vertexBuffer[i++] = float(g.xSize);
 		bufferInfo.vertexBuffer[i++] = 0.0;
 
 		bufferInfo.vertexBuffer[i++] = xpos + w;
 		bufferInfo.vertexBuffer[i++] = ypos + h;
-		bufferInfo.vertexBuffer[i++] = float(g.xSize) / float(mMaxXSize);
+		bufferInfo.vertexBuffer[i++] = float(g.xSize);
 		bufferInfo.vertexBuffer[i++] = 0.0;
 
 		bufferInfo.vertexBuffer[i++] = xpos + w;
 		bufferInfo.vertexBuffer[i++] = ypos;
-		bufferInfo.vertexBuffer[i++] = float(g.xSize) / float(mMaxXSize);
-		bufferInfo.vertexBuffer[i++] = float(g.ySize) / float(mMaxYSize);
+		bufferInfo.vertexBuffer[i++] = float(g.xSize);
+		bufferInfo.vertexBuffer[i++] = float(g.ySize);
 
 		bufferInfo.vertexBuffer[i++] = xpos;
 		bufferInfo.vertexBuffer[i++] = ypos;
 		bufferInfo.vertexBuffer[i++] = 0.0;
-		bufferInfo.vertexBuffer[i++] = float(g.ySize) / float(mMaxYSize);
+		bufferInfo.vertexBuffer[i++] = float(g.ySize);
 
 		xStart += (g.advance >> 6) * mScale;// Bitshift by 6 to get value in pixels (2^6 = 64)
     }
 
+	bufferInfo.vertexCount = texI;
+	bufferInfo.vertexBuffer.resize(i);
+	bufferInfo.indexBuffer.resize(texI);
+
 	return bufferInfo;
 }
 
@@ -764,16 +851,16 @@ void Text::ConfigureVertexArray(Primitive::BufferInfo& bufferInfo) const
 	bufferInfo.GetOpenGLIndices(true);
 	glBindVertexArray(bufferInfo.GetVertexArrayIndex());
 
-	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetVertexBufferIndex());
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * bufferInfo.vertexBuffer.size(),
-		bufferInfo.vertexBuffer.data(), GL_DYNAMIC_DRAW);
+	bufferInfo.BufferVertexData(GL_DYNAMIC_DRAW);
 
 	glEnableVertexAttribArray(mVertexLocation);
 	glVertexAttribPointer(mVertexLocation, 4, GL_FLOAT, GL_FALSE, 0, 0);
 
+	// Indices are a vertex attribute, so they don't go through BufferIndexData()
 	glBindBuffer(GL_ARRAY_BUFFER, bufferInfo.GetIndexBufferIndex());
 	glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint) * bufferInfo.indexBuffer.size(),
 		bufferInfo.indexBuffer.data(), GL_DYNAMIC_DRAW);
+	bufferInfo.AddBytesUploaded(sizeof(GLuint) * bufferInfo.indexBuffer.size());
 
 	glEnableVertexAttribArray(mIndexLocation);
 	glVertexAttribIPointer(mIndexLocation, 1, GL_UNSIGNED_INT, 0, 0);
@@ -0,0 +1,174 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  mappedFile.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Read-only, memory-mapped view of a file.
+
+// Local headers
+#include "lp2d/utilities/mappedFile.h"
+
+// Platform headers
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			MappedFile
+// Function:		~MappedFile
+//
+// Description:		Destructor for MappedFile class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+//=============================================================================
+// Class:			MappedFile
+// Function:		Open
+//
+// Description:		Maps the specified file.  Empty files can't be mapped.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool MappedFile::Open(const std::string& fileName)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file(CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	mFileHandle = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+	{
+		Close();
+		return false;
+	}
+
+	mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+		nullptr);
+	if (!mMappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	mData = static_cast<const unsigned char*>(MapViewOfFile(mMappingHandle,
+		FILE_MAP_READ, 0, 0, 0));
+	if (!mData)
+	{
+		Close();
+		return false;
+	}
+
+	mSize = static_cast<std::size_t>(size.QuadPart);
+#else
+	mFileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (mFileDescriptor < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(mFileDescriptor, &status) != 0 || status.st_size <= 0)
+	{
+		Close();
+		return false;
+	}
+
+	void* data(mmap(nullptr, static_cast<std::size_t>(status.st_size),
+		PROT_READ, MAP_SHARED, mFileDescriptor, 0));
+	if (data == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	mData = static_cast<const unsigned char*>(data);
+	mSize = static_cast<std::size_t>(status.st_size);
+
+	// Access is mostly localized binary searches and tile reads, so
+	// read-ahead would only evict pages we still need
+	madvise(data, mSize, MADV_RANDOM);
+#endif
+
+	return true;
+}
+
+//=============================================================================
+// Class:			MappedFile
+// Function:		Close
+//
+// Description:		Unmaps the file and releases the associated handles.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (mData)
+		UnmapViewOfFile(mData);
+	if (mMappingHandle)
+		CloseHandle(mMappingHandle);
+	if (mFileHandle)
+		CloseHandle(mFileHandle);
+
+	mMappingHandle = nullptr;
+	mFileHandle = nullptr;
+#else
+	if (mData)
+		munmap(const_cast<unsigned char*>(mData), mSize);
+	if (mFileDescriptor >= 0)
+		close(mFileDescriptor);
+
+	mFileDescriptor = -1;
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+}// namespace LibPlot2D
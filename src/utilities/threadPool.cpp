@@ -0,0 +1,282 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  threadPool.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed-size pool of worker threads for executing batches of jobs.
+
+// Standard C++ headers
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+
+// Local headers
+#include "lp2d/utilities/threadPool.h"
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for ThreadPool class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+thread_local bool ThreadPool::mIsWorkerThread(false);
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		ThreadPool
+//
+// Description:		Constructor for the ThreadPool class.
+//
+// Input Arguments:
+//		threadCount	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+ThreadPool::ThreadPool(const unsigned int& threadCount)
+{
+	assert(threadCount > 0);
+
+	unsigned int i;
+	for (i = 0; i < threadCount; ++i)
+		mThreads.push_back(std::thread(&ThreadPool::ThreadEntry, this));
+}
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		~ThreadPool
+//
+// Description:		Destructor for the ThreadPool class.  Waits for queued jobs
+//					to complete before stopping the worker threads.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+ThreadPool::~ThreadPool()
+{
+	WaitForAllJobsComplete();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mShuttingDown = true;
+	}
+
+	mJobReadyCondition.notify_all();
+	for (auto& t : mThreads)
+		t.join();
+}
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		AddJob
+//
+// Description:		Adds a job to the queue.
+//
+// Input Arguments:
+//		job	= std::function<void()>
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ThreadPool::AddJob(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push(std::move(job));
+		++mPendingJobs;
+	}
+
+	mJobReadyCondition.notify_one();
+}
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		WaitForAllJobsComplete
+//
+// Description:		Blocks until the job queue is empty and no jobs are being
+//					executed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ThreadPool::WaitForAllJobsComplete()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mJobsCompleteCondition.wait(lock, [this]() { return mPendingJobs == 0; });
+}
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		ParallelFor
+//
+// Description:		Executes the specified work for each block of the range,
+//					using the worker threads and the calling thread.  Blocks
+//					are claimed one at a time, so uneven blocks are balanced
+//					across the threads.  Only the jobs added here are waited
+//					for.
+//
+// Input Arguments:
+//		count		= const unsigned int&
+//		blockSize	= const unsigned int&
+//		work		= const std::function<void(const unsigned int&,
+//					  const unsigned int&)>& to be called with the beginning
+//					  and (one past the) end of each block
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ThreadPool::ParallelFor(const unsigned int& count,
+	const unsigned int& blockSize, const std::function<void(
+	const unsigned int&, const unsigned int&)>& work)
+{
+	assert(blockSize > 0);
+
+	const unsigned int blockCount((count + blockSize - 1) / blockSize);
+	if (blockCount < 2 || mIsWorkerThread)
+	{
+		if (count > 0)
+			work(0, count);
+		return;
+	}
+
+	std::atomic<unsigned int> nextBlock(0);
+	auto doBlocks([&nextBlock, &blockCount, &blockSize, &count, &work]()
+	{
+		unsigned int block;
+		while ((block = nextBlock++) < blockCount)
+		{
+			const unsigned int begin(block * blockSize);
+			work(begin, std::min(begin + blockSize, count));
+		}
+	});
+
+	// Helpers which start after the last block has been claimed return
+	// immediately
+	const unsigned int helperCount(std::min(blockCount - 1, GetThreadCount()));
+	unsigned int remainingHelpers(helperCount);
+	std::mutex helperMutex;
+	std::condition_variable helpersCompleteCondition;
+
+	unsigned int i;
+	for (i = 0; i < helperCount; ++i)
+	{
+		AddJob([&doBlocks, &remainingHelpers, &helperMutex,
+			&helpersCompleteCondition]()
+		{
+			doBlocks();
+
+			// Notify while holding the lock, since the condition is destroyed
+			// as soon as the caller sees that all helpers are complete
+			std::lock_guard<std::mutex> lock(helperMutex);
+			if (--remainingHelpers == 0)
+				helpersCompleteCondition.notify_one();
+		});
+	}
+
+	doBlocks();
+
+	std::unique_lock<std::mutex> lock(helperMutex);
+	helpersCompleteCondition.wait(lock, [&remainingHelpers]()
+	{
+		return remainingHelpers == 0;
+	});
+}
+
+//=============================================================================
+// Class:			ThreadPool
+// Function:		ThreadEntry
+//
+// Description:		Entry point for worker threads.  Executes jobs until the
+//					pool is destroyed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void ThreadPool::ThreadEntry()
+{
+	mIsWorkerThread = true;
+
+	while (true)
+	{
+		std::function<void()> job;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mJobReadyCondition.wait(lock, [this]()
+			{
+				return mShuttingDown || !mJobs.empty();
+			});
+
+			if (mJobs.empty())
+				return;// Shutting down
+
+			job = std::move(mJobs.front());
+			mJobs.pop();
+		}
+
+		job();
+
+		bool allComplete;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			allComplete = --mPendingJobs == 0;
+		}
+
+		if (allComplete)
+			mJobsCompleteCondition.notify_all();
+	}
+}
+
+}// namespace LibPlot2D
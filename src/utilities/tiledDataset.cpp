@@ -0,0 +1,1266 @@
+/*=============================================================================
+                                   LibPlot2D
+                       Copyright Kerry R. Loux 2011-2016
+
+                  This code is licensed under the GPLv2 License
+                    (http://opensource.org/licenses/GPL-2.0).
+=============================================================================*/
+
+// File:  tiledDataset.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Multi-resolution, on-disk representation of x-y data sets which are
+//        too large to fit in memory.
+
+// Local headers
+#include "lp2d/utilities/tiledDataset.h"
+#include "lp2d/utilities/math/plotMath.h"
+
+// Standard C++ headers
+#include <cassert>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+
+namespace LibPlot2D
+{
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		Constant declarations
+//
+// Description:		Constant declarations for TiledDataset class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+const char TiledDataset::mMagic[8] = { 'L', 'P', '2', 'D', 'T', 'I', 'L', 'E' };
+const std::uint32_t TiledDataset::mVersion(1);
+const unsigned int TiledDataset::mLevelFactor(16);
+const unsigned int TiledDataset::mDefaultTileSize(4096);
+const unsigned int TiledDataset::mMaxLevels(16);
+const unsigned int TiledDataset::mMinCacheSize(16);
+const unsigned int TiledDataset::mDefaultCacheSize(256);
+const unsigned int TiledDataset::mPointsPerColumn(4);
+
+// Records are read directly from the mapped file, so the layout must not
+// depend on the compiler
+static_assert(sizeof(TiledDataset::Record) == 8 * sizeof(double),
+	"Unexpected padding in TiledDataset::Record");
+
+//=============================================================================
+// Class:			TiledDataset::FileHeader
+//
+// Description:		Layout of the start of a tiled data file.  Each level
+//					follows the header, starting with the raw points (stored
+//					as x-y pairs) and ending with the coarsest level.
+//
+//=============================================================================
+struct TiledDataset::FileHeader
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t levelFactor;
+	std::uint32_t tileSize;
+	std::uint32_t levelCount;
+	std::uint64_t levelOffsets[mMaxLevels];// [bytes]
+	std::uint64_t levelSizes[mMaxLevels];// [records]
+};
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+//
+// Description:		Streams points to a tiled data file, building the coarser
+//					levels as it goes.  The coarser levels are written to
+//					temporary files and appended to the output file when
+//					complete.  The output file is removed unless Finish()
+//					succeeds.
+//
+//=============================================================================
+class TiledDataset::PyramidWriter
+{
+public:
+	explicit PyramidWriter(const std::string& fileName);
+	~PyramidWriter();
+
+	bool IsOpen() const { return mFile.is_open(); }
+	bool Add(const std::vector<double>& x, const std::vector<double>& y);
+	bool Finish();
+
+private:
+	const std::string mFileName;
+	std::ofstream mFile;
+
+	// Record under construction for each level (the first is unused)
+	struct Accumulator
+	{
+		Record record;
+		double ySum = 0.0;
+		unsigned int children = 0;
+	};
+
+	std::vector<Accumulator> mAccumulators;
+	std::vector<std::unique_ptr<std::fstream>> mLevelFiles;
+	std::vector<std::uint64_t> mLevelSizes;
+
+	double mLastX = std::numeric_limits<double>::lowest();
+	std::vector<double> mBuffer;
+	bool mFailed = false;
+	bool mComplete = false;
+
+	void Merge(const unsigned int& level, const Record& child);
+	void Emit(const unsigned int& level);
+	std::string GetLevelFileName(const unsigned int& level) const;
+	void RemoveLevelFiles();
+};
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		PyramidWriter
+//
+// Description:		Constructor for PyramidWriter class.  Opens the output file
+//					and reserves space for the header.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+TiledDataset::PyramidWriter::PyramidWriter(const std::string& fileName)
+	: mFileName(fileName), mFile(fileName.c_str(),
+	std::ios::binary | std::ios::trunc), mLevelSizes(1, 0)
+{
+	FileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		~PyramidWriter
+//
+// Description:		Destructor for PyramidWriter class.  Removes the temporary
+//					files, and the output file if it is incomplete.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+TiledDataset::PyramidWriter::~PyramidWriter()
+{
+	RemoveLevelFiles();
+
+	if (!mComplete)
+	{
+		mFile.close();
+		std::remove(mFileName.c_str());
+	}
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		Add
+//
+// Description:		Writes the specified points to the file and adds them to
+//					the coarser levels.
+//
+// Input Arguments:
+//		x	= const std::vector<double>&
+//		y	= const std::vector<double>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise (i.e. points not in order)
+//
+//=============================================================================
+bool TiledDataset::PyramidWriter::Add(const std::vector<double>& x,
+	const std::vector<double>& y)
+{
+	assert(x.size() == y.size());
+
+	mBuffer.resize(x.size() * 2);
+	Record record;
+	unsigned int i;
+	for (i = 0; i < x.size(); ++i)
+	{
+		if (!PlotMath::IsValid(x[i]) || x[i] < mLastX)
+			return false;
+		mLastX = x[i];
+
+		mBuffer[2 * i] = x[i];
+		mBuffer[2 * i + 1] = y[i];
+
+		record.xMin = x[i];
+		record.xMax = x[i];
+		record.yMin = y[i];
+		record.yMax = y[i];
+		record.yMean = y[i];
+		record.xAtYMin = x[i];
+		record.xAtYMax = x[i];
+		record.count = PlotMath::IsValid(y[i]) ? 1 : 0;
+		Merge(1, record);
+	}
+
+	mFile.write(reinterpret_cast<const char*>(mBuffer.data()),
+		mBuffer.size() * sizeof(double));
+	mLevelSizes[0] += x.size();
+
+	return !mFailed && mFile.good();
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		Finish
+//
+// Description:		Completes the partial records, appends the coarser levels
+//					to the output file and writes the header.  Levels are added
+//					until one fits within a single tile.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool TiledDataset::PyramidWriter::Finish()
+{
+	if (mFailed || mLevelSizes[0] == 0)
+		return false;
+
+	unsigned int levelCount(1);
+	while (!mFailed && mLevelSizes[levelCount - 1] > mDefaultTileSize)
+	{
+		assert(levelCount < mAccumulators.size());
+		if (mAccumulators[levelCount].children > 0)
+			Emit(levelCount);
+		++levelCount;
+	}
+
+	if (mFailed || levelCount > mMaxLevels)
+		return false;
+
+	FileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, mMagic, sizeof(header.magic));
+	header.version = mVersion;
+	header.levelFactor = mLevelFactor;
+	header.tileSize = mDefaultTileSize;
+	header.levelCount = levelCount;
+
+	std::uint64_t offset(sizeof(header));
+	unsigned int level;
+	for (level = 0; level < levelCount; ++level)
+	{
+		header.levelOffsets[level] = offset;
+		header.levelSizes[level] = mLevelSizes[level];
+		offset += mLevelSizes[level] * GetRecordSize(level);
+	}
+
+	std::vector<char> buffer(1 << 20);
+	for (level = 1; level < levelCount; ++level)
+	{
+		std::fstream& levelFile(*mLevelFiles[level]);
+		levelFile.flush();
+		levelFile.seekg(0);
+
+		std::uint64_t remaining(mLevelSizes[level] * GetRecordSize(level));
+		while (remaining > 0 && levelFile.good())
+		{
+			const std::size_t size(static_cast<std::size_t>(
+				std::min<std::uint64_t>(remaining, buffer.size())));
+			levelFile.read(buffer.data(), size);
+			mFile.write(buffer.data(), size);
+			remaining -= size;
+		}
+
+		if (remaining > 0)
+			return false;
+	}
+
+	mFile.seekp(0);
+	mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	mFile.close();
+
+	mComplete = !mFile.fail();
+	return mComplete;
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		Merge
+//
+// Description:		Adds the specified record to the record under construction
+//					for the specified level, creating the level if necessary.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		child	= const Record& from the level below
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::PyramidWriter::Merge(const unsigned int& level,
+	const Record& child)
+{
+	if (level >= mMaxLevels)
+	{
+		mFailed = true;
+		return;
+	}
+
+	if (mAccumulators.size() <= level)
+	{
+		mAccumulators.resize(level + 1);
+		mLevelSizes.resize(level + 1, 0);
+		mLevelFiles.resize(level + 1);
+		mLevelFiles[level].reset(new std::fstream(
+			GetLevelFileName(level).c_str(), std::ios::in | std::ios::out
+			| std::ios::binary | std::ios::trunc));
+		if (!mLevelFiles[level]->is_open())
+			mFailed = true;
+	}
+
+	Accumulator& accumulator(mAccumulators[level]);
+	Record& record(accumulator.record);
+	if (accumulator.children == 0)
+	{
+		record = child;
+		accumulator.ySum = child.count > 0 ? child.yMean * child.count : 0.0;
+	}
+	else
+	{
+		record.xMax = child.xMax;
+		if (child.count > 0)
+		{
+			if (record.count == 0 || child.yMin < record.yMin)
+			{
+				record.yMin = child.yMin;
+				record.xAtYMin = child.xAtYMin;
+			}
+
+			if (record.count == 0 || child.yMax > record.yMax)
+			{
+				record.yMax = child.yMax;
+				record.xAtYMax = child.xAtYMax;
+			}
+
+			accumulator.ySum += child.yMean * child.count;
+			record.count += child.count;
+		}
+	}
+
+	if (++accumulator.children == mLevelFactor)
+		Emit(level);
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		Emit
+//
+// Description:		Completes the record under construction for the specified
+//					level, writes it to the level's file and adds it to the
+//					next level.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::PyramidWriter::Emit(const unsigned int& level)
+{
+	// Copy the record, since adding to the next level may reallocate the
+	// accumulators
+	Record record(mAccumulators[level].record);
+	if (record.count > 0)
+		record.yMean = mAccumulators[level].ySum / record.count;
+	else
+	{
+		record.yMin = std::numeric_limits<double>::quiet_NaN();
+		record.yMax = record.yMin;
+		record.yMean = record.yMin;
+	}
+
+	mAccumulators[level].children = 0;
+
+	mLevelFiles[level]->write(reinterpret_cast<const char*>(&record),
+		sizeof(record));
+	if (!mLevelFiles[level]->good())
+		mFailed = true;
+	++mLevelSizes[level];
+
+	Merge(level + 1, record);
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		GetLevelFileName
+//
+// Description:		Returns the name of the temporary file for the specified
+//					level.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//=============================================================================
+std::string TiledDataset::PyramidWriter::GetLevelFileName(
+	const unsigned int& level) const
+{
+	return mFileName + ".level" + std::to_string(level);
+}
+
+//=============================================================================
+// Class:			TiledDataset::PyramidWriter
+// Function:		RemoveLevelFiles
+//
+// Description:		Closes and deletes the temporary files.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::PyramidWriter::RemoveLevelFiles()
+{
+	unsigned int level;
+	for (level = 1; level < mLevelFiles.size(); ++level)
+	{
+		mLevelFiles[level].reset();
+		std::remove(GetLevelFileName(level).c_str());
+	}
+
+	mLevelFiles.clear();
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		~TiledDataset
+//
+// Description:		Destructor for TiledDataset class.  Waits for any tiles
+//					being read to finish.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+TiledDataset::~TiledDataset()
+{
+	if (mLoad.valid())
+		mLoad.wait();
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		Create
+//
+// Description:		Creates a tiled data file from the specified source.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//		source		= const Source&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool TiledDataset::Create(const std::string& fileName, const Source& source)
+{
+	PyramidWriter writer(fileName);
+	if (!writer.IsOpen())
+		return false;
+
+	std::vector<double> x, y;
+	while (source(x, y))
+	{
+		if (x.size() != y.size() || !writer.Add(x, y))
+			return false;
+	}
+
+	return writer.Finish();
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		Open
+//
+// Description:		Maps the specified file and reads the coarsest level.
+//
+// Input Arguments:
+//		fileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//=============================================================================
+bool TiledDataset::Open(const std::string& fileName)
+{
+	if (mLoad.valid())
+		mLoad.wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mTiles.clear();
+	}
+
+	mLevelOffsets.clear();
+	mLevelSizes.clear();
+	mTopLevel.clear();
+	mData.Resize(0);
+	mViewValid = false;
+
+	if (!mFile.Open(fileName))
+		return false;
+
+	FileHeader header;
+	if (mFile.GetSize() < sizeof(header))
+	{
+		mFile.Close();
+		return false;
+	}
+
+	std::memcpy(&header, mFile.GetData(), sizeof(header));
+	bool valid(std::memcmp(header.magic, mMagic, sizeof(mMagic)) == 0
+		&& header.version == mVersion && header.tileSize > 0
+		&& header.levelCount > 0 && header.levelCount <= mMaxLevels);
+
+	unsigned int level;
+	for (level = 0; valid && level < header.levelCount; ++level)
+	{
+		valid = header.levelSizes[level] > 0 && header.levelOffsets[level]
+			+ header.levelSizes[level] * GetRecordSize(level) <= mFile.GetSize();
+	}
+
+	if (!valid)
+	{
+		mFile.Close();
+		return false;
+	}
+
+	mTileSize = header.tileSize;
+	mLevelOffsets.assign(header.levelOffsets,
+		header.levelOffsets + header.levelCount);
+	mLevelSizes.assign(header.levelSizes,
+		header.levelSizes + header.levelCount);
+
+	const unsigned int topLevel(GetLevelCount() - 1);
+	mTopLevel.resize(static_cast<std::size_t>(mLevelSizes[topLevel]));
+	std::uint64_t i;
+	for (i = 0; i < mLevelSizes[topLevel]; ++i)
+		mTopLevel[static_cast<std::size_t>(i)] = ReadRecord(topLevel, i);
+
+	return true;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		SetLoadCallback
+//
+// Description:		Sets the function to call when tiles have been read.  Must
+//					not be called while tiles are being read.
+//
+// Input Arguments:
+//		callback	= std::function<void()>
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::SetLoadCallback(std::function<void()> callback)
+{
+	if (mLoad.valid())
+		mLoad.wait();
+	mLoadCallback = std::move(callback);
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		SetCacheSize
+//
+// Description:		Sets the maximum number of cached tiles.  Enough tiles to
+//					cover any view are always retained.
+//
+// Input Arguments:
+//		tiles	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::SetCacheSize(const unsigned int& tiles)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCacheSize = std::max(tiles, mMinCacheSize);
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		UpdateView
+//
+// Description:		Rebuilds the data set for the specified view, if the view
+//					or the cached tiles have changed.  The desired level is the
+//					finest level with no more than a few points per column
+//					within the view.  Starting from the coarsest level (which
+//					is in memory), the records within the view are found among
+//					the children of the records found at the level above, so
+//					only records from cached tiles are read here.  If the next
+//					finer level may be within the budget but is not cached, it
+//					is requested and the current level is used instead (the
+//					view is refined further when the tiles have been read).
+//
+// Input Arguments:
+//		xMin	= const double&
+//		xMax	= const double&
+//		columns	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the data set was modified
+//
+//=============================================================================
+bool TiledDataset::UpdateView(const double& xMin, const double& xMax,
+	const unsigned int& columns)
+{
+	if (!mFile.GetData())
+		return false;
+
+	const std::uint64_t budget(static_cast<std::uint64_t>(
+		std::max(columns, 1U)) * mPointsPerColumn);
+
+	// Hold the lock until the data is built so the tiles can't be evicted
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	unsigned int level(GetLevelCount() - 1);
+	std::uint64_t first, last;
+	FindRange(level, xMin, xMax, 0, mLevelSizes[level], first, last);
+	while (level > 0)
+	{
+		const unsigned int below(level - 1);
+		const std::uint64_t childFirst(std::min<std::uint64_t>(
+			first * mLevelFactor, mLevelSizes[below]));
+		const std::uint64_t childLast(std::min<std::uint64_t>(
+			last * mLevelFactor, mLevelSizes[below]));
+
+		// The children of all but the first and last records are entirely
+		// within the view, so if they exceed the budget, this level is
+		// the desired level
+		const std::uint64_t interior(last - first > 2
+			? (last - first - 2) * mLevelFactor : 0);
+		if (RecordsToPoints(below, std::min(interior, childLast - childFirst))
+			> budget)
+			break;
+
+		// Includes the records beyond each end of the view
+		const std::uint64_t searchFirst(childFirst > 0 ? childFirst - 1 : 0);
+		const std::uint64_t searchLast(std::min<std::uint64_t>(
+			childLast + 1, mLevelSizes[below]));
+		if (!TilesAreCached(below, searchFirst, searchLast))
+		{
+			RequestTiles(below, searchFirst, searchLast);
+			break;
+		}
+
+		std::uint64_t belowFirst, belowLast;
+		FindRange(below, xMin, xMax, childFirst, childLast, belowFirst,
+			belowLast);
+		if (RecordsToPoints(below, belowLast - belowFirst + 2) > budget)
+			break;
+
+		level = below;
+		first = belowFirst;
+		last = belowLast;
+	}
+
+	// Include one record beyond each end (so lines continue past the edges
+	// of the view)
+	if (first > 0)
+		--first;
+	if (last < mLevelSizes[level])
+		++last;
+
+	if (mViewValid && xMin == mViewXMin && xMax == mViewXMax
+		&& columns == mViewColumns && level == mViewLevel)
+		return false;
+
+	BuildData(level, first, last);
+
+	mViewValid = true;
+	mViewXMin = xMin;
+	mViewXMax = xMax;
+	mViewColumns = columns;
+	mViewLevel = level;
+
+	return true;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		GetPointCount
+//
+// Description:		Returns the number of raw points in the file.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//=============================================================================
+std::uint64_t TiledDataset::GetPointCount() const
+{
+	if (mLevelSizes.empty())
+		return 0;
+	return mLevelSizes.front();
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		GetXMinimum
+//
+// Description:		Returns the minimum x-value in the file.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//=============================================================================
+double TiledDataset::GetXMinimum() const
+{
+	if (mTopLevel.empty())
+		return 0.0;
+	return mTopLevel.front().xMin;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		GetXMaximum
+//
+// Description:		Returns the maximum x-value in the file.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double
+//
+//=============================================================================
+double TiledDataset::GetXMaximum() const
+{
+	if (mTopLevel.empty())
+		return 0.0;
+	return mTopLevel.back().xMax;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		ReadRecord
+//
+// Description:		Reads the specified record from the mapped file.  Records
+//					at the lowest level are expanded from x-y pairs.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		index	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Record
+//
+//=============================================================================
+TiledDataset::Record TiledDataset::ReadRecord(const unsigned int& level,
+	const std::uint64_t& index) const
+{
+	assert(level < GetLevelCount() && index < mLevelSizes[level]);
+
+	const unsigned char* start(mFile.GetData()
+		+ mLevelOffsets[level] + index * GetRecordSize(level));
+
+	Record record;
+	if (level > 0)
+	{
+		std::memcpy(&record, start, sizeof(record));
+		return record;
+	}
+
+	double point[2];
+	std::memcpy(point, start, sizeof(point));
+	record.xMin = point[0];
+	record.xMax = point[0];
+	record.yMin = point[1];
+	record.yMax = point[1];
+	record.yMean = point[1];
+	record.xAtYMin = point[0];
+	record.xAtYMax = point[0];
+	record.count = PlotMath::IsValid(point[1]) ? 1 : 0;
+	return record;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		GetCachedRecord
+//
+// Description:		Returns the specified record from the coarsest level or
+//					from the tile cache.  Must be called with mMutex locked,
+//					and with the tile containing the record cached.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		index	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Record&
+//
+//=============================================================================
+const TiledDataset::Record& TiledDataset::GetCachedRecord(
+	const unsigned int& level, const std::uint64_t& index) const
+{
+	if (level == GetLevelCount() - 1)
+		return mTopLevel[static_cast<std::size_t>(index)];
+
+	const Tile& tile(mTiles.at(TileKey(level, index / mTileSize)));
+	return tile.records[static_cast<std::size_t>(index % mTileSize)];
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		FindRange
+//
+// Description:		Finds the records at the specified level which overlap the
+//					specified range, among the specified records (which must
+//					be cached, see GetCachedRecord()).
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		xMin	= const double&
+//		xMax	= const double&
+//		start	= const std::uint64_t&
+//		end		= const std::uint64_t& (one past the final record)
+//
+// Output Arguments:
+//		first	= std::uint64_t&
+//		last	= std::uint64_t& (one past the final record)
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::FindRange(const unsigned int& level, const double& xMin,
+	const double& xMax, const std::uint64_t& start, const std::uint64_t& end,
+	std::uint64_t& first, std::uint64_t& last) const
+{
+	// Records are sorted, so both ends of each record increase with index
+	std::uint64_t low(start), high(end), middle;
+	while (low < high)
+	{
+		middle = low + (high - low) / 2;
+		if (GetCachedRecord(level, middle).xMax < xMin)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	first = low;
+
+	high = end;
+	while (low < high)
+	{
+		middle = low + (high - low) / 2;
+		if (GetCachedRecord(level, middle).xMin <= xMax)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	last = low;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		RecordsToPoints
+//
+// Description:		Returns the number of points in the data set representing
+//					the specified number of records at the specified level.
+//					Each record above the lowest level contributes two points.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		records	= const std::uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::uint64_t
+//
+//=============================================================================
+std::uint64_t TiledDataset::RecordsToPoints(const unsigned int& level,
+	const std::uint64_t& records)
+{
+	if (level == 0)
+		return records;
+	return 2 * records;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		TilesAreCached
+//
+// Description:		Checks for the tiles containing the specified records,
+//					marking them as recently used.  Must be called with mMutex
+//					locked.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		first	= const std::uint64_t&
+//		last	= const std::uint64_t& (one past the final record)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if all of the tiles are cached
+//
+//=============================================================================
+bool TiledDataset::TilesAreCached(const unsigned int& level,
+	const std::uint64_t& first, const std::uint64_t& last)
+{
+	if (last <= first)
+		return true;
+
+	std::uint64_t tile;
+	for (tile = first / mTileSize; tile <= (last - 1) / mTileSize; ++tile)
+	{
+		auto it(mTiles.find(TileKey(level, tile)));
+		if (it == mTiles.end())
+			return false;
+		it->second.lastUsed = ++mUseCounter;
+	}
+
+	return true;
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		RequestTiles
+//
+// Description:		Starts reading the uncached tiles containing the specified
+//					records on a worker thread.  If tiles are already being
+//					read, no new request is made; the load callback will
+//					trigger another update when the current request finishes.
+//					Must be called with mMutex locked.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		first	= const std::uint64_t&
+//		last	= const std::uint64_t& (one past the final record)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::RequestTiles(const unsigned int& level,
+	const std::uint64_t& first, const std::uint64_t& last)
+{
+	if (mLoad.valid())
+	{
+		if (mLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return;
+		mLoad.get();
+	}
+
+	std::vector<TileKey> keys;
+	std::uint64_t tile;
+	for (tile = first / mTileSize; tile <= (last - 1) / mTileSize; ++tile)
+	{
+		if (mTiles.find(TileKey(level, tile)) == mTiles.end())
+			keys.push_back(TileKey(level, tile));
+	}
+
+	if (keys.empty())
+		return;
+
+	// Reading the records from the mapped file is what touches the disk, so
+	// it must not happen on the calling thread
+	mLoad = std::async(std::launch::async, [this, keys]()
+	{
+		for (const auto& key : keys)
+		{
+			const std::uint64_t start(key.second * mTileSize);
+			const std::uint64_t end(std::min<std::uint64_t>(
+				start + mTileSize, mLevelSizes[key.first]));
+
+			std::vector<Record> records;
+			records.reserve(static_cast<std::size_t>(end - start));
+			std::uint64_t i;
+			for (i = start; i < end; ++i)
+				records.push_back(ReadRecord(key.first, i));
+
+			CacheTile(key, std::move(records));
+		}
+
+		if (mLoadCallback)
+			mLoadCallback();
+	});
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		CacheTile
+//
+// Description:		Adds the specified tile to the cache, evicting the least
+//					recently used tiles if the cache is full.
+//
+// Input Arguments:
+//		key		= const TileKey&
+//		records	= std::vector<Record>&&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::CacheTile(const TileKey& key, std::vector<Record>&& records)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	Tile& tile(mTiles[key]);
+	tile.records = std::move(records);
+	tile.lastUsed = ++mUseCounter;
+
+	while (mTiles.size() > mCacheSize)
+	{
+		auto oldest(std::min_element(mTiles.begin(), mTiles.end(),
+			[](const std::pair<const TileKey, Tile>& a,
+			const std::pair<const TileKey, Tile>& b)
+		{
+			return a.second.lastUsed < b.second.lastUsed;
+		}));
+		mTiles.erase(oldest);
+	}
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		BuildData
+//
+// Description:		Fills the data set with the specified records, and the
+//					records from the coarsest level outside of their range.
+//					Must be called with mMutex locked, and with the tiles
+//					containing the specified records cached.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//		first	= const std::uint64_t&
+//		last	= const std::uint64_t& (one past the final record)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::BuildData(const unsigned int& level,
+	const std::uint64_t& first, const std::uint64_t& last)
+{
+	std::vector<double>& x(mData.GetX());
+	std::vector<double>& y(mData.GetY());
+	x.clear();
+	y.clear();
+
+	if (level == GetLevelCount() - 1 || last <= first)
+	{
+		for (const auto& record : mTopLevel)
+			AppendRecord(record, x, y);
+		return;
+	}
+
+	std::vector<const Record*> records;
+	records.reserve(static_cast<std::size_t>(last - first));
+	std::uint64_t i;
+	for (i = first; i < last; ++i)
+	{
+		const Tile& tile(mTiles.at(TileKey(level, i / mTileSize)));
+		records.push_back(&tile.records[static_cast<std::size_t>(i % mTileSize)]);
+	}
+
+	const double xStart(records.front()->xMin);
+	const double xEnd(records.back()->xMax);
+
+	for (const auto& record : mTopLevel)
+	{
+		if (record.xMax >= xStart)
+			break;
+		AppendRecord(record, x, y);
+	}
+
+	for (const auto& record : records)
+		AppendRecord(*record, x, y);
+
+	for (const auto& record : mTopLevel)
+	{
+		if (record.xMin > xEnd)
+			AppendRecord(record, x, y);
+	}
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		AppendRecord
+//
+// Description:		Adds the points representing the specified record.  The
+//					minimum and maximum are added in order of increasing x, so
+//					the envelope of the data is preserved.  Records without
+//					valid values are represented by an invalid point, which
+//					breaks the line.
+//
+// Input Arguments:
+//		record	= const Record&
+//
+// Output Arguments:
+//		x		= std::vector<double>&
+//		y		= std::vector<double>&
+//
+// Return Value:
+//		None
+//
+//=============================================================================
+void TiledDataset::AppendRecord(const Record& record, std::vector<double>& x,
+	std::vector<double>& y)
+{
+	if (record.count == 0)
+	{
+		x.push_back(record.xMin);
+		y.push_back(std::numeric_limits<double>::quiet_NaN());
+	}
+	else if (record.count == 1)
+	{
+		x.push_back(record.xAtYMin);
+		y.push_back(record.yMin);
+	}
+	else if (record.xAtYMin <= record.xAtYMax)
+	{
+		x.push_back(record.xAtYMin);
+		y.push_back(record.yMin);
+		x.push_back(record.xAtYMax);
+		y.push_back(record.yMax);
+	}
+	else
+	{
+		x.push_back(record.xAtYMax);
+		y.push_back(record.yMax);
+		x.push_back(record.xAtYMin);
+		y.push_back(record.yMin);
+	}
+}
+
+//=============================================================================
+// Class:			TiledDataset
+// Function:		GetRecordSize
+//
+// Description:		Returns the size of each record stored at the specified
+//					level.
+//
+// Input Arguments:
+//		level	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::size_t [bytes]
+//
+//=============================================================================
+std::size_t TiledDataset::GetRecordSize(const unsigned int& level)
+{
+	if (level == 0)
+		return 2 * sizeof(double);
+	return sizeof(Record);
+}
+
+}// namespace LibPlot2D